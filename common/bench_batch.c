@@ -0,0 +1,101 @@
+/* 批量加载性能对比: 逐个 udlist_append vs udlist_append_n */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "uni_doubly_linkedlist.h"
+
+/* 获取当前时间(秒) */
+static double now_sec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* 创建指定模式的链表 */
+static udlist_t *make(int mode)
+{
+    if (0 == mode)
+    {
+        return udlist_create_ex(sizeof(int), NULL, UDLIST_INLINE);
+    } /* end of if (0 == mode) */
+    if (1 == mode)
+    {
+        return udlist_create_pooled(sizeof(int), NULL, 4096);
+    } /* end of if (1 == mode) */
+    if (2 == mode)
+    {
+        return udlist_create_ex(sizeof(int), NULL, UDLIST_INLINE | UDLIST_INDEXED);
+    } /* end of if (2 == mode) */
+    return udlist_create_ex(sizeof(int), NULL, UDLIST_UNROLLED);
+}
+
+/* 加载 n 个元素: batch 为 0 时逐个插入, 否则每次批量插入 batch 个 */
+static double run(int mode, int *array, int n, int batch)
+{
+    udlist_t *head = NULL;
+    double t0 = 0;
+    double t1 = 0;
+    int i = 0;
+
+    head = make(mode);
+    t0 = now_sec();
+    if (0 == batch)
+    {
+        for (i = 0; i < n; i++)
+        {
+            udlist_append(head, &array[i]);
+        } /* end of for (i = 0; i < n; i++) */
+    }
+    else
+    {
+        for (i = 0; i < n; i += batch)
+        {
+            udlist_append_n(head, &array[i], (n - i < batch) ? n - i : batch);
+        } /* end of for (i = 0; i < n; i += batch) */
+    }
+    t1 = now_sec();
+
+    udlist_destroy(head);
+    head_destroy(&head);
+
+    return (t1 - t0) * 1e9 / n;
+}
+
+
+int main(int argc, char **argv)
+{
+    const char *name[] = {"inline", "pooled", "indexed", "unrolled"};
+    int *array = NULL;
+    double t_one = 0;
+    double t_all = 0;
+    double t_1k = 0;
+    int n = 5000000;
+    int i = 0;
+
+    if (argc > 1)
+    {
+        n = atoi(argv[1]);
+    } /* end of if (argc > 1) */
+
+    array = (int *)malloc(n * sizeof(int));
+    for (i = 0; i < n; i++)
+    {
+        array[i] = i;
+    } /* end of for (i = 0; i < n; i++) */
+
+    for (i = 0; i < 4; i++)
+    {
+        run(i, array, n, n);    // 预热堆内存, 避免首次缺页计入
+        t_one = run(i, array, n, 0);
+        t_all = run(i, array, n, n);
+        t_1k = run(i, array, n, 1024);
+        printf("%-8s n=%-9d append %6.1f ns/elem   append_n(all) %6.1f ns/elem   append_n(1024) %6.1f ns/elem\n",
+               name[i], n, t_one, t_all, t_1k);
+    } /* end of for (i = 0; i < 4; i++) */
+
+    free(array);
+
+    return 0;
+}
@@ -0,0 +1,126 @@
+/* 并发读性能对比: 全局互斥锁包裹每次调用 vs 并发模式(UDLIST_CONCURRENT) 读写锁
+ *
+ * 用法: ./bench_concurrent [threads] [n] [ops]
+ *      threads 最大读线程数(默认 8), 从 1 开始按 2 倍递增
+ *      n       链表长度(默认 100000)
+ *      ops     每个线程的检索次数(默认 200000)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+#include "uni_doubly_linkedlist.h"
+
+/* 测试参数 */
+static udlist_t *head = NULL;              // 当前测试的链表
+static udlist_t *plain = NULL;             // 普通链表, 由全局互斥锁保护
+static udlist_t *shared = NULL;            // 并发模式链表
+static pthread_mutex_t global = PTHREAD_MUTEX_INITIALIZER;
+static int use_mutex = 0;
+static int n = 100000;
+static int ops = 200000;
+
+/* 获取当前时间(秒) */
+static double now_sec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* 读线程: 随机位置检索 */
+static void *reader(void *arg)
+{
+    unsigned int seed = (unsigned int)(long)arg;
+    int data = 0;
+    int i = 0;
+
+    for (i = 0; i < ops; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        if (use_mutex)
+        {
+            pthread_mutex_lock(&global);
+        } /* end of if (use_mutex) */
+        udlist_retrieve_by_index(head, &data, seed % n);
+        if (use_mutex)
+        {
+            pthread_mutex_unlock(&global);
+        } /* end of if (use_mutex) */
+    } /* end of for (i = 0; i < ops; i++) */
+
+    return NULL;
+}
+
+/* threads 个读线程同时检索, 返回总吞吐量(次/秒) */
+static double run(int threads)
+{
+    pthread_t tid[64];
+    double t0 = 0;
+    int i = 0;
+
+    t0 = now_sec();
+    for (i = 0; i < threads; i++)
+    {
+        pthread_create(&tid[i], NULL, reader, (void *)(long)(i + 1));
+    } /* end of for (i = 0; i < threads; i++) */
+    for (i = 0; i < threads; i++)
+    {
+        pthread_join(tid[i], NULL);
+    } /* end of for (i = 0; i < threads; i++) */
+
+    return (double)threads * ops / (now_sec() - t0);
+}
+
+
+int main(int argc, char **argv)
+{
+    double t_mutex = 0;
+    double t_rwlock = 0;
+    int max = 8;
+    int t = 0;
+    int i = 0;
+
+    if (argc > 1)
+    {
+        max = atoi(argv[1]);
+        max = (max > 64) ? 64 : max;
+    } /* end of if (argc > 1) */
+    if (argc > 2)
+    {
+        n = atoi(argv[2]);
+    } /* end of if (argc > 2) */
+    if (argc > 3)
+    {
+        ops = atoi(argv[3]);
+    } /* end of if (argc > 3) */
+
+    // 秩树模式使随机检索为 O(log n), 避免遍历耗时掩盖锁开销
+    plain = udlist_create_ex(sizeof(int), NULL, UDLIST_INLINE | UDLIST_INDEXED);
+    shared = udlist_create_ex(sizeof(int), NULL, UDLIST_INLINE | UDLIST_INDEXED | UDLIST_CONCURRENT);
+    for (i = 0; i < n; i++)
+    {
+        udlist_append(plain, &i);
+        udlist_append(shared, &i);
+    } /* end of for (i = 0; i < n; i++) */
+
+    for (t = 1; t <= max; t *= 2)
+    {
+        head = plain;
+        use_mutex = 1;
+        t_mutex = run(t);
+        head = shared;
+        use_mutex = 0;
+        t_rwlock = run(t);
+        printf("threads=%-3d global mutex %8.2f Mops/s   rwlock %8.2f Mops/s   (%.2fx)\n",
+               t, t_mutex / 1e6, t_rwlock / 1e6, t_rwlock / t_mutex);
+    } /* end of for (t = 1; t <= max; t *= 2) */
+
+    udlist_destroy(plain);
+    head_destroy(&plain);
+    udlist_destroy(shared);
+    head_destroy(&shared);
+
+    return 0;
+}
@@ -0,0 +1,140 @@
+/* 按关键字查找性能对比: C 接口(cmp_t 函数指针) vs C++ 模板封装 udlist<T>(lambda 内联)
+ *
+ * 用法: ./bench_cpp [n] [lookups]
+ *      n       链表长度(默认 100000)
+ *      lookups 查找次数(默认 2000)
+ *
+ * 元素为 16 字节记录, 按 id 查找; 依次测试:
+ *      udlist_retrieve_by_key   函数指针比较, 命中后拷贝 size 字节
+ *      udlist_peek_by_key       函数指针比较, 不拷贝
+ *      udlist<T>::find_if       lambda 比较, 沿节点指针内联遍历
+ * 三种方式查找同一组关键字, 并校验结果一致
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include "udlist.hpp"
+
+/* 测试记录 */
+struct record
+{
+    int id;
+    int qty;
+    double price;
+};
+
+/* 获取当前时间(秒) */
+static double now_sec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* 比较函数: 按 id 匹配 */
+static int id_compare(void *data, void *key)
+{
+    return (((record *)data)->id == *(int *)key) ? MATCH_SUCCESS : MATCH_FAIL;
+}
+
+
+int main(int argc, char **argv)
+{
+    udlist<record> list;
+    udlist_t *ud = NULL;
+    record r = {0, 0, 0};
+    unsigned int seed = 12345;
+    double t0 = 0;
+    double t_get = 0;
+    double t_peek = 0;
+    double t_cpp = 0;
+    long s_get = 0;
+    long s_peek = 0;
+    long s_cpp = 0;
+    void *p = NULL;
+    int *keys = NULL;
+    int n = 100000;
+    int lookups = 2000;
+    int i = 0;
+
+    if (argc > 1)
+    {
+        n = atoi(argv[1]);
+    } /* end of if (argc > 1) */
+    if (argc > 2)
+    {
+        lookups = atoi(argv[2]);
+    } /* end of if (argc > 2) */
+
+    /* 两个链表存放相同的记录(分别连续插入, 节点不交错) */
+    ud = udlist_create_ex(sizeof(record), NULL, UDLIST_INLINE);
+    for (i = 0; i < n; i++)
+    {
+        r.id = i;
+        r.qty = i % 100;
+        r.price = i * 0.5;
+        udlist_append(ud, &r);
+    } /* end of for (i = 0; i < n; i++) */
+    for (i = 0; i < n; i++)
+    {
+        r.id = i;
+        r.qty = i % 100;
+        r.price = i * 0.5;
+        list.push_back(r);
+    } /* end of for (i = 0; i < n; i++) */
+
+    keys = (int *)malloc(sizeof(int) * lookups);
+    for (i = 0; i < lookups; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        keys[i] = (int)((seed >> 8) % (unsigned int)n);
+    } /* end of for (i = 0; i < lookups; i++) */
+
+    t0 = now_sec();
+    for (i = 0; i < lookups; i++)
+    {
+        if (0 == udlist_retrieve_by_key(ud, &r, &keys[i], id_compare))
+        {
+            s_get += r.qty;
+        } /* end of if (0 == udlist_retrieve_by_key(...)) */
+    } /* end of for (i = 0; i < lookups; i++) */
+    t_get = now_sec() - t0;
+
+    t0 = now_sec();
+    for (i = 0; i < lookups; i++)
+    {
+        p = udlist_peek_by_key(ud, &keys[i], id_compare);
+        if (NULL != p && (void *)PAR_ERROR != p)
+        {
+            s_peek += ((record *)p)->qty;
+            udlist_peek_end(ud);
+        } /* end of if (NULL != p && (void *)PAR_ERROR != p) */
+    } /* end of for (i = 0; i < lookups; i++) */
+    t_peek = now_sec() - t0;
+
+    t0 = now_sec();
+    for (i = 0; i < lookups; i++)
+    {
+        const int key = keys[i];
+        auto it = list.find_if([key](const record &x) { return x.id == key; });
+
+        if (list.end() != it)
+        {
+            s_cpp += it->qty;
+        } /* end of if (list.end() != it) */
+    } /* end of for (i = 0; i < lookups; i++) */
+    t_cpp = now_sec() - t0;
+
+    printf("n=%d lookups=%d\n", n, lookups);
+    printf("udlist_retrieve_by_key   %8.2f ms\n", t_get * 1e3);
+    printf("udlist_peek_by_key       %8.2f ms (%.2fx)\n", t_peek * 1e3, t_get / t_peek);
+    printf("udlist<T>::find_if       %8.2f ms (%.2fx)%s\n", t_cpp * 1e3, t_get / t_cpp,
+           (s_get == s_peek && s_get == s_cpp) ? "" : "  MISMATCH");
+
+    free(keys);
+    udlist_destroy(ud);
+    head_destroy(&ud);
+
+    return 0;
+}
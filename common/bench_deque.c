@@ -0,0 +1,157 @@
+/* 多生产者多消费者队列性能对比: 全局互斥锁包裹的内联链表 vs 无锁模式(UDLIST_LOCKFREE)
+ *
+ * 用法: ./bench_deque [threads] [ops]
+ *      threads 最大生产者(消费者)线程数(默认 16), 从 1 开始按 2 倍递增
+ *      ops     每个生产者插入的元素个数(默认 200000)
+ *
+ * 生产者交替头尾插入, 消费者交替头尾删除, 直到所有元素被取出
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+#include "uni_doubly_linkedlist.h"
+
+/* 测试参数 */
+static udlist_t *head = NULL;
+static pthread_mutex_t global = PTHREAD_MUTEX_INITIALIZER;
+static int use_mutex = 0;
+static int ops = 200000;
+static long remain = 0;
+
+/* 获取当前时间(秒) */
+static double now_sec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* 插入: 需要时用全局互斥锁包裹 */
+static void push(int data, int front)
+{
+    if (use_mutex)
+    {
+        pthread_mutex_lock(&global);
+    } /* end of if (use_mutex) */
+    if (front)
+    {
+        udlist_push_front(head, &data);
+    }
+    else
+    {
+        udlist_push_back(head, &data);
+    }
+    if (use_mutex)
+    {
+        pthread_mutex_unlock(&global);
+    } /* end of if (use_mutex) */
+}
+
+/* 删除: 需要时用全局互斥锁包裹 */
+static int pop(int *data, int front)
+{
+    int ret = 0;
+
+    if (use_mutex)
+    {
+        pthread_mutex_lock(&global);
+    } /* end of if (use_mutex) */
+    ret = front ? udlist_pop_front(head, data) : udlist_pop_back(head, data);
+    if (use_mutex)
+    {
+        pthread_mutex_unlock(&global);
+    } /* end of if (use_mutex) */
+
+    return ret;
+}
+
+/* 生产者线程 */
+static void *producer(void *arg)
+{
+    int i = 0;
+
+    for (i = 0; i < ops; i++)
+    {
+        push(i, i & 1);
+    } /* end of for (i = 0; i < ops; i++) */
+
+    return NULL;
+}
+
+/* 消费者线程: 取完所有元素后退出 */
+static void *consumer(void *arg)
+{
+    int data = 0;
+    int i = 0;
+
+    while (__atomic_load_n(&remain, __ATOMIC_RELAXED) > 0)
+    {
+        if (0 == pop(&data, i++ & 1))
+        {
+            __atomic_fetch_sub(&remain, 1, __ATOMIC_RELAXED);
+        } /* end of if (0 == pop(&data, i++ & 1)) */
+    } /* end of while (__atomic_load_n(&remain, __ATOMIC_RELAXED) > 0) */
+
+    return NULL;
+}
+
+/* threads 个生产者和 threads 个消费者, 返回总吞吐量(插入 + 删除次数/秒) */
+static double run(int flags, int mutex, int threads)
+{
+    pthread_t tid[128];
+    double t0 = 0;
+    double t1 = 0;
+    int i = 0;
+
+    head = udlist_create_ex(sizeof(int), NULL, flags);
+    use_mutex = mutex;
+    remain = (long)threads * ops;
+
+    t0 = now_sec();
+    for (i = 0; i < threads; i++)
+    {
+        pthread_create(&tid[i], NULL, consumer, NULL);
+        pthread_create(&tid[threads + i], NULL, producer, NULL);
+    } /* end of for (i = 0; i < threads; i++) */
+    for (i = 0; i < 2 * threads; i++)
+    {
+        pthread_join(tid[i], NULL);
+    } /* end of for (i = 0; i < 2 * threads; i++) */
+    t1 = now_sec();
+
+    udlist_destroy(head);
+    head_destroy(&head);
+
+    return 2.0 * threads * ops / (t1 - t0);
+}
+
+
+int main(int argc, char **argv)
+{
+    double t_mutex = 0;
+    double t_free = 0;
+    int max = 16;
+    int t = 0;
+
+    if (argc > 1)
+    {
+        max = atoi(argv[1]);
+        max = (max > 64) ? 64 : max;
+    } /* end of if (argc > 1) */
+    if (argc > 2)
+    {
+        ops = atoi(argv[2]);
+    } /* end of if (argc > 2) */
+
+    for (t = 1; t <= max; t *= 2)
+    {
+        t_mutex = run(UDLIST_INLINE, 1, t);
+        t_free = run(UDLIST_LOCKFREE, 0, t);
+        printf("producers=consumers=%-3d global mutex %8.2f Mops/s   lockfree %8.2f Mops/s   (%.2fx)\n",
+               t, t_mutex / 1e6, t_free / 1e6, t_free / t_mutex);
+    } /* end of for (t = 1; t <= max; t *= 2) */
+
+    return 0;
+}
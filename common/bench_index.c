@@ -0,0 +1,76 @@
+/* 按索引访问性能对比: 普通链表 vs 秩树模式(UDLIST_INDEXED) */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "uni_doubly_linkedlist.h"
+
+/* 获取当前时间(秒) */
+static double now_sec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* 在 n 个元素的链表上执行 ops 次随机检索 和 ops 次随机插入 + 删除 */
+static void run(const char *name, int flags, int n, int ops)
+{
+    udlist_t *head = NULL;
+    int i = 0;
+    int temp = 0;
+    double t0 = 0;
+    double t1 = 0;
+    double t2 = 0;
+
+    head = udlist_create_ex(sizeof(int), NULL, flags);
+    for (i = 0; i < n; i++)
+    {
+        udlist_append(head, &i);
+    } /* end of for (i = 0; i < n; i++) */
+
+    srand(1);
+    t0 = now_sec();
+    for (i = 0; i < ops; i++)
+    {
+        udlist_retrieve_by_index(head, &temp, rand() % n);
+    } /* end of for (i = 0; i < ops; i++) */
+    t1 = now_sec();
+    for (i = 0; i < ops; i++)
+    {
+        udlist_insert_by_index(head, &i, rand() % n);
+        udlist_delete_by_index(head, rand() % n);
+    } /* end of for (i = 0; i < ops; i++) */
+    t2 = now_sec();
+
+    udlist_destroy(head);
+    head_destroy(&head);
+
+    printf("%-8s n=%-9d retrieve %10.1f ns/op   insert+delete %10.1f ns/op\n",
+           name, n, (t1 - t0) * 1e9 / ops, (t2 - t1) * 1e9 / ops);
+}
+
+
+int main(int argc, char **argv)
+{
+    int n = 0;
+    int max = 1000000;
+    int ops = 2000;
+
+    if (argc > 1)
+    {
+        max = atoi(argv[1]);
+    } /* end of if (argc > 1) */
+    if (argc > 2)
+    {
+        ops = atoi(argv[2]);
+    } /* end of if (argc > 2) */
+
+    for (n = 1000; n <= max; n *= 10)
+    {
+        run("linear", UDLIST_INLINE, n, ops);
+        run("indexed", UDLIST_INLINE | UDLIST_INDEXED, n, ops);
+    } /* end of for (n = 1000; n <= max; n *= 10) */
+
+    return 0;
+}
@@ -0,0 +1,113 @@
+/* 遍历方式性能对比: udlist_traverse 回调 vs udlist_traverse_ex 带上下文回调 vs udlist_iter 内联游标
+ *
+ * 用法: ./bench_iter [n] [rounds]
+ *      n       链表长度(默认 1000000)
+ *      rounds  重复遍历次数(默认 20)
+ *
+ * 每次遍历对所有元素求和; 依次测试内联模式及展开模式
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "uni_doubly_linkedlist.h"
+#include "udlist_iter.h"
+
+/* udlist_traverse 的回调没有上下文, 只能通过全局变量累加 */
+static long g_sum = 0;
+
+/* 获取当前时间(秒) */
+static double now_sec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* 全局变量累加 */
+static int sum_global(void *data)
+{
+    g_sum += *(int *)data;
+    return 0;
+}
+
+/* 上下文累加 */
+static int sum_ctx(void *data, void *ctx)
+{
+    *(long *)ctx += *(int *)data;
+    return 0;
+}
+
+/* 测试一种存储模式 */
+static void bench(const char *name, int flags, int n, int rounds)
+{
+    udlist_t *ud = NULL;
+    udlist_iter_t it;
+    double t0 = 0;
+    double t_cb = 0;
+    double t_ex = 0;
+    double t_it = 0;
+    long s_ex = 0;
+    long s_it = 0;
+    int r = 0;
+    int i = 0;
+
+    ud = udlist_create_ex(sizeof(int), NULL, flags);
+    for (i = 0; i < n; i++)
+    {
+        udlist_append(ud, &i);
+    } /* end of for (i = 0; i < n; i++) */
+
+    g_sum = 0;
+    t0 = now_sec();
+    for (r = 0; r < rounds; r++)
+    {
+        udlist_traverse(ud, sum_global);
+    } /* end of for (r = 0; r < rounds; r++) */
+    t_cb = now_sec() - t0;
+
+    t0 = now_sec();
+    for (r = 0; r < rounds; r++)
+    {
+        udlist_traverse_ex(ud, sum_ctx, &s_ex, 0);
+    } /* end of for (r = 0; r < rounds; r++) */
+    t_ex = now_sec() - t0;
+
+    t0 = now_sec();
+    for (r = 0; r < rounds; r++)
+    {
+        for (udlist_iter_begin(&it, ud); udlist_iter_valid(&it); udlist_iter_next(&it))
+        {
+            s_it += *(int *)udlist_iter_get(&it);
+        } /* end of for (udlist_iter_begin(&it, ud); ...) */
+    } /* end of for (r = 0; r < rounds; r++) */
+    t_it = now_sec() - t0;
+
+    printf("%-8s n=%d traverse %8.2f ms  traverse_ex %8.2f ms  iter %8.2f ms  (%.2fx)%s\n", name, n,
+           t_cb * 1e3, t_ex * 1e3, t_it * 1e3, t_cb / t_it,
+           (g_sum == s_ex && s_ex == s_it) ? "" : "  MISMATCH");
+
+    udlist_destroy(ud);
+    head_destroy(&ud);
+}
+
+
+int main(int argc, char **argv)
+{
+    int n = 1000000;
+    int rounds = 20;
+
+    if (argc > 1)
+    {
+        n = atoi(argv[1]);
+    } /* end of if (argc > 1) */
+    if (argc > 2)
+    {
+        rounds = atoi(argv[2]);
+    } /* end of if (argc > 2) */
+
+    bench("inline", UDLIST_INLINE, n, rounds);
+    bench("unrolled", UDLIST_UNROLLED, n, rounds);
+
+    return 0;
+}
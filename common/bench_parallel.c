@@ -0,0 +1,145 @@
+/* 大链表查找性能对比: udlist_find_all_index_by_key vs udlist_find_all_parallel
+ *
+ * 用法: ./bench_parallel [threads] [n] [work]
+ *      threads 最大线程数(默认 8), 从 1 开始按 2 倍递增
+ *      n       链表长度(默认 2000000)
+ *      work    每次比较附加的计算量(默认 0, 模拟代价较高的比较函数)
+ *
+ * 先后测试内联模式及秩树模式, 并校验两种查找的结果一致
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "uni_doubly_linkedlist.h"
+
+/* 测试参数 */
+static int work = 0;
+
+/* 获取当前时间(秒) */
+static double now_sec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* 比较函数: 附加 work 次整数运算 */
+static int int_compare(void *data, void *key)
+{
+    volatile unsigned int h = *(int *)data;
+    int i = 0;
+
+    for (i = 0; i < work; i++)
+    {
+        h = h * 2654435761u + 1;
+    } /* end of for (i = 0; i < work; i++) */
+
+    return (*(int *)data == *(int *)key) ? MATCH_SUCCESS : MATCH_FAIL;
+}
+
+/* 比较两个索引链表是否相同 */
+static int same(udlist_t *a, udlist_t *b)
+{
+    int x = 0;
+    int y = 0;
+    int i = 0;
+
+    if (NULL == a || NULL == b)
+    {
+        return a == b;
+    } /* end of if (NULL == a || NULL == b) */
+    if (get_count(a) != get_count(b))
+    {
+        return 0;
+    } /* end of if (get_count(a) != get_count(b)) */
+    for (i = 0; i < get_count(a); i++)
+    {
+        udlist_retrieve_by_index(a, &x, i);
+        udlist_retrieve_by_index(b, &y, i);
+        if (x != y)
+        {
+            return 0;
+        } /* end of if (x != y) */
+    } /* end of for (i = 0; i < get_count(a); i++) */
+
+    return 1;
+}
+
+/* 释放结果链表(没有匹配时为 NULL) */
+static void release(udlist_t **r)
+{
+    if (NULL != *r)
+    {
+        udlist_destroy(*r);
+        head_destroy(r);
+    } /* end of if (NULL != *r) */
+}
+
+/* 测试一种存储模式 */
+static void bench(const char *name, int flags, int n, int max)
+{
+    udlist_t *ud = NULL;
+    udlist_t *r0 = NULL;
+    udlist_t *r1 = NULL;
+    double t0 = 0;
+    double t_seq = 0;
+    double t_par = 0;
+    int key = 7;
+    int t = 0;
+    int i = 0;
+
+    ud = udlist_create_ex(sizeof(int), NULL, flags);
+    for (i = 0; i < n; i++)
+    {
+        t = (int)((i * 2654435761u) >> 8) % 1000;
+        udlist_append(ud, &t);
+    } /* end of for (i = 0; i < n; i++) */
+
+    t0 = now_sec();
+    r0 = udlist_find_all_index_by_key(ud, &key, int_compare);
+    t_seq = now_sec() - t0;
+    printf("%-8s n=%d sequential %8.2f ms (%d matches)\n", name, n, t_seq * 1e3, NULL == r0 ? 0 : get_count(r0));
+
+    for (t = 1; t <= max; t *= 2)
+    {
+        // 第一次调用计算并缓存分段点, 计时取第二次
+        r1 = udlist_find_all_parallel(ud, &key, int_compare, t);
+        release(&r1);
+        t0 = now_sec();
+        r1 = udlist_find_all_parallel(ud, &key, int_compare, t);
+        t_par = now_sec() - t0;
+        printf("%-8s threads=%-3d parallel   %8.2f ms (%.2fx)%s\n", name, t, t_par * 1e3, t_seq / t_par,
+               same(r0, r1) ? "" : "  MISMATCH");
+        release(&r1);
+    } /* end of for (t = 1; t <= max; t *= 2) */
+
+    release(&r0);
+    udlist_destroy(ud);
+    head_destroy(&ud);
+}
+
+
+int main(int argc, char **argv)
+{
+    int max = 8;
+    int n = 2000000;
+
+    if (argc > 1)
+    {
+        max = atoi(argv[1]);
+    } /* end of if (argc > 1) */
+    if (argc > 2)
+    {
+        n = atoi(argv[2]);
+    } /* end of if (argc > 2) */
+    if (argc > 3)
+    {
+        work = atoi(argv[3]);
+    } /* end of if (argc > 3) */
+
+    bench("inline", UDLIST_INLINE, n, max);
+    bench("indexed", UDLIST_INLINE | UDLIST_INDEXED, n, max);
+
+    return 0;
+}
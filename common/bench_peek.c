@@ -0,0 +1,113 @@
+/* 大记录读写性能对比: udlist_retrieve_by_index / udlist_append 拷贝 vs udlist_peek_by_index / udlist_emplace_back 借用
+ *
+ * 用法: ./bench_peek [n] [size]
+ *      n       记录个数(默认 20000)
+ *      size    记录大小(默认 4096 字节)
+ *
+ * 使用节点内存池(emplace_back 不清零新元素)
+ * 写入: 逐个填写记录头部字段后插入; 读取: 按索引顺序访问每条记录, 只读取头部两个字段
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "uni_doubly_linkedlist.h"
+
+/* 记录头部字段 */
+typedef struct _rec_head_t
+{
+    int id;
+    int value;
+}rec_head_t;
+
+/* 获取当前时间(秒) */
+static double now_sec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+
+int main(int argc, char **argv)
+{
+    udlist_t *a = NULL;
+    udlist_t *b = NULL;
+    rec_head_t *h = NULL;
+    unsigned char *buf = NULL;
+    double t0 = 0;
+    double t_append = 0;
+    double t_emplace = 0;
+    double t_retrieve = 0;
+    double t_peek = 0;
+    long sum0 = 0;
+    long sum1 = 0;
+    int size = 4096;
+    int n = 20000;
+    int i = 0;
+
+    if (argc > 1)
+    {
+        n = atoi(argv[1]);
+    } /* end of if (argc > 1) */
+    if (argc > 2)
+    {
+        size = atoi(argv[2]);
+    } /* end of if (argc > 2) */
+
+    buf = (unsigned char *)calloc(1, size);
+    a = udlist_create_pooled(size, NULL, 256);
+    b = udlist_create_pooled(size, NULL, 256);
+
+    /* 1.写入 */
+    t0 = now_sec();
+    for (i = 0; i < n; i++)
+    {
+        ((rec_head_t *)buf)->id = i;
+        ((rec_head_t *)buf)->value = i * 3;
+        udlist_append(a, buf);
+    } /* end of for (i = 0; i < n; i++) */
+    t_append = now_sec() - t0;
+
+    t0 = now_sec();
+    for (i = 0; i < n; i++)
+    {
+        h = (rec_head_t *)udlist_emplace_back(b);
+        h->id = i;
+        h->value = i * 3;
+        udlist_peek_end(b);
+    } /* end of for (i = 0; i < n; i++) */
+    t_emplace = now_sec() - t0;
+
+    /* 2.读取 */
+    t0 = now_sec();
+    for (i = 0; i < n; i++)
+    {
+        udlist_retrieve_by_index(a, buf, i);
+        sum0 += ((rec_head_t *)buf)->id + ((rec_head_t *)buf)->value;
+    } /* end of for (i = 0; i < n; i++) */
+    t_retrieve = now_sec() - t0;
+
+    t0 = now_sec();
+    for (i = 0; i < n; i++)
+    {
+        h = (rec_head_t *)udlist_peek_by_index(b, i);
+        sum1 += h->id + h->value;
+        udlist_peek_end(b);
+    } /* end of for (i = 0; i < n; i++) */
+    t_peek = now_sec() - t0;
+
+    printf("n=%d size=%d\n", n, size);
+    printf("write  append   %8.2f ms  emplace_back %8.2f ms  %.1fx\n", t_append * 1e3, t_emplace * 1e3, t_append / t_emplace);
+    printf("read   retrieve %8.2f ms  peek         %8.2f ms  %.1fx%s\n", t_retrieve * 1e3, t_peek * 1e3, t_retrieve / t_peek,
+           sum0 == sum1 ? "" : "  MISMATCH");
+
+    udlist_destroy(a);
+    head_destroy(&a);
+    udlist_destroy(b);
+    head_destroy(&b);
+    free(buf);
+
+    return 0;
+}
@@ -0,0 +1,73 @@
+/* 节点内存池性能对比: 尾部插入 + 头部删除循环 */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "uni_doubly_linkedlist.h"
+
+/* 兼容模式数据域销毁函数 */
+int node_destroy(void *data)
+{
+    free(data);
+    return 0;
+}
+
+/* 获取当前时间(秒) */
+static double now_sec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* 预先插入 depth 个元素, 再执行 cycles 次 尾插 + 删头 */
+static double run(const char *name, udlist_t *head, long cycles, int depth)
+{
+    long i = 0;
+    int temp = 0;
+    double t0 = 0;
+    double t1 = 0;
+
+    for (temp = 0; temp < depth; temp++)
+    {
+        udlist_append(head, &temp);
+    } /* end of for (temp = 0; temp < depth; temp++) */
+
+    t0 = now_sec();
+    for (i = 0; i < cycles; i++)
+    {
+        temp = (int)i;
+        udlist_append(head, &temp);
+        udlist_delete_by_index(head, 0);
+    } /* end of for (i = 0; i < cycles; i++) */
+    t1 = now_sec();
+
+    udlist_destroy(head);
+    head_destroy(&head);
+
+    printf("%-10s %ld cycles: %.3f s  %.1f ns/cycle\n",
+           name, cycles, t1 - t0, (t1 - t0) * 1e9 / cycles);
+    return t1 - t0;
+}
+
+
+int main(int argc, char **argv)
+{
+    long cycles = 10000000;
+    int depth = 1000;
+
+    if (argc > 1)
+    {
+        cycles = atol(argv[1]);
+    } /* end of if (argc > 1) */
+    if (argc > 2)
+    {
+        depth = atoi(argv[2]);
+    } /* end of if (argc > 2) */
+
+    run("compat", udlist_create(sizeof(int), node_destroy), cycles, depth);
+    run("inline", udlist_create_ex(sizeof(int), NULL, UDLIST_INLINE), cycles, depth);
+    run("pooled", udlist_create_pooled(sizeof(int), NULL, 4096), cycles, depth);
+
+    return 0;
+}
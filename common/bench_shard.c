@@ -0,0 +1,172 @@
+/* 关键字操作并发性能对比: 单个并发模式链表 vs 分片链表(udlist_sharded_t)
+ *
+ * 用法: ./bench_shard [threads] [shards] [n] [ops]
+ *      threads 最大线程数(默认 32), 从 1 开始按 2 倍递增
+ *      shards  分片个数(默认 64)
+ *      n       元素个数(默认 100000)
+ *      ops     每个线程的操作次数(默认 100000)
+ *
+ * 两者都附加哈希索引; 每次操作随机选择一个关键字, 依次执行 修改 / 删除后重新插入 / 检索
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+#include "uni_doubly_linkedlist.h"
+#include "udlist_shard.h"
+
+typedef struct _kv_t
+{
+    int key;
+    int val;
+}kv_t;
+
+/* 测试参数 */
+static udlist_t *single = NULL;
+static udlist_sharded_t *sharded = NULL;
+static int n = 100000;
+static int ops = 100000;
+
+/* 关键字哈希函数 */
+static unsigned long kv_hash(void *data)
+{
+    return (unsigned long)((kv_t *)data)->key * 2654435761u;
+}
+
+/* 关键字比较函数 */
+static int kv_compare(void *data, void *key)
+{
+    return (((kv_t *)data)->key == ((kv_t *)key)->key) ? MATCH_SUCCESS : MATCH_FAIL;
+}
+
+/* 获取当前时间(秒) */
+static double now_sec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* 工作线程: arg 为随机种子, 种子为负数时使用分片链表 */
+static void *worker(void *arg)
+{
+    long seed = (long)arg;
+    unsigned int r = (unsigned int)(seed < 0 ? -seed : seed);
+    kv_t x;
+    kv_t out;
+    int i = 0;
+
+    for (i = 0; i < ops; i++)
+    {
+        r = r * 1103515245 + 12345;
+        x.key = (r >> 8) % n;
+        x.val = i;
+        if (seed < 0)
+        {
+            switch (i % 3)
+            {
+                case 0: udlist_sharded_modify_by_key(sharded, &x, &x, kv_compare); break;
+                case 1:
+                    if (0 == udlist_sharded_delete_by_key(sharded, &x, kv_compare))
+                    {
+                        udlist_sharded_insert(sharded, &x);
+                    } /* end of if (0 == udlist_sharded_delete_by_key(sharded, &x, kv_compare)) */
+                    break;
+                default: udlist_sharded_retrieve_by_key(sharded, &out, &x, kv_compare); break;
+            } /* end of switch (i % 3) */
+        }
+        else
+        {
+            switch (i % 3)
+            {
+                case 0: udlist_modify_by_key(single, &x, &x, kv_compare); break;
+                case 1:
+                    if (0 == udlist_delete_by_key(single, &x, kv_compare))
+                    {
+                        udlist_append(single, &x);
+                    } /* end of if (0 == udlist_delete_by_key(single, &x, kv_compare)) */
+                    break;
+                default: udlist_retrieve_by_key(single, &out, &x, kv_compare); break;
+            } /* end of switch (i % 3) */
+        }
+    } /* end of for (i = 0; i < ops; i++) */
+
+    return NULL;
+}
+
+/* threads 个线程同时操作, 返回总吞吐量(次/秒) */
+static double run(int threads, int use_shard)
+{
+    pthread_t tid[128];
+    double t0 = 0;
+    long i = 0;
+
+    t0 = now_sec();
+    for (i = 0; i < threads; i++)
+    {
+        pthread_create(&tid[i], NULL, worker, (void *)(use_shard ? -(i + 1) : (i + 1)));
+    } /* end of for (i = 0; i < threads; i++) */
+    for (i = 0; i < threads; i++)
+    {
+        pthread_join(tid[i], NULL);
+    } /* end of for (i = 0; i < threads; i++) */
+
+    return (double)threads * ops / (now_sec() - t0);
+}
+
+
+int main(int argc, char **argv)
+{
+    double t_single = 0;
+    double t_shard = 0;
+    int shards = 64;
+    int max = 32;
+    kv_t x;
+    int t = 0;
+    int i = 0;
+
+    if (argc > 1)
+    {
+        max = atoi(argv[1]);
+        max = (max > 128) ? 128 : max;
+    } /* end of if (argc > 1) */
+    if (argc > 2)
+    {
+        shards = atoi(argv[2]);
+    } /* end of if (argc > 2) */
+    if (argc > 3)
+    {
+        n = atoi(argv[3]);
+    } /* end of if (argc > 3) */
+    if (argc > 4)
+    {
+        ops = atoi(argv[4]);
+    } /* end of if (argc > 4) */
+
+    single = udlist_create_ex(sizeof(kv_t), NULL, UDLIST_INLINE | UDLIST_CONCURRENT);
+    udlist_hash_attach(single, kv_hash, kv_compare);
+    sharded = udlist_sharded_create(sizeof(kv_t), NULL, kv_hash, kv_compare, shards);
+    for (i = 0; i < n; i++)
+    {
+        x.key = i;
+        x.val = 0;
+        udlist_append(single, &x);
+        udlist_sharded_insert(sharded, &x);
+    } /* end of for (i = 0; i < n; i++) */
+
+    for (t = 1; t <= max; t *= 2)
+    {
+        t_single = run(t, 0);
+        t_shard = run(t, 1);
+        printf("threads=%-3d single list %8.2f Mops/s   %d shards %8.2f Mops/s   (%.2fx)\n",
+               t, t_single / 1e6, shards, t_shard / 1e6, t_shard / t_single);
+    } /* end of for (t = 1; t <= max; t *= 2) */
+
+    udlist_destroy(single);
+    head_destroy(&single);
+    udlist_sharded_destroy(sharded);
+    udlist_sharded_head_destroy(&sharded);
+
+    return 0;
+}
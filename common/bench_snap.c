@@ -0,0 +1,137 @@
+/* 链表重建性能对比: 逐个 udlist_append vs udlist_save / udlist_load vs udlist_view_open
+ *
+ * 用法: ./bench_snap [n] [path]
+ *      n       元素个数(默认 2000000)
+ *      path    快照文件路径(默认 /tmp/bench_snap.snap)
+ *
+ * 元素为 32 字节记录; 加载后校验第一个和最后一个元素
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include "uni_doubly_linkedlist.h"
+#include "udlist_snap.h"
+
+/* 测试记录 */
+typedef struct
+{
+    int key;
+    int val;
+    double score;
+    char tag[16];
+}rec_t;
+
+/* 获取当前时间(秒) */
+static double now_sec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* 生成第 i 个记录 */
+static void make(rec_t *r, int i)
+{
+    memset(r, 0, sizeof(*r));
+    r->key = i;
+    r->val = (int)(i * 2654435761u >> 8);
+    r->score = i * 0.5;
+    snprintf(r->tag, sizeof(r->tag), "r%d", i);
+}
+
+/* 校验第一个和最后一个记录 */
+static int check(const rec_t *first, const rec_t *last, int n)
+{
+    rec_t a;
+    rec_t b;
+
+    make(&a, 0);
+    make(&b, n - 1);
+    return 0 == memcmp(first, &a, sizeof(a)) && 0 == memcmp(last, &b, sizeof(b));
+}
+
+/* 按指定存储模式加载并计时 */
+static void load(const char *name, const char *path, int flags, int n, double t_build)
+{
+    udlist_t *ud = NULL;
+    rec_t a;
+    rec_t b;
+    double t0 = 0;
+    double t = 0;
+
+    t0 = now_sec();
+    ud = udlist_load_ex(path, NULL, flags);
+    t = now_sec() - t0;
+    udlist_retrieve_by_index(ud, &a, 0);
+    udlist_retrieve_by_index(ud, &b, n - 1);
+    printf("load %-14s %8.2f ms (%.2fx)%s\n", name, t * 1e3, t_build / t, check(&a, &b, n) ? "" : "  MISMATCH");
+    udlist_destroy(ud);
+    head_destroy(&ud);
+}
+
+
+int main(int argc, char **argv)
+{
+    const char *path = "/tmp/bench_snap.snap";
+    udlist_t *ud = NULL;
+    udlist_view_t *v = NULL;
+    rec_t r;
+    double t0 = 0;
+    double t_build = 0;
+    double t = 0;
+    int n = 2000000;
+    int i = 0;
+
+    if (argc > 1)
+    {
+        n = atoi(argv[1]);
+    } /* end of if (argc > 1) */
+    if (argc > 2)
+    {
+        path = argv[2];
+    } /* end of if (argc > 2) */
+
+    /* 1.逐个插入重建(基准) */
+    t0 = now_sec();
+    ud = udlist_create_ex(sizeof(rec_t), NULL, UDLIST_INLINE);
+    for (i = 0; i < n; i++)
+    {
+        make(&r, i);
+        udlist_append(ud, &r);
+    } /* end of for (i = 0; i < n; i++) */
+    t_build = now_sec() - t0;
+    printf("build append       %8.2f ms (n=%d, %zu bytes each)\n", t_build * 1e3, n, sizeof(rec_t));
+
+    /* 2.保存 */
+    t0 = now_sec();
+    if (0 != udlist_save(ud, path))
+    {
+        printf("save failed\n");
+        return 1;
+    } /* end of if (0 != udlist_save(ud, path)) */
+    t = now_sec() - t0;
+    printf("save               %8.2f ms\n", t * 1e3);
+    udlist_destroy(ud);
+    head_destroy(&ud);
+
+    /* 3.加载建立节点 */
+    load("inline", path, UDLIST_INLINE, n, t_build);
+    load("unrolled", path, UDLIST_UNROLLED, n, t_build);
+
+    /* 4.只读视图 */
+    for (i = 1; i >= 0; i--)
+    {
+        t0 = now_sec();
+        v = udlist_view_open(path, i);
+        t = now_sec() - t0;
+        printf("view %-14s %8.2f ms (%.2fx)%s\n", i ? "verify" : "no-verify", t * 1e3, t_build / t,
+               check(udlist_view_at(v, 0), udlist_view_at(v, n - 1), n) ? "" : "  MISMATCH");
+        udlist_view_close(&v);
+    } /* end of for (i = 1; i >= 0; i--) */
+
+    unlink(path);
+
+    return 0;
+}
@@ -0,0 +1,136 @@
+/* 链表排序性能对比: 拷出数据 qsort 后重建链表 vs udlist_sort 原地归并排序
+ *
+ * 用法: ./bench_sort [n]
+ *      n       记录个数(默认 1000000), 记录为 32 字节结构体
+ *
+ * 依次测试内联模式及兼容模式下关键字随机、基本有序(1% 随机)两种数据, 并校验两种方法的结果一致
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "uni_doubly_linkedlist.h"
+
+typedef struct _rec_t
+{
+    int key;
+    int seq;
+    char pad[24];
+}rec_t;
+
+/* 获取当前时间(秒) */
+static double now_sec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* 排序比较函数: 关键字相同时按原顺序(qsort 需要 seq 保证稳定) */
+static int rec_order(void *a, void *b)
+{
+    if (((rec_t *)a)->key != ((rec_t *)b)->key)
+    {
+        return (((rec_t *)a)->key < ((rec_t *)b)->key) ? -1 : 1;
+    } /* end of if (((rec_t *)a)->key != ((rec_t *)b)->key) */
+    return ((rec_t *)a)->seq - ((rec_t *)b)->seq;
+}
+
+static int rec_qsort(const void *a, const void *b)
+{
+    return rec_order((void *)a, (void *)b);
+}
+
+/* 兼容模式销毁函数 */
+static int rec_destroy(void *data)
+{
+    free(data);
+    return 0;
+}
+
+/* 建表: nearly 为 1 时关键字基本有序 */
+static udlist_t *make(int flags, int n, int nearly)
+{
+    udlist_t *ud = NULL;
+    rec_t r;
+    int i = 0;
+
+    ud = udlist_create_ex(sizeof(rec_t), (UDLIST_INLINE & flags) ? NULL : rec_destroy, flags);
+    srand(1);
+    for (i = 0; i < n; i++)
+    {
+        r.key = (nearly && 0 != rand() % 100) ? i : rand() % (n / 4 + 1);
+        r.seq = i;
+        udlist_append(ud, &r);
+    } /* end of for (i = 0; i < n; i++) */
+
+    return ud;
+}
+
+/* 测试一种存储模式 */
+static void bench(const char *name, int flags, int n, int nearly)
+{
+    udlist_t *a = NULL;
+    udlist_t *b = NULL;
+    rec_t *arr = NULL;
+    rec_t x;
+    rec_t y;
+    double t0 = 0;
+    double t_copy = 0;
+    double t_sort = 0;
+    int same = 1;
+    int i = 0;
+
+    /* 1.拷出 - qsort - 销毁 - 重新插入 */
+    a = make(flags, n, nearly);
+    t0 = now_sec();
+    arr = (rec_t *)malloc((size_t)n * sizeof(rec_t));
+    for (i = 0; i < n; i++)
+    {
+        udlist_retrieve_by_index(a, &arr[i], i);
+    } /* end of for (i = 0; i < n; i++) */
+    qsort(arr, n, sizeof(rec_t), rec_qsort);
+    udlist_destroy(a);
+    udlist_append_n(a, arr, n);
+    free(arr);
+    t_copy = now_sec() - t0;
+
+    /* 2.原地排序 */
+    b = make(flags, n, nearly);
+    t0 = now_sec();
+    udlist_sort(b, rec_order);
+    t_sort = now_sec() - t0;
+
+    for (i = 0; i < n && same; i++)
+    {
+        udlist_retrieve_by_index(a, &x, i);
+        udlist_retrieve_by_index(b, &y, i);
+        same = (x.key == y.key && x.seq == y.seq);
+    } /* end of for (i = 0; i < n && same; i++) */
+
+    printf("%-8s %-7s n=%d copy+qsort+rebuild %8.1f ms   udlist_sort %8.1f ms   (%.2fx)%s\n",
+           name, nearly ? "nearly" : "random", n, t_copy * 1e3, t_sort * 1e3, t_copy / t_sort, same ? "" : "  MISMATCH");
+
+    udlist_destroy(a);
+    head_destroy(&a);
+    udlist_destroy(b);
+    head_destroy(&b);
+}
+
+
+int main(int argc, char **argv)
+{
+    int n = 1000000;
+
+    if (argc > 1)
+    {
+        n = atoi(argv[1]);
+    } /* end of if (argc > 1) */
+
+    bench("inline", UDLIST_INLINE, n, 0);
+    bench("compat", UDLIST_COMPAT, n, 0);
+    bench("inline", UDLIST_INLINE, n, 1);
+    bench("compat", UDLIST_COMPAT, n, 1);
+
+    return 0;
+}
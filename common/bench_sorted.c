@@ -0,0 +1,144 @@
+/* 有序插入及区间删除性能对比: 线性查找插入位置 vs udlist_create_sorted 有序模式
+ *
+ * 用法: ./bench_sorted [n]
+ *      n       事件个数(默认 50000)
+ *
+ * 模拟按时间排序的事件表: 事件时间戳乱序到达(在当前时间附近随机抖动), 按时间有序插入;
+ * 每插入 100 个事件删除一次过期事件(时间戳早于当前时间 - 窗口), 并按时间戳查找一次;
+ * 对照组使用内联秩树模式, 用 get_match_index 线性查找插入位置及过期事件
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "uni_doubly_linkedlist.h"
+
+/* 过期窗口 */
+#define WINDOW 20000
+
+/* 获取当前时间(秒) */
+static double now_sec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* 排序比较函数 */
+static int ts_order(void *a, void *b)
+{
+    return (*(int *)a < *(int *)b) ? -1 : (*(int *)a > *(int *)b);
+}
+
+/* 匹配第一个时间戳大于关键字的事件(插入位置) */
+static int ts_after(void *data, void *key)
+{
+    return (*(int *)data > *(int *)key) ? MATCH_SUCCESS : MATCH_FAIL;
+}
+
+/* 匹配时间戳小于关键字的事件(过期) */
+static int ts_before(void *data, void *key)
+{
+    return (*(int *)data < *(int *)key) ? MATCH_SUCCESS : MATCH_FAIL;
+}
+
+/* 事件时间戳: 当前时间附近随机抖动 */
+static int event_ts(int i)
+{
+    return i * 4 + (int)((i * 2654435761u) >> 20) % 4096;
+}
+
+/* 对照组: 线性查找插入位置及过期事件 */
+static double run_linear(int n, int *live, long *sum)
+{
+    udlist_t *ud = NULL;
+    double t0 = 0;
+    int ts = 0;
+    int key = 0;
+    int index = 0;
+    int i = 0;
+
+    ud = udlist_create_ex(sizeof(int), NULL, UDLIST_INLINE | UDLIST_INDEXED);
+    t0 = now_sec();
+    for (i = 0; i < n; i++)
+    {
+        ts = event_ts(i);
+        index = get_match_index(ud, &ts, ts_after);
+        udlist_insert_by_index(ud, &ts, index < 0 ? get_count(ud) : index);
+
+        if (0 == i % 100)
+        {
+            key = i * 4 - WINDOW;
+            udlist_delete_all_by_key(ud, &key, ts_before);
+            index = get_match_index(ud, &key, ts_after);
+            *sum += index;
+        } /* end of if (0 == i % 100) */
+    } /* end of for (i = 0; i < n; i++) */
+    t0 = now_sec() - t0;
+
+    *live = get_count(ud);
+    udlist_destroy(ud);
+    head_destroy(&ud);
+
+    return t0;
+}
+
+/* 有序模式: O(log n) 插入、区间删除及查找 */
+static double run_sorted(int n, int *live, long *sum)
+{
+    udlist_t *ud = NULL;
+    double t0 = 0;
+    int ts = 0;
+    int lo = -1;
+    int key = 0;
+    int i = 0;
+
+    ud = udlist_create_sorted(sizeof(int), NULL, ts_order);
+    t0 = now_sec();
+    for (i = 0; i < n; i++)
+    {
+        ts = event_ts(i);
+        udlist_append(ud, &ts);
+
+        if (0 == i % 100)
+        {
+            key = i * 4 - WINDOW - 1;
+            udlist_delete_range(ud, &lo, &key);
+            key++;
+            *sum += udlist_upper_bound(ud, &key);
+        } /* end of if (0 == i % 100) */
+    } /* end of for (i = 0; i < n; i++) */
+    t0 = now_sec() - t0;
+
+    *live = get_count(ud);
+    udlist_destroy(ud);
+    head_destroy(&ud);
+
+    return t0;
+}
+
+
+int main(int argc, char **argv)
+{
+    int n = 50000;
+    int live0 = 0;
+    int live1 = 0;
+    long sum0 = 0;
+    long sum1 = 0;
+    double t_lin = 0;
+    double t_sorted = 0;
+
+    if (argc > 1)
+    {
+        n = atoi(argv[1]);
+    } /* end of if (argc > 1) */
+
+    t_lin = run_linear(n, &live0, &sum0);
+    t_sorted = run_sorted(n, &live1, &sum1);
+
+    printf("linear  n=%d %10.2f ms (%d live)\n", n, t_lin * 1e3, live0);
+    printf("sorted  n=%d %10.2f ms (%d live) %.2fx%s\n", n, t_sorted * 1e3, live1, t_lin / t_sorted,
+           (live0 == live1 && sum0 == sum1) ? "" : "  MISMATCH");
+
+    return 0;
+}
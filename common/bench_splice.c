@@ -0,0 +1,157 @@
+/* 链表间移动节点性能对比: 逐个拷贝(检索 + 尾部插入 + 删除) vs udlist_splice / udlist_concat
+ *
+ * 用法: ./bench_splice [n] [chunk]
+ *      n       记录个数(默认 1000000), 记录为 64 字节结构体
+ *      chunk   每次交接的记录个数(默认 4000)
+ *
+ * 模拟流水线: 上游链表每次把头部 chunk 个记录交给下游链表, 直到上游为空;
+ * 依次测试内联模式及秩树模式, 并校验两种方法下游链表的内容一致
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "uni_doubly_linkedlist.h"
+
+typedef struct _rec_t
+{
+    int seq;
+    char pad[60];
+}rec_t;
+
+/* 获取当前时间(秒) */
+static double now_sec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* 创建上游链表 */
+static udlist_t *make_src(int flags, int n)
+{
+    udlist_t *ud = NULL;
+    rec_t r = {0};
+    int i = 0;
+
+    ud = udlist_create_ex(sizeof(rec_t), NULL, flags);
+    for (i = 0; i < n; i++)
+    {
+        r.seq = i;
+        udlist_append(ud, &r);
+    } /* end of for (i = 0; i < n; i++) */
+
+    return ud;
+}
+
+/* 逐个拷贝交接 */
+static double run_copy(udlist_t *src, udlist_t *dst, int chunk)
+{
+    double t0 = now_sec();
+    rec_t r;
+    int i = 0;
+
+    while (get_count(src) > 0)
+    {
+        for (i = 0; i < chunk && get_count(src) > 0; i++)
+        {
+            udlist_retrieve_by_index(src, &r, 0);
+            udlist_append(dst, &r);
+            udlist_delete_by_index(src, 0);
+        } /* end of for (i = 0; i < chunk && get_count(src) > 0; i++) */
+    } /* end of while (get_count(src) > 0) */
+
+    return now_sec() - t0;
+}
+
+/* 整段交接: 上游头部 chunk 个节点移动到下游尾部, 最后一段直接连接 */
+static double run_splice(udlist_t *src, udlist_t *dst, int chunk)
+{
+    double t0 = now_sec();
+    node_t *last = NULL;
+    int i = 0;
+
+    while (get_count(src) > chunk)
+    {
+        last = src->fstnode_p;
+        for (i = 1; i < chunk; i++)
+        {
+            last = last->next;
+        } /* end of for (i = 1; i < chunk; i++) */
+        udlist_splice(dst, NULL == dst->fstnode_p ? NULL : dst->fstnode_p->prev, src, src->fstnode_p, last);
+    } /* end of while (get_count(src) > chunk) */
+    udlist_concat(dst, src);
+
+    return now_sec() - t0;
+}
+
+/* 检查下游链表的顺序 */
+static int check(udlist_t *ud, int n)
+{
+    node_t *p = ud->fstnode_p;
+    int i = 0;
+
+    if (get_count(ud) != n)
+    {
+        return 0;
+    } /* end of if (get_count(ud) != n) */
+    for (i = 0; i < n; i++, p = p->next)
+    {
+        if (((rec_t *)p->data)->seq != i)
+        {
+            return 0;
+        } /* end of if (((rec_t *)p->data)->seq != i) */
+    } /* end of for (i = 0; i < n; i++, p = p->next) */
+
+    return 1;
+}
+
+/* 测试一种存储模式 */
+static void bench(const char *name, int flags, int n, int chunk)
+{
+    udlist_t *src = NULL;
+    udlist_t *dst = NULL;
+    double t_copy = 0;
+    double t_splice = 0;
+    int ok = 1;
+
+    src = make_src(flags, n);
+    dst = udlist_create_ex(sizeof(rec_t), NULL, flags);
+    t_copy = run_copy(src, dst, chunk);
+    ok = ok && check(dst, n);
+    udlist_destroy(dst);
+    head_destroy(&dst);
+    head_destroy(&src);
+
+    src = make_src(flags, n);
+    dst = udlist_create_ex(sizeof(rec_t), NULL, flags);
+    t_splice = run_splice(src, dst, chunk);
+    ok = ok && check(dst, n);
+    udlist_destroy(dst);
+    head_destroy(&dst);
+    head_destroy(&src);
+
+    printf("%-8s n=%d chunk=%d copy %8.2f ms  splice %8.2f ms  %.1fx%s\n", name, n, chunk,
+           t_copy * 1e3, t_splice * 1e3, t_copy / t_splice, ok ? "" : "  MISMATCH");
+}
+
+
+int main(int argc, char **argv)
+{
+    int n = 1000000;
+    int chunk = 4000;
+
+    if (argc > 1)
+    {
+        n = atoi(argv[1]);
+    } /* end of if (argc > 1) */
+    if (argc > 2)
+    {
+        chunk = atoi(argv[2]);
+    } /* end of if (argc > 2) */
+
+    bench("inline", UDLIST_INLINE, n, chunk);
+    bench("indexed", UDLIST_INLINE | UDLIST_INDEXED, n, chunk);
+
+    return 0;
+}
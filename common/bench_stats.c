@@ -0,0 +1,118 @@
+/* 统计功能开销测试: 同一负载分别链接关闭/开启 UDLIST_STATS 的链表库
+ *
+ * 用法: ./bench_stats [n] [rounds]      (链表库不带统计)
+ *       ./bench_stats_on [n] [rounds]   (链表库以 -DUDLIST_STATS 编译)
+ *      n       链表长度(默认 20000)
+ *      rounds  随机操作轮数(默认 200000)
+ *
+ * 负载: 尾部插入 n 个元素, 然后 rounds 轮随机按索引读取/按索引修改/尾部弹出并插回,
+ * 每 1000 轮按关键字查找一次; 输出总耗时, 开启统计时再输出统计信息
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "uni_doubly_linkedlist.h"
+#include "udlist_stats.h"
+
+/* 获取当前时间(秒) */
+static double now_sec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* 比较函数 */
+static int int_compare(void *data, void *key)
+{
+    return (*(int *)data == *(int *)key) ? MATCH_SUCCESS : MATCH_FAIL;
+}
+
+/* 测试一种存储模式 */
+static void bench(const char *name, int flags, int n, int rounds, int dump)
+{
+    udlist_t *ud = NULL;
+    unsigned int seed = 12345;
+    double t0 = 0;
+    double t_fill = 0;
+    double t_ops = 0;
+    int x = 0;
+    int i = 0;
+
+    ud = udlist_create_ex(sizeof(int), NULL, flags);
+
+    t0 = now_sec();
+    for (i = 0; i < n; i++)
+    {
+        udlist_append(ud, &i);
+    } /* end of for (i = 0; i < n; i++) */
+    t_fill = now_sec() - t0;
+
+    t0 = now_sec();
+    for (i = 0; i < rounds; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        switch (seed >> 30)
+        {
+            case 0:
+            case 1:
+                udlist_retrieve_by_index(ud, &x, (int)((seed >> 8) % (unsigned int)n));
+                break;
+            case 2:
+                udlist_modify_by_index(ud, &i, (int)((seed >> 8) % (unsigned int)n));
+                break;
+            default:
+                udlist_pop_back(ud, &x);
+                udlist_append(ud, &x);
+                break;
+        } /* end of switch (seed >> 30) */
+
+        if (0 == i % 1000)
+        {
+            x = (int)((seed >> 8) % (unsigned int)n);
+            udlist_retrieve_by_key(ud, &x, &x, int_compare);
+        } /* end of if (0 == i % 1000) */
+    } /* end of for (i = 0; i < rounds; i++) */
+    t_ops = now_sec() - t0;
+
+    printf("%-8s append %8.2f ms   mixed ops %8.2f ms (%.1f ns/op)\n", name, t_fill * 1e3, t_ops * 1e3,
+           t_ops * 1e9 / rounds);
+    if (dump)
+    {
+        udlist_stats_dump(ud, stdout);
+    } /* end of if (dump) */
+
+    udlist_destroy(ud);
+    head_destroy(&ud);
+}
+
+
+int main(int argc, char **argv)
+{
+    int n = 20000;
+    int rounds = 200000;
+    int dump = 0;
+    udlist_t *probe = NULL;
+
+    if (argc > 1)
+    {
+        n = atoi(argv[1]);
+    } /* end of if (argc > 1) */
+    if (argc > 2)
+    {
+        rounds = atoi(argv[2]);
+    } /* end of if (argc > 2) */
+
+    // 链表库未开启统计时 udlist_stats_reset 返回 FUN_ERROR
+    probe = udlist_create_ex(sizeof(int), NULL, UDLIST_INLINE);
+    dump = (0 == udlist_stats_reset(probe));
+    head_destroy(&probe);
+    printf("stats %s\n", dump ? "enabled" : "disabled");
+
+    bench("inline", UDLIST_INLINE, n, rounds, dump);
+    bench("indexed", UDLIST_INLINE | UDLIST_INDEXED, n, rounds, dump);
+    bench("unrolled", UDLIST_UNROLLED, n, rounds, dump);
+
+    return 0;
+}
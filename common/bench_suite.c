@@ -0,0 +1,360 @@
+/* 链表操作微基准测试: 覆盖所有 udlist_* 操作, 输出 CSV 或 JSON
+ *
+ * 用法: ./bench_suite [-j] [-a] [max_n]
+ *      -j      输出 JSON(默认 CSV)
+ *      -a      额外测试 int 元素的内存池、秩树、展开模式
+ *      max_n   最大链表长度(默认 10000000), 从 100 开始按 10 倍递增
+ *
+ * 每行: 元素类型, 存储模式, 链表长度, 操作, 调用次数, 每次调用耗时(ns),
+ *      每次调用的内存申请次数(链接时通过 --wrap 统计 malloc/calloc/realloc), 当前常驻内存(KB)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include "uni_doubly_linkedlist.h"
+
+typedef struct _stu_t
+{
+    char name[32];
+    int num;
+}stu_t;
+
+
+/* 测试配置 */
+typedef struct _cfg_t
+{
+    const char *elem;               // 元素类型
+    const char *mode;               // 存储模式
+    int size;                       // 元素大小
+    op_t my_destroy;                // 销毁函数
+    cmp_t op_cmp;                   // 比较函数
+    int flags;                      // udlist_create_ex 的存储模式
+    int pooled;                     // 是否使用内存池
+}cfg_t;
+
+
+/* 内存申请次数统计 */
+static long alloc_count = 0;
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t nmemb, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+void *__wrap_malloc(size_t size)
+{
+    alloc_count++;
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t nmemb, size_t size)
+{
+    alloc_count++;
+    return __real_calloc(nmemb, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+    alloc_count++;
+    return __real_realloc(ptr, size);
+}
+
+
+/* 结构体指针元素销毁函数 */
+int stu_destroy(void *data)
+{
+    free(*(stu_t **)data);
+    free(data);
+    return 0;
+}
+
+/* 结构体指针元素比较函数 */
+int stu_compare(void *data, void *key)
+{
+    return ((*(stu_t **)data)->num == (*(stu_t **)key)->num) ? MATCH_SUCCESS : MATCH_FAIL;
+}
+
+/* int 元素比较函数 */
+int int_compare(void *data, void *key)
+{
+    return (*(int *)data == *(int *)key) ? MATCH_SUCCESS : MATCH_FAIL;
+}
+
+/* 遍历函数 */
+static long visit_sum = 0;
+static int visit(void *data)
+{
+    visit_sum += *(unsigned char *)data;
+    return 0;
+}
+
+
+/* 释放索引链表 */
+static void index_list_free(udlist_t *index_head)
+{
+    if (NULL != index_head)
+    {
+        udlist_destroy(index_head);
+        head_destroy(&index_head);
+    } /* end of if (NULL != index_head) */
+}
+
+
+/* 获取当前时间(秒) */
+static double now_sec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* 当前常驻内存(KB) */
+static long rss_kb(void)
+{
+    FILE *fp = NULL;
+    long pages = 0;
+    long resident = 0;
+
+    fp = fopen("/proc/self/statm", "r");
+    if (NULL == fp)
+    {
+        return -1;
+    } /* end of if (NULL == fp) */
+    if (2 != fscanf(fp, "%ld %ld", &pages, &resident))
+    {
+        resident = -1;
+    } /* end of if (2 != fscanf(fp, "%ld %ld", &pages, &resident)) */
+    fclose(fp);
+
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+
+/* 生成 k 个值为 from, from+1, ... 的元素; 结构体指针元素的结构体由链表接管 */
+static void *values(cfg_t *c, int from, int k)
+{
+    unsigned char *buf = NULL;
+    stu_t *stu = NULL;
+    int i = 0;
+
+    buf = (unsigned char *)malloc((size_t)k * c->size);
+    for (i = 0; i < k; i++)
+    {
+        if (sizeof(int) == c->size)
+        {
+            *(int *)(buf + (size_t)i * c->size) = from + i;
+        }
+        else
+        {
+            stu = (stu_t *)calloc(1, sizeof(stu_t));
+            stu->num = from + i;
+            snprintf(stu->name, sizeof(stu->name), "stu%d", from + i);
+            *(stu_t **)(buf + (size_t)i * c->size) = stu;
+        }
+    } /* end of for (i = 0; i < k; i++) */
+
+    return buf;
+}
+
+/* 释放 values 生成但未交给链表的结构体 */
+static void values_drop(cfg_t *c, void *buf, int k)
+{
+    int i = 0;
+
+    for (i = 0; i < k && sizeof(int) != c->size; i++)
+    {
+        free(((stu_t **)buf)[i]);
+    } /* end of for (i = 0; i < k && sizeof(int) != c->size; i++) */
+}
+
+
+/* 输出一行结果 */
+static int json = 0;
+static int first_row = 1;
+static void report(cfg_t *c, int n, const char *op, long ops, double sec, long allocs)
+{
+    if (json)
+    {
+        printf("%s{\"elem\":\"%s\",\"mode\":\"%s\",\"n\":%d,\"op\":\"%s\",\"ops\":%ld,"
+               "\"ns_per_op\":%.1f,\"allocs_per_op\":%.3f,\"rss_kb\":%ld}",
+               first_row ? "[\n" : ",\n", c->elem, c->mode, n, op, ops,
+               sec * 1e9 / ops, (double)allocs / ops, rss_kb());
+    }
+    else
+    {
+        printf("%s,%s,%d,%s,%ld,%.1f,%.3f,%ld\n", c->elem, c->mode, n, op, ops,
+               sec * 1e9 / ops, (double)allocs / ops, rss_kb());
+    }
+    first_row = 0;
+    fflush(stdout);
+}
+
+
+/* 计时执行 stmt ops 次并输出 */
+#define MEASURE(op, ops, stmt)                                          \
+    do                                                                  \
+    {                                                                   \
+        long a0_ = alloc_count;                                         \
+        double t0_ = now_sec();                                         \
+        for (i = 0; i < (ops); i++)                                     \
+        {                                                               \
+            stmt;                                                       \
+        }                                                               \
+        report(c, n, (op), (ops), now_sec() - t0_, alloc_count - a0_);  \
+    }                                                                   \
+    while (0)
+
+
+/* 创建链表 */
+static udlist_t *make(cfg_t *c)
+{
+    if (c->pooled)
+    {
+        return udlist_create_pooled(c->size, c->my_destroy, 4096);
+    } /* end of if (c->pooled) */
+    return udlist_create_ex(c->size, c->my_destroy, c->flags);
+}
+
+/* 长度为 n 的链表上测试所有操作 */
+static void run(cfg_t *c, int n)
+{
+    const char *pos_name[3] = {"head", "mid", "tail"};
+    char op[64];
+    udlist_t *head = NULL;
+    unsigned char *buf = NULL;
+    unsigned char *out = NULL;
+    void *key = NULL;
+    int k1 = 0;
+    int kn = 0;
+    int pos = 0;
+    int idx = 0;
+    int i = 0;
+
+    // O(1) 操作的调用次数, O(n) 操作的调用次数
+    k1 = (n < 10000) ? n : 10000;
+    kn = 2000000 / n;
+    kn = (kn < 3) ? 3 : ((kn > 1000) ? 1000 : kn);
+    kn = (kn > n) ? n : kn;
+
+    out = (unsigned char *)malloc(c->size);
+    head = make(c);
+
+    /* 1.尾部插入建表 */
+    buf = values(c, 0, n);
+    MEASURE("append", n, udlist_append(head, buf + (size_t)i * c->size));
+    free(buf);
+
+    /* 2.头部插入, 之后删除恢复原长度 */
+    buf = values(c, n, k1);
+    MEASURE("prepend", k1, udlist_prepend(head, buf + (size_t)i * c->size));
+    for (i = 0; i < k1; i++)
+    {
+        udlist_delete_by_index(head, 0);
+    } /* end of for (i = 0; i < k1; i++) */
+    free(buf);
+
+    /* 3.按索引插入、删除、修改、检索: 头部 / 中间 / 尾部 */
+    for (pos = 0; pos < 3; pos++)
+    {
+        idx = (0 == pos) ? 0 : ((1 == pos) ? n / 2 : n);
+
+        buf = values(c, n, k1);
+        snprintf(op, sizeof(op), "insert_by_index_%s", pos_name[pos]);
+        MEASURE(op, (1 == pos) ? kn : k1, udlist_insert_by_index(head, buf + (size_t)i * c->size, idx));
+        snprintf(op, sizeof(op), "delete_by_index_%s", pos_name[pos]);
+        MEASURE(op, (1 == pos) ? kn : k1, udlist_delete_by_index(head, (2 == pos) ? get_count(head) - 1 : idx));
+        values_drop(c, buf + (size_t)((1 == pos) ? kn : k1) * c->size, k1 - ((1 == pos) ? kn : k1));
+        free(buf);
+
+        idx = (2 == pos) ? n - 1 : idx;
+        snprintf(op, sizeof(op), "retrieve_by_index_%s", pos_name[pos]);
+        MEASURE(op, (1 == pos) ? kn : k1, udlist_retrieve_by_index(head, out, idx));
+        snprintf(op, sizeof(op), "modify_by_index_%s", pos_name[pos]);
+        MEASURE(op, (1 == pos) ? kn : k1, udlist_modify_by_index(head, out, idx));
+    } /* end of for (pos = 0; pos < 3; pos++) */
+
+    /* 4.关键字操作: 关键字为中间元素 */
+    key = values(c, n / 2, 1);
+    MEASURE("get_match_index", kn, get_match_index(head, key, c->op_cmp));
+    MEASURE("retrieve_by_key", kn, udlist_retrieve_by_key(head, out, key, c->op_cmp));
+    udlist_retrieve_by_key(head, out, key, c->op_cmp);
+    MEASURE("modify_by_key", kn, udlist_modify_by_key(head, out, key, c->op_cmp));
+    MEASURE("modify_all_by_key", kn, udlist_modify_all_by_key(head, out, key, c->op_cmp));
+    MEASURE("find_all_index_by_key", kn, index_list_free(udlist_find_all_index_by_key(head, key, c->op_cmp)));
+    MEASURE("find_all_index_array", kn, free(udlist_find_all_index_array(head, key, c->op_cmp, &idx)));
+    MEASURE("find_all_index_buf", kn, udlist_find_all_index_buf(head, key, c->op_cmp, &idx, 1));
+    values_drop(c, key, 1);
+    free(key);
+
+    /* 5.删除所有匹配: 每次删除尾部一个不同的元素, 之后补回 */
+    buf = values(c, n - kn, kn);
+    MEASURE("delete_all_by_key", kn, udlist_delete_all_by_key(head, buf + (size_t)i * c->size, c->op_cmp));
+    values_drop(c, buf, kn);
+    free(buf);
+    buf = values(c, n - kn, kn);
+    udlist_append_n(head, buf, kn);
+    free(buf);
+
+    /* 6.遍历 */
+    MEASURE("traverse", kn, udlist_traverse(head, visit));
+    MEASURE("traverse_back", kn, udlist_traverse_back(head, visit));
+
+    /* 7.销毁 */
+    MEASURE("destroy", 1, udlist_destroy(head));
+
+    head_destroy(&head);
+    free(out);
+}
+
+
+int main(int argc, char **argv)
+{
+    cfg_t cfg[] = {
+        {"int", "inline", sizeof(int), NULL, int_compare, UDLIST_INLINE, 0},
+        {"stu_ptr", "compat", sizeof(stu_t *), stu_destroy, stu_compare, UDLIST_COMPAT, 0},
+        {"int", "pooled", sizeof(int), NULL, int_compare, UDLIST_INLINE, 1},
+        {"int", "indexed", sizeof(int), NULL, int_compare, UDLIST_INLINE | UDLIST_INDEXED, 0},
+        {"int", "unrolled", sizeof(int), NULL, int_compare, UDLIST_UNROLLED, 0},
+    };
+    int ncfg = 2;
+    int max = 10000000;
+    int n = 0;
+    int i = 0;
+
+    for (i = 1; i < argc; i++)
+    {
+        if (0 == strcmp(argv[i], "-j"))
+        {
+            json = 1;
+        }
+        else if (0 == strcmp(argv[i], "-a"))
+        {
+            ncfg = sizeof(cfg) / sizeof(cfg[0]);
+        }
+        else
+        {
+            max = atoi(argv[i]);
+        }
+    } /* end of for (i = 1; i < argc; i++) */
+
+    if (!json)
+    {
+        printf("elem,mode,n,op,ops,ns_per_op,allocs_per_op,rss_kb\n");
+    } /* end of if (!json) */
+
+    for (i = 0; i < ncfg; i++)
+    {
+        for (n = 100; n <= max; n *= 10)
+        {
+            run(&cfg[i], n);
+        } /* end of for (n = 100; n <= max; n *= 10) */
+    } /* end of for (i = 0; i < ncfg; i++) */
+
+    if (json)
+    {
+        printf("\n]\n");
+    } /* end of if (json) */
+
+    return 0;
+}
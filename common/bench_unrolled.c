@@ -0,0 +1,91 @@
+/* 展开链表性能对比: 兼容模式 vs 内联模式 vs 展开模式(UDLIST_UNROLLED) 的内存占用及遍历速度 */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <malloc.h>
+#include "uni_doubly_linkedlist.h"
+
+/* 兼容模式数据域销毁函数 */
+int node_destroy(void *data)
+{
+    free(data);
+    return 0;
+}
+
+/* 遍历累加 */
+static long sum = 0;
+static int data_sum(void *data)
+{
+    sum += *(int *)data;
+    return 0;
+}
+
+/* 获取当前时间(秒) */
+static double now_sec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* 当前堆使用字节数 */
+static size_t heap_used(void)
+{
+    return mallinfo2().uordblks;
+}
+
+/* 插入 n 个元素, 统计每个元素的堆占用, 再执行 rounds 次完整遍历 */
+static void run(const char *name, op_t my_destroy, int flags, int n, int rounds)
+{
+    udlist_t *head = NULL;
+    size_t m0 = 0;
+    size_t m1 = 0;
+    double t0 = 0;
+    double t1 = 0;
+    int i = 0;
+
+    m0 = heap_used();
+    head = udlist_create_ex(sizeof(int), my_destroy, flags);
+    for (i = 0; i < n; i++)
+    {
+        udlist_append(head, &i);
+    } /* end of for (i = 0; i < n; i++) */
+    m1 = heap_used();
+
+    sum = 0;
+    t0 = now_sec();
+    for (i = 0; i < rounds; i++)
+    {
+        udlist_traverse(head, data_sum);
+    } /* end of for (i = 0; i < rounds; i++) */
+    t1 = now_sec();
+
+    udlist_destroy(head);
+    head_destroy(&head);
+
+    printf("%-8s n=%-9d %6.1f bytes/elem   traverse %6.2f ns/elem   (sum %ld)\n",
+           name, n, (double)(m1 - m0) / n, (t1 - t0) * 1e9 / ((double)n * rounds), sum);
+}
+
+
+int main(int argc, char **argv)
+{
+    int n = 1000000;
+    int rounds = 20;
+
+    if (argc > 1)
+    {
+        n = atoi(argv[1]);
+    } /* end of if (argc > 1) */
+    if (argc > 2)
+    {
+        rounds = atoi(argv[2]);
+    } /* end of if (argc > 2) */
+
+    run("compat", node_destroy, UDLIST_COMPAT, n, rounds);
+    run("inline", NULL, UDLIST_INLINE, n, rounds);
+    run("unrolled", NULL, UDLIST_UNROLLED, n, rounds);
+
+    return 0;
+}
@@ -0,0 +1,314 @@
+/* 持久化修改性能对比: 每次修改后 udlist_save 整表重写 vs 预写日志各持久化级别
+ *
+ * 用法: ./bench_wal [n] [ops] [threads] [dir]
+ *      n       链表初始长度(默认 100000)
+ *      ops     每个线程的修改次数(默认 2000)
+ *      threads UDWAL_SYNC 组提交测试的并发线程数(默认 8)
+ *      dir     快照及日志所在目录(默认 /tmp)
+ *
+ * 修改为 modify_by_index 及 append 交替; 每项测试后从快照及日志恢复并校验元素个数;
+ * 最后对各存储模式执行所有记录日志的修改操作, 恢复后逐个元素比较(round-trip)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "uni_doubly_linkedlist.h"
+#include "udlist_wal.h"
+#include "udlist_snap.h"
+#include "udlist_iter.h"
+
+/* 测试参数 */
+static int g_ops = 2000;
+static char g_snap[256];
+static char g_log[256];
+
+/* 获取当前时间(秒) */
+static double now_sec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* 创建初始链表 */
+static udlist_t *make(int n, int flags)
+{
+    udlist_t *ud = NULL;
+    int i = 0;
+
+    ud = udlist_create_ex(sizeof(int) * 4, NULL, flags);
+    for (i = 0; i < n; i++)
+    {
+        int rec[4] = {i, i, i, i};
+        udlist_append(ud, rec);
+    } /* end of for (i = 0; i < n; i++) */
+
+    return ud;
+}
+
+/* 一次修改 */
+static int one(udlist_t *ud, int i)
+{
+    int rec[4] = {i, -i, i, -i};
+
+    return (i & 1) ? udlist_append(ud, rec) : udlist_modify_by_index(ud, rec, i % 1000);
+}
+
+/* 并发修改线程 */
+static void *worker(void *arg)
+{
+    udlist_t *ud = (udlist_t *)arg;
+    int i = 0;
+
+    for (i = 0; i < g_ops; i++)
+    {
+        one(ud, i);
+    } /* end of for (i = 0; i < g_ops; i++) */
+
+    return NULL;
+}
+
+/* 恢复并校验元素个数 */
+static const char *check(int count)
+{
+    udlist_t *ud = NULL;
+    int ok = 0;
+
+    ud = udlist_wal_recover(g_snap, g_log, NULL, UDLIST_INLINE, UDWAL_LAZY, 0);
+    if ((void *)PAR_ERROR == ud || (void *)FUN_ERROR == ud)
+    {
+        return "  RECOVER FAILED";
+    } /* end of if ((void *)PAR_ERROR == ud || (void *)FUN_ERROR == ud) */
+    ok = (get_count(ud) == count);
+    udlist_wal_close(ud);
+    udlist_destroy(ud);
+    head_destroy(&ud);
+
+    return ok ? "" : "  MISMATCH";
+}
+
+/* 谓词: 第一个字段是 7 的倍数 */
+static int by7(void *data, void *ctx)
+{
+    (void)ctx;
+    return (0 == ((int *)data)[0] % 7) ? MATCH_SUCCESS : MATCH_FAIL;
+}
+
+/* 比较函数: 第一个字段相等 */
+static int by_id(void *data, void *key)
+{
+    return (((int *)data)[0] == *(int *)key) ? MATCH_SUCCESS : MATCH_FAIL;
+}
+
+/* 排序比较函数: 按第一个字段 */
+static int ord_id(void *a, void *b)
+{
+    return ((int *)a)[0] - ((int *)b)[0];
+}
+
+/* 执行所有记录日志的修改操作, 恢复后逐个元素比较 */
+static const char *roundtrip(int flags)
+{
+    udlist_iter_t it;
+    udlist_t *ud = NULL;
+    udlist_t *re = NULL;
+    node_t *h = NULL;
+    int rec[4] = {0, 0, 0, 0};
+    int a[4] = {0, 0, 0, 0};
+    int b[4] = {0, 0, 0, 0};
+    int *p = NULL;
+    int bad = 0;
+    int i = 0;
+
+    ud = make(200, flags);
+    udlist_wal_attach(ud, g_snap, g_log, UDWAL_FLUSH, 0);
+
+    /* 1.按索引、按关键字及批量修改 */
+    for (i = 0; i < 20; i++)
+    {
+        rec[0] = 1000 + i;
+        udlist_insert_by_index(ud, rec, i * 7);
+        udlist_delete_by_index(ud, i * 5);
+        udlist_modify_by_index(ud, rec, i * 3 + 1);
+    } /* end of for (i = 0; i < 20; i++) */
+    i = 50;
+    udlist_delete_by_key(ud, &i, by_id);
+    udlist_modify_all_by_key(ud, rec, &rec[0], by_id);
+    udlist_remove_if(ud, by7, NULL);
+    udlist_pop_front(ud, a);
+    udlist_pop_back(ud, a);
+
+    /* 2.借用写入 */
+    p = (int *)udlist_emplace_back(ud);
+    p[0] = 2000;
+    p[1] = 2001;
+    p[2] = 2002;
+    p[3] = 2003;
+    udlist_peek_end(ud);
+
+    /* 3.游标删除及插入 */
+    udlist_iter_begin(&it, ud);
+    for (i = 0; udlist_iter_valid(&it); i++)
+    {
+        if (0 == i % 9)
+        {
+            udlist_iter_erase(&it);
+            continue;
+        } /* end of if (0 == i % 9) */
+        if (0 == i % 11)
+        {
+            rec[0] = 3000 + i;
+            udlist_iter_insert_before(&it, rec);
+        } /* end of if (0 == i % 11) */
+        udlist_iter_next(&it);
+    } /* end of for (i = 0; udlist_iter_valid(&it); i++) */
+
+    /* 4.节点句柄(展开模式不支持) */
+    if (!(UDLIST_UNROLLED & flags))
+    {
+        rec[0] = 4000;
+        h = udlist_append_h(ud, rec);
+        rec[0] = 4001;
+        udlist_insert_after_node(ud, NULL, rec);
+        udlist_insert_after_node(ud, h, rec);
+        i = 100;
+        udlist_remove_node(ud, udlist_find_node(ud, &i, by_id));
+    } /* end of if (!(UDLIST_UNROLLED & flags)) */
+
+    /* 5.无法记录的操作必须拒绝 */
+    bad = (PAR_ERROR != udlist_sort(ud, ord_id));
+
+    /* 6.恢复并逐个比较 */
+    udlist_wal_sync(ud);
+    re = udlist_wal_recover(g_snap, g_log, NULL, flags, UDWAL_LAZY, 0);
+    if ((void *)PAR_ERROR == re || (void *)FUN_ERROR == re)
+    {
+        bad = 1;
+    }
+    else
+    {
+        bad |= (get_count(re) != get_count(ud));
+        for (i = 0; !bad && i < get_count(ud); i++)
+        {
+            udlist_retrieve_by_index(ud, a, i);
+            udlist_retrieve_by_index(re, b, i);
+            bad = (0 != memcmp(a, b, sizeof(a)));
+        } /* end of for (i = 0; !bad && i < get_count(ud); i++) */
+        udlist_wal_close(re);
+        udlist_destroy(re);
+        head_destroy(&re);
+    }
+
+    udlist_wal_close(ud);
+    udlist_destroy(ud);
+    head_destroy(&ud);
+
+    return bad ? "MISMATCH" : "ok";
+}
+
+/* 测试一种持久化级别 */
+static void bench(const char *name, int n, int level, int threads, double base)
+{
+    pthread_t tid[64];
+    udlist_t *ud = NULL;
+    double t0 = 0;
+    double t = 0;
+    int count = 0;
+    int i = 0;
+
+    ud = make(n, threads > 1 ? UDLIST_INLINE | UDLIST_CONCURRENT : UDLIST_INLINE);
+    udlist_wal_attach(ud, g_snap, g_log, level, 0);
+
+    t0 = now_sec();
+    if (threads > 1)
+    {
+        for (i = 0; i < threads; i++)
+        {
+            pthread_create(&tid[i], NULL, worker, ud);
+        } /* end of for (i = 0; i < threads; i++) */
+        for (i = 0; i < threads; i++)
+        {
+            pthread_join(tid[i], NULL);
+        } /* end of for (i = 0; i < threads; i++) */
+    }
+    else
+    {
+        worker(ud);
+    }
+    udlist_wal_sync(ud);
+    t = (now_sec() - t0) / ((double)g_ops * (threads > 1 ? threads : 1));
+
+    count = get_count(ud);
+    udlist_wal_close(ud);
+    udlist_destroy(ud);
+    head_destroy(&ud);
+    printf("%-22s %10.2f us/op (%.1fx)%s\n", name, t * 1e6, base / t, check(count));
+}
+
+
+int main(int argc, char **argv)
+{
+    const char *dir = "/tmp";
+    udlist_t *ud = NULL;
+    double t0 = 0;
+    double base = 0;
+    char name[32];
+    int threads = 8;
+    int n = 100000;
+    int rounds = 0;
+    int i = 0;
+
+    if (argc > 1)
+    {
+        n = atoi(argv[1]);
+    } /* end of if (argc > 1) */
+    if (argc > 2)
+    {
+        g_ops = atoi(argv[2]);
+    } /* end of if (argc > 2) */
+    if (argc > 3)
+    {
+        threads = atoi(argv[3]);
+        threads = (threads > 64) ? 64 : threads;
+    } /* end of if (argc > 3) */
+    if (argc > 4)
+    {
+        dir = argv[4];
+    } /* end of if (argc > 4) */
+    snprintf(g_snap, sizeof(g_snap), "%s/bench_wal.snap", dir);
+    snprintf(g_log, sizeof(g_log), "%s/bench_wal.log", dir);
+
+    /* 1.基准: 每次修改后保存整个链表(只测少量次数) */
+    ud = make(n, UDLIST_INLINE);
+    rounds = (g_ops < 50) ? g_ops : 50;
+    t0 = now_sec();
+    for (i = 0; i < rounds; i++)
+    {
+        one(ud, i);
+        udlist_save(ud, g_snap);
+    } /* end of for (i = 0; i < rounds; i++) */
+    base = (now_sec() - t0) / rounds;
+    printf("%-22s %10.2f us/op (n=%d)\n", "save-per-change", base * 1e6, n);
+    udlist_destroy(ud);
+    head_destroy(&ud);
+
+    /* 2.预写日志 */
+    bench("wal lazy", n, UDWAL_LAZY, 1, base);
+    bench("wal flush", n, UDWAL_FLUSH, 1, base);
+    bench("wal sync", n, UDWAL_SYNC, 1, base);
+    snprintf(name, sizeof(name), "wal sync threads=%d", threads);
+    bench(name, n, UDWAL_SYNC, threads, base);
+
+    /* 3.恢复校验 */
+    printf("%-22s %s\n", "round-trip inline", roundtrip(UDLIST_INLINE));
+    printf("%-22s %s\n", "round-trip indexed", roundtrip(UDLIST_INLINE | UDLIST_INDEXED));
+    printf("%-22s %s\n", "round-trip unrolled", roundtrip(UDLIST_UNROLLED));
+
+    unlink(g_snap);
+    unlink(g_log);
+
+    return 0;
+}
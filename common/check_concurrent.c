@@ -0,0 +1,319 @@
+/* 并发模式(UDLIST_CONCURRENT)及分片链表压力测试
+ *
+ * 用法: ./check_concurrent [readers] [ops]
+ *      readers 读线程数(默认 4), 另有 2 个写线程
+ *      ops     每个写线程的插入次数(默认 5000)
+ *
+ * 写线程插入自己的元素(值唯一), 每三次删除一个、修改一个自己插入过的元素, 结束时元素个数及总和确定;
+ * 读线程同时按索引读取、借用(udlist_peek_*)、按关键字查找及遍历, 检查读到的值都在写入范围内;
+ * 分片链表由多个线程按关键字插入、修改、删除, 同时并行遍历
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "uni_doubly_linkedlist.h"
+#include "udlist_shard.h"
+
+/* 检查失败时打印位置并退出 */
+#define CHECK(cond)                                                                 \
+    do                                                                              \
+    {                                                                               \
+        if (!(cond))                                                                \
+        {                                                                           \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            exit(1);                                                                \
+        }                                                                           \
+    }                                                                               \
+    while (0)
+
+#define WRITERS 2
+#define MAX_READERS 64
+
+/* 分片链表元素 */
+typedef struct _kv_t
+{
+    int key;
+    int val;
+}kv_t;
+
+/* 测试参数 */
+static udlist_t *head = NULL;
+static udlist_sharded_t *shard = NULL;
+static int readers = 4;
+static int ops = 5000;
+static int stop = 0;
+static long shard_sum = 0;
+
+/* 比较函数 */
+static int int_compare(void *data, void *key)
+{
+    return (*(int *)data == *(int *)key) ? MATCH_SUCCESS : MATCH_FAIL;
+}
+
+/* 哈希函数 */
+static unsigned long int_hash(void *data)
+{
+    return (unsigned long)(*(int *)data) * 2654435761u;
+}
+
+/* 遍历时检查值的范围 */
+static int in_range(void *data)
+{
+    CHECK(*(int *)data >= 0 && *(int *)data < WRITERS * ops);
+    return 0;
+}
+
+/* 遍历时求和 */
+static long sum = 0;
+static int add(void *data)
+{
+    sum += *(int *)data;
+    return 0;
+}
+
+/* 写线程: 插入 w * ops + i, 每三次删除及修改一个之前插入的元素 */
+static void *writer(void *arg)
+{
+    int base = (int)(long)arg * ops;
+    int data = 0;
+    int i = 0;
+
+    for (i = 0; i < ops; i++)
+    {
+        data = base + i;
+        CHECK(0 == udlist_append(head, &data));
+        if (2 == i % 3)
+        {
+            data = base + i - 2;
+            CHECK(0 == udlist_delete_by_key(head, &data, int_compare));
+            data = base + i - 1;
+            CHECK(0 == udlist_modify_by_key(head, &data, &data, int_compare));
+        } /* end of if (2 == i % 3) */
+    } /* end of for (i = 0; i < ops; i++) */
+
+    return NULL;
+}
+
+/* 读线程 */
+static void *reader(void *arg)
+{
+    unsigned int r = (unsigned int)(long)arg * 7 + 1;
+    long it = 0;
+    int *p = NULL;
+    int data = 0;
+    int key = 0;
+    int n = 0;
+
+    while (!__atomic_load_n(&stop, __ATOMIC_ACQUIRE))
+    {
+        r = r * 1103515245 + 12345;
+        n = get_count(head);
+        key = (int)((r >> 8) % (unsigned int)(WRITERS * ops));
+
+        /* 读取时链表可能已经变短 */
+        if (n > 0 && 0 == udlist_retrieve_by_index(head, &data, (int)(r % n)))
+        {
+            CHECK(data >= 0 && data < WRITERS * ops);
+        } /* end of if (n > 0 && ...) */
+        get_match_index(head, &key, int_compare);
+
+        /* 借用期间持有读锁, 元素不会被修改或删除 */
+        p = (int *)udlist_peek_by_key(head, &key, int_compare);
+        if (NULL != p && (void *)PAR_ERROR != p)
+        {
+            CHECK(*p == key);
+            udlist_peek_end(head);
+        } /* end of if (NULL != p && (void *)PAR_ERROR != p) */
+
+        if (0 == it++ % 64)
+        {
+            udlist_traverse(head, in_range);
+        } /* end of if (0 == it++ % 64) */
+    } /* end of while (!__atomic_load_n(&stop, __ATOMIC_ACQUIRE)) */
+
+    return NULL;
+}
+
+/* 一种存储模式: 读写线程同时运行, 结束后检查元素个数及总和 */
+static void stress(const char *name, int flags, int hash)
+{
+    pthread_t tid[WRITERS + MAX_READERS];
+    long expect = 0;
+    int count = 0;
+    long i = 0;
+    int w = 0;
+
+    head = udlist_create_ex(sizeof(int), NULL, flags);
+    CHECK((void *)PAR_ERROR != head && (void *)FUN_ERROR != head);
+    if (hash)
+    {
+        CHECK(0 == udlist_hash_attach(head, int_hash, int_compare));
+    } /* end of if (hash) */
+    stop = 0;
+
+    for (i = 0; i < readers; i++)
+    {
+        pthread_create(&tid[WRITERS + i], NULL, reader, (void *)i);
+    } /* end of for (i = 0; i < readers; i++) */
+    for (i = 0; i < WRITERS; i++)
+    {
+        pthread_create(&tid[i], NULL, writer, (void *)i);
+    } /* end of for (i = 0; i < WRITERS; i++) */
+    for (i = 0; i < WRITERS; i++)
+    {
+        pthread_join(tid[i], NULL);
+    } /* end of for (i = 0; i < WRITERS; i++) */
+    __atomic_store_n(&stop, 1, __ATOMIC_RELEASE);
+    for (i = 0; i < readers; i++)
+    {
+        pthread_join(tid[WRITERS + i], NULL);
+    } /* end of for (i = 0; i < readers; i++) */
+
+    /* 每个写线程保留序号 i % 3 != 0 或最后不满三次的元素 */
+    for (w = 0; w < WRITERS; w++)
+    {
+        for (i = 0; i < ops; i++)
+        {
+            if (0 != i % 3 || i + 2 >= ops)
+            {
+                expect += (long)w * ops + i;
+                count++;
+            } /* end of if (0 != i % 3 || i + 2 >= ops) */
+        } /* end of for (i = 0; i < ops; i++) */
+    } /* end of for (w = 0; w < WRITERS; w++) */
+    sum = 0;
+    CHECK(0 == udlist_traverse(head, add));
+    CHECK(count == get_count(head) && expect == sum);
+
+    udlist_destroy(head);
+    head_destroy(&head);
+    printf("check_concurrent %-20s ok (%d elements)\n", name, count);
+}
+
+/* 分片链表 */
+static unsigned long kv_hash(void *data)
+{
+    return (unsigned long)((kv_t *)data)->key * 2654435761u;
+}
+
+static int kv_compare(void *data, void *key)
+{
+    return (((kv_t *)data)->key == ((kv_t *)key)->key) ? MATCH_SUCCESS : MATCH_FAIL;
+}
+
+static int kv_add(void *data)
+{
+    __atomic_fetch_add(&shard_sum, ((kv_t *)data)->val, __ATOMIC_RELAXED);
+    return 0;
+}
+
+/* 分片写线程: 插入自己的关键字, 删除一半, 修改并读回另一半后删除 */
+static void *shard_writer(void *arg)
+{
+    int base = (int)(long)arg * ops;
+    kv_t x;
+    kv_t o;
+    int i = 0;
+
+    for (i = 0; i < ops; i++)
+    {
+        x.key = base + i;
+        x.val = 1;
+        CHECK(0 == udlist_sharded_insert(shard, &x));
+    } /* end of for (i = 0; i < ops; i++) */
+    for (i = 0; i < ops; i += 2)
+    {
+        x.key = base + i;
+        CHECK(0 == udlist_sharded_delete_by_key(shard, &x, kv_compare));
+    } /* end of for (i = 0; i < ops; i += 2) */
+    for (i = 1; i < ops; i += 2)
+    {
+        x.key = base + i;
+        x.val = 2;
+        CHECK(0 == udlist_sharded_modify_by_key(shard, &x, &x, kv_compare));
+        CHECK(0 == udlist_sharded_retrieve_by_key(shard, &o, &x, kv_compare) && 2 == o.val);
+        CHECK(1 == udlist_sharded_delete_all_by_key(shard, &x, kv_compare));
+    } /* end of for (i = 1; i < ops; i += 2) */
+
+    return NULL;
+}
+
+/* 分片遍历线程 */
+static void *shard_reader(void *arg)
+{
+    int i = 0;
+
+    for (i = 0; i < 20; i++)
+    {
+        udlist_sharded_traverse(shard, kv_add, 3);
+    } /* end of for (i = 0; i < 20; i++) */
+
+    return NULL;
+}
+
+/* 分片链表: 有无哈希索引各一次 */
+static void stress_sharded(int hash)
+{
+    pthread_t tid[MAX_READERS + 1];
+    kv_t x;
+    long i = 0;
+
+    shard = udlist_sharded_create(sizeof(kv_t), NULL, kv_hash, hash ? kv_compare : NULL, 16);
+    CHECK((void *)PAR_ERROR != shard && (void *)FUN_ERROR != shard);
+
+    for (i = 0; i < readers; i++)
+    {
+        pthread_create(&tid[i], NULL, shard_writer, (void *)i);
+    } /* end of for (i = 0; i < readers; i++) */
+    pthread_create(&tid[readers], NULL, shard_reader, NULL);
+    for (i = 0; i <= readers; i++)
+    {
+        pthread_join(tid[i], NULL);
+    } /* end of for (i = 0; i <= readers; i++) */
+    CHECK(0 == udlist_sharded_get_count(shard));
+
+    /* 单线程及多线程遍历结果相同 */
+    for (i = 0; i < 1000; i++)
+    {
+        x.key = (int)i;
+        x.val = (int)i;
+        CHECK(0 == udlist_sharded_insert(shard, &x));
+    } /* end of for (i = 0; i < 1000; i++) */
+    shard_sum = 0;
+    CHECK(0 == udlist_sharded_traverse(shard, kv_add, 4));
+    CHECK(999 * 1000 / 2 == shard_sum);
+    shard_sum = 0;
+    CHECK(0 == udlist_sharded_traverse(shard, kv_add, 0));
+    CHECK(999 * 1000 / 2 == shard_sum);
+
+    udlist_sharded_destroy(shard);
+    CHECK(0 == udlist_sharded_get_count(shard));
+    udlist_sharded_head_destroy(&shard);
+    CHECK(NULL == shard);
+    printf("check_concurrent %-20s ok\n", hash ? "sharded+hash" : "sharded");
+}
+
+
+int main(int argc, char **argv)
+{
+    if (argc > 1)
+    {
+        readers = atoi(argv[1]);
+        readers = (readers > MAX_READERS) ? MAX_READERS : (readers < 1 ? 1 : readers);
+    } /* end of if (argc > 1) */
+    if (argc > 2)
+    {
+        ops = atoi(argv[2]);
+        ops = (ops < 3) ? 3 : ops;
+    } /* end of if (argc > 2) */
+
+    stress("inline", UDLIST_INLINE | UDLIST_CONCURRENT, 0);
+    stress("inline+hash", UDLIST_INLINE | UDLIST_CONCURRENT, 1);
+    stress("indexed", UDLIST_INLINE | UDLIST_INDEXED | UDLIST_CONCURRENT, 0);
+    stress("unrolled", UDLIST_UNROLLED | UDLIST_CONCURRENT, 0);
+    stress_sharded(0);
+    stress_sharded(1);
+
+    return 0;
+}
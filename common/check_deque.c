@@ -0,0 +1,197 @@
+/* 无锁模式(UDLIST_LOCKFREE)多生产者多消费者测试: 每个插入的元素恰好被取出一次
+ *
+ * 用法: ./check_deque [threads] [ops]
+ *      threads 生产者(消费者)线程数(默认 8)
+ *      ops     每个生产者插入的元素个数(默认 100000)
+ *
+ * 生产者随机头尾插入, 消费者随机头尾删除, 所有生产者结束且链表为空时消费者退出;
+ * 最后检查顺序语义及其他接口在无锁模式下返回 PAR_ERROR
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "uni_doubly_linkedlist.h"
+
+/* 检查失败时打印位置并退出 */
+#define CHECK(cond)                                                                 \
+    do                                                                              \
+    {                                                                               \
+        if (!(cond))                                                                \
+        {                                                                           \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            exit(1);                                                                \
+        }                                                                           \
+    }                                                                               \
+    while (0)
+
+/* 元素值: 高位为生产者编号, 低 20 位为序号 */
+#define SEQ_BITS 20
+#define MAX_THREADS 64
+
+/* 测试参数 */
+static udlist_t *head = NULL;
+static int threads = 8;
+static int ops = 100000;
+static int done = 0;
+static unsigned char *seen = NULL;
+
+/* 生产者线程 */
+static void *producer(void *arg)
+{
+    long t = (long)arg;
+    unsigned int r = (unsigned int)t * 7 + 1;
+    int data = 0;
+    int i = 0;
+
+    for (i = 0; i < ops; i++)
+    {
+        data = (int)(t << SEQ_BITS | i);
+        r = r * 1103515245 + 12345;
+        CHECK(0 == ((r >> 16) & 1 ? udlist_push_front(head, &data) : udlist_push_back(head, &data)));
+    } /* end of for (i = 0; i < ops; i++) */
+    __atomic_add_fetch(&done, 1, __ATOMIC_RELEASE);
+
+    return NULL;
+}
+
+/* 消费者线程: 返回取出的元素个数 */
+static void *consumer(void *arg)
+{
+    unsigned int r = (unsigned int)(long)arg * 13 + 5;
+    long got = 0;
+    int data = 0;
+    int ret = 0;
+    int p = 0;
+    int i = 0;
+
+    for (;;)
+    {
+        r = r * 1103515245 + 12345;
+        ret = (r >> 16) & 1 ? udlist_pop_front(head, &data) : udlist_pop_back(head, &data);
+        if (0 == ret)
+        {
+            p = data >> SEQ_BITS;
+            i = data & ((1 << SEQ_BITS) - 1);
+            CHECK(p < threads && i < ops);
+            CHECK(0 == __atomic_fetch_add(&seen[(long)p * ops + i], 1, __ATOMIC_RELAXED));
+            got++;
+        }
+        else
+        {
+            CHECK(MATCH_FAIL == ret);
+            if (__atomic_load_n(&done, __ATOMIC_ACQUIRE) == threads && 0 == get_count(head))
+            {
+                break;
+            } /* end of if (__atomic_load_n(&done, __ATOMIC_ACQUIRE) == threads && ...) */
+        }
+    } /* end of for (;;) */
+
+    return (void *)got;
+}
+
+/* 多线程插入删除, 检查每个元素恰好取出一次 */
+static void stress(int flags)
+{
+    pthread_t tid[2 * MAX_THREADS];
+    void *got = NULL;
+    long total = 0;
+    long i = 0;
+
+    head = udlist_create_ex(sizeof(int), NULL, flags);
+    CHECK((void *)PAR_ERROR != head && (void *)FUN_ERROR != head);
+    memset(seen, 0, (size_t)threads * ops);
+    done = 0;
+
+    for (i = 0; i < threads; i++)
+    {
+        pthread_create(&tid[i], NULL, consumer, (void *)i);
+        pthread_create(&tid[threads + i], NULL, producer, (void *)i);
+    } /* end of for (i = 0; i < threads; i++) */
+    for (i = 0; i < 2 * threads; i++)
+    {
+        pthread_join(tid[i], &got);
+        total += (i < threads) ? (long)got : 0;
+    } /* end of for (i = 0; i < 2 * threads; i++) */
+
+    CHECK(total == (long)threads * ops);
+    for (i = 0; i < (long)threads * ops; i++)
+    {
+        CHECK(1 == seen[i]);
+    } /* end of for (i = 0; i < (long)threads * ops; i++) */
+    CHECK(0 == get_count(head));
+}
+
+/* 单线程下的顺序语义及不支持的接口 */
+static void sequential(void)
+{
+    int batch[5] = { 1, 2, 3, 4, 5 };
+    int data = 0;
+    int i = 0;
+
+    for (i = 0; i < 1000; i++)
+    {
+        CHECK(0 == udlist_append(head, &i));
+    } /* end of for (i = 0; i < 1000; i++) */
+    for (i = 1; i <= 10; i++)
+    {
+        data = -i;
+        CHECK(0 == udlist_prepend(head, &data));
+    } /* end of for (i = 1; i <= 10; i++) */
+    CHECK(0 == udlist_pop_front(head, &data) && -10 == data);
+    CHECK(0 == udlist_pop_back(head, &data) && 999 == data);
+    CHECK(0 == udlist_delete_by_index(head, 0));
+    CHECK(1007 == get_count(head));
+
+    /* 批量插入保持顺序 */
+    CHECK(0 == udlist_prepend_n(head, batch, 5));
+    for (i = 0; i < 5; i++)
+    {
+        CHECK(0 == udlist_pop_front(head, &data) && batch[i] == data);
+    } /* end of for (i = 0; i < 5; i++) */
+    CHECK(0 == udlist_append_n(head, batch, 5));
+    for (i = 4; i >= 0; i--)
+    {
+        CHECK(0 == udlist_pop_back(head, &data) && batch[i] == data);
+    } /* end of for (i = 4; i >= 0; i--) */
+
+    /* 其他接口不支持 */
+    CHECK(PAR_ERROR == udlist_delete_by_index(head, 1));
+    CHECK(PAR_ERROR == udlist_insert_by_index(head, &data, 0));
+    CHECK(PAR_ERROR == udlist_traverse(head, index_print));
+    CHECK((void *)PAR_ERROR == udlist_append_h(head, &data));
+
+    CHECK(0 == udlist_destroy(head));
+    CHECK(0 == get_count(head));
+    CHECK(MATCH_FAIL == udlist_pop_back(head, &data));
+    head_destroy(&head);
+}
+
+
+int main(int argc, char **argv)
+{
+    if (argc > 1)
+    {
+        threads = atoi(argv[1]);
+        threads = (threads > MAX_THREADS) ? MAX_THREADS : (threads < 1 ? 1 : threads);
+    } /* end of if (argc > 1) */
+    if (argc > 2)
+    {
+        ops = atoi(argv[2]);
+        ops = (ops > (1 << SEQ_BITS)) ? (1 << SEQ_BITS) : (ops < 1 ? 1 : ops);
+    } /* end of if (argc > 2) */
+
+    seen = (unsigned char *)malloc((size_t)threads * ops);
+    CHECK(NULL != seen);
+
+    stress(UDLIST_LOCKFREE);
+    sequential();
+    stress(UDLIST_LOCKFREE | UDLIST_INLINE);
+    sequential();
+    CHECK((void *)PAR_ERROR == udlist_create_ex(sizeof(int), NULL, UDLIST_LOCKFREE | UDLIST_CONCURRENT));
+
+    free(seen);
+    printf("check_deque ok (%d producers, %d consumers, %d ops each)\n", threads, threads, ops);
+
+    return 0;
+}
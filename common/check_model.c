@@ -0,0 +1,361 @@
+/* 模型测试: 随机操作序列同时作用于链表和一个普通数组(模型), 定期比较两者内容
+ *
+ * 用法: ./check_model [seed] [steps]
+ *      seed    随机数种子(默认 1)
+ *      steps   每种存储模式的操作次数(默认 20000)
+ *
+ * 覆盖兼容、内联、秩树、展开、内存池、并发、无锁模式及附加哈希索引的组合;
+ * 无锁模式只执行其支持的头尾插入、删除操作, 比较时依次弹出再批量插回
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "uni_doubly_linkedlist.h"
+
+/* 检查失败时打印位置并退出 */
+#define CHECK(cond)                                                                 \
+    do                                                                              \
+    {                                                                               \
+        if (!(cond))                                                                \
+        {                                                                           \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            exit(1);                                                                \
+        }                                                                           \
+    }                                                                               \
+    while (0)
+
+/* 模型及遍历结果的最大元素个数 */
+#define MODEL_MAX 100000
+
+/* 一种存储模式 */
+typedef struct _ckmode_t
+{
+    const char *name;               // 模式名
+    int flags;                      // 存储模式
+    int pooled;                     // 内存池每块节点数(0 表示不使用内存池)
+    int hash;                       // 是否附加哈希索引
+}ckmode_t;
+
+static const ckmode_t modes[] =
+{
+    { "compat",             UDLIST_COMPAT,                                      0, 0 },
+    { "compat+indexed",     UDLIST_INDEXED,                                     0, 0 },
+    { "inline",             UDLIST_INLINE,                                      0, 0 },
+    { "inline+hash",        UDLIST_INLINE,                                      0, 1 },
+    { "indexed+hash",       UDLIST_INLINE | UDLIST_INDEXED,                     0, 1 },
+    { "concurrent",         UDLIST_INLINE | UDLIST_CONCURRENT,                  0, 0 },
+    { "indexed+concurrent", UDLIST_INLINE | UDLIST_INDEXED | UDLIST_CONCURRENT, 0, 0 },
+    { "pooled",             UDLIST_COMPAT,                                      7, 0 },
+    { "pooled+hash",        UDLIST_COMPAT,                                      5, 1 },
+    { "unrolled",           UDLIST_UNROLLED,                                    0, 0 },
+    { "lockfree",           UDLIST_LOCKFREE,                                    0, 0 },
+};
+
+/* 模型 */
+static int model[MODEL_MAX];
+static int mn = 0;
+
+/* 遍历结果 */
+static int coll[MODEL_MAX];
+static int cn = 0;
+
+/* 比较函数 */
+static int int_compare(void *data, void *key)
+{
+    return (*(int *)data == *(int *)key) ? MATCH_SUCCESS : MATCH_FAIL;
+}
+
+/* 哈希函数 */
+static unsigned long int_hash(void *data)
+{
+    return (unsigned long)(*(int *)data) * 2654435761u;
+}
+
+/* 遍历时收集元素 */
+static int collect(void *data)
+{
+    coll[cn++] = *(int *)data;
+    return 0;
+}
+
+/* 模型中在 i 处插入 n 个元素 */
+static void model_insert(int i, const int *data, int n)
+{
+    memmove(model + i + n, model + i, (mn - i) * sizeof(int));
+    memcpy(model + i, data, n * sizeof(int));
+    mn += n;
+}
+
+/* 模型中删除 i 处的元素 */
+static void model_delete(int i)
+{
+    memmove(model + i, model + i + 1, (mn - i - 1) * sizeof(int));
+    mn--;
+}
+
+/* 模型中第一个等于 v 的元素的索引, 没有时返回 -1 */
+static int model_find(int v)
+{
+    int i = 0;
+
+    for (i = 0; i < mn; i++)
+    {
+        if (model[i] == v)
+        {
+            return i;
+        } /* end of if (model[i] == v) */
+    } /* end of for (i = 0; i < mn; i++) */
+
+    return -1;
+}
+
+/* 比较链表与模型 */
+static void verify(udlist_t *ud)
+{
+    int data = 0;
+    int i = 0;
+
+    CHECK(get_count(ud) == mn);
+
+    /* 无锁模式不支持遍历: 依次弹出比较后批量插回 */
+    if (UDLIST_LOCKFREE & ud->flags)
+    {
+        for (i = 0; i < mn; i++)
+        {
+            CHECK(0 == udlist_pop_front(ud, &data) && data == model[i]);
+        } /* end of for (i = 0; i < mn; i++) */
+        CHECK(MATCH_FAIL == udlist_pop_front(ud, &data));
+        CHECK(0 == udlist_append_n(ud, model, mn));
+        return;
+    } /* end of if (UDLIST_LOCKFREE & ud->flags) */
+
+    cn = 0;
+    CHECK(0 == udlist_traverse(ud, collect));
+    CHECK(cn == mn && 0 == memcmp(coll, model, mn * sizeof(int)));
+
+    /* 反向遍历从首节点开始沿 prev 方向: 首、尾、尾的前一个... */
+    cn = 0;
+    CHECK(0 == udlist_traverse_back(ud, collect));
+    CHECK(cn == mn);
+    for (i = 0; i < mn; i++)
+    {
+        CHECK(coll[i] == model[(mn - i) % mn]);
+    } /* end of for (i = 0; i < mn; i++) */
+
+    for (i = 0; i < 5 && mn > 0; i++)
+    {
+        int index = rand() % mn;
+
+        CHECK(0 == udlist_retrieve_by_index(ud, &data, index) && data == model[index]);
+    } /* end of for (i = 0; i < 5 && mn > 0; i++) */
+}
+
+/* 执行一个随机操作 */
+static void step(udlist_t *ud)
+{
+    int batch[40];
+    int data = 0;
+    int v = rand() % 50;
+    int op = rand() % 13;
+    int i = 0;
+    int n = 0;
+    int ret = 0;
+
+    /* 无锁模式只有头尾插入、删除; 模型将满时只删除 */
+    if ((UDLIST_LOCKFREE & ud->flags) && !(op <= 1 || 3 == op || 9 == op || 10 == op || op >= 11))
+    {
+        op = 11;
+    } /* end of if ((UDLIST_LOCKFREE & ud->flags) && ...) */
+    if (mn > MODEL_MAX - 64)
+    {
+        op = 11;
+    } /* end of if (mn > MODEL_MAX - 64) */
+
+    switch (op)
+    {
+    case 0:
+        CHECK(0 == udlist_append(ud, &v));
+        model_insert(mn, &v, 1);
+        break;
+    case 1:
+        CHECK(0 == udlist_prepend(ud, &v));
+        model_insert(0, &v, 1);
+        break;
+    case 2:
+        /* 索引超出时插入尾部 */
+        i = rand() % (mn + 3);
+        CHECK(0 == udlist_insert_by_index(ud, &v, i));
+        model_insert(i > mn ? mn : i, &v, 1);
+        break;
+    case 3:
+        if (mn > 0)
+        {
+            i = (UDLIST_LOCKFREE & ud->flags) ? 0 : rand() % mn;
+            CHECK(0 == udlist_delete_by_index(ud, i));
+            model_delete(i);
+        } /* end of if (mn > 0) */
+        break;
+    case 4:
+        if (mn > 0)
+        {
+            i = rand() % mn;
+            CHECK(0 == udlist_modify_by_index(ud, &v, i));
+            model[i] = v;
+        } /* end of if (mn > 0) */
+        break;
+    case 5:
+        i = model_find(v);
+        ret = udlist_delete_by_key(ud, &v, int_compare);
+        CHECK((i >= 0) == (0 == ret));
+        if (i >= 0)
+        {
+            model_delete(i);
+        } /* end of if (i >= 0) */
+        break;
+    case 6:
+        /* 删除全部匹配较少执行, 避免链表过短 */
+        if (0 == rand() % 20)
+        {
+            for (i = 0; i < mn; i++)
+            {
+                if (model[i] != v)
+                {
+                    model[n++] = model[i];
+                } /* end of if (model[i] != v) */
+            } /* end of for (i = 0; i < mn; i++) */
+            CHECK(udlist_delete_all_by_key(ud, &v, int_compare) == mn - n);
+            mn = n;
+        } /* end of if (0 == rand() % 20) */
+        break;
+    case 7:
+        i = model_find(v);
+        CHECK(get_match_index(ud, &v, int_compare) == (i >= 0 ? i : MATCH_FAIL));
+        break;
+    case 8:
+    {
+        udlist_t *r = udlist_find_all_index_by_key(ud, &v, int_compare);
+
+        for (i = 0; i < mn; i++)
+        {
+            if (model[i] == v)
+            {
+                CHECK(NULL != r && 0 == udlist_retrieve_by_index(r, &data, n++) && data == i);
+            } /* end of if (model[i] == v) */
+        } /* end of for (i = 0; i < mn; i++) */
+        if (NULL != r)
+        {
+            CHECK(get_count(r) == n);
+            udlist_destroy(r);
+            head_destroy(&r);
+        } /* end of if (NULL != r) */
+        break;
+    }
+    case 9:
+    case 10:
+        n = rand() % 40;
+        for (i = 0; i < n; i++)
+        {
+            batch[i] = rand() % 50;
+        } /* end of for (i = 0; i < n; i++) */
+        if (9 == op)
+        {
+            CHECK(0 == udlist_append_n(ud, batch, n));
+            model_insert(mn, batch, n);
+        }
+        else
+        {
+            CHECK(0 == udlist_prepend_n(ud, batch, n));
+            model_insert(0, batch, n);
+        }
+        break;
+    default:
+        /* 弹出元素, 空链表返回 MATCH_FAIL */
+        if (rand() % 2)
+        {
+            ret = udlist_pop_front(ud, &data);
+            CHECK(mn > 0 ? (0 == ret && data == model[0]) : MATCH_FAIL == ret);
+            if (mn > 0)
+            {
+                model_delete(0);
+            } /* end of if (mn > 0) */
+        }
+        else
+        {
+            ret = udlist_pop_back(ud, &data);
+            CHECK(mn > 0 ? (0 == ret && data == model[mn - 1]) : MATCH_FAIL == ret);
+            if (mn > 0)
+            {
+                mn--;
+            } /* end of if (mn > 0) */
+        }
+        break;
+    } /* end of switch (op) */
+}
+
+/* 测试一种存储模式 */
+static void run(const ckmode_t *m, int steps)
+{
+    udlist_t *ud = NULL;
+    op_t my_destroy = NULL;
+    int i = 0;
+
+    /* 兼容模式(不使用内存池)数据域单独申请, 需要销毁函数 */
+    if (0 == m->pooled && !((UDLIST_INLINE | UDLIST_UNROLLED | UDLIST_LOCKFREE) & m->flags))
+    {
+        my_destroy = index_destroy;
+    } /* end of if (0 == m->pooled && ...) */
+    if (m->pooled > 0)
+    {
+        ud = udlist_create_pooled(sizeof(int), my_destroy, m->pooled);
+    }
+    else
+    {
+        ud = udlist_create_ex(sizeof(int), my_destroy, m->flags);
+    }
+    CHECK(NULL != ud && (void *)PAR_ERROR != ud && (void *)FUN_ERROR != ud);
+    if (m->hash)
+    {
+        CHECK(0 == udlist_hash_attach(ud, int_hash, int_compare));
+    } /* end of if (m->hash) */
+
+    mn = 0;
+    for (i = 0; i < steps; i++)
+    {
+        step(ud);
+        if (0 == i % 97)
+        {
+            verify(ud);
+        } /* end of if (0 == i % 97) */
+    } /* end of for (i = 0; i < steps; i++) */
+    verify(ud);
+
+    udlist_destroy(ud);
+    CHECK(0 == get_count(ud));
+    head_destroy(&ud);
+    printf("check_model %-20s ok (%d elements at end)\n", m->name, mn);
+}
+
+
+int main(int argc, char **argv)
+{
+    int steps = 20000;
+    int seed = 1;
+    size_t i = 0;
+
+    if (argc > 1)
+    {
+        seed = atoi(argv[1]);
+    } /* end of if (argc > 1) */
+    if (argc > 2)
+    {
+        steps = atoi(argv[2]);
+    } /* end of if (argc > 2) */
+
+    for (i = 0; i < sizeof(modes) / sizeof(modes[0]); i++)
+    {
+        srand(seed);
+        run(&modes[i], steps);
+    } /* end of for (i = 0; i < sizeof(modes) / sizeof(modes[0]); i++) */
+
+    return 0;
+}
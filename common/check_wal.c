@@ -0,0 +1,425 @@
+/* 预写日志恢复及快照校验测试
+ *
+ * 用法: ./check_wal [dir]
+ *      dir     快照及日志所在目录(默认 /tmp)
+ *
+ * 1.round-trip: 随机修改同时作用于开启日志的链表和参照链表, 中途做检查点, 恢复后逐个元素比较;
+ *   在恢复的链表上继续记录, 日志末尾追加半条记录后再恢复; 在检查点保存快照和清空日志之间"崩溃"后恢复
+ * 2.组提交: 多个线程同时插入(UDWAL_SYNC 等各级别), 其间做检查点, 恢复后与原链表比较
+ * 3.快照损坏: 数据区、文件头(seq)损坏及截断都必须被拒绝
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "uni_doubly_linkedlist.h"
+#include "udlist_wal.h"
+#include "udlist_snap.h"
+
+/* 检查失败时打印位置并退出 */
+#define CHECK(cond)                                                                 \
+    do                                                                              \
+    {                                                                               \
+        if (!(cond))                                                                \
+        {                                                                           \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            exit(1);                                                                \
+        }                                                                           \
+    }                                                                               \
+    while (0)
+
+/* 有效指针(非 NULL 及错误码) */
+#define VALID(p) (NULL != (p) && (void *)PAR_ERROR != (p) && (void *)FUN_ERROR != (p))
+
+#define THREADS 8
+
+/* 测试元素: 含未对齐的尾部 */
+typedef struct _rec_t
+{
+    int key;
+    int val;
+    char pad[5];
+}rec_t;
+
+/* 测试参数 */
+static char g_snap[256];
+static char g_log[256];
+static udlist_t *g_mt = NULL;
+static int g_per = 2000;
+
+/* 比较函数 */
+static int key_compare(void *data, void *key)
+{
+    return (((rec_t *)data)->key == *(int *)key) ? MATCH_SUCCESS : MATCH_FAIL;
+}
+
+/* 哈希函数 */
+static unsigned long key_hash(void *data)
+{
+    return (unsigned long)((rec_t *)data)->key * 2654435761u;
+}
+
+/* 复制文件 */
+static void copy_file(const char *from, const char *to)
+{
+    char buf[4096];
+    FILE *in = fopen(from, "rb");
+    FILE *out = fopen(to, "wb");
+    size_t n = 0;
+
+    CHECK(NULL != in && NULL != out);
+    while ((n = fread(buf, 1, sizeof(buf), in)) > 0)
+    {
+        CHECK(fwrite(buf, 1, n, out) == n);
+    } /* end of while ((n = fread(buf, 1, sizeof(buf), in)) > 0) */
+    fclose(in);
+    fclose(out);
+}
+
+/* 两个链表逐个元素比较 */
+static void same(udlist_t *a, udlist_t *b, size_t size)
+{
+    unsigned char x[64];
+    unsigned char y[64];
+    int i = 0;
+
+    CHECK(get_count(a) == get_count(b));
+    for (i = 0; i < get_count(a); i++)
+    {
+        CHECK(0 == udlist_retrieve_by_index(a, x, i));
+        CHECK(0 == udlist_retrieve_by_index(b, y, i));
+        CHECK(0 == memcmp(x, y, size));
+    } /* end of for (i = 0; i < get_count(a); i++) */
+}
+
+/* 随机修改同时作用于 ud 及参照链表 ref, 返回值必须相同 */
+static void ops(udlist_t *ud, udlist_t *ref, int n, unsigned int *seed)
+{
+    rec_t batch[5];
+    rec_t x;
+    int count = 0;
+    int index = 0;
+    int a = 0;
+    int b = 0;
+    int i = 0;
+    int k = 0;
+
+    for (i = 0; i < n; i++)
+    {
+        memset(&x, 0, sizeof(x));
+        x.key = rand_r(seed) % 50;
+        x.val = rand_r(seed);
+        x.pad[2] = (char)i;
+        count = get_count(ref);
+        index = count > 0 ? rand_r(seed) % count : 0;
+
+        switch (rand_r(seed) % 14)
+        {
+        case 0:
+        case 1:
+            a = udlist_append(ud, &x);
+            b = udlist_append(ref, &x);
+            break;
+        case 2:
+            a = udlist_prepend(ud, &x);
+            b = udlist_prepend(ref, &x);
+            break;
+        case 3:
+            a = udlist_insert_by_index(ud, &x, index);
+            b = udlist_insert_by_index(ref, &x, index);
+            break;
+        case 4:
+            a = udlist_delete_by_index(ud, index);
+            b = udlist_delete_by_index(ref, index);
+            break;
+        case 5:
+            a = udlist_modify_by_index(ud, &x, index);
+            b = udlist_modify_by_index(ref, &x, index);
+            break;
+        case 6:
+            a = udlist_modify_by_key(ud, &x, &x.key, key_compare);
+            b = udlist_modify_by_key(ref, &x, &x.key, key_compare);
+            break;
+        case 7:
+            a = udlist_delete_by_key(ud, &x.key, key_compare);
+            b = udlist_delete_by_key(ref, &x.key, key_compare);
+            break;
+        case 8:
+            a = udlist_delete_all_by_key(ud, &x.key, key_compare);
+            b = udlist_delete_all_by_key(ref, &x.key, key_compare);
+            break;
+        case 9:
+            a = udlist_modify_all_by_key(ud, &x, &x.key, key_compare);
+            b = udlist_modify_all_by_key(ref, &x, &x.key, key_compare);
+            break;
+        case 10:
+        case 11:
+            for (k = 0; k < 5; k++)
+            {
+                batch[k] = x;
+                batch[k].key = k + 7 * (i & 1);
+            } /* end of for (k = 0; k < 5; k++) */
+            a = (i & 1) ? udlist_prepend_n(ud, batch, 3) : udlist_append_n(ud, batch, 5);
+            b = (i & 1) ? udlist_prepend_n(ref, batch, 3) : udlist_append_n(ref, batch, 5);
+            break;
+        case 12:
+            a = udlist_pop_front(ud, &x);
+            b = udlist_pop_front(ref, &x);
+            break;
+        default:
+            /* 偶尔清空 */
+            if (0 == rand_r(seed) % 40)
+            {
+                a = udlist_destroy(ud);
+                b = udlist_destroy(ref);
+            }
+            else
+            {
+                a = udlist_pop_back(ud, &x);
+                b = udlist_pop_back(ref, &x);
+            }
+            break;
+        } /* end of switch (rand_r(seed) % 14) */
+        CHECK(a == b);
+    } /* end of for (i = 0; i < n; i++) */
+}
+
+/* round-trip: 一种存储模式及持久化级别 */
+static void round_trip(int flags, int level, int hash)
+{
+    unsigned int seed = (unsigned int)(flags * 100 + level * 10 + hash + 1);
+    op_t my_destroy = ((UDLIST_INLINE | UDLIST_UNROLLED) & flags) ? NULL : index_destroy;
+    udlist_t *ud = NULL;
+    udlist_t *ref = NULL;
+    udlist_t *re = NULL;
+    char old[300];
+
+    unlink(g_snap);
+    unlink(g_log);
+    ud = udlist_create_ex(sizeof(rec_t), my_destroy, flags);
+    ref = udlist_create_ex(sizeof(rec_t), NULL, UDLIST_INLINE);
+    CHECK(VALID(ud) && VALID(ref));
+    if (hash)
+    {
+        CHECK(0 == udlist_hash_attach(ud, key_hash, key_compare));
+    } /* end of if (hash) */
+
+    /* 1.开启前的修改进入第一个快照 */
+    ops(ud, ref, 50, &seed);
+    CHECK(0 == udlist_wal_attach(ud, g_snap, g_log, level, 5));
+    CHECK(PAR_ERROR == udlist_wal_attach(ud, g_snap, g_log, level, 5));
+    ops(ud, ref, 800, &seed);
+    CHECK(0 == udlist_wal_checkpoint(ud));
+    ops(ud, ref, 300, &seed);
+    CHECK(0 == udlist_wal_sync(ud));
+    same(ud, ref, sizeof(rec_t));
+
+    /* 2.恢复后比较, 并在恢复的链表上继续记录 */
+    re = udlist_wal_recover(g_snap, g_log, my_destroy, flags, level, 5);
+    CHECK(VALID(re));
+    same(re, ref, sizeof(rec_t));
+    udlist_wal_close(ud);
+    ops(re, ref, 200, &seed);
+    CHECK(0 == udlist_wal_close(re));
+    udlist_destroy(re);
+    head_destroy(&re);
+
+    /* 3.日志末尾写了一半的记录被丢弃 */
+    {
+        FILE *fp = fopen(g_log, "ab");
+
+        CHECK(NULL != fp);
+        fwrite("\x40\0\0\0garbage-garbage-garbage-garbage-garbage", 1, 40, fp);
+        fclose(fp);
+    }
+    re = udlist_wal_recover(g_snap, g_log, my_destroy, flags, level, 5);
+    CHECK(VALID(re));
+    same(re, ref, sizeof(rec_t));
+
+    /* 4.检查点保存快照后、清空日志前崩溃: 重放时跳过快照已包含的记录 */
+    ops(re, ref, 100, &seed);
+    CHECK(0 == udlist_wal_sync(re));
+    snprintf(old, sizeof(old), "%s.old", g_log);
+    copy_file(g_log, old);
+    CHECK(0 == udlist_wal_checkpoint(re));
+    CHECK(0 == udlist_wal_close(re));
+    copy_file(old, g_log);
+    unlink(old);
+    udlist_destroy(re);
+    head_destroy(&re);
+    re = udlist_wal_recover(g_snap, g_log, my_destroy, flags, level, 5);
+    CHECK(VALID(re));
+    same(re, ref, sizeof(rec_t));
+    CHECK(0 == udlist_wal_close(re));
+
+    udlist_destroy(re);
+    head_destroy(&re);
+    udlist_destroy(ud);
+    head_destroy(&ud);
+    udlist_destroy(ref);
+    head_destroy(&ref);
+}
+
+/* 组提交线程: 插入自己的元素, 线程 0 定期做检查点 */
+static void *appender(void *arg)
+{
+    long t = (long)arg;
+    int data = 0;
+    int i = 0;
+
+    for (i = 0; i < g_per; i++)
+    {
+        data = (int)(t * 1000000 + i);
+        CHECK(0 == udlist_append(g_mt, &data));
+        if (0 == t && 0 == i % 500)
+        {
+            CHECK(0 == udlist_wal_checkpoint(g_mt));
+        } /* end of if (0 == t && 0 == i % 500) */
+    } /* end of for (i = 0; i < g_per; i++) */
+
+    return NULL;
+}
+
+/* 组提交: 多线程插入后恢复比较 */
+static void group_commit(int level)
+{
+    pthread_t tid[THREADS];
+    udlist_t *re = NULL;
+    long t = 0;
+
+    unlink(g_snap);
+    unlink(g_log);
+    g_mt = udlist_create_ex(sizeof(int), NULL, UDLIST_INLINE | UDLIST_CONCURRENT);
+    CHECK(VALID(g_mt));
+    CHECK(0 == udlist_wal_attach(g_mt, g_snap, g_log, level, 2));
+    for (t = 0; t < THREADS; t++)
+    {
+        pthread_create(&tid[t], NULL, appender, (void *)t);
+    } /* end of for (t = 0; t < THREADS; t++) */
+    for (t = 0; t < THREADS; t++)
+    {
+        pthread_join(tid[t], NULL);
+    } /* end of for (t = 0; t < THREADS; t++) */
+    CHECK(0 == udlist_wal_sync(g_mt));
+
+    re = udlist_wal_recover(g_snap, g_log, NULL, UDLIST_INLINE, level, 0);
+    CHECK(VALID(re));
+    CHECK(THREADS * g_per == get_count(re));
+    same(re, g_mt, sizeof(int));
+
+    udlist_wal_close(re);
+    udlist_destroy(re);
+    head_destroy(&re);
+    udlist_wal_close(g_mt);
+    udlist_destroy(g_mt);
+    head_destroy(&g_mt);
+}
+
+/* 修改文件中 off 处的一个字节 */
+static void flip(const char *path, long off)
+{
+    FILE *fp = fopen(path, "r+b");
+    int c = 0;
+
+    CHECK(NULL != fp);
+    CHECK(0 == fseek(fp, off, SEEK_SET));
+    c = fgetc(fp);
+    CHECK(0 == fseek(fp, off, SEEK_SET));
+    fputc(c ^ 0x55, fp);
+    fclose(fp);
+}
+
+/* 快照损坏: 返回 FUN_ERROR 而不是错误的内容 */
+static void corruption(void)
+{
+    udlist_view_t *v = NULL;
+    udlist_t *ud = NULL;
+    udlist_t *re = NULL;
+    int i = 0;
+
+    ud = udlist_create_ex(sizeof(int), NULL, UDLIST_INLINE);
+    for (i = 0; i < 1000; i++)
+    {
+        udlist_append(ud, &i);
+    } /* end of for (i = 0; i < 1000; i++) */
+
+    /* 1.完好的快照 */
+    CHECK(0 == udlist_save(ud, g_snap));
+    re = udlist_load(g_snap, NULL);
+    CHECK(VALID(re));
+    same(re, ud, sizeof(int));
+    udlist_destroy(re);
+    head_destroy(&re);
+    v = udlist_view_open(g_snap, 1);
+    CHECK(VALID(v) && 1000 == v->count && 999 == *(const int *)udlist_view_at(v, 999));
+    CHECK(NULL == udlist_view_at(v, 1000));
+    udlist_view_close(&v);
+    CHECK(NULL == v);
+
+    /* 2.数据区损坏: 加载及校验的视图拒绝, 不校验的视图可以打开 */
+    flip(g_snap, UDSNAP_HEAD_SIZE + 100);
+    CHECK((void *)FUN_ERROR == udlist_load(g_snap, NULL));
+    CHECK((void *)FUN_ERROR == udlist_view_open(g_snap, 1));
+    v = udlist_view_open(g_snap, 0);
+    CHECK(VALID(v));
+    udlist_view_close(&v);
+
+    /* 3.文件头损坏(seq 字段): 不论是否校验都拒绝 */
+    CHECK(0 == udlist_save(ud, g_snap));
+    flip(g_snap, 40);
+    CHECK((void *)FUN_ERROR == udlist_view_open(g_snap, 0));
+    CHECK((void *)FUN_ERROR == udlist_load(g_snap, NULL));
+
+    /* 4.标识错误及截断 */
+    CHECK(0 == udlist_save(ud, g_snap));
+    flip(g_snap, 0);
+    CHECK((void *)FUN_ERROR == udlist_view_open(g_snap, 0));
+    CHECK(0 == udlist_save(ud, g_snap));
+    CHECK(0 == truncate(g_snap, UDSNAP_HEAD_SIZE + 200));
+    CHECK((void *)FUN_ERROR == udlist_view_open(g_snap, 0));
+    CHECK((void *)FUN_ERROR == udlist_load(g_snap, NULL));
+
+    udlist_destroy(ud);
+    head_destroy(&ud);
+}
+
+
+int main(int argc, char **argv)
+{
+    const int flags[] = { UDLIST_INLINE, UDLIST_INLINE | UDLIST_INDEXED, UDLIST_UNROLLED,
+                          UDLIST_INLINE | UDLIST_CONCURRENT, UDLIST_COMPAT };
+    const char *dir = (argc > 1) ? argv[1] : "/tmp";
+    size_t f = 0;
+    int level = 0;
+
+    snprintf(g_snap, sizeof(g_snap), "%s/check_wal.snap", dir);
+    snprintf(g_log, sizeof(g_log), "%s/check_wal.log", dir);
+
+    for (f = 0; f < sizeof(flags) / sizeof(flags[0]); f++)
+    {
+        for (level = UDWAL_LAZY; level <= UDWAL_SYNC; level++)
+        {
+            round_trip(flags[f], level, 0);
+            if (!(UDLIST_UNROLLED & flags[f]))
+            {
+                round_trip(flags[f], level, 1);
+            } /* end of if (!(UDLIST_UNROLLED & flags[f])) */
+        } /* end of for (level = UDWAL_LAZY; level <= UDWAL_SYNC; level++) */
+    } /* end of for (f = 0; f < sizeof(flags) / sizeof(flags[0]); f++) */
+    printf("check_wal round-trip ok\n");
+
+    for (level = UDWAL_LAZY; level <= UDWAL_SYNC; level++)
+    {
+        group_commit(level);
+    } /* end of for (level = UDWAL_LAZY; level <= UDWAL_SYNC; level++) */
+    printf("check_wal group commit ok\n");
+
+    corruption();
+    printf("check_wal snapshot corruption ok\n");
+
+    unlink(g_snap);
+    unlink(g_log);
+
+    return 0;
+}
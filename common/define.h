@@ -1,32 +1,46 @@
-/**
- * @file                define.h
- * @brief               对链表进行宏定义的头文件
- * @author              BHR
- * @version             v1.0
- * @date                2024-03-05
- * @copyright           MIT
- */
-
-#ifndef __DEFINE_H__
-#define __DEFINE_H__
-
-// 匹配成功
-#define MATCH_SUCCESS 0
-
-// 匹配失败
-#define MATCH_FAIL -3
-
-// 调试宏
-#define DEBUG
-#define _FILE_DEBUG
-
-// 函数功能错误
-#define FUN_ERROR -1
-// 参数错误
-#define PAR_ERROR -2
-
-
-
-
-
+/**
+ * @file                define.h
+ * @brief               对链表进行宏定义的头文件
+ * @author              BHR
+ * @version             v1.0
+ * @date                2024-03-05
+ * @copyright           MIT
+ */
+
+#ifndef __DEFINE_H__
+#define __DEFINE_H__
+
+// 匹配成功
+#define MATCH_SUCCESS 0
+
+// 匹配失败
+#define MATCH_FAIL -3
+
+// 调试宏: 去掉下划线(或编译时 -DUDLIST_DEBUG)后错误信息打印到标准输出, 并检查借用期间的写操作(udlist_peek_*)
+#define _UDLIST_DEBUG
+
+// 函数功能错误
+#define FUN_ERROR -1
+// 参数错误
+#define PAR_ERROR -2
+
+// 链表存储模式
+#define UDLIST_COMPAT 0x00          // 兼容模式: 数据域单独申请, my_destroy 负责释放数据域
+#define UDLIST_INLINE 0x01          // 内联模式: 数据域紧跟节点头, my_destroy 只清理数据引用的资源
+#define UDLIST_INDEXED 0x02         // 秩树模式: 按索引访问 O(log n)
+#define UDLIST_UNROLLED 0x04        // 展开模式: 每个节点连续存放多个元素, my_destroy 语义同内联模式
+#define UDLIST_CONCURRENT 0x08      // 并发模式: 读操作持有读锁, 修改操作持有写锁, 可以与其他模式组合
+#define UDLIST_LOCKFREE 0x10        // 无锁模式: 无锁双端队列, 只支持头尾插入、删除, my_destroy 语义同内联模式
+#define UDLIST_SORTED 0x20          // 有序模式: 插入时保持有序, 按关键字 O(log n) 查找, 由 udlist_create_sorted 创建
+
+// 统计宏: 去掉下划线(或编译时 -DUDLIST_STATS)后每个链表记录调用次数及耗时直方图, 见 udlist_stats.h
+#define _UDLIST_STATS
+
+// 追踪宏: 去掉下划线(或编译时 -DUDLIST_TRACE)后接口调用及错误记录到环形缓冲区, 见 udlist_trace.h
+#define _UDLIST_TRACE
+
+
+
+
+
 #endif /* __DEFINE_H__ */
\ No newline at end of file
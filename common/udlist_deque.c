@@ -0,0 +1,570 @@
+/**
+ * @file                udlist_deque.c
+ * @brief               无锁双端队列(UDLIST_LOCKFREE 模式)
+ * @author              BHR
+ * @version             v1.0
+ * @date                2024-03-07
+ * @copyright           MIT
+ */
+
+#include <sched.h>
+#include <stddef.h>
+#include "udlist_deque.h"
+#include "udlist_trace.h"
+
+// 锚点状态: 稳定 / 右端插入未补全链接 / 左端插入未补全链接
+#define UDDQ_STABLE 0
+#define UDDQ_RPUSH 1
+#define UDDQ_LPUSH 2
+
+// 锚点打包及拆分: 低 31 位左端索引, 中间 31 位右端索引, 高 2 位状态
+#define UDDQ_ANCHOR(l, r, s) ((uint64_t)(l) | ((uint64_t)(r) << 31) | ((uint64_t)(s) << 62))
+#define UDDQ_L(a) ((uint32_t)((a) & 0x7fffffff))
+#define UDDQ_R(a) ((uint32_t)(((a) >> 31) & 0x7fffffff))
+#define UDDQ_S(a) ((int)((a) >> 62))
+
+// 最大节点索引
+#define UDDQ_MAX_INDEX 0x7fffffffu
+
+// 第 0 块的节点个数(以 2 为底的对数)
+#define UDDQ_BASE_SHIFT 6
+
+// 原子操作简写
+#define UD_LOAD(p) __atomic_load_n((p), __ATOMIC_SEQ_CST)
+#define UD_STORE(p, v) __atomic_store_n((p), (v), __ATOMIC_SEQ_CST)
+#define UD_CAS(p, e, v) __atomic_compare_exchange_n((p), (e), (v), 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)
+
+
+// 线程上次使用的操作记录下标, 各线程从不同的记录开始查找
+static __thread int __rec_hint = -1;
+static int __rec_seq = 0;
+
+
+/**
+ * @brief           节点索引转换为节点地址
+ * @details         索引 i 位于第 c 块, c 为 (i - 1 + 64) 的最高位减 6, 块内偏移为去掉最高位后的值
+ * @param           队列指针
+ * @param           节点索引(不为 0)
+ * @return          节点指针
+ */
+static uddq_node_t *__node_at(uddq_t *q, uint32_t idx)
+{
+    uint32_t j = idx - 1 + (1u << UDDQ_BASE_SHIFT);
+    int c = 31 - __builtin_clz(j) - UDDQ_BASE_SHIFT;
+    unsigned char *chunk = __atomic_load_n(&q->chunk[c], __ATOMIC_ACQUIRE);
+
+    return (uddq_node_t *)(chunk + (size_t)(j - (1u << (c + UDDQ_BASE_SHIFT))) * q->node_size);
+}
+
+
+
+/**
+ * @brief           申请一个节点
+ * @details         优先从空闲栈弹出, 空闲栈为空时切分新的节点索引, 所在分块未申请时申请;
+ *                  空闲栈栈顶带版本号, 避免弹出时栈顶被其他线程弹出又压回造成的 ABA 问题
+ * @param           队列指针
+ * @return          节点索引, 失败返回 0
+ */
+static uint32_t __node_alloc(uddq_t *q)
+{
+    uint64_t top = 0;
+    uint64_t next = 0;
+    uint32_t idx = 0;
+    unsigned char *chunk = NULL;
+    unsigned char *expect = NULL;
+    int c = 0;
+
+    /* 1.从空闲栈弹出 */
+    top = __atomic_load_n(&q->free_top, __ATOMIC_ACQUIRE);
+    while (0 != (uint32_t)top)
+    {
+        idx = (uint32_t)top;
+        next = __atomic_load_n(&__node_at(q, idx)->free_next, __ATOMIC_RELAXED) | (((top >> 32) + 1) << 32);
+        if (__atomic_compare_exchange_n(&q->free_top, &top, next, 1, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE))
+        {
+            return idx;
+        } /* end of if (__atomic_compare_exchange_n(&q->free_top, ...)) */
+    } /* end of while (0 != (uint32_t)top) */
+
+    /* 2.切分新的节点索引 */
+    idx = __atomic_fetch_add(&q->bump, 1, __ATOMIC_RELAXED);
+    if (0 == idx || idx > UDDQ_MAX_INDEX)
+    {
+        return 0;
+    } /* end of if (0 == idx || idx > UDDQ_MAX_INDEX) */
+
+    /* 3.所在分块未申请时申请, 多个线程同时申请时只保留一个 */
+    c = 31 - __builtin_clz(idx - 1 + (1u << UDDQ_BASE_SHIFT)) - UDDQ_BASE_SHIFT;
+    if (NULL == __atomic_load_n(&q->chunk[c], __ATOMIC_ACQUIRE))
+    {
+        chunk = (unsigned char *)malloc(((size_t)1 << (c + UDDQ_BASE_SHIFT)) * q->node_size);
+        if (NULL == chunk)
+        {
+            UD_ALLOC_ERROR("__node_alloc: malloc error\n");
+            return 0;
+        } /* end of if (NULL == chunk) */
+
+        if (!__atomic_compare_exchange_n(&q->chunk[c], &expect, chunk, 0, __ATOMIC_RELEASE, __ATOMIC_ACQUIRE))
+        {
+            free(chunk);
+        } /* end of if (!__atomic_compare_exchange_n(&q->chunk[c], ...)) */
+    } /* end of if (NULL == __atomic_load_n(&q->chunk[c], __ATOMIC_ACQUIRE)) */
+
+    return idx;
+}
+
+
+
+/**
+ * @brief           将节点压入空闲栈
+ * @param           队列指针
+ * @param           节点索引
+ */
+static void __node_release(uddq_t *q, uint32_t idx)
+{
+    uddq_node_t *p = __node_at(q, idx);
+    uint64_t top = 0;
+    uint64_t next = 0;
+
+    top = __atomic_load_n(&q->free_top, __ATOMIC_RELAXED);
+    do
+    {
+        __atomic_store_n(&p->free_next, (uint32_t)top, __ATOMIC_RELAXED);
+        next = idx | (((top >> 32) + 1) << 32);
+    }
+    while (!__atomic_compare_exchange_n(&q->free_top, &top, next, 1, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+}
+
+
+
+/**
+ * @brief           占用一个线程操作记录
+ * @details         优先使用本线程上次的记录, 记录全部被占用时让出 CPU 后重试
+ * @param           队列指针
+ * @return          操作记录指针
+ */
+static uddq_rec_t *__rec_acquire(uddq_t *q)
+{
+    uddq_rec_t *rec = NULL;
+    uint32_t expect = 0;
+    int i = 0;
+    int k = 0;
+
+    if (__rec_hint < 0)
+    {
+        __rec_hint = __atomic_fetch_add(&__rec_seq, 1, __ATOMIC_RELAXED) % UDDQ_THREADS;
+    } /* end of if (__rec_hint < 0) */
+
+    for (;;)
+    {
+        for (k = 0; k < UDDQ_THREADS; k++)
+        {
+            i = (__rec_hint + k) % UDDQ_THREADS;
+            rec = &q->rec[i];
+            expect = 0;
+            if (0 == __atomic_load_n(&rec->active, __ATOMIC_RELAXED)
+                && __atomic_compare_exchange_n(&rec->active, &expect, 1, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+            {
+                __rec_hint = i;
+                return rec;
+            } /* end of if (0 == __atomic_load_n(&rec->active, __ATOMIC_RELAXED) && ...) */
+        } /* end of for (k = 0; k < UDDQ_THREADS; k++) */
+        sched_yield();
+    } /* end of for (;;) */
+}
+
+
+
+/**
+ * @brief           清除危险指针并释放线程操作记录
+ * @param           操作记录指针
+ */
+static void __rec_release(uddq_rec_t *rec)
+{
+    int i = 0;
+
+    for (i = 0; i < UDDQ_HP; i++)
+    {
+        __atomic_store_n(&rec->hp[i], 0, __ATOMIC_RELEASE);
+    } /* end of for (i = 0; i < UDDQ_HP; i++) */
+    __atomic_store_n(&rec->active, 0, __ATOMIC_RELEASE);
+}
+
+
+
+/**
+ * @brief           危险指针排序比较函数
+ */
+static int __hp_compare(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+
+
+/**
+ * @brief           延迟回收已删除的节点
+ * @details         待回收节点数达到 UDDQ_RETIRED 时收集所有线程的危险指针,
+ *                  不在其中的节点压入空闲栈; 危险指针总数小于 UDDQ_RETIRED, 每次扫描至少回收 64 个
+ * @param           队列指针
+ * @param           本线程的操作记录
+ * @param           已从队列中删除的节点索引
+ */
+static void __rec_retire(uddq_t *q, uddq_rec_t *rec, uint32_t idx)
+{
+    uint32_t hz[UDDQ_THREADS * UDDQ_HP];
+    uint32_t v = 0;
+    int nh = 0;
+    int i = 0;
+    int j = 0;
+    int k = 0;
+
+    rec->retired[rec->retired_n++] = idx;
+    if (rec->retired_n < UDDQ_RETIRED)
+    {
+        return;
+    } /* end of if (rec->retired_n < UDDQ_RETIRED) */
+
+    /* 1.收集危险指针 */
+    for (i = 0; i < UDDQ_THREADS; i++)
+    {
+        for (j = 0; j < UDDQ_HP; j++)
+        {
+            v = UD_LOAD(&q->rec[i].hp[j]);
+            if (0 != v)
+            {
+                hz[nh++] = v;
+            } /* end of if (0 != v) */
+        } /* end of for (j = 0; j < UDDQ_HP; j++) */
+    } /* end of for (i = 0; i < UDDQ_THREADS; i++) */
+    qsort(hz, nh, sizeof(uint32_t), __hp_compare);
+
+    /* 2.回收不被访问的节点, 其余继续等待 */
+    for (i = 0; i < rec->retired_n; i++)
+    {
+        if (NULL != bsearch(&rec->retired[i], hz, nh, sizeof(uint32_t), __hp_compare))
+        {
+            rec->retired[k++] = rec->retired[i];
+        }
+        else
+        {
+            __node_release(q, rec->retired[i]);
+        }
+    } /* end of for (i = 0; i < rec->retired_n; i++) */
+    rec->retired_n = k;
+}
+
+
+
+/**
+ * @brief           补全插入端节点与原端点之间的链接, 并将锚点恢复为稳定状态
+ * @details         右端插入时新节点的 left 已指向原右端, 需要把原右端的 right 指向新节点;
+ *                  左端插入对称. 任一步发现锚点已变化说明其他线程已经完成, 直接返回
+ * @param           队列指针
+ * @param           本线程的操作记录
+ * @param           非稳定状态的锚点
+ */
+static void __stabilize(uddq_t *q, uddq_rec_t *rec, uint64_t a)
+{
+    int right = (UDDQ_RPUSH == UDDQ_S(a));
+    uint32_t end = right ? UDDQ_R(a) : UDDQ_L(a);
+    uint32_t nb = 0;
+    uint32_t link = 0;
+    uint32_t *link_p = NULL;
+
+    /* 1.保护插入的端点 */
+    UD_STORE(&rec->hp[0], end);
+    if (UD_LOAD(&q->anchor) != a)
+    {
+        return;
+    } /* end of if (UD_LOAD(&q->anchor) != a) */
+
+    /* 2.保护原端点 */
+    nb = right ? UD_LOAD(&__node_at(q, end)->left) : UD_LOAD(&__node_at(q, end)->right);
+    UD_STORE(&rec->hp[1], nb);
+    if (UD_LOAD(&q->anchor) != a)
+    {
+        return;
+    } /* end of if (UD_LOAD(&q->anchor) != a) */
+
+    /* 3.原端点指向插入的端点 */
+    link_p = right ? &__node_at(q, nb)->right : &__node_at(q, nb)->left;
+    link = UD_LOAD(link_p);
+    if (link != end)
+    {
+        if (UD_LOAD(&q->anchor) != a || !UD_CAS(link_p, &link, end))
+        {
+            return;
+        } /* end of if (UD_LOAD(&q->anchor) != a || !UD_CAS(link_p, &link, end)) */
+    } /* end of if (link != end) */
+
+    /* 4.恢复稳定状态 */
+    UD_CAS(&q->anchor, &a, UDDQ_ANCHOR(UDDQ_L(a), UDDQ_R(a), UDDQ_STABLE));
+}
+
+
+
+/**
+ * @brief           创建无锁双端队列
+ * @param           元素大小
+ * @param           自定义数据销毁函数(可以为 NULL)
+ * @return          队列指针, 失败返回 NULL
+ */
+uddq_t *uddq_create(int size, op_t my_destroy)
+{
+    uddq_t *q = NULL;
+
+    /* 参数检查 */
+    if (size <= 0)
+    {
+        UD_ERROR("uddq_create: Parameter error\n");
+        goto ERR0;
+    } /* end of if (size <= 0) */
+
+    /* 申请队列结构体(按缓存行对齐, 锚点、空闲栈、计数各占一行) */
+    q = (uddq_t *)aligned_alloc(64, (sizeof(uddq_t) + 63) & ~(size_t)63);
+    if (NULL == q)
+    {
+        UD_ALLOC_ERROR("uddq_create: aligned_alloc error\n");
+        goto ERR0;
+    } /* end of if (NULL == q) */
+    memset(q, 0, sizeof(uddq_t));
+
+    /* 信息输入: 索引 0 表示空 */
+    q->bump = 1;
+    q->size = size;
+    q->node_size = (offsetof(uddq_node_t, data) + (size_t)size + 7) & ~(size_t)7;
+    q->my_destroy = my_destroy;
+
+    return q;
+
+ERR0:
+    return NULL;
+}
+
+
+
+/**
+ * @brief           插入元素(线程安全, 无锁)
+ * @param           队列指针
+ * @param           数据的指针
+ * @param           非 0 头部插入, 0 尾部插入
+ * @return
+ *      @arg  0:正常
+ *      @arg  FUN_ERROR:函数错误
+ */
+int uddq_push(uddq_t *q, void *data, int front)
+{
+    uddq_rec_t *rec = NULL;
+    uddq_node_t *p = NULL;
+    uint64_t a = 0;
+    uint64_t b = 0;
+    uint32_t idx = 0;
+
+    /* 1.申请节点并拷入数据 */
+    idx = __node_alloc(q);
+    if (0 == idx)
+    {
+        UD_ALLOC_ERROR("uddq_push: node alloc error\n");
+        goto ERR1;
+    } /* end of if (0 == idx) */
+    p = __node_at(q, idx);
+    memcpy(p->data, data, q->size);
+
+    // 先计数再接入, 使并发删除时计数不会为负
+    __atomic_fetch_add(&q->count, 1, __ATOMIC_RELAXED);
+
+    /* 2.一次锚点 CAS 接入端点 */
+    rec = __rec_acquire(q);
+    for (;;)
+    {
+        a = UD_LOAD(&q->anchor);
+        if (0 == UDDQ_R(a))
+        {
+            // 空队列
+            UD_STORE(&p->left, 0);
+            UD_STORE(&p->right, 0);
+            if (UD_CAS(&q->anchor, &a, UDDQ_ANCHOR(idx, idx, UDDQ_S(a))))
+            {
+                break;
+            } /* end of if (UD_CAS(&q->anchor, &a, UDDQ_ANCHOR(idx, idx, UDDQ_S(a)))) */
+        }
+        else if (UDDQ_STABLE == UDDQ_S(a))
+        {
+            UD_STORE(&p->left, front ? 0 : UDDQ_R(a));
+            UD_STORE(&p->right, front ? UDDQ_L(a) : 0);
+            b = front ? UDDQ_ANCHOR(idx, UDDQ_R(a), UDDQ_LPUSH) : UDDQ_ANCHOR(UDDQ_L(a), idx, UDDQ_RPUSH);
+            if (UD_CAS(&q->anchor, &a, b))
+            {
+                /* 3.补全链接 */
+                __stabilize(q, rec, b);
+                break;
+            } /* end of if (UD_CAS(&q->anchor, &a, b)) */
+        }
+        else
+        {
+            // 协助完成其他线程未补全的插入
+            __stabilize(q, rec, a);
+        }
+    } /* end of for (;;) */
+    __rec_release(rec);
+
+    return 0;
+
+ERR1:
+    return FUN_ERROR;
+}
+
+
+
+/**
+ * @brief           删除元素并拷出数据(线程安全, 无锁)
+ * @param           队列指针
+ * @param           输出数据的指针, NULL 表示丢弃(调用 my_destroy)
+ * @param           非 0 头部删除, 0 尾部删除
+ * @return
+ *      @arg  0:正常
+ *      @arg  MATCH_FAIL:队列为空
+ */
+int uddq_pop(uddq_t *q, void *data, int front)
+{
+    uddq_rec_t *rec = NULL;
+    uddq_node_t *p = NULL;
+    uint64_t a = 0;
+    uint64_t b = 0;
+    uint32_t end = 0;
+    uint32_t nb = 0;
+
+    /* 1.一次锚点 CAS 摘下端点 */
+    rec = __rec_acquire(q);
+    for (;;)
+    {
+        a = UD_LOAD(&q->anchor);
+        end = front ? UDDQ_L(a) : UDDQ_R(a);
+        if (0 == end)
+        {
+            __rec_release(rec);
+            return MATCH_FAIL;
+        } /* end of if (0 == end) */
+
+        if (UDDQ_L(a) == UDDQ_R(a))
+        {
+            // 最后一个元素
+            if (UD_CAS(&q->anchor, &a, UDDQ_ANCHOR(0, 0, UDDQ_S(a))))
+            {
+                break;
+            } /* end of if (UD_CAS(&q->anchor, &a, UDDQ_ANCHOR(0, 0, UDDQ_S(a)))) */
+        }
+        else if (UDDQ_STABLE == UDDQ_S(a))
+        {
+            // 保护端点后确认仍在队列中, 再读取相邻节点
+            UD_STORE(&rec->hp[0], end);
+            if (UD_LOAD(&q->anchor) != a)
+            {
+                continue;
+            } /* end of if (UD_LOAD(&q->anchor) != a) */
+            p = __node_at(q, end);
+            nb = front ? UD_LOAD(&p->right) : UD_LOAD(&p->left);
+            b = front ? UDDQ_ANCHOR(nb, UDDQ_R(a), UDDQ_STABLE) : UDDQ_ANCHOR(UDDQ_L(a), nb, UDDQ_STABLE);
+            if (UD_CAS(&q->anchor, &a, b))
+            {
+                break;
+            } /* end of if (UD_CAS(&q->anchor, &a, b)) */
+        }
+        else
+        {
+            __stabilize(q, rec, a);
+        }
+    } /* end of for (;;) */
+
+    /* 2.拷出数据, 摘下的节点只属于本线程 */
+    p = __node_at(q, end);
+    if (NULL != data)
+    {
+        memcpy(data, p->data, q->size);
+    }
+    else if (NULL != q->my_destroy)
+    {
+        q->my_destroy(p->data);
+    }
+    __atomic_fetch_sub(&q->count, 1, __ATOMIC_RELAXED);
+
+    /* 3.其他线程可能仍在读取该节点的链接, 延迟回收 */
+    UD_STORE(&rec->hp[0], 0);
+    __rec_retire(q, rec, end);
+    __rec_release(rec);
+
+    return 0;
+}
+
+
+
+/**
+ * @brief           获取元素个数(并发插入、删除时为近似值)
+ * @param           队列指针
+ * @return          元素个数
+ */
+int uddq_count(uddq_t *q)
+{
+    return __atomic_load_n(&q->count, __ATOMIC_RELAXED);
+}
+
+
+
+/**
+ * @brief           清空队列并释放所有节点分块(不能与其他操作同时调用)
+ * @param           队列指针
+ */
+void uddq_clear(uddq_t *q)
+{
+    uddq_node_t *p = NULL;
+    uint32_t idx = 0;
+    int c = 0;
+
+    /* 1.清理数据引用的资源: 没有并发操作时锚点为稳定状态, 链接完整 */
+    idx = UDDQ_L(q->anchor);
+    while (0 != idx && NULL != q->my_destroy)
+    {
+        p = __node_at(q, idx);
+        q->my_destroy(p->data);
+        idx = (idx == UDDQ_R(q->anchor)) ? 0 : p->right;
+    } /* end of while (0 != idx && NULL != q->my_destroy) */
+
+    /* 2.整块释放 */
+    for (c = 0; c < UDDQ_CHUNKS; c++)
+    {
+        free(q->chunk[c]);
+        q->chunk[c] = NULL;
+    } /* end of for (c = 0; c < UDDQ_CHUNKS; c++) */
+
+    /* 3.信息刷新 */
+    for (c = 0; c < UDDQ_THREADS; c++)
+    {
+        q->rec[c].retired_n = 0;
+    } /* end of for (c = 0; c < UDDQ_THREADS; c++) */
+    q->anchor = 0;
+    q->free_top = 0;
+    q->bump = 1;
+    q->count = 0;
+}
+
+
+
+/**
+ * @brief           销毁队列(不能与其他操作同时调用)
+ * @param           队列指针的地址
+ */
+void uddq_destroy(uddq_t **q)
+{
+    if (NULL == q || NULL == *q)
+    {
+        return;
+    } /* end of if (NULL == q || NULL == *q) */
+
+    uddq_clear(*q);
+    free(*q);
+    *q = NULL;
+}
@@ -0,0 +1,95 @@
+/**
+ * @file                udlist_hash.h
+ * @brief               链表关键字哈希索引
+ * @details             开放定址(线性探测)哈希表, 槽中保存节点句柄及数据的哈希值,
+                        由链表的插入、修改、删除自动维护
+ * @author              BHR
+ * @version             v1.0
+ * @date                2024-03-07
+ * @copyright           MIT
+ */
+
+#ifndef __UDLIST_HASH_H__
+#define __UDLIST_HASH_H__
+
+#include "uni_doubly_linkedlist.h"
+
+/**
+ * @brief 哈希槽定义
+ */
+typedef struct _udhash_slot_t
+{
+    unsigned long hash;             // 数据的哈希值
+    node_t *node;                   // 节点句柄(NULL 表示空槽)
+}udhash_slot_t;
+
+
+/**
+ * @brief 哈希索引定义
+ */
+typedef struct _udhash_t
+{
+    udhash_slot_t *slots;           // 槽数组
+    size_t cap;                     // 槽个数(2 的幂)
+    size_t used;                    // 已用槽个数
+    hash_t my_hash;                 // 自定义哈希函数
+    cmp_t op_cmp;                   // 自定义比较函数
+}udhash_t;
+
+
+
+/**
+ * @brief           创建哈希索引
+ * @param           自定义哈希函数
+ * @param           自定义比较函数
+ * @param           预计节点个数
+ * @return          哈希索引指针, 失败返回 NULL
+ */
+udhash_t *udhash_create(hash_t my_hash, cmp_t op_cmp, int expect);
+
+
+/**
+ * @brief           将节点加入哈希索引
+ * @param           哈希索引指针
+ * @param           节点指针
+ * @return
+ *      @arg  0:正常
+ *      @arg  FUN_ERROR:扩容失败
+ */
+int udhash_add(udhash_t *h, node_t *p);
+
+
+/**
+ * @brief           将节点从哈希索引中删除
+ * @param           哈希索引指针
+ * @param           节点指针
+ */
+void udhash_del(udhash_t *h, node_t *p);
+
+
+/**
+ * @brief           根据关键字查找节点
+ * @param           哈希索引指针
+ * @param           关键字
+ * @param           输出是否有多个节点匹配
+ * @return          匹配的节点指针, 无匹配返回 NULL
+ */
+node_t *udhash_find(udhash_t *h, void *key, int *dup);
+
+
+/**
+ * @brief           清空哈希索引
+ * @param           哈希索引指针
+ */
+void udhash_clear(udhash_t *h);
+
+
+/**
+ * @brief           销毁哈希索引
+ * @param           哈希索引指针的地址
+ */
+void udhash_destroy(udhash_t **h);
+
+
+
+#endif /* __UDLIST_HASH_H__ */
@@ -0,0 +1,39 @@
+/**
+ * @file                udlist_parallel.h
+ * @brief               并行遍历及并行查找
+ * @details             按元素索引把链表切成若干段, 各段由线程池中的线程并行处理;
+                        段起点在秩树模式下由秩树 O(log n) 选出, 其他模式下顺序走一遍
+                        记录并缓存在头信息中, 链表结构未变化(mods 不变)时直接复用;
+                        线程池为进程内共享, 工作线程按需创建且不退出
+ * @author              BHR
+ * @version             v1.0
+ * @date                2024-03-07
+ * @copyright           MIT
+ */
+
+#ifndef __UDLIST_PARALLEL_H__
+#define __UDLIST_PARALLEL_H__
+
+#include "uni_doubly_linkedlist.h"
+
+// 最大分段数(同时也是最大并行线程数)
+#define UDPAR_SEGS 64
+
+// 每段最少元素个数, 元素过少时不值得并行
+#define UDPAR_MIN_SEG 4096
+
+
+/**
+ * @brief 分段点定义
+ */
+typedef struct _udsplit_t
+{
+    unsigned long mods;             // 计算分段点时链表的结构修改计数
+    int segs;                       // 分段个数
+    node_t *node[UDPAR_SEGS];       // 各段起始节点(展开模式为起始块)
+    int index[UDPAR_SEGS + 1];      // 各段起始元素索引, index[segs] 为元素个数
+}udsplit_t;
+
+
+
+#endif /* __UDLIST_PARALLEL_H__ */
@@ -0,0 +1,217 @@
+/**
+ * @file                udlist_pool.c
+ * @brief               链表节点内存池
+ * @author              BHR
+ * @version             v1.0
+ * @date                2024-03-07
+ * @copyright           MIT
+ */
+
+#include "udlist_pool.h"
+#include "udlist_trace.h"
+
+// 节点对齐字节数
+#define UDPOOL_ALIGN sizeof(void *)
+
+
+/**
+ * @brief           申请一个新的内存块并设为当前切分块
+ * @param           内存池指针
+ * @param           内存块可容纳的节点个数
+ * @return
+ *      @arg  0:正常
+ *      @arg  FUN_ERROR:函数错误
+ */
+static int __chunk_calloc(udpool_t *pool, size_t nodes)
+{
+    udchunk_t *chunk = NULL;
+
+    /* 申请内存块 */
+    chunk = (udchunk_t *)malloc(sizeof(udchunk_t) + nodes * pool->node_size);
+    if (NULL == chunk)
+    {
+        UD_ALLOC_ERROR("__chunk_calloc: malloc error\n");
+        goto ERR1;
+    } /* end of if (NULL == chunk) */
+
+    /* 挂入内存块链表 */
+    chunk->nodes = nodes;
+    chunk->next = pool->chunk_p;
+    pool->chunk_p = chunk;
+
+    /* 刷新切分位置 */
+    pool->bump_p = chunk->mem;
+    pool->bump_end = chunk->mem + nodes * pool->node_size;
+
+    return 0;
+
+ERR1:
+    return FUN_ERROR;
+}
+
+
+
+/**
+ * @brief           创建节点内存池
+ * @param           单个节点空间大小
+ * @param           每块节点个数
+ * @return          内存池指针, 失败返回 NULL
+ */
+udpool_t *udpool_create(int node_size, int chunk_nodes)
+{
+    udpool_t *pool = NULL;
+
+    /* 参数检查 */
+    if (node_size < (int)sizeof(void *) || chunk_nodes <= 0)
+    {
+        UD_ERROR("udpool_create: Parameter error\n");
+        goto ERR0;
+    } /* end of if (node_size < (int)sizeof(void *) || chunk_nodes <= 0) */
+
+    /* 申请内存池结构体 */
+    pool = (udpool_t *)calloc(1, sizeof(udpool_t));
+    if (NULL == pool)
+    {
+        UD_ALLOC_ERROR("udpool_create: calloc error\n");
+        goto ERR0;
+    } /* end of if (NULL == pool) */
+
+    /* 节点大小按指针对齐 */
+    pool->node_size = ((size_t)node_size + UDPOOL_ALIGN - 1) & ~(UDPOOL_ALIGN - 1);
+    pool->chunk_nodes = chunk_nodes;
+
+    return pool;
+
+ERR0:
+    return NULL;
+}
+
+
+
+/**
+ * @brief           从内存池中申请一个节点空间(不清零)
+ * @param           内存池指针
+ * @return          节点空间指针, 失败返回 NULL
+ */
+void *udpool_alloc(udpool_t *pool)
+{
+    void *p = NULL;
+
+    /* 1.优先复用空闲节点 */
+    if (NULL != pool->free_p)
+    {
+        p = pool->free_p;
+        pool->free_p = *(void **)p;
+        return p;
+    } /* end of if (NULL != pool->free_p) */
+
+    /* 2.当前块用完则申请新块 */
+    if (pool->bump_p == pool->bump_end)
+    {
+        if (0 != __chunk_calloc(pool, pool->chunk_nodes))
+        {
+            return NULL;
+        } /* end of if (0 != __chunk_calloc(pool, pool->chunk_nodes)) */
+    } /* end of if (pool->bump_p == pool->bump_end) */
+
+    /* 3.从当前块切分 */
+    p = pool->bump_p;
+    pool->bump_p += pool->node_size;
+
+    return p;
+}
+
+
+
+/**
+ * @brief           从内存池中申请 n 个连续的节点空间(不清零)
+ * @details         当前块剩余空间不足时, 剩余节点挂入空闲链表,
+ *                  再申请一个至少容纳 n 个节点的新块
+ * @param           内存池指针
+ * @param           节点个数
+ * @return          第一个节点空间指针, 失败返回 NULL
+ */
+void *udpool_alloc_n(udpool_t *pool, size_t n)
+{
+    void *p = NULL;
+
+    /* 1.当前块剩余空间不足则申请新块 */
+    if ((size_t)(pool->bump_end - pool->bump_p) < n * pool->node_size)
+    {
+        // 剩余节点回收到空闲链表
+        while (pool->bump_p != pool->bump_end)
+        {
+            udpool_free(pool, pool->bump_p);
+            pool->bump_p += pool->node_size;
+        } /* end of while (pool->bump_p != pool->bump_end) */
+
+        if (0 != __chunk_calloc(pool, n > (size_t)pool->chunk_nodes ? n : (size_t)pool->chunk_nodes))
+        {
+            return NULL;
+        } /* end of if (0 != __chunk_calloc(pool, ...)) */
+    } /* end of if ((size_t)(pool->bump_end - pool->bump_p) < n * pool->node_size) */
+
+    /* 2.从当前块连续切分 */
+    p = pool->bump_p;
+    pool->bump_p += n * pool->node_size;
+
+    return p;
+}
+
+
+
+/**
+ * @brief           将节点空间归还内存池
+ * @param           内存池指针
+ * @param           节点空间指针
+ */
+void udpool_free(udpool_t *pool, void *p)
+{
+    *(void **)p = pool->free_p;
+    pool->free_p = p;
+}
+
+
+
+/**
+ * @brief           释放内存池中的所有内存块(内存池本身保留)
+ * @param           内存池指针
+ */
+void udpool_reset(udpool_t *pool)
+{
+    udchunk_t *chunk = NULL;
+    udchunk_t *save = NULL;
+
+    /* 整块释放 */
+    chunk = pool->chunk_p;
+    while (NULL != chunk)
+    {
+        save = chunk->next;
+        free(chunk);
+        chunk = save;
+    } /* end of while (NULL != chunk) */
+
+    /* 信息刷新 */
+    pool->chunk_p = NULL;
+    pool->free_p = NULL;
+    pool->bump_p = NULL;
+    pool->bump_end = NULL;
+}
+
+
+
+/**
+ * @brief           销毁内存池
+ * @param           内存池指针的地址
+ */
+void udpool_destroy(udpool_t **pool)
+{
+    if (NULL == pool || NULL == *pool)
+    {
+        return;
+    } /* end of if (NULL == pool || NULL == *pool) */
+
+    udpool_reset(*pool);
+    free(*pool);
+    *pool = NULL;
+}
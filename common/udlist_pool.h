@@ -0,0 +1,93 @@
+/**
+ * @file                udlist_pool.h
+ * @brief               链表节点内存池
+ * @details             从大块内存中切分固定大小的节点(秩树节点 + 节点头 + 数据域),
+                        删除的节点通过侵入式空闲链表回收复用,
+                        销毁时整块释放
+ * @author              BHR
+ * @version             v1.0
+ * @date                2024-03-07
+ * @copyright           MIT
+ */
+
+#ifndef __UDLIST_POOL_H__
+#define __UDLIST_POOL_H__
+
+#include "uni_doubly_linkedlist.h"
+
+/**
+ * @brief 内存块定义
+ */
+typedef struct _udchunk_t
+{
+    struct _udchunk_t *next;        // 下一个内存块
+    size_t nodes;                   // 本块可容纳的节点个数
+    unsigned char mem[];            // 节点空间
+}udchunk_t;
+
+
+/**
+ * @brief 节点内存池定义
+ */
+typedef struct _udpool_t
+{
+    udchunk_t *chunk_p;             // 内存块链表
+    void *free_p;                   // 空闲节点链表(通过节点空间的第一个字串联)
+    unsigned char *bump_p;          // 当前内存块中未切分空间的起始
+    unsigned char *bump_end;        // 当前内存块的结束位置
+    size_t node_size;               // 单个节点空间大小
+    int chunk_nodes;                // 每块节点个数
+}udpool_t;
+
+
+
+/**
+ * @brief           创建节点内存池
+ * @param           单个节点空间大小
+ * @param           每块节点个数
+ * @return          内存池指针, 失败返回 NULL
+ */
+udpool_t *udpool_create(int node_size, int chunk_nodes);
+
+
+/**
+ * @brief           从内存池中申请一个节点空间(不清零)
+ * @param           内存池指针
+ * @return          节点空间指针, 失败返回 NULL
+ */
+void *udpool_alloc(udpool_t *pool);
+
+
+/**
+ * @brief           从内存池中申请 n 个连续的节点空间(不清零)
+ * @param           内存池指针
+ * @param           节点个数
+ * @return          第一个节点空间指针, 失败返回 NULL
+ */
+void *udpool_alloc_n(udpool_t *pool, size_t n);
+
+
+/**
+ * @brief           将节点空间归还内存池
+ * @param           内存池指针
+ * @param           节点空间指针
+ */
+void udpool_free(udpool_t *pool, void *p);
+
+
+/**
+ * @brief           释放内存池中的所有内存块(内存池本身保留)
+ * @param           内存池指针
+ */
+void udpool_reset(udpool_t *pool);
+
+
+/**
+ * @brief           销毁内存池
+ * @param           内存池指针的地址
+ */
+void udpool_destroy(udpool_t **pool);
+
+
+
+#endif /* __UDLIST_POOL_H__ */
@@ -0,0 +1,408 @@
+/**
+ * @file                udlist_rank.c
+ * @brief               链表秩树索引(UDLIST_INDEXED 模式)
+ * @author              BHR
+ * @version             v1.0
+ * @date                2024-03-07
+ * @copyright           MIT
+ */
+
+#include <stdint.h>
+#include "udlist_rank.h"
+
+// 子树节点个数
+#define RSIZE(t) (NULL == (t) ? 0 : (t)->size)
+
+
+/**
+ * @brief           由节点地址生成堆优先级
+ * @details         不需要随机数状态, 多个链表之间互不影响
+ * @param           秩树节点指针
+ * @return          优先级
+ */
+static unsigned int __rank_prio(udrank_t *t)
+{
+    uint64_t x = (uint64_t)(uintptr_t)t;
+
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+
+    return (unsigned int)x;
+}
+
+
+
+/**
+ * @brief           刷新子树节点个数及子节点的父指针
+ * @param           秩树节点指针
+ */
+static void __rank_update(udrank_t *t)
+{
+    t->size = 1 + RSIZE(t->left) + RSIZE(t->right);
+
+    if (NULL != t->left)
+    {
+        t->left->parent = t;
+    } /* end of if (NULL != t->left) */
+    if (NULL != t->right)
+    {
+        t->right->parent = t;
+    } /* end of if (NULL != t->right) */
+}
+
+
+
+/**
+ * @brief           将树分裂为前 k 个节点和其余节点
+ * @param           秩树根节点
+ * @param           前半部分节点个数
+ * @param           输出前半部分
+ * @param           输出后半部分
+ */
+static void __rank_split(udrank_t *t, int k, udrank_t **a, udrank_t **b)
+{
+    if (NULL == t)
+    {
+        *a = NULL;
+        *b = NULL;
+        return;
+    } /* end of if (NULL == t) */
+
+    if (RSIZE(t->left) >= k)
+    {
+        __rank_split(t->left, k, a, &t->left);
+        __rank_update(t);
+        *b = t;
+    }
+    else
+    {
+        __rank_split(t->right, k - RSIZE(t->left) - 1, &t->right, b);
+        __rank_update(t);
+        *a = t;
+    }
+}
+
+
+
+/**
+ * @brief           合并两棵树(a 中节点全部排在 b 之前)
+ * @param           前半部分
+ * @param           后半部分
+ * @return          合并后的根节点
+ */
+static udrank_t *__rank_merge(udrank_t *a, udrank_t *b)
+{
+    if (NULL == a)
+    {
+        return b;
+    } /* end of if (NULL == a) */
+    if (NULL == b)
+    {
+        return a;
+    } /* end of if (NULL == b) */
+
+    if (a->prio > b->prio)
+    {
+        a->right = __rank_merge(a->right, b);
+        __rank_update(a);
+        return a;
+    }
+    else
+    {
+        b->left = __rank_merge(a, b->left);
+        __rank_update(b);
+        return b;
+    }
+}
+
+
+
+/**
+ * @brief           将已链接到链表中的节点插入秩树
+ * @param           头信息结构体的指针
+ * @param           节点指针
+ * @param           节点的索引
+ */
+void udrank_insert(udlist_t *ud, node_t *p, int index)
+{
+    udrank_t *t = UD_RANK(p);
+    udrank_t *a = NULL;
+    udrank_t *b = NULL;
+
+    /* 初始化树节点 */
+    t->left = NULL;
+    t->right = NULL;
+    t->parent = NULL;
+    t->prio = __rank_prio(t);
+    t->size = 1;
+
+    /* 在 index 处分裂后依次合并 */
+    __rank_split(ud->root, index, &a, &b);
+    ud->root = __rank_merge(__rank_merge(a, t), b);
+    ud->root->parent = NULL;
+}
+
+
+
+/**
+ * @brief           将已链接到链表中的一段连续节点插入秩树
+ * @details         用栈保存最右链, 按堆优先级 O(n) 建成笛卡尔树, 再在 index 处并入;
+ *                  栈空间申请失败时退回逐个插入
+ * @param           头信息结构体的指针
+ * @param           第一个节点指针
+ * @param           节点个数
+ * @param           第一个节点的索引
+ */
+void udrank_insert_n(udlist_t *ud, node_t *first, size_t n, int index)
+{
+    udrank_t **stack = NULL;
+    udrank_t *t = NULL;
+    udrank_t *last = NULL;
+    udrank_t *a = NULL;
+    udrank_t *b = NULL;
+    size_t top = 0;
+    size_t i = 0;
+
+    stack = (udrank_t **)malloc(n * sizeof(udrank_t *));
+    if (NULL == stack)
+    {
+        for (i = 0; i < n; i++, first = first->next)
+        {
+            udrank_insert(ud, first, index + (int)i);
+        } /* end of for (i = 0; i < n; i++, first = first->next) */
+        return;
+    } /* end of if (NULL == stack) */
+
+    /* 1.建树: 优先级不低于栈顶的节点把栈顶及其下方较低的节点收为左子树 */
+    for (i = 0; i < n; i++, first = first->next)
+    {
+        t = UD_RANK(first);
+        t->right = NULL;
+        t->prio = __rank_prio(t);
+
+        last = NULL;
+        while (top > 0 && stack[top - 1]->prio <= t->prio)
+        {
+            last = stack[--top];
+            __rank_update(last);
+        } /* end of while (top > 0 && stack[top - 1]->prio <= t->prio) */
+        t->left = last;
+
+        if (top > 0)
+        {
+            stack[top - 1]->right = t;
+        } /* end of if (top > 0) */
+        stack[top++] = t;
+    } /* end of for (i = 0; i < n; i++, first = first->next) */
+
+    // 最右链自下而上刷新
+    while (top > 0)
+    {
+        __rank_update(stack[--top]);
+    } /* end of while (top > 0) */
+    t = stack[0];
+    free(stack);
+
+    /* 2.在 index 处分裂后依次合并 */
+    __rank_split(ud->root, index, &a, &b);
+    ud->root = __rank_merge(__rank_merge(a, t), b);
+    ud->root->parent = NULL;
+}
+
+
+
+/**
+ * @brief           将节点从秩树中删除
+ * @details         用左右子树合并的结果替换该节点, 再沿父指针刷新子树节点个数
+ * @param           头信息结构体的指针
+ * @param           节点指针
+ */
+void udrank_remove(udlist_t *ud, node_t *p)
+{
+    udrank_t *t = UD_RANK(p);
+    udrank_t *m = NULL;
+    udrank_t *parent = t->parent;
+
+    /* 合并左右子树 */
+    m = __rank_merge(t->left, t->right);
+    if (NULL != m)
+    {
+        m->parent = parent;
+    } /* end of if (NULL != m) */
+
+    /* 替换该节点 */
+    if (NULL == parent)
+    {
+        ud->root = m;
+    }
+    else if (parent->left == t)
+    {
+        parent->left = m;
+    }
+    else
+    {
+        parent->right = m;
+    }
+
+    /* 刷新祖先的子树节点个数 */
+    while (NULL != parent)
+    {
+        parent->size--;
+        parent = parent->parent;
+    } /* end of while (NULL != parent) */
+}
+
+
+
+/**
+ * @brief           按索引查找节点 O(log n)
+ * @param           头信息结构体的指针
+ * @param           索引值(0 <= index < count)
+ * @return          节点指针
+ */
+node_t *udrank_select(udlist_t *ud, int index)
+{
+    udrank_t *t = ud->root;
+
+    while (NULL != t)
+    {
+        if (index < RSIZE(t->left))
+        {
+            t = t->left;
+        }
+        else if (index == RSIZE(t->left))
+        {
+            break;
+        }
+        else
+        {
+            index -= RSIZE(t->left) + 1;
+            t = t->right;
+        }
+    } /* end of while (NULL != t) */
+
+    return UD_RANK_NODE(t);
+}
+
+
+
+/**
+ * @brief           计算节点的索引 O(log n)
+ * @param           头信息结构体的指针
+ * @param           节点指针
+ * @return          索引值
+ */
+int udrank_index(udlist_t *ud, node_t *p)
+{
+    udrank_t *t = UD_RANK(p);
+    int index = RSIZE(t->left);
+
+    /* 沿父指针向上累加左侧节点个数 */
+    while (NULL != t->parent)
+    {
+        if (t == t->parent->right)
+        {
+            index += RSIZE(t->parent->left) + 1;
+        } /* end of if (t == t->parent->right) */
+        t = t->parent;
+    } /* end of while (NULL != t->parent) */
+
+    return index;
+}
+
+
+
+/**
+ * @brief           有序链表中按关键字二分查找边界 O(log n)
+ * @details         中序即链表顺序, 从根向下按排序比较函数选择左右子树
+ * @param           头信息结构体的指针
+ * @param           关键字(与元素同类型)
+ * @param           自定义排序比较函数
+ * @param           非 0 查找第一个大于关键字的元素, 0 查找第一个不小于关键字的元素
+ * @param           输出边界元素的索引(不存在时为元素个数)
+ * @return          边界节点指针, 不存在返回 NULL
+ */
+node_t *udrank_bound(udlist_t *ud, void *key, ord_t op_ord, int upper, int *index)
+{
+    udrank_t *t = ud->root;
+    udrank_t *hit = NULL;
+    int base = 0;
+    int c = 0;
+
+    *index = ud->count;
+    while (NULL != t)
+    {
+        c = op_ord(UD_RANK_NODE(t)->data, key);
+        if (upper ? (c > 0) : (c >= 0))
+        {
+            // 当前节点满足条件, 继续在左子树中找更靠前的
+            hit = t;
+            *index = base + RSIZE(t->left);
+            t = t->left;
+        }
+        else
+        {
+            base += RSIZE(t->left) + 1;
+            t = t->right;
+        }
+    } /* end of while (NULL != t) */
+
+    return (NULL == hit) ? NULL : UD_RANK_NODE(hit);
+}
+
+
+
+/**
+ * @brief           从秩树中分离一段连续节点 O(log n)
+ * @details         在两端分裂后合并剩余部分, 被分离的节点仍在链表中, 由调用者摘下
+ * @param           头信息结构体的指针
+ * @param           第一个节点的索引
+ * @param           节点个数
+ * @return          分离出的子树根节点
+ */
+udrank_t *udrank_cut(udlist_t *ud, int index, int n)
+{
+    udrank_t *a = NULL;
+    udrank_t *b = NULL;
+    udrank_t *m = NULL;
+    udrank_t *c = NULL;
+
+    __rank_split(ud->root, index, &a, &b);
+    __rank_split(b, n, &m, &c);
+    ud->root = __rank_merge(a, c);
+    if (NULL != ud->root)
+    {
+        ud->root->parent = NULL;
+    } /* end of if (NULL != ud->root) */
+    if (NULL != m)
+    {
+        m->parent = NULL;
+    } /* end of if (NULL != m) */
+
+    return m;
+}
+
+
+
+/**
+ * @brief           将一棵子树整体并入秩树 O(log n)
+ * @details         子树中的节点已按顺序链接到链表的 index 位置
+ * @param           头信息结构体的指针
+ * @param           子树根节点(由 udrank_cut 分离)
+ * @param           子树第一个节点的索引
+ */
+void udrank_paste(udlist_t *ud, udrank_t *t, int index)
+{
+    udrank_t *a = NULL;
+    udrank_t *b = NULL;
+
+    __rank_split(ud->root, index, &a, &b);
+    ud->root = __rank_merge(__rank_merge(a, t), b);
+    if (NULL != ud->root)
+    {
+        ud->root->parent = NULL;
+    } /* end of if (NULL != ud->root) */
+}
@@ -0,0 +1,430 @@
+/**
+ * @file                udlist_shard.c
+ * @brief               分片链表
+ * @author              BHR
+ * @version             v1.0
+ * @date                2024-03-07
+ * @copyright           MIT
+ */
+
+#include "udlist_shard.h"
+#include "udlist_trace.h"
+
+/**
+ * @brief 并行遍历参数
+ */
+typedef struct _udshard_walk_t
+{
+    udlist_sharded_t *sh;           // 分片链表
+    op_t my_print;                  // 自定义打印数据函数
+    int next;                       // 下一个待遍历的分片
+    int ret;                        // 遍历结果
+}udshard_walk_t;
+
+
+/**
+ * @brief           计算关键字所在的分片
+ * @details         取混合后哈希值的高位, 与分片内哈希索引使用的低位无关
+ * @param           分片链表的指针
+ * @param           关键字
+ * @return          分片下标
+ */
+static int __shard_of(udlist_sharded_t *sh, void *key)
+{
+    unsigned long long h = (unsigned long long)sh->my_hash(key) * 0x9E3779B97F4A7C15ull;
+
+    return (int)((h >> 32) % (unsigned long long)sh->shards);
+}
+
+
+
+/**
+ * @brief           创建分片链表
+ * @param           存储数据类型大小
+ * @param           自定义销毁数据函数(可以为 NULL, 语义同 UDLIST_INLINE)
+ * @param           自定义哈希函数
+ * @param           自定义比较函数, 不为 NULL 时每个分片附加哈希索引, 传入相同比较函数的 *_by_key 为 O(1)
+ * @param           分片个数
+ * @return          指向分片链表的指针
+ */
+udlist_sharded_t *udlist_sharded_create(int size, op_t my_destroy, hash_t my_hash, cmp_t op_cmp, int shards)
+{
+    udlist_sharded_t *sh = NULL;
+    udlist_t *ud = NULL;
+    int i = 0;
+
+    /* 参数检查 */
+    if (size <= 0 || NULL == my_hash || shards <= 0)
+    {
+        UD_ERROR("udlist_sharded_create: Parameter error\n");
+        goto ERR0;
+    } /* end of if (size <= 0 || NULL == my_hash || shards <= 0) */
+
+    /* 申请分片链表结构体及分片数组 */
+    sh = (udlist_sharded_t *)calloc(1, sizeof(udlist_sharded_t));
+    if (NULL == sh)
+    {
+        UD_ALLOC_ERROR("udlist_sharded_create: calloc error\n");
+        goto ERR1;
+    } /* end of if (NULL == sh) */
+    sh->shard = (udlist_t **)calloc(shards, sizeof(udlist_t *));
+    if (NULL == sh->shard)
+    {
+        UD_ALLOC_ERROR("udlist_sharded_create: calloc error\n");
+        goto ERR2;
+    } /* end of if (NULL == sh->shard) */
+
+    /* 信息输入 */
+    sh->shards = shards;
+    sh->size = size;
+    sh->my_hash = my_hash;
+
+    /* 创建分片: 并发模式, 各自的节点内存池, 可选哈希索引 */
+    for (i = 0; i < shards; i++)
+    {
+        ud = udlist_create_pooled_ex(size, my_destroy, UDSHARD_CHUNK, UDLIST_CONCURRENT);
+        if ((void *)PAR_ERROR == ud || (void *)FUN_ERROR == ud)
+        {
+            goto ERR3;
+        } /* end of if ((void *)PAR_ERROR == ud || (void *)FUN_ERROR == ud) */
+        sh->shard[i] = ud;
+
+        if (NULL != op_cmp && 0 != udlist_hash_attach(ud, my_hash, op_cmp))
+        {
+            goto ERR3;
+        } /* end of if (NULL != op_cmp && 0 != udlist_hash_attach(ud, my_hash, op_cmp)) */
+    } /* end of for (i = 0; i < shards; i++) */
+
+    return sh;
+
+ERR0:
+    return (void *)PAR_ERROR;
+ERR3:
+    udlist_sharded_head_destroy(&sh);
+    return (void *)FUN_ERROR;
+ERR2:
+    free(sh);
+    sh = NULL;
+ERR1:
+    return (void *)FUN_ERROR;
+}
+
+
+
+/**
+ * @brief           获取关键字所在的分片
+ * @param           分片链表的指针
+ * @param           关键字(或数据)
+ * @return          分片链表头信息结构体的指针, 参数错误返回 NULL
+ */
+udlist_t *udlist_sharded_get(udlist_sharded_t *sh, void *key)
+{
+    /* 参数检查 */
+    if (NULL == sh || NULL == key)
+    {
+        UD_ERROR("udlist_sharded_get: Parameter error\n");
+        return NULL;
+    } /* end of if (NULL == sh || NULL == key) */
+
+    return sh->shard[__shard_of(sh, key)];
+}
+
+
+
+/**
+ * @brief           插入数据到所在分片的尾部
+ * @param           分片链表的指针
+ * @param           数据的指针
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+int udlist_sharded_insert(udlist_sharded_t *sh, void *data)
+{
+    if (NULL == sh || NULL == data)
+    {
+        return PAR_ERROR;
+    } /* end of if (NULL == sh || NULL == data) */
+
+    return udlist_append(sh->shard[__shard_of(sh, data)], data);
+}
+
+
+
+/**
+ * @brief           根据关键字删除第一个匹配的数据
+ * @param           分片链表的指针
+ * @param           关键字
+ * @param           自定义比较函数
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+int udlist_sharded_delete_by_key(udlist_sharded_t *sh, void *key, cmp_t op_cmp)
+{
+    if (NULL == sh || NULL == key)
+    {
+        return PAR_ERROR;
+    } /* end of if (NULL == sh || NULL == key) */
+
+    return udlist_delete_by_key(sh->shard[__shard_of(sh, key)], key, op_cmp);
+}
+
+
+
+/**
+ * @brief           根据关键字修改第一个匹配的数据
+ * @param           分片链表的指针
+ * @param           修改数据
+ * @param           关键字
+ * @param           自定义比较函数
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+int udlist_sharded_modify_by_key(udlist_sharded_t *sh, void *data, void *key, cmp_t op_cmp)
+{
+    if (NULL == sh || NULL == key)
+    {
+        return PAR_ERROR;
+    } /* end of if (NULL == sh || NULL == key) */
+
+    return udlist_modify_by_key(sh->shard[__shard_of(sh, key)], data, key, op_cmp);
+}
+
+
+
+/**
+ * @brief           根据关键字获取第一个匹配的数据
+ * @param           分片链表的指针
+ * @param           输出数据的指针
+ * @param           关键字
+ * @param           自定义比较函数
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+int udlist_sharded_retrieve_by_key(udlist_sharded_t *sh, void *data, void *key, cmp_t op_cmp)
+{
+    if (NULL == sh || NULL == key)
+    {
+        return PAR_ERROR;
+    } /* end of if (NULL == sh || NULL == key) */
+
+    return udlist_retrieve_by_key(sh->shard[__shard_of(sh, key)], data, key, op_cmp);
+}
+
+
+
+/**
+ * @brief           根据关键字删除所有匹配的数据
+ * @param           分片链表的指针
+ * @param           关键字
+ * @param           自定义比较函数
+ * @return          删除的个数, 参数错误返回 PAR_ERROR
+ */
+int udlist_sharded_delete_all_by_key(udlist_sharded_t *sh, void *key, cmp_t op_cmp)
+{
+    if (NULL == sh || NULL == key)
+    {
+        return PAR_ERROR;
+    } /* end of if (NULL == sh || NULL == key) */
+
+    return udlist_delete_all_by_key(sh->shard[__shard_of(sh, key)], key, op_cmp);
+}
+
+
+
+/**
+ * @brief           根据关键字修改所有匹配的数据
+ * @param           分片链表的指针
+ * @param           修改数据
+ * @param           关键字
+ * @param           自定义比较函数
+ * @return          修改的个数, 参数错误返回 PAR_ERROR
+ */
+int udlist_sharded_modify_all_by_key(udlist_sharded_t *sh, void *data, void *key, cmp_t op_cmp)
+{
+    if (NULL == sh || NULL == key)
+    {
+        return PAR_ERROR;
+    } /* end of if (NULL == sh || NULL == key) */
+
+    return udlist_modify_all_by_key(sh->shard[__shard_of(sh, key)], data, key, op_cmp);
+}
+
+
+
+/**
+ * @brief           获取所有分片的元素总数
+ * @param           分片链表的指针
+ * @return          元素个数, 参数错误返回 PAR_ERROR
+ */
+int udlist_sharded_get_count(udlist_sharded_t *sh)
+{
+    int count = 0;
+    int i = 0;
+
+    if (NULL == sh)
+    {
+        return PAR_ERROR;
+    } /* end of if (NULL == sh) */
+
+    for (i = 0; i < sh->shards; i++)
+    {
+        count += get_count(sh->shard[i]);
+    } /* end of for (i = 0; i < sh->shards; i++) */
+
+    return count;
+}
+
+
+
+/**
+ * @brief           遍历线程: 依次领取分片并遍历
+ * @param           并行遍历参数
+ * @return          NULL
+ */
+static void *__shard_walk(void *arg)
+{
+    udshard_walk_t *w = (udshard_walk_t *)arg;
+    int i = 0;
+
+    while ((i = __atomic_fetch_add(&w->next, 1, __ATOMIC_RELAXED)) < w->sh->shards)
+    {
+        if (0 != udlist_traverse(w->sh->shard[i], w->my_print))
+        {
+            __atomic_store_n(&w->ret, FUN_ERROR, __ATOMIC_RELAXED);
+        } /* end of if (0 != udlist_traverse(w->sh->shard[i], w->my_print)) */
+    } /* end of while ((i = __atomic_fetch_add(&w->next, 1, __ATOMIC_RELAXED)) < w->sh->shards) */
+
+    return NULL;
+}
+
+
+
+/**
+ * @brief           遍历所有分片
+ * @param           分片链表的指针
+ * @param           自定义打印数据函数
+ * @param           遍历线程数(小于等于 1 时在调用线程中依次遍历)
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+int udlist_sharded_traverse(udlist_sharded_t *sh, op_t my_print, int threads)
+{
+    udshard_walk_t w;
+    pthread_t *tid = NULL;
+    int started = 0;
+    int i = 0;
+
+    /* 参数检查 */
+    if (NULL == sh || NULL == my_print)
+    {
+        UD_ERROR("udlist_sharded_traverse: Parameter error\n");
+        goto ERR0;
+    } /* end of if (NULL == sh || NULL == my_print) */
+
+    w.sh = sh;
+    w.my_print = my_print;
+    w.next = 0;
+    w.ret = 0;
+
+    /* 线程数不超过分片数, 调用线程也参与遍历 */
+    threads = (threads > sh->shards) ? sh->shards : threads;
+    if (threads > 1)
+    {
+        tid = (pthread_t *)malloc((threads - 1) * sizeof(pthread_t));
+    } /* end of if (threads > 1) */
+    for (i = 0; NULL != tid && i < threads - 1; i++)
+    {
+        if (0 != pthread_create(&tid[i], NULL, __shard_walk, &w))
+        {
+            break;
+        } /* end of if (0 != pthread_create(&tid[i], NULL, __shard_walk, &w)) */
+        started++;
+    } /* end of for (i = 0; NULL != tid && i < threads - 1; i++) */
+
+    // 线程创建失败时剩余分片由调用线程遍历
+    __shard_walk(&w);
+
+    for (i = 0; i < started; i++)
+    {
+        pthread_join(tid[i], NULL);
+    } /* end of for (i = 0; i < started; i++) */
+    free(tid);
+
+    return w.ret;
+
+ERR0:
+    return PAR_ERROR;
+}
+
+
+
+/**
+ * @brief           销毁所有分片中的数据(不包括分片链表本身)
+ * @param           分片链表的指针
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ */
+int udlist_sharded_destroy(udlist_sharded_t *sh)
+{
+    int i = 0;
+
+    if (NULL == sh)
+    {
+        return PAR_ERROR;
+    } /* end of if (NULL == sh) */
+
+    for (i = 0; i < sh->shards; i++)
+    {
+        udlist_destroy(sh->shard[i]);
+    } /* end of for (i = 0; i < sh->shards; i++) */
+
+    return 0;
+}
+
+
+
+/**
+ * @brief           销毁分片链表本身
+ * @details         未销毁的数据随分片内存池一起释放, 不调用 my_destroy
+ * @param           分片链表的指针的地址
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ */
+int udlist_sharded_head_destroy(udlist_sharded_t **p)
+{
+    int i = 0;
+
+    if (NULL == p)
+    {
+        return PAR_ERROR;
+    } /* end of if (NULL == p) */
+
+    if (NULL != *p)
+    {
+        for (i = 0; i < (*p)->shards; i++)
+        {
+            if (NULL != (*p)->shard[i])
+            {
+                head_destroy(&(*p)->shard[i]);
+            } /* end of if (NULL != (*p)->shard[i]) */
+        } /* end of for (i = 0; i < (*p)->shards; i++) */
+        free((*p)->shard);
+    } /* end of if (NULL != *p) */
+
+    free(*p);
+    *p = NULL;
+
+    return 0;
+}
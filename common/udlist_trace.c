@@ -0,0 +1,339 @@
+/**
+ * @file                udlist_trace.c
+ * @brief               链表追踪
+ * @details             环形缓冲区为全局数组, 写者原子递增写入序号占用槽位, 每个槽位带序号:
+                        写入期间序号为 0, 写完后为写入序号加 1, 读者前后两次读到相同的序号才认为事件完整
+ * @author              BHR
+ * @version             v1.0
+ * @date                2024-03-07
+ * @copyright           MIT
+ */
+
+#include <string.h>
+#include <time.h>
+#include "udlist_trace.h"
+
+#ifdef UDLIST_TRACE
+/**
+ * @brief 环形缓冲区
+ */
+static udtrace_ev_t s_ring[UDTRACE_CAP];
+static unsigned long long s_head = 0;       // 下一个写入序号
+static int s_on = 1;                        // 是否记录
+static unsigned int s_next_tid = 0;         // 已分配的线程编号
+static __thread unsigned int s_tid = 0;     // 本线程编号
+
+
+/**
+ * @brief           获取单调时钟(纳秒)
+ * @return          纳秒
+ */
+static unsigned long long __trace_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ull + (unsigned long long)ts.tv_nsec;
+}
+
+
+/**
+ * @brief           读取一个事件
+ * @param           写入序号
+ * @param           输出事件
+ * @return          1: 事件完整, 0: 未写入、正在写入或已被覆盖
+ */
+static int __trace_read(unsigned long long idx, udtrace_ev_t *out)
+{
+    udtrace_ev_t *ev = &s_ring[idx & (UDTRACE_CAP - 1)];
+    unsigned long long seq = __atomic_load_n(&ev->seq, __ATOMIC_ACQUIRE);
+
+    if (seq != idx + 1)
+    {
+        return 0;
+    } /* end of if (seq != idx + 1) */
+
+    out->seq = seq;
+    out->ts = __atomic_load_n(&ev->ts, __ATOMIC_RELAXED);
+    out->name = __atomic_load_n(&ev->name, __ATOMIC_RELAXED);
+    out->obj = __atomic_load_n(&ev->obj, __ATOMIC_RELAXED);
+    out->arg = __atomic_load_n(&ev->arg, __ATOMIC_RELAXED);
+    out->tid = __atomic_load_n(&ev->tid, __ATOMIC_RELAXED);
+    out->type = __atomic_load_n(&ev->type, __ATOMIC_RELAXED);
+
+    /* 读取期间被覆盖则丢弃 */
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return __atomic_load_n(&ev->seq, __ATOMIC_RELAXED) == seq;
+}
+
+
+/**
+ * @brief           事件名长度(去掉错误信息末尾的换行)
+ * @param           事件名
+ * @return          长度
+ */
+static int __trace_name_len(const char *name)
+{
+    int len = (int)strlen(name);
+
+    while (len > 0 && '\n' == name[len - 1])
+    {
+        len--;
+    } /* end of while (len > 0 && '\n' == name[len - 1]) */
+
+    return len;
+}
+
+
+/**
+ * @brief           按 JSON 字符串输出事件名
+ * @param           输出文件
+ * @param           事件名
+ */
+static void __trace_json_name(FILE *fp, const char *name)
+{
+    int len = __trace_name_len(name);
+    int i = 0;
+
+    fputc('"', fp);
+    for (i = 0; i < len; i++)
+    {
+        if ('"' == name[i] || '\\' == name[i])
+        {
+            fputc('\\', fp);
+            fputc(name[i], fp);
+        }
+        else if ((unsigned char)name[i] >= 0x20)
+        {
+            fputc(name[i], fp);
+        } /* end of if ('"' == name[i] || '\\' == name[i]) */
+    } /* end of for (i = 0; i < len; i++) */
+    fputc('"', fp);
+}
+
+
+/**
+ * @brief           缓冲区中最早的写入序号
+ * @param           当前写入序号
+ * @return          最早的写入序号
+ */
+static unsigned long long __trace_first(unsigned long long head)
+{
+    return (head > UDTRACE_CAP) ? head - UDTRACE_CAP : 0;
+}
+#endif /* UDLIST_TRACE */
+
+
+
+/**
+ * @brief           开始或暂停记录
+ * @details         定义 UDLIST_TRACE 时默认开始记录
+ * @param           非 0 开始, 0 暂停
+ * @return
+ *      @arg  0:正常
+ *      @arg  FUN_ERROR:函数错误(未定义 UDLIST_TRACE)
+ */
+int udlist_trace_enable(int on)
+{
+#ifdef UDLIST_TRACE
+    __atomic_store_n(&s_on, (0 != on), __ATOMIC_RELAXED);
+    return 0;
+#else
+    (void)on;
+    return FUN_ERROR;
+#endif
+}
+
+
+/**
+ * @brief           清空环形缓冲区
+ * @details         不能与记录同时进行(先暂停记录)
+ * @return
+ *      @arg  0:正常
+ *      @arg  FUN_ERROR:函数错误(未定义 UDLIST_TRACE)
+ */
+int udlist_trace_clear(void)
+{
+#ifdef UDLIST_TRACE
+    int i = 0;
+
+    for (i = 0; i < UDTRACE_CAP; i++)
+    {
+        __atomic_store_n(&s_ring[i].seq, 0, __ATOMIC_RELAXED);
+    } /* end of for (i = 0; i < UDTRACE_CAP; i++) */
+    __atomic_store_n(&s_head, 0, __ATOMIC_RELEASE);
+
+    return 0;
+#else
+    return FUN_ERROR;
+#endif
+}
+
+
+/**
+ * @brief           按文本输出缓冲区中的事件
+ * @details         每个事件一行: 时间戳(纳秒) 线程编号 类型 事件名 链表指针 参数;
+ *                  可以与记录同时进行, 输出期间被覆盖的事件跳过
+ * @param           输出文件(如 stdout)
+ * @return          输出的事件个数, 参数错误返回 PAR_ERROR, 未定义 UDLIST_TRACE 返回 FUN_ERROR
+ */
+int udlist_trace_dump(FILE *fp)
+{
+    /* 参数检查 */
+    if (NULL == fp)
+    {
+        UD_ERROR("udlist_trace_dump: Parameter error\n");
+        return PAR_ERROR;
+    } /* end of if (NULL == fp) */
+
+#ifdef UDLIST_TRACE
+    static const char *type_name[] = {"?", "enter", "exit", "walk", "alloc_fail", "error"};
+    unsigned long long head = __atomic_load_n(&s_head, __ATOMIC_ACQUIRE);
+    unsigned long long idx = 0;
+    udtrace_ev_t ev;
+    int n = 0;
+
+    for (idx = __trace_first(head); idx < head; idx++)
+    {
+        if (!__trace_read(idx, &ev))
+        {
+            continue;
+        } /* end of if (!__trace_read(idx, &ev)) */
+
+        fprintf(fp, "%llu %u %-10s %.*s %p %lld\n", ev.ts, ev.tid, type_name[ev.type],
+                __trace_name_len(ev.name), ev.name, ev.obj, ev.arg);
+        n++;
+    } /* end of for (idx = __trace_first(head); idx < head; idx++) */
+
+    return n;
+#else
+    fprintf(fp, "udlist trace: disabled (compile with -DUDLIST_TRACE)\n");
+    return FUN_ERROR;
+#endif
+}
+
+
+/**
+ * @brief           输出为 Chrome trace JSON
+ * @details         进入/退出为 B/E 事件, 访问节点数为计数(C)事件, 错误为即时(i)事件
+ * @param           文件路径
+ * @return          输出的事件个数, 参数错误返回 PAR_ERROR, 打开文件失败或未定义 UDLIST_TRACE 返回 FUN_ERROR
+ */
+int udlist_trace_export_chrome(const char *path)
+{
+    /* 参数检查 */
+    if (NULL == path)
+    {
+        UD_ERROR("udlist_trace_export_chrome: Parameter error\n");
+        return PAR_ERROR;
+    } /* end of if (NULL == path) */
+
+#ifdef UDLIST_TRACE
+    unsigned long long head = __atomic_load_n(&s_head, __ATOMIC_ACQUIRE);
+    unsigned long long t0 = 0;
+    unsigned long long idx = 0;
+    udtrace_ev_t ev;
+    FILE *fp = NULL;
+    int n = 0;
+
+    fp = fopen(path, "w");
+    if (NULL == fp)
+    {
+        UD_ERROR("udlist_trace_export_chrome: fopen %s error\n", path);
+        return FUN_ERROR;
+    } /* end of if (NULL == fp) */
+
+    fprintf(fp, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+    for (idx = __trace_first(head); idx < head; idx++)
+    {
+        if (!__trace_read(idx, &ev))
+        {
+            continue;
+        } /* end of if (!__trace_read(idx, &ev)) */
+
+        // 时间戳以第一个事件为 0 点, 单位微秒
+        if (0 == n)
+        {
+            t0 = ev.ts;
+        } /* end of if (0 == n) */
+
+        fprintf(fp, "%s\n{\"name\":", (0 == n) ? "" : ",");
+        __trace_json_name(fp, ev.name);
+        fprintf(fp, ",\"pid\":1,\"tid\":%u,\"ts\":%.3f", ev.tid, (double)(ev.ts - t0) / 1e3);
+        switch (ev.type)
+        {
+            case UDTRACE_ENTER:
+                fprintf(fp, ",\"ph\":\"B\",\"args\":{\"list\":\"%p\"}}", ev.obj);
+                break;
+            case UDTRACE_EXIT:
+                fprintf(fp, ",\"ph\":\"E\"}");
+                break;
+            case UDTRACE_WALK:
+                fprintf(fp, ",\"ph\":\"C\",\"args\":{\"nodes\":%lld}}", ev.arg);
+                break;
+            default:
+                fprintf(fp, ",\"ph\":\"i\",\"s\":\"t\",\"cat\":\"%s\"}",
+                        (UDTRACE_ALLOC_FAIL == ev.type) ? "alloc_fail" : "error");
+                break;
+        } /* end of switch (ev.type) */
+        n++;
+    } /* end of for (idx = __trace_first(head); idx < head; idx++) */
+    fprintf(fp, "\n]}\n");
+
+    if (0 != fclose(fp))
+    {
+        return FUN_ERROR;
+    } /* end of if (0 != fclose(fp)) */
+
+    return n;
+#else
+    return FUN_ERROR;
+#endif
+}
+
+
+/**
+ * @brief           记录一个事件(无锁, 可以被多个线程同时调用)
+ * @param           事件类型 UDTRACE_*
+ * @param           事件名(静态字符串)
+ * @param           链表头信息结构体的指针(可以为 NULL)
+ * @param           参数
+ */
+void udtrace_emit(int type, const char *name, const void *obj, long long arg)
+{
+#ifdef UDLIST_TRACE
+    unsigned long long idx = 0;
+    udtrace_ev_t *ev = NULL;
+
+    if (!__atomic_load_n(&s_on, __ATOMIC_RELAXED))
+    {
+        return;
+    } /* end of if (!__atomic_load_n(&s_on, __ATOMIC_RELAXED)) */
+    if (0 == s_tid)
+    {
+        s_tid = __atomic_add_fetch(&s_next_tid, 1, __ATOMIC_RELAXED);
+    } /* end of if (0 == s_tid) */
+
+    /* 1.占用槽位, 标记为写入中 */
+    idx = __atomic_fetch_add(&s_head, 1, __ATOMIC_RELAXED);
+    ev = &s_ring[idx & (UDTRACE_CAP - 1)];
+    __atomic_store_n(&ev->seq, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    /* 2.写入事件 */
+    __atomic_store_n(&ev->ts, __trace_now(), __ATOMIC_RELAXED);
+    __atomic_store_n(&ev->name, name, __ATOMIC_RELAXED);
+    __atomic_store_n(&ev->obj, obj, __ATOMIC_RELAXED);
+    __atomic_store_n(&ev->arg, arg, __ATOMIC_RELAXED);
+    __atomic_store_n(&ev->tid, s_tid, __ATOMIC_RELAXED);
+    __atomic_store_n(&ev->type, type, __ATOMIC_RELAXED);
+
+    /* 3.发布 */
+    __atomic_store_n(&ev->seq, idx + 1, __ATOMIC_RELEASE);
+#else
+    (void)type;
+    (void)name;
+    (void)obj;
+    (void)arg;
+#endif
+}
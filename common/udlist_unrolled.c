@@ -0,0 +1,877 @@
+/**
+ * @file                udlist_unrolled.c
+ * @brief               展开链表存储(UDLIST_UNROLLED 模式)
+ * @author              BHR
+ * @version             v1.0
+ * @date                2024-03-07
+ * @copyright           MIT
+ */
+
+#include "udlist_unrolled.h"
+#include "udlist_stats.h"
+#include "udlist_trace.h"
+
+
+/**
+ * @brief           创建元素块节点
+ * @param           头信息结构体的指针
+ * @return          节点指针, 失败返回 NULL
+ */
+static node_t *__ur_block_new(udlist_t *ud)
+{
+    node_t *p = NULL;
+
+    p = (node_t *)calloc(1, sizeof(node_t) + sizeof(udblock_t)
+                            + (size_t)ud->unroll_k * ud->size);
+    if (NULL == p)
+    {
+        UD_ALLOC_ERROR("__ur_block_new: calloc error\n");
+        return NULL;
+    } /* end of if (NULL == p) */
+
+    p->data = p->payload;
+    UD_STAT_ADD(ud, allocs, 1);
+
+    return p;
+}
+
+
+
+/**
+ * @brief           将元素块节点链接到 pos 之后
+ * @param           头信息结构体的指针
+ * @param           位置节点, NULL 表示链表为空
+ * @param           元素块节点
+ */
+static void __ur_link_after(udlist_t *ud, node_t *pos, node_t *p)
+{
+    if (NULL == pos)
+    {
+        p->prev = p;
+        p->next = p;
+        ud->fstnode_p = p;
+        return;
+    } /* end of if (NULL == pos) */
+
+    p->prev = pos;
+    p->next = pos->next;
+    pos->next->prev = p;
+    pos->next = p;
+}
+
+
+
+/**
+ * @brief           摘下并释放元素块节点(不处理其中的元素)
+ * @param           头信息结构体的指针
+ * @param           元素块节点
+ */
+static void __ur_block_free(udlist_t *ud, node_t *p)
+{
+    if (p == p->next)
+    {
+        ud->fstnode_p = NULL;
+    }
+    else
+    {
+        p->prev->next = p->next;
+        p->next->prev = p->prev;
+        if (ud->fstnode_p == p)
+        {
+            ud->fstnode_p = p->next;
+        } /* end of if (ud->fstnode_p == p) */
+    }
+
+    free(p);
+    UD_STAT_ADD(ud, frees, 1);
+}
+
+
+
+/**
+ * @brief           定位索引所在的元素块
+ * @details         从距离较近的一端按块跳跃; index == count 时返回尾部块及其已用个数
+ * @param           头信息结构体的指针
+ * @param           索引值(0 <= index <= count, 链表非空)
+ * @param           输出块内偏移
+ * @return          元素块节点
+ */
+static node_t *__ur_locate(udlist_t *ud, int index, int *off)
+{
+    node_t *p = ud->fstnode_p;
+    int hops = 0;
+
+    if (index <= ud->count / 2)
+    {
+        /* 从头部向后 */
+        while (index >= UD_BLOCK(p)->used && p->next != ud->fstnode_p)
+        {
+            index -= UD_BLOCK(p)->used;
+            p = p->next;
+            hops++;
+        } /* end of while (index >= UD_BLOCK(p)->used && ...) */
+    }
+    else
+    {
+        /* 从尾部向前, index 换算为位置及其之后的元素个数 */
+        index = ud->count - index;
+        p = p->prev;
+        while (index > UD_BLOCK(p)->used && p != ud->fstnode_p)
+        {
+            index -= UD_BLOCK(p)->used;
+            p = p->prev;
+            hops++;
+        } /* end of while (index > UD_BLOCK(p)->used && ...) */
+        index = UD_BLOCK(p)->used - index;
+    }
+
+    *off = index;
+    UD_STAT_ADD(ud, visits, hops);
+    UD_TRACE_WALK(ud, hops);
+
+    return p;
+}
+
+
+
+/**
+ * @brief           元素减少后释放空块, 或与相邻块合并
+ * @details         相邻两块元素总数不超过一半容量时合并, 避免反复分裂合并
+ * @param           头信息结构体的指针
+ * @param           元素块节点
+ */
+static void __ur_rebalance(udlist_t *ud, node_t *p)
+{
+    udblock_t *b = UD_BLOCK(p);
+    udblock_t *nb = NULL;
+
+    if (0 == b->used)
+    {
+        __ur_block_free(ud, p);
+        return;
+    } /* end of if (0 == b->used) */
+
+    /* 优先把后继块并入本块, 否则把本块并入前驱块 */
+    if (p->next != ud->fstnode_p
+        && b->used + UD_BLOCK(p->next)->used <= ud->unroll_k / 2)
+    {
+        nb = UD_BLOCK(p->next);
+        memcpy(UD_ELEM(ud, b, b->used), nb->elem, (size_t)nb->used * ud->size);
+        b->used += nb->used;
+        __ur_block_free(ud, p->next);
+    }
+    else if (p != ud->fstnode_p
+             && b->used + UD_BLOCK(p->prev)->used <= ud->unroll_k / 2)
+    {
+        nb = UD_BLOCK(p->prev);
+        memcpy(UD_ELEM(ud, nb, nb->used), b->elem, (size_t)b->used * ud->size);
+        nb->used += b->used;
+        __ur_block_free(ud, p);
+    }
+}
+
+
+
+/**
+ * @brief           计算默认的每节点元素个数
+ * @details         使节点(节点头 + 块头 + 元素数组)约为 UDUR_NODE_BYTES 字节, 至少 4 个
+ * @param           元素大小
+ * @return          每节点元素个数
+ */
+int udur_default_k(int size)
+{
+    int k = (int)((UDUR_NODE_BYTES - sizeof(node_t) - sizeof(udblock_t)) / size);
+
+    return (k < 4) ? 4 : k;
+}
+
+
+
+/**
+ * @brief           在索引处插入元素, 索引大于元素个数时尾部插入
+ * @details         块满时: 插入在块尾/块首则新建相邻块, 否则对半分裂
+ * @param           头信息结构体的指针
+ * @param           数据的指针, NULL 表示只预留位置不写入数据
+ * @param           索引值
+ * @return
+ *      @arg  0:正常
+ *      @arg  FUN_ERROR:函数错误
+ */
+int udur_insert(udlist_t *ud, void *data, int index)
+{
+    node_t *p = NULL;
+    node_t *q = NULL;
+    udblock_t *b = NULL;
+    udblock_t *qb = NULL;
+    int off = 0;
+    int half = 0;
+
+    if (index > ud->count)
+    {
+        index = ud->count;
+    } /* end of if (index > ud->count) */
+
+    /* 1.定位元素块, 空链表先创建第一个块 */
+    if (NULL == ud->fstnode_p)
+    {
+        p = __ur_block_new(ud);
+        if (NULL == p)
+        {
+            goto ERR1;
+        } /* end of if (NULL == p) */
+        __ur_link_after(ud, NULL, p);
+        off = 0;
+    }
+    else
+    {
+        p = __ur_locate(ud, index, &off);
+    }
+    b = UD_BLOCK(p);
+
+    /* 2.块已满 */
+    if (b->used == ud->unroll_k)
+    {
+        q = __ur_block_new(ud);
+        if (NULL == q)
+        {
+            goto ERR1;
+        } /* end of if (NULL == q) */
+        qb = UD_BLOCK(q);
+
+        if (off == b->used)
+        {
+            // 块尾插入: 新块链接在之后
+            __ur_link_after(ud, p, q);
+            p = q;
+            off = 0;
+        }
+        else if (0 == off)
+        {
+            // 块首插入: 新块链接在之前
+            __ur_link_after(ud, p->prev, q);
+            if (ud->fstnode_p == p)
+            {
+                ud->fstnode_p = q;
+            } /* end of if (ud->fstnode_p == p) */
+            p = q;
+        }
+        else
+        {
+            // 对半分裂, 后一半移入新块
+            half = b->used / 2;
+            memcpy(qb->elem, UD_ELEM(ud, b, half), (size_t)(b->used - half) * ud->size);
+            qb->used = b->used - half;
+            b->used = half;
+            __ur_link_after(ud, p, q);
+            if (off > half)
+            {
+                p = q;
+                off -= half;
+            } /* end of if (off > half) */
+        }
+        b = UD_BLOCK(p);
+    } /* end of if (b->used == ud->unroll_k) */
+
+    /* 3.块内移动并写入 */
+    memmove(UD_ELEM(ud, b, off + 1), UD_ELEM(ud, b, off), (size_t)(b->used - off) * ud->size);
+    if (NULL != data)
+    {
+        memcpy(UD_ELEM(ud, b, off), data, ud->size);
+    } /* end of if (NULL != data) */
+    b->used++;
+    ud->count++;
+    ud->mods++;
+
+    return 0;
+
+ERR1:
+    return FUN_ERROR;
+}
+
+
+
+/**
+ * @brief           在头部或尾部批量插入元素
+ * @details         尾部插入先填满尾部块; 其余元素整块拷贝到新块, 在本地串成链后一次接入;
+ *                  申请失败时链表不变
+ * @param           头信息结构体的指针
+ * @param           元素数组
+ * @param           元素个数
+ * @param           0 尾部插入, 1 头部插入
+ * @return
+ *      @arg  0:正常
+ *      @arg  FUN_ERROR:函数错误
+ */
+int udur_insert_n(udlist_t *ud, const void *array, size_t n, int front)
+{
+    const unsigned char *src = (const unsigned char *)array;
+    node_t *first = NULL;
+    node_t *last = NULL;
+    node_t *tail = NULL;
+    node_t *p = NULL;
+    udblock_t *b = NULL;
+    size_t room = 0;
+    size_t take = 0;
+    size_t i = 0;
+
+    /* 1.尾部插入时尾部块的剩余空间 */
+    if (!front && NULL != ud->fstnode_p)
+    {
+        tail = ud->fstnode_p->prev;
+        room = (size_t)(ud->unroll_k - UD_BLOCK(tail)->used);
+        if (room > n)
+        {
+            room = n;
+        } /* end of if (room > n) */
+    } /* end of if (!front && NULL != ud->fstnode_p) */
+
+    /* 2.其余元素放入新块并在本地串成链 */
+    for (i = room; i < n; i += take)
+    {
+        p = __ur_block_new(ud);
+        if (NULL == p)
+        {
+            goto ERR1;
+        } /* end of if (NULL == p) */
+
+        take = n - i;
+        if (take > (size_t)ud->unroll_k)
+        {
+            take = (size_t)ud->unroll_k;
+        } /* end of if (take > (size_t)ud->unroll_k) */
+        b = UD_BLOCK(p);
+        memcpy(b->elem, src + i * ud->size, take * ud->size);
+        b->used = (int)take;
+
+        if (NULL == first)
+        {
+            first = p;
+        }
+        else
+        {
+            last->next = p;
+            p->prev = last;
+        }
+        last = p;
+    } /* end of for (i = room; i < n; i += take) */
+
+    /* 3.填充尾部块 */
+    if (0 != room)
+    {
+        b = UD_BLOCK(tail);
+        memcpy(UD_ELEM(ud, b, b->used), src, room * ud->size);
+        b->used += (int)room;
+    } /* end of if (0 != room) */
+
+    /* 4.新块整链接入 */
+    if (NULL != first)
+    {
+        if (NULL == ud->fstnode_p)
+        {
+            first->prev = last;
+            last->next = first;
+            ud->fstnode_p = first;
+        }
+        else
+        {
+            first->prev = ud->fstnode_p->prev;
+            last->next = ud->fstnode_p;
+            ud->fstnode_p->prev->next = first;
+            ud->fstnode_p->prev = last;
+            if (front)
+            {
+                ud->fstnode_p = first;
+            } /* end of if (front) */
+        }
+    } /* end of if (NULL != first) */
+
+    ud->count += (int)n;
+    ud->mods++;
+
+    return 0;
+
+ERR1:
+    while (NULL != first)
+    {
+        p = (first == last) ? NULL : first->next;
+        free(first);
+        UD_STAT_ADD(ud, frees, 1);
+        first = p;
+    } /* end of while (NULL != first) */
+    return FUN_ERROR;
+}
+
+
+
+/**
+ * @brief           删除块内指定位置的元素
+ * @param           头信息结构体的指针
+ * @param           元素块节点
+ * @param           块内偏移
+ * @param           输出数据的指针, NULL 表示丢弃(调用 my_destroy)
+ */
+static void __ur_remove(udlist_t *ud, node_t *p, int off, void *data)
+{
+    udblock_t *b = UD_BLOCK(p);
+
+    /* 拷出数据或清理数据引用的资源 */
+    if (NULL != data)
+    {
+        memcpy(data, UD_ELEM(ud, b, off), ud->size);
+    }
+    else if (NULL != ud->my_destroy)
+    {
+        ud->my_destroy(UD_ELEM(ud, b, off));
+    }
+
+    /* 块内前移 */
+    memmove(UD_ELEM(ud, b, off), UD_ELEM(ud, b, off + 1), (size_t)(b->used - off - 1) * ud->size);
+    b->used--;
+    ud->count--;
+    ud->mods++;
+
+    __ur_rebalance(ud, p);
+}
+
+
+
+/**
+ * @brief           删除索引处的元素
+ * @param           头信息结构体的指针
+ * @param           索引值(0 <= index < count)
+ * @param           输出数据的指针, NULL 表示丢弃(调用 my_destroy)
+ */
+void udur_delete(udlist_t *ud, int index, void *data)
+{
+    node_t *p = NULL;
+    int off = 0;
+
+    p = __ur_locate(ud, index, &off);
+    __ur_remove(ud, p, off, data);
+}
+
+
+
+/**
+ * @brief           删除块内指定位置的元素并定位其后继元素
+ * @details         合并只会释放本块或后继块, 前驱块保留, 从前驱块(或头部)向后最多跨两块即可重新定位
+ * @param           头信息结构体的指针
+ * @param           元素块节点
+ * @param           块内偏移, 输出后继元素的块内偏移
+ * @param           被删除元素的索引
+ * @return          后继元素所在的块节点, 没有后继元素返回 NULL
+ */
+node_t *udur_erase(udlist_t *ud, node_t *p, int *off, int index)
+{
+    node_t *start = NULL;
+    int base = 0;
+
+    /* 1.记下前驱块及其第一个元素的索引 */
+    base = index - *off;
+    if (p != ud->fstnode_p)
+    {
+        start = p->prev;
+        base -= UD_BLOCK(start)->used;
+    } /* end of if (p != ud->fstnode_p) */
+
+    /* 2.删除并合并 */
+    __ur_remove(ud, p, *off, NULL);
+    if (index >= ud->count)
+    {
+        return NULL;
+    } /* end of if (index >= ud->count) */
+
+    /* 3.重新定位: 后继元素的索引仍为 index */
+    p = (NULL == start) ? ud->fstnode_p : start;
+    index -= base;
+    while (index >= UD_BLOCK(p)->used)
+    {
+        index -= UD_BLOCK(p)->used;
+        p = p->next;
+    } /* end of while (index >= UD_BLOCK(p)->used) */
+    *off = index;
+
+    return p;
+}
+
+
+
+/**
+ * @brief           定位索引所在的元素块
+ * @param           头信息结构体的指针
+ * @param           索引值(0 <= index < count)
+ * @param           输出块内偏移
+ * @return          元素块节点
+ */
+node_t *udur_locate(udlist_t *ud, int index, int *off)
+{
+    return __ur_locate(ud, index, off);
+}
+
+
+
+/**
+ * @brief           获取索引处元素的地址
+ * @param           头信息结构体的指针
+ * @param           索引值(0 <= index < count)
+ * @return          元素地址
+ */
+void *udur_at(udlist_t *ud, int index)
+{
+    node_t *p = NULL;
+    int off = 0;
+
+    p = __ur_locate(ud, index, &off);
+
+    return UD_ELEM(ud, UD_BLOCK(p), off);
+}
+
+
+
+/**
+ * @brief           寻找第一个匹配关键字的元素
+ * @param           头信息结构体的指针
+ * @param           关键字
+ * @param           自定义比较函数
+ * @param           输出匹配元素的索引(可以为 NULL)
+ * @return          元素地址, 无匹配返回 NULL
+ */
+void *udur_find(udlist_t *ud, void *key, cmp_t op_cmp, int *index)
+{
+    node_t *p = ud->fstnode_p;
+    udblock_t *b = NULL;
+    int base = 0;
+    int i = 0;
+
+    if (NULL == p)
+    {
+        return NULL;
+    } /* end of if (NULL == p) */
+
+    do
+    {
+        b = UD_BLOCK(p);
+        for (i = 0; i < b->used; i++)
+        {
+            if (MATCH_SUCCESS == op_cmp(UD_ELEM(ud, b, i), key))
+            {
+                if (NULL != index)
+                {
+                    *index = base + i;
+                } /* end of if (NULL != index) */
+                UD_STAT_ADD(ud, visits, base + i + 1);
+                UD_TRACE_WALK(ud, base + i + 1);
+                UD_STAT_ADD(ud, cmps, base + i + 1);
+                return UD_ELEM(ud, b, i);
+            } /* end of if (MATCH_SUCCESS == op_cmp(UD_ELEM(ud, b, i), key)) */
+        } /* end of for (i = 0; i < b->used; i++) */
+
+        base += b->used;
+        p = p->next;
+    }
+    while (p != ud->fstnode_p);
+    UD_STAT_ADD(ud, visits, base);
+    UD_TRACE_WALK(ud, base);
+    UD_STAT_ADD(ud, cmps, base);
+
+    return NULL;
+}
+
+
+
+/**
+ * @brief           单次遍历删除或覆盖所有匹配的元素
+ * @details         读写两个游标顺序压缩, 保留的元素前移填满前面的块, 最后释放多余的块
+ * @param           头信息结构体的指针
+ * @param           关键字(或谓词上下文)
+ * @param           自定义比较函数(或谓词)
+ * @param           覆盖的数据, NULL 表示删除
+ * @return          命中的元素个数
+ */
+int udur_sweep(udlist_t *ud, void *key, cmp_t op_cmp, void *data)
+{
+    node_t *p = ud->fstnode_p;
+    node_t *wp = ud->fstnode_p;
+    node_t *tail = NULL;
+    node_t *save = NULL;
+    udblock_t *b = NULL;
+    unsigned char *e = NULL;
+    unsigned char *dst = NULL;
+    int hit = 0;
+    int kept = 0;
+    int w = 0;
+    int n = 0;
+    int r = 0;
+
+    if (NULL == p)
+    {
+        return 0;
+    } /* end of if (NULL == p) */
+
+    /* 1.顺序压缩, 写游标 (wp, w) 永远不超过读游标 */
+    tail = p->prev;
+    while (1)
+    {
+        b = UD_BLOCK(p);
+        n = b->used;
+        for (r = 0; r < n; r++)
+        {
+            e = UD_ELEM(ud, b, r);
+            if (MATCH_SUCCESS == op_cmp(e, key))
+            {
+                hit++;
+                if (NULL == data)
+                {
+                    if (NULL != ud->my_destroy)
+                    {
+                        ud->my_destroy(e);
+                    } /* end of if (NULL != ud->my_destroy) */
+                    continue;
+                } /* end of if (NULL == data) */
+                memcpy(e, data, ud->size);
+            } /* end of if (MATCH_SUCCESS == op_cmp(e, key)) */
+
+            // 保留的元素写到写游标处
+            if (w == ud->unroll_k)
+            {
+                UD_BLOCK(wp)->used = w;
+                wp = wp->next;
+                w = 0;
+            } /* end of if (w == ud->unroll_k) */
+            dst = UD_ELEM(ud, UD_BLOCK(wp), w);
+            if (dst != e)
+            {
+                memcpy(dst, e, ud->size);
+            } /* end of if (dst != e) */
+            w++;
+            kept++;
+        } /* end of for (r = 0; r < n; r++) */
+
+        if (p == tail)
+        {
+            break;
+        } /* end of if (p == tail) */
+        p = p->next;
+    } /* end of while (1) */
+
+    /* 2.释放写游标之后的块 */
+    UD_BLOCK(wp)->used = w;
+    p = wp->next;
+    while (p != ud->fstnode_p)
+    {
+        save = p->next;
+        free(p);
+        UD_STAT_ADD(ud, frees, 1);
+        p = save;
+    } /* end of while (p != ud->fstnode_p) */
+    wp->next = ud->fstnode_p;
+    ud->fstnode_p->prev = wp;
+
+    if (0 == kept)
+    {
+        __ur_block_free(ud, wp);
+    } /* end of if (0 == kept) */
+
+    UD_STAT_ADD(ud, visits, ud->count);
+    UD_TRACE_WALK(ud, ud->count);
+    UD_STAT_ADD(ud, cmps, ud->count);
+    ud->count = kept;
+    ud->mods++;
+
+    return hit;
+}
+
+
+
+/**
+ * @brief           遍历所有元素
+ * @details         反向遍历与 udlist_traverse_back 一致: 先第一个元素, 再从尾部向前
+ * @param           头信息结构体的指针
+ * @param           自定义函数
+ * @param           0 正向, 1 反向
+ */
+void udur_traverse(udlist_t *ud, op_t my_op, int back)
+{
+    node_t *p = ud->fstnode_p;
+    udblock_t *b = NULL;
+    int i = 0;
+
+    if (NULL == p)
+    {
+        return;
+    } /* end of if (NULL == p) */
+
+    if (0 == back)
+    {
+        do
+        {
+            b = UD_BLOCK(p);
+            for (i = 0; i < b->used; i++)
+            {
+                my_op(UD_ELEM(ud, b, i));
+            } /* end of for (i = 0; i < b->used; i++) */
+            p = p->next;
+        }
+        while (p != ud->fstnode_p);
+
+        return;
+    } /* end of if (0 == back) */
+
+    /* 反向: 第一个元素, 然后尾部到第二个元素 */
+    my_op(UD_BLOCK(p)->elem);
+    do
+    {
+        p = p->prev;
+        b = UD_BLOCK(p);
+        for (i = b->used - 1; i >= (p == ud->fstnode_p ? 1 : 0); i--)
+        {
+            my_op(UD_ELEM(ud, b, i));
+        } /* end of for (i = b->used - 1; ...) */
+    }
+    while (p != ud->fstnode_p);
+}
+
+
+
+/**
+ * @brief           稳定排序所有元素
+ * @details         元素指针数组自底向上归并排序, 再按序拷贝回原有各块, 块结构不变;
+ *                  需要 2n 个指针及 n 个元素的临时空间
+ * @param           头信息结构体的指针(非空链表)
+ * @param           自定义排序比较函数
+ * @return
+ *      @arg  0:正常
+ *      @arg  FUN_ERROR:函数错误
+ */
+int udur_sort(udlist_t *ud, ord_t op_ord)
+{
+    unsigned char **base = NULL;
+    unsigned char **ptr = NULL;
+    unsigned char **tmp = NULL;
+    unsigned char **t = NULL;
+    unsigned char *buf = NULL;
+    node_t *p = ud->fstnode_p;
+    udblock_t *b = NULL;
+    size_t n = (size_t)ud->count;
+    size_t w = 0;
+    size_t lo = 0;
+    size_t mid = 0;
+    size_t hi = 0;
+    size_t i = 0;
+    size_t j = 0;
+    size_t k = 0;
+    int e = 0;
+
+    base = (unsigned char **)malloc(2 * n * sizeof(unsigned char *));
+    buf = (unsigned char *)malloc(n * ud->size);
+    if (NULL == base || NULL == buf)
+    {
+        free(base);
+        free(buf);
+        return FUN_ERROR;
+    } /* end of if (NULL == base || NULL == buf) */
+    ptr = base;
+    tmp = base + n;
+
+    /* 1.收集元素指针 */
+    do
+    {
+        b = UD_BLOCK(p);
+        for (e = 0; e < b->used; e++)
+        {
+            ptr[k++] = UD_ELEM(ud, b, e);
+        } /* end of for (e = 0; e < b->used; e++) */
+        p = p->next;
+    }
+    while (p != ud->fstnode_p);
+
+    /* 2.自底向上归并, 相等时先取前半段保证稳定 */
+    for (w = 1; w < n; w *= 2)
+    {
+        for (lo = 0; lo < n; lo += 2 * w)
+        {
+            mid = (lo + w < n) ? lo + w : n;
+            hi = (lo + 2 * w < n) ? lo + 2 * w : n;
+            i = lo;
+            j = mid;
+            k = lo;
+            while (i < mid && j < hi)
+            {
+                tmp[k++] = (op_ord(ptr[j], ptr[i]) < 0) ? ptr[j++] : ptr[i++];
+            } /* end of while (i < mid && j < hi) */
+            while (i < mid)
+            {
+                tmp[k++] = ptr[i++];
+            } /* end of while (i < mid) */
+            while (j < hi)
+            {
+                tmp[k++] = ptr[j++];
+            } /* end of while (j < hi) */
+        } /* end of for (lo = 0; lo < n; lo += 2 * w) */
+
+        t = ptr;
+        ptr = tmp;
+        tmp = t;
+    } /* end of for (w = 1; w < n; w *= 2) */
+
+    /* 3.按序拷出, 再依次写回各块 */
+    for (k = 0; k < n; k++)
+    {
+        memcpy(buf + k * ud->size, ptr[k], ud->size);
+    } /* end of for (k = 0; k < n; k++) */
+
+    k = 0;
+    p = ud->fstnode_p;
+    do
+    {
+        b = UD_BLOCK(p);
+        memcpy(UD_ELEM(ud, b, 0), buf + k * ud->size, (size_t)b->used * ud->size);
+        k += (size_t)b->used;
+        p = p->next;
+    }
+    while (p != ud->fstnode_p);
+
+    free(base);
+    free(buf);
+
+    return 0;
+}
+
+
+
+/**
+ * @brief           释放所有元素及节点
+ * @param           头信息结构体的指针
+ */
+void udur_destroy(udlist_t *ud)
+{
+    node_t *p = ud->fstnode_p;
+    node_t *save = NULL;
+    udblock_t *b = NULL;
+    int i = 0;
+
+    if (NULL == p)
+    {
+        return;
+    } /* end of if (NULL == p) */
+
+    do
+    {
+        save = p->next;
+        b = UD_BLOCK(p);
+        if (NULL != ud->my_destroy)
+        {
+            for (i = 0; i < b->used; i++)
+            {
+                ud->my_destroy(UD_ELEM(ud, b, i));
+            } /* end of for (i = 0; i < b->used; i++) */
+        } /* end of if (NULL != ud->my_destroy) */
+        free(p);
+        UD_STAT_ADD(ud, frees, 1);
+        p = save;
+    }
+    while (p != ud->fstnode_p);
+
+    ud->fstnode_p = NULL;
+    ud->count = 0;
+}
@@ -0,0 +1,923 @@
+/**
+ * @file                udlist_wal.c
+ * @brief               链表预写日志(WAL)
+ * @author              BHR
+ * @version             v1.0
+ * @date                2024-03-07
+ * @copyright           MIT
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stddef.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "udlist_wal.h"
+#include "udlist_snap.h"
+#include "udlist_lock.h"
+#include "udlist_trace.h"
+
+// 记录总长度按 8 字节对齐
+#define UDWAL_ALIGN(n) (((n) + 7) & ~(size_t)7)
+
+
+/**
+ * @brief           写出追加缓冲中的记录(调用者持有 wal->mutex, 写出期间释放)
+ * @details         追加缓冲与写出缓冲交换后释放互斥锁, 写出期间其他线程可以继续追加记录;
+ *                  同一时刻只有一个线程写出, 一次写出并同步之前所有线程追加的记录(组提交)
+ * @param           预写日志的指针
+ * @param           非 0 写出后同步到磁盘
+ * @return
+ *      @arg  0:正常
+ *      @arg  FUN_ERROR:函数错误
+ */
+static int __wal_write(udwal_t *wal, int sync)
+{
+    unsigned char *p = wal->buf;
+    size_t n = wal->used;
+    size_t cap = wal->cap;
+    uint64_t end = wal->lsn;
+    size_t off = 0;
+    ssize_t k = 0;
+    int fail = 0;
+
+    /* 1.交换缓冲 */
+    wal->writing = 1;
+    wal->buf = wal->spare;
+    wal->cap = wal->spare_cap;
+    wal->used = 0;
+    wal->spare = p;
+    wal->spare_cap = cap;
+    pthread_mutex_unlock(&wal->mutex);
+
+    /* 2.写出并同步 */
+    while (off < n)
+    {
+        k = write(wal->fd, p + off, n - off);
+        if (k < 0 && EINTR != errno)
+        {
+            fail = 1;
+            break;
+        } /* end of if (k < 0 && EINTR != errno) */
+        off += (k > 0) ? (size_t)k : 0;
+    } /* end of while (off < n) */
+    if (!fail && sync && 0 != fdatasync(wal->fd))
+    {
+        fail = 1;
+    } /* end of if (!fail && sync && 0 != fdatasync(wal->fd)) */
+
+    /* 3.更新进度并唤醒等待的提交者 */
+    pthread_mutex_lock(&wal->mutex);
+    if (fail)
+    {
+        UD_ERROR("udlist_wal: write log error\n");
+        wal->err = 1;
+    }
+    else
+    {
+        wal->written = end;
+        wal->synced = sync ? end : wal->synced;
+    }
+    wal->writing = 0;
+    pthread_cond_broadcast(&wal->cond);
+
+    return fail ? FUN_ERROR : 0;
+}
+
+
+/**
+ * @brief           后台同步线程(UDWAL_LAZY / UDWAL_FLUSH)
+ * @param           预写日志的指针
+ */
+static void *__wal_thread(void *arg)
+{
+    udwal_t *wal = (udwal_t *)arg;
+    struct timespec ts;
+
+    pthread_mutex_lock(&wal->mutex);
+    while (!wal->stop)
+    {
+        clock_gettime(CLOCK_REALTIME, &ts);
+        ts.tv_nsec += (long)(wal->interval % 1000) * 1000000L;
+        ts.tv_sec += wal->interval / 1000 + ts.tv_nsec / 1000000000L;
+        ts.tv_nsec %= 1000000000L;
+        pthread_cond_timedwait(&wal->kick, &wal->mutex, &ts);
+
+        if (!wal->writing && !wal->err && (wal->used > 0 || wal->written > wal->synced))
+        {
+            __wal_write(wal, 1);
+        } /* end of if (!wal->writing && !wal->err && ...) */
+    } /* end of while (!wal->stop) */
+    pthread_mutex_unlock(&wal->mutex);
+
+    return NULL;
+}
+
+
+/**
+ * @brief           清空日志文件并写入文件头(调用者持有 wal->mutex 且没有线程正在写出)
+ * @details         缓冲中未写出的记录一并丢弃, 它们已经包含在快照中
+ * @param           预写日志的指针
+ * @param           快照包含的最后一条记录序号
+ * @return
+ *      @arg  0:正常
+ *      @arg  FUN_ERROR:函数错误
+ */
+static int __wal_reset(udwal_t *wal, uint64_t base)
+{
+    udwal_head_t head;
+
+    memset(&head, 0, sizeof(head));
+    memcpy(head.magic, "UDLW", 4);
+    head.version = UDWAL_VERSION;
+    head.size = (uint32_t)wal->size;
+    head.base = base;
+
+    // 以追加方式打开, 清空后的写入从文件头开始
+    if (0 != ftruncate(wal->fd, 0) || write(wal->fd, &head, sizeof(head)) != (ssize_t)sizeof(head)
+        || 0 != fdatasync(wal->fd))
+    {
+        UD_ERROR("udlist_wal: reset log error\n");
+        wal->err = 1;
+        return FUN_ERROR;
+    } /* end of if (0 != ftruncate(wal->fd, 0) || ...) */
+
+    wal->used = 0;
+    wal->written = wal->lsn;
+    wal->synced = wal->lsn;
+    pthread_cond_broadcast(&wal->cond);
+
+    return 0;
+}
+
+
+/**
+ * @brief           创建预写日志结构体并启动后台线程
+ * @param           已打开的日志文件(失败时不关闭)
+ * @param           快照文件路径
+ * @param           元素大小
+ * @param           持久化级别
+ * @param           后台同步间隔(毫秒)
+ * @param           最后一条记录的序号
+ * @return          预写日志的指针, 失败返回 NULL
+ */
+static udwal_t *__wal_new(int fd, const char *snap, int size, int level, int interval, uint64_t seq)
+{
+    udwal_t *wal = NULL;
+
+    wal = (udwal_t *)calloc(1, sizeof(udwal_t));
+    if (NULL == wal)
+    {
+        goto ERR0;
+    } /* end of if (NULL == wal) */
+    wal->snap = strdup(snap);
+    if (NULL == wal->snap)
+    {
+        goto ERR1;
+    } /* end of if (NULL == wal->snap) */
+
+    /* 信息输入 */
+    wal->fd = fd;
+    wal->level = level;
+    wal->interval = (interval > 0) ? interval : UDWAL_INTERVAL;
+    wal->size = size;
+    wal->seq = seq;
+    pthread_mutex_init(&wal->mutex, NULL);
+    pthread_cond_init(&wal->cond, NULL);
+    pthread_cond_init(&wal->kick, NULL);
+
+    /* 后台同步线程 */
+    if (UDWAL_SYNC != level)
+    {
+        if (0 != pthread_create(&wal->thread, NULL, __wal_thread, wal))
+        {
+            goto ERR2;
+        } /* end of if (0 != pthread_create(&wal->thread, NULL, __wal_thread, wal)) */
+        wal->has_thread = 1;
+    } /* end of if (UDWAL_SYNC != level) */
+
+    return wal;
+
+ERR2:
+    pthread_mutex_destroy(&wal->mutex);
+    pthread_cond_destroy(&wal->cond);
+    pthread_cond_destroy(&wal->kick);
+    free(wal->snap);
+ERR1:
+    free(wal);
+ERR0:
+    UD_ERROR("udlist_wal: create error\n");
+    return NULL;
+}
+
+
+/**
+ * @brief           停止后台线程, 写出并同步剩余记录后释放预写日志
+ * @param           预写日志的指针
+ * @return
+ *      @arg  0:正常
+ *      @arg  FUN_ERROR:函数错误(写日志失败过)
+ */
+static int __wal_free(udwal_t *wal)
+{
+    int ret = 0;
+
+    /* 1.等待已追加记录的提交完成(释放写锁后提交的线程仍在使用预写日志) */
+    pthread_mutex_lock(&wal->mutex);
+    while (wal->refs > 0)
+    {
+        pthread_cond_wait(&wal->cond, &wal->mutex);
+    } /* end of while (wal->refs > 0) */
+    pthread_mutex_unlock(&wal->mutex);
+
+    /* 2.停止后台线程 */
+    if (wal->has_thread)
+    {
+        pthread_mutex_lock(&wal->mutex);
+        wal->stop = 1;
+        pthread_cond_signal(&wal->kick);
+        pthread_mutex_unlock(&wal->mutex);
+        pthread_join(wal->thread, NULL);
+    } /* end of if (wal->has_thread) */
+
+    /* 3.写出并同步剩余记录 */
+    pthread_mutex_lock(&wal->mutex);
+    while (wal->writing)
+    {
+        pthread_cond_wait(&wal->cond, &wal->mutex);
+    } /* end of while (wal->writing) */
+    if (!wal->err && (wal->used > 0 || wal->written > wal->synced))
+    {
+        __wal_write(wal, 1);
+    } /* end of if (!wal->err && ...) */
+    ret = wal->err ? FUN_ERROR : 0;
+    pthread_mutex_unlock(&wal->mutex);
+
+    /* 4.释放 */
+    close(wal->fd);
+    pthread_mutex_destroy(&wal->mutex);
+    pthread_cond_destroy(&wal->cond);
+    pthread_cond_destroy(&wal->kick);
+    free(wal->buf);
+    free(wal->spare);
+    free(wal->snap);
+    free(wal);
+
+    return ret;
+}
+
+
+/**
+ * @brief           重放一条记录
+ * @param           头信息结构体的指针
+ * @param           记录头
+ * @return
+ *      @arg  0:正常
+ *      @arg  FUN_ERROR:函数错误(记录与链表不一致)
+ */
+static int __wal_apply(udlist_t *ud, const udwal_rec_t *rec)
+{
+    const int *pos = (const int *)(rec + 1);
+    udwal_match_t m;
+    void *data = NULL;
+    int ret = 0;
+
+    // 负载中命中位置在前(4 字节对齐), 元素数据在后
+    data = (unsigned char *)(rec + 1)
+         + ((UDWAL_DELETE_SET == rec->type || UDWAL_MODIFY_SET == rec->type) ? rec->n * sizeof(int32_t) : 0);
+    memset(&m, 0, sizeof(m));
+    m.hit = (int *)pos;
+    m.n = (int)rec->n;
+
+    switch (rec->type)
+    {
+    case UDWAL_APPEND:
+        return udlist_append(ud, data);
+    case UDWAL_PREPEND:
+        return udlist_prepend(ud, data);
+    case UDWAL_INSERT:
+        return udlist_insert_by_index(ud, data, rec->index);
+    case UDWAL_DELETE:
+        return udlist_delete_by_index(ud, rec->index);
+    case UDWAL_MODIFY:
+        return udlist_modify_by_index(ud, data, rec->index);
+    case UDWAL_DELETE_SET:
+        ret = udlist_delete_all_by_key(ud, &m, udwal_match);
+        return (ret == m.n && m.next == m.n) ? 0 : FUN_ERROR;
+    case UDWAL_MODIFY_SET:
+        ret = udlist_modify_all_by_key(ud, data, &m, udwal_match);
+        return (ret == m.n && m.next == m.n) ? 0 : FUN_ERROR;
+    case UDWAL_APPEND_N:
+        return udlist_append_n(ud, data, rec->n);
+    case UDWAL_PREPEND_N:
+        return udlist_prepend_n(ud, data, rec->n);
+    case UDWAL_CLEAR:
+        return udlist_destroy(ud);
+    default:
+        return FUN_ERROR;
+    } /* end of switch (rec->type) */
+}
+
+
+/**
+ * @brief           重放日志中快照之后的记录
+ * @details         遇到长度越界或校验和不符的记录即停止(崩溃时写了一半的记录)
+ * @param           头信息结构体的指针
+ * @param           日志文件
+ * @param           快照包含的最后一条记录序号
+ * @param           输出最后一条记录的序号
+ * @param           输出有效内容的长度(0 表示需要重建文件头)
+ * @return
+ *      @arg  0:正常
+ *      @arg  FUN_ERROR:函数错误(格式错误或日志与快照不一致)
+ */
+static int __wal_replay(udlist_t *ud, int fd, uint64_t since, uint64_t *seq, off_t *end)
+{
+    const udwal_head_t *head = NULL;
+    const udwal_rec_t *rec = NULL;
+    unsigned char *map = NULL;
+    struct stat st;
+    size_t len = 0;
+    size_t off = sizeof(udwal_head_t);
+    uint64_t sum = 0;
+
+    *seq = since;
+    *end = 0;
+
+    /* 1.私有映射文件(校验时改写 sum 字段), 文件头不完整时视为空日志 */
+    if (0 != fstat(fd, &st))
+    {
+        return FUN_ERROR;
+    } /* end of if (0 != fstat(fd, &st)) */
+    len = (size_t)st.st_size;
+    if (len < sizeof(udwal_head_t))
+    {
+        return 0;
+    } /* end of if (len < sizeof(udwal_head_t)) */
+    map = (unsigned char *)mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    if (MAP_FAILED == (void *)map)
+    {
+        return FUN_ERROR;
+    } /* end of if (MAP_FAILED == (void *)map) */
+    madvise(map, len, MADV_SEQUENTIAL);
+
+    /* 2.校验文件头: 日志必须在快照之前或同时清空 */
+    head = (const udwal_head_t *)map;
+    if (0 != memcmp(head->magic, "UDLW", 4) || UDWAL_VERSION != head->version
+        || (int)head->size != ud->size || head->base > since)
+    {
+        UD_ERROR("udlist_wal: bad log header\n");
+        goto ERR0;
+    } /* end of if (0 != memcmp(head->magic, "UDLW", 4) || ...) */
+
+    /* 3.依次校验并重放记录 */
+    while (off + sizeof(udwal_rec_t) <= len)
+    {
+        rec = (const udwal_rec_t *)(map + off);
+        if (rec->len < sizeof(udwal_rec_t) || 0 != rec->len % 8 || rec->len > len - off)
+        {
+            break;
+        } /* end of if (rec->len < sizeof(udwal_rec_t) || ...) */
+
+        // 校验和计算时 sum 字段为 0
+        memcpy(&sum, &rec->sum, sizeof(sum));
+        ((udwal_rec_t *)rec)->sum = 0;
+        if (udsnap_sum(rec, rec->len) != sum)
+        {
+            break;
+        } /* end of if (udsnap_sum(rec, rec->len) != sum) */
+
+        // 跳过快照已包含的记录, 之后的记录序号必须连续
+        if (rec->seq > since)
+        {
+            if (rec->seq != *seq + 1 || 0 != __wal_apply(ud, rec))
+            {
+                UD_ERROR("udlist_wal: replay record %llu error\n", (unsigned long long)rec->seq);
+                goto ERR0;
+            } /* end of if (rec->seq != *seq + 1 || 0 != __wal_apply(ud, rec)) */
+            *seq = rec->seq;
+        } /* end of if (rec->seq > since) */
+
+        off += rec->len;
+    } /* end of while (off + sizeof(udwal_rec_t) <= len) */
+
+    munmap(map, len);
+    *end = (off_t)off;
+
+    return 0;
+
+ERR0:
+    munmap(map, len);
+    return FUN_ERROR;
+}
+
+
+
+/**
+ * @brief           追加一条日志记录(调用者持有写锁)
+ * @param           头信息结构体的指针
+ * @param           记录类型
+ * @param           索引
+ * @param           元素数据(n 个元素或 1 个元素, 可以为 NULL)
+ * @param           元素个数或命中位置个数, 小于 0 表示无法记录(之后的提交均失败)
+ * @param           命中位置数组(可以为 NULL)
+ * @return          记录结束位置, 失败返回 UDWAL_FAIL
+ */
+uint64_t udwal_log(udlist_t *ud, int type, int index, const void *data, int n, const int *pos)
+{
+    udwal_t *wal = ud->wal;
+    udwal_rec_t rec;
+    unsigned char *p = NULL;
+    size_t plen = 0;
+    size_t dlen = 0;
+    size_t len = 0;
+    size_t cap = 0;
+    uint64_t end = 0;
+
+    /* 1.计算记录长度 */
+    if ((UDWAL_DELETE_SET == type || UDWAL_MODIFY_SET == type) && n > 0)
+    {
+        plen = (size_t)n * sizeof(int32_t);
+    } /* end of if (UDWAL_DELETE_SET == type || UDWAL_MODIFY_SET == type) */
+    if ((UDWAL_APPEND_N == type || UDWAL_PREPEND_N == type) && n > 0)
+    {
+        dlen = (size_t)n * (size_t)ud->size;
+    }
+    else if (NULL != data)
+    {
+        dlen = (size_t)ud->size;
+    }
+    len = UDWAL_ALIGN(sizeof(rec) + plen + dlen);
+
+    // n 小于 0 表示修改已生效但无法记录, 日志与链表不再一致
+    pthread_mutex_lock(&wal->mutex);
+    if (wal->err || n < 0)
+    {
+        wal->err = 1;
+        goto ERR0;
+    } /* end of if (wal->err || n < 0) */
+
+    /* 2.追加缓冲扩容 */
+    if (wal->used + len > wal->cap)
+    {
+        cap = (0 == wal->cap) ? 4096 : wal->cap;
+        while (cap < wal->used + len)
+        {
+            cap *= 2;
+        } /* end of while (cap < wal->used + len) */
+        p = (unsigned char *)realloc(wal->buf, cap);
+        if (NULL == p)
+        {
+            UD_ALLOC_ERROR("udwal_log: realloc error\n");
+            wal->err = 1;
+            goto ERR0;
+        } /* end of if (NULL == p) */
+        wal->buf = p;
+        wal->cap = cap;
+    } /* end of if (wal->used + len > wal->cap) */
+
+    /* 3.写入记录: 记录头, 命中位置, 元素数据, 对齐填充 */
+    p = wal->buf + wal->used;
+    memset(&rec, 0, sizeof(rec));
+    rec.len = (uint32_t)len;
+    rec.type = (uint16_t)type;
+    rec.index = index;
+    rec.n = (uint32_t)n;
+    rec.seq = ++wal->seq;
+    memcpy(p, &rec, sizeof(rec));
+    if (plen > 0)
+    {
+        memcpy(p + sizeof(rec), pos, plen);
+    } /* end of if (plen > 0) */
+    if (dlen > 0)
+    {
+        memcpy(p + sizeof(rec) + plen, data, dlen);
+    } /* end of if (dlen > 0) */
+    memset(p + sizeof(rec) + plen + dlen, 0, len - sizeof(rec) - plen - dlen);
+    rec.sum = udsnap_sum(p, len);
+    memcpy(p + offsetof(udwal_rec_t, sum), &rec.sum, sizeof(rec.sum));
+
+    wal->used += len;
+    wal->lsn += len;
+    wal->refs++;
+    end = wal->lsn;
+
+    /* 4.缓冲过大时提前唤醒后台线程 */
+    if (wal->used > UDWAL_BUF_MAX && wal->has_thread)
+    {
+        pthread_cond_signal(&wal->kick);
+    } /* end of if (wal->used > UDWAL_BUF_MAX && wal->has_thread) */
+    pthread_mutex_unlock(&wal->mutex);
+
+    return end;
+
+ERR0:
+    pthread_mutex_unlock(&wal->mutex);
+    return UDWAL_FAIL;
+}
+
+
+/**
+ * @brief           按持久化级别等待日志记录写出或同步
+ * @details         没有线程在写出时由当前线程写出所有已追加的记录, 否则等待其完成后再检查
+ * @param           预写日志的指针
+ * @param           记录结束位置
+ * @param           修改操作的返回值
+ * @return          修改操作的返回值, 写日志失败返回 FUN_ERROR
+ */
+int udwal_commit(udwal_t *wal, uint64_t lsn, int ret)
+{
+    if (UDWAL_FAIL == lsn)
+    {
+        return FUN_ERROR;
+    } /* end of if (UDWAL_FAIL == lsn) */
+
+    pthread_mutex_lock(&wal->mutex);
+    while (!wal->err && UDWAL_LAZY != wal->level
+           && ((UDWAL_SYNC == wal->level) ? wal->synced : wal->written) < lsn)
+    {
+        if (wal->writing)
+        {
+            pthread_cond_wait(&wal->cond, &wal->mutex);
+        }
+        else
+        {
+            __wal_write(wal, UDWAL_SYNC == wal->level);
+        }
+    } /* end of while (!wal->err && ...) */
+    ret = wal->err ? FUN_ERROR : ret;
+
+    // 最后一个提交者唤醒等待关闭的线程
+    if (0 == --wal->refs)
+    {
+        pthread_cond_broadcast(&wal->cond);
+    } /* end of if (0 == --wal->refs) */
+    pthread_mutex_unlock(&wal->mutex);
+
+    return ret;
+}
+
+
+/**
+ * @brief           比较函数: 记录时调用原比较函数并记下命中位置, 重放时按位置命中
+ * @details         传给 delete_all_by_key / modify_all_by_key, 依赖单次遍历按顺序对每个元素调用一次
+ * @param           数据
+ * @param           udwal_match_t 的指针
+ * @return          MATCH_SUCCESS / MATCH_FAIL
+ */
+int udwal_match(void *data, void *key)
+{
+    udwal_match_t *m = (udwal_match_t *)key;
+    int *hit = NULL;
+    int ret = MATCH_FAIL;
+
+    /* 重放: 按位置命中 */
+    if (NULL == m->op_cmp)
+    {
+        if (m->next < m->n && m->hit[m->next] == m->pos)
+        {
+            m->next++;
+            ret = MATCH_SUCCESS;
+        } /* end of if (m->next < m->n && m->hit[m->next] == m->pos) */
+        m->pos++;
+        return ret;
+    } /* end of if (NULL == m->op_cmp) */
+
+    /* 记录: 调用原比较函数, 命中时记下位置 */
+    ret = m->op_cmp(data, m->key);
+    if (MATCH_SUCCESS == ret)
+    {
+        if (m->n == m->cap)
+        {
+            hit = (int *)realloc(m->hit, sizeof(int) * (size_t)((0 == m->cap) ? 64 : m->cap * 2));
+            if (NULL == hit)
+            {
+                m->err = 1;
+                m->pos++;
+                return ret;
+            } /* end of if (NULL == hit) */
+            m->hit = hit;
+            m->cap = (0 == m->cap) ? 64 : m->cap * 2;
+        } /* end of if (m->n == m->cap) */
+        m->hit[m->n++] = m->pos;
+    } /* end of if (MATCH_SUCCESS == ret) */
+    m->pos++;
+
+    return ret;
+}
+
+
+/**
+ * @brief           同步并销毁预写日志(head_destroy 调用)
+ * @param           预写日志的指针的地址
+ */
+void udwal_destroy(udwal_t **wal)
+{
+    if (NULL == wal || NULL == *wal)
+    {
+        return;
+    } /* end of if (NULL == wal || NULL == *wal) */
+
+    __wal_free(*wal);
+    *wal = NULL;
+}
+
+
+
+/**
+ * @brief           开启预写日志
+ * @details         先清空日志再保存快照, 两步之间崩溃时恢复为旧快照的状态
+ * @param           头信息结构体的指针
+ * @param           快照文件路径
+ * @param           日志文件路径(已存在时清空)
+ * @param           持久化级别 UDWAL_LAZY / UDWAL_FLUSH / UDWAL_SYNC
+ * @param           后台同步间隔(毫秒), 小于等于 0 时使用 UDWAL_INTERVAL
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误(包括已经开启)
+ *      @arg  FUN_ERROR:函数错误(文件读写失败)
+ */
+static int __udlist_wal_attach(udlist_t *ud, const char *snap, const char *log, int level, int interval)
+{
+    udwal_t *wal = NULL;
+    int fd = -1;
+
+    /* 参数检查 */
+    if (NULL == ud || NULL == snap || NULL == log || level < UDWAL_LAZY || level > UDWAL_SYNC
+        || NULL != ud->wal || ((UDLIST_LOCKFREE | UDLIST_SORTED) & ud->flags))
+    {
+        UD_ERROR("udlist_wal_attach: Parameter error\n");
+        goto ERR0;
+    } /* end of if (NULL == ud || NULL == snap || ...) */
+
+    /* 1.打开日志文件并创建预写日志 */
+    fd = open(log, O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (fd < 0)
+    {
+        UD_ERROR("udlist_wal_attach: open %s error\n", log);
+        goto ERR1;
+    } /* end of if (fd < 0) */
+    wal = __wal_new(fd, snap, ud->size, level, interval, 0);
+    if (NULL == wal)
+    {
+        close(fd);
+        goto ERR1;
+    } /* end of if (NULL == wal) */
+
+    /* 2.清空日志, 再保存快照 */
+    pthread_mutex_lock(&wal->mutex);
+    if (0 != __wal_reset(wal, 0))
+    {
+        pthread_mutex_unlock(&wal->mutex);
+        goto ERR2;
+    } /* end of if (0 != __wal_reset(wal, 0)) */
+    pthread_mutex_unlock(&wal->mutex);
+    if (0 != udsnap_save(ud, snap, 0))
+    {
+        goto ERR2;
+    } /* end of if (0 != udsnap_save(ud, snap, 0)) */
+
+    ud->wal = wal;
+
+    return 0;
+
+ERR0:
+    return PAR_ERROR;
+ERR2:
+    __wal_free(wal);
+ERR1:
+    return FUN_ERROR;
+}
+
+
+
+/**
+ * @brief           开启预写日志(并发模式下持有写锁)
+ */
+int udlist_wal_attach(udlist_t *ud, const char *snap, const char *log, int level, int interval)
+{
+    int ret = 0;
+
+    UD_WRLOCK(ud);
+    ret = __udlist_wal_attach(ud, snap, log, level, interval);
+    UD_WRUNLOCK(ud);
+
+    return ret;
+}
+
+
+/**
+ * @brief           从快照及日志恢复链表并继续记录日志
+ * @details         加载快照, 按顺序重放日志中快照之后的记录, 日志末尾写了一半的记录被丢弃;
+ *                  日志不存在时只加载快照; 之后的修改继续追加到同一个日志
+ * @param           快照文件路径
+ * @param           日志文件路径
+ * @param           自定义销毁数据函数
+ * @param           存储模式, 同 udlist_create_ex
+ * @param           持久化级别 UDWAL_LAZY / UDWAL_FLUSH / UDWAL_SYNC
+ * @param           后台同步间隔(毫秒), 小于等于 0 时使用 UDWAL_INTERVAL
+ * @return          指向链表头信息结构体的指针
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误(文件读写失败、格式错误或日志与快照不一致)
+ */
+udlist_t *udlist_wal_recover(const char *snap, const char *log, op_t my_destroy, int flags, int level, int interval)
+{
+    udlist_t *ud = NULL;
+    udwal_t *wal = NULL;
+    uint64_t since = 0;
+    uint64_t seq = 0;
+    off_t end = 0;
+    int fd = -1;
+    int ret = 0;
+
+    /* 参数检查 */
+    if (NULL == snap || NULL == log || level < UDWAL_LAZY || level > UDWAL_SYNC
+        || (UDLIST_LOCKFREE & flags))
+    {
+        UD_ERROR("udlist_wal_recover: Parameter error\n");
+        goto ERR0;
+    } /* end of if (NULL == snap || NULL == log || ...) */
+
+    /* 1.加载快照 */
+    ud = udsnap_load(snap, my_destroy, flags, &since);
+    if ((void *)PAR_ERROR == ud || (void *)FUN_ERROR == ud)
+    {
+        return ud;
+    } /* end of if ((void *)PAR_ERROR == ud || (void *)FUN_ERROR == ud) */
+
+    /* 2.重放日志, 丢弃末尾不完整的记录 */
+    fd = open(log, O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (fd < 0)
+    {
+        UD_ERROR("udlist_wal_recover: open %s error\n", log);
+        goto ERR1;
+    } /* end of if (fd < 0) */
+    if (0 != __wal_replay(ud, fd, since, &seq, &end)
+        || (end > 0 && 0 != ftruncate(fd, end)))
+    {
+        goto ERR2;
+    } /* end of if (0 != __wal_replay(ud, fd, since, &seq, &end) || ...) */
+
+    /* 3.继续记录日志, 空日志重建文件头 */
+    wal = __wal_new(fd, snap, ud->size, level, interval, seq);
+    if (NULL == wal)
+    {
+        goto ERR2;
+    } /* end of if (NULL == wal) */
+    if (0 == end)
+    {
+        pthread_mutex_lock(&wal->mutex);
+        ret = __wal_reset(wal, since);
+        pthread_mutex_unlock(&wal->mutex);
+        if (0 != ret)
+        {
+            __wal_free(wal);
+            goto ERR1;
+        } /* end of if (0 != ret) */
+    } /* end of if (0 == end) */
+    ud->wal = wal;
+
+    return ud;
+
+ERR0:
+    return (void *)PAR_ERROR;
+ERR2:
+    close(fd);
+ERR1:
+    udlist_destroy(ud);
+    head_destroy(&ud);
+    return (void *)FUN_ERROR;
+}
+
+
+/**
+ * @brief           立即写出并同步所有日志记录
+ * @param           头信息结构体的指针
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误(未开启预写日志)
+ *      @arg  FUN_ERROR:函数错误(文件读写失败)
+ */
+int udlist_wal_sync(udlist_t *ud)
+{
+    udwal_t *wal = NULL;
+    uint64_t lsn = 0;
+    int ret = 0;
+
+    /* 参数检查 */
+    if (NULL == ud || NULL == ud->wal)
+    {
+        UD_ERROR("udlist_wal_sync: Parameter error\n");
+        return PAR_ERROR;
+    } /* end of if (NULL == ud || NULL == ud->wal) */
+
+    /* 写出到调用时为止追加的所有记录 */
+    wal = ud->wal;
+    pthread_mutex_lock(&wal->mutex);
+    lsn = wal->lsn;
+    while (!wal->err && wal->synced < lsn)
+    {
+        if (wal->writing)
+        {
+            pthread_cond_wait(&wal->cond, &wal->mutex);
+        }
+        else
+        {
+            __wal_write(wal, 1);
+        }
+    } /* end of while (!wal->err && wal->synced < lsn) */
+    ret = wal->err ? FUN_ERROR : 0;
+    pthread_mutex_unlock(&wal->mutex);
+
+    return ret;
+}
+
+
+/**
+ * @brief           检查点: 保存快照并清空日志
+ * @details         快照记录其包含的最后一条记录序号, 在保存快照和清空日志之间崩溃时重放会跳过已包含的记录
+ * @param           头信息结构体的指针
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误(未开启预写日志)
+ *      @arg  FUN_ERROR:函数错误(文件读写失败)
+ */
+static int __udlist_wal_checkpoint(udlist_t *ud)
+{
+    udwal_t *wal = NULL;
+    int ret = 0;
+
+    /* 参数检查 */
+    if (NULL == ud || NULL == ud->wal)
+    {
+        UD_ERROR("udlist_wal_checkpoint: Parameter error\n");
+        return PAR_ERROR;
+    } /* end of if (NULL == ud || NULL == ud->wal) */
+
+    /* 1.保存快照(持有写锁, 期间没有新记录) */
+    wal = ud->wal;
+    if (0 != udsnap_save(ud, wal->snap, wal->seq))
+    {
+        return FUN_ERROR;
+    } /* end of if (0 != udsnap_save(ud, wal->snap, wal->seq)) */
+
+    /* 2.等待正在进行的写出完成后清空日志 */
+    pthread_mutex_lock(&wal->mutex);
+    while (wal->writing)
+    {
+        pthread_cond_wait(&wal->cond, &wal->mutex);
+    } /* end of while (wal->writing) */
+    ret = __wal_reset(wal, wal->seq);
+    pthread_mutex_unlock(&wal->mutex);
+
+    return ret;
+}
+
+
+
+/**
+ * @brief           检查点: 保存快照并清空日志(并发模式下持有写锁)
+ */
+int udlist_wal_checkpoint(udlist_t *ud)
+{
+    int ret = 0;
+
+    UD_WRLOCK(ud);
+    ret = __udlist_wal_checkpoint(ud);
+    UD_WRUNLOCK(ud);
+
+    return ret;
+}
+
+
+/**
+ * @brief           同步所有日志记录并关闭预写日志(并发模式下持有写锁)
+ * @param           头信息结构体的指针
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误(未开启预写日志)
+ *      @arg  FUN_ERROR:函数错误(最后一次同步失败)
+ */
+int udlist_wal_close(udlist_t *ud)
+{
+    udwal_t *wal = NULL;
+
+    UD_WRLOCK(ud);
+    if (NULL != ud)
+    {
+        wal = ud->wal;
+        ud->wal = NULL;
+    } /* end of if (NULL != ud) */
+    UD_WRUNLOCK(ud);
+
+    /* 参数检查 */
+    if (NULL == wal)
+    {
+        UD_ERROR("udlist_wal_close: Parameter error\n");
+        return PAR_ERROR;
+    } /* end of if (NULL == wal) */
+
+    return __wal_free(wal);
+}
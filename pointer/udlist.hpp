@@ -0,0 +1,700 @@
+/**
+ * @file                udlist.hpp
+ * @brief               万能型双向循环链表的 C++ 模板封装(C++17)
+ * @details             udlist<T, Alloc> 以 UDLIST_INLINE 模式创建底层链表, T 直接存放在节点的内联数据域中:
+                            1.插入时在节点内原位构造, 非平凡类型不经过 memcpy, 支持移动语义;
+                              平凡可拷贝类型仍走 C 接口的拷贝路径;
+                            2.删除时底层链表通过 my_destroy 调用 T 的析构函数;
+                            3.查找、遍历直接沿节点指针进行, 谓词为模板参数(lambda)可以被内联,
+                              不经过 cmp_t 函数指针及整块拷贝;
+                            4.迭代器为 STL 双向迭代器, 可以用于范围 for 及 <algorithm>;
+                        底层仍是 udlist_t, 节点布局不变, native_handle() 可以直接传给 C 接口读取;
+                        与 STL 容器相同, 对象本身不加锁, 也不支持附加哈希索引、有序模式及预写日志
+                        (通过引用修改元素会绕过它们)
+ * @author              BHR
+ * @version             v1.0
+ * @date                2024-03-07
+ * @copyright           MIT
+ */
+
+#ifndef __UDLIST_HPP__
+#define __UDLIST_HPP__
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <pthread.h>
+
+extern "C"
+{
+#include "uni_doubly_linkedlist.h"
+}
+
+
+/**
+ * @brief           节点逐个申请的分配策略
+ * @tparam          附加存储模式, 0 或 UDLIST_INDEXED(按索引访问 O(log n))
+ */
+template <int Flags = 0>
+struct ud_heap_alloc
+{
+    static_assert(0 == (Flags & ~UDLIST_INDEXED), "ud_heap_alloc: Flags must be 0 or UDLIST_INDEXED");
+
+    static udlist_t *create(int size, op_t my_destroy)
+    {
+        return udlist_create_ex(size, my_destroy, UDLIST_INLINE | Flags);
+    }
+};
+
+
+/**
+ * @brief           节点内存池的分配策略
+ * @tparam          每个内存块的节点个数
+ * @tparam          附加存储模式, 0 或 UDLIST_INDEXED
+ */
+template <int ChunkNodes = 1024, int Flags = 0>
+struct ud_pool_alloc
+{
+    static_assert(ChunkNodes > 0, "ud_pool_alloc: ChunkNodes must be positive");
+    static_assert(0 == (Flags & ~UDLIST_INDEXED), "ud_pool_alloc: Flags must be 0 or UDLIST_INDEXED");
+
+    static udlist_t *create(int size, op_t my_destroy)
+    {
+        return udlist_create_pooled_ex(size, my_destroy, ChunkNodes, Flags);
+    }
+};
+
+
+/**
+ * @brief           类型化链表
+ * @tparam          元素类型(对齐要求不能超过指针)
+ * @tparam          分配策略 ud_heap_alloc / ud_pool_alloc
+ */
+template <typename T, typename Alloc = ud_heap_alloc<> >
+class udlist
+{
+    static_assert(alignof(T) <= alignof(node_t), "udlist: T is over-aligned for the inline payload");
+    static_assert(sizeof(T) <= INT_MAX, "udlist: T is too large");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T &;
+    using const_reference = const T &;
+    using pointer = T *;
+    using const_pointer = const T *;
+
+
+    /**
+     * @brief 双向迭代器, end() 为越过末端(节点为 NULL)
+     */
+    template <bool Const>
+    class basic_iterator
+    {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = typename std::conditional<Const, const T *, T *>::type;
+        using reference = typename std::conditional<Const, const T &, T &>::type;
+
+        basic_iterator() = default;
+
+        // iterator 可以转换为 const_iterator
+        template <bool C = Const, typename = typename std::enable_if<C>::type>
+        basic_iterator(const basic_iterator<false> &o) noexcept : ud_(o.ud_), node_(o.node_)
+        {
+        }
+
+        reference operator*() const
+        {
+            return *static_cast<pointer>(node_->data);
+        }
+
+        pointer operator->() const
+        {
+            return static_cast<pointer>(node_->data);
+        }
+
+        basic_iterator &operator++()
+        {
+            node_ = (node_->next == ud_->fstnode_p) ? NULL : node_->next;
+            return *this;
+        }
+
+        basic_iterator operator++(int)
+        {
+            basic_iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        // end() 前移到最后一个元素
+        basic_iterator &operator--()
+        {
+            node_ = (NULL == node_) ? ud_->fstnode_p->prev : ((node_ == ud_->fstnode_p) ? NULL : node_->prev);
+            return *this;
+        }
+
+        basic_iterator operator--(int)
+        {
+            basic_iterator old = *this;
+            --*this;
+            return old;
+        }
+
+        friend bool operator==(const basic_iterator &a, const basic_iterator &b)
+        {
+            return a.node_ == b.node_;
+        }
+
+        friend bool operator!=(const basic_iterator &a, const basic_iterator &b)
+        {
+            return a.node_ != b.node_;
+        }
+
+        // 节点句柄, 可以传给 udlist_remove_node 等 C 接口
+        node_t *native_handle() const
+        {
+            return node_;
+        }
+
+    private:
+        friend class udlist;
+        template <bool> friend class basic_iterator;
+
+        basic_iterator(const udlist_t *ud, node_t *node) noexcept : ud_(ud), node_(node)
+        {
+        }
+
+        const udlist_t *ud_ = NULL;
+        node_t *node_ = NULL;
+    };
+
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+
+    udlist() : ud_(create())
+    {
+    }
+
+    // 委托默认构造: 填充时抛出异常由析构函数释放已插入的元素
+    udlist(std::initializer_list<T> il) : udlist()
+    {
+        for (const T &v : il)
+        {
+            push_back(v);
+        } /* end of for (const T &v : il) */
+    }
+
+    udlist(const udlist &o) : udlist()
+    {
+        for (const T &v : o)
+        {
+            push_back(v);
+        } /* end of for (const T &v : o) */
+    }
+
+    // 移动后 o 为空链表(底层链表在下次插入时创建)
+    udlist(udlist &&o) noexcept : ud_(o.ud_)
+    {
+        o.ud_ = NULL;
+    }
+
+    /**
+     * @brief           接管 C 接口创建的链表
+     * @details         链表必须为 UDLIST_INLINE 模式(展开、无锁、有序模式不支持), 元素大小为 sizeof(T);
+     *                  T 不是平凡析构类型时链表必须由 udlist<T> 创建(my_destroy 为其析构函数)
+     * @param           头信息结构体的指针, 接管后由本对象销毁; 不兼容时先销毁再抛出 std::invalid_argument
+     */
+    explicit udlist(udlist_t *ud) : ud_(ud)
+    {
+        if (bad(ud) || sizeof(T) != (size_t)ud->size || !(UDLIST_INLINE & ud->flags)
+            || ((UDLIST_UNROLLED | UDLIST_LOCKFREE | UDLIST_SORTED) & ud->flags)
+            || ud->my_destroy != destroy_fn())
+        {
+            // 构造失败时析构函数不会执行, 在这里释放, 否则 udlist<T> x(udlist_create(...)) 泄漏
+            if (!bad(ud))
+            {
+                udlist_destroy(ud);
+                head_destroy(&ud);
+            } /* end of if (!bad(ud)) */
+            ud_ = NULL;
+            throw std::invalid_argument("udlist: incompatible udlist_t");
+        } /* end of if (bad(ud) || ...) */
+    }
+
+    // 拷贝赋值及移动赋值
+    udlist &operator=(udlist o) noexcept
+    {
+        swap(o);
+        return *this;
+    }
+
+    ~udlist()
+    {
+        if (NULL != ud_)
+        {
+            udlist_destroy(ud_);
+            head_destroy(&ud_);
+        } /* end of if (NULL != ud_) */
+    }
+
+    void swap(udlist &o) noexcept
+    {
+        std::swap(ud_, o.ud_);
+    }
+
+    // 底层链表, 可以传给 C 接口(移动后到下次插入之前为 NULL)
+    udlist_t *native_handle() const noexcept
+    {
+        return ud_;
+    }
+
+    // 放弃所有权并返回底层链表, 之后由调用者销毁
+    udlist_t *release() noexcept
+    {
+        udlist_t *ud = ud_;
+
+        ud_ = NULL;
+        return ud;
+    }
+
+
+    /* 迭代器 */
+    iterator begin() noexcept { return iterator(ud_, first()); }
+    const_iterator begin() const noexcept { return const_iterator(ud_, first()); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    iterator end() noexcept { return iterator(ud_, NULL); }
+    const_iterator end() const noexcept { return const_iterator(ud_, NULL); }
+    const_iterator cend() const noexcept { return end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+
+    /* 容量 */
+    bool empty() const noexcept { return 0 == count(); }
+    size_type size() const noexcept { return (size_type)count(); }
+
+
+    /* 元素访问 */
+    reference front() { return *elem(ud_->fstnode_p); }
+    const_reference front() const { return *elem(ud_->fstnode_p); }
+    reference back() { return *elem(ud_->fstnode_p->prev); }
+    const_reference back() const { return *elem(ud_->fstnode_p->prev); }
+
+    // 按索引访问: 秩树模式 O(log n), 其他模式利用位置缓存从最近位置走
+    reference operator[](size_type index) { return *peek(index); }
+    const_reference operator[](size_type index) const { return *peek(index); }
+
+    reference at(size_type index)
+    {
+        check(index);
+        return *peek(index);
+    }
+
+    const_reference at(size_type index) const
+    {
+        check(index);
+        return *peek(index);
+    }
+
+
+    /* 插入 */
+    void push_back(const T &v) { emplace_after(last(), v); }
+    void push_back(T &&v) { emplace_after(last(), std::move(v)); }
+    void push_front(const T &v) { emplace_after(NULL, v); }
+    void push_front(T &&v) { emplace_after(NULL, std::move(v)); }
+
+    template <typename... Args>
+    reference emplace_back(Args &&...args)
+    {
+        return *elem(emplace_after(last(), std::forward<Args>(args)...));
+    }
+
+    template <typename... Args>
+    reference emplace_front(Args &&...args)
+    {
+        return *elem(emplace_after(NULL, std::forward<Args>(args)...));
+    }
+
+    // 在 pos 之前原位构造
+    template <typename... Args>
+    iterator emplace(const_iterator pos, Args &&...args)
+    {
+        node_t *p = emplace_after(before(pos.node_), std::forward<Args>(args)...);
+
+        return iterator(ud_, p);
+    }
+
+    iterator insert(const_iterator pos, const T &v) { return emplace(pos, v); }
+    iterator insert(const_iterator pos, T &&v) { return emplace(pos, std::move(v)); }
+
+
+    /* 删除 */
+    void pop_front() { udlist_remove_node(ud_, ud_->fstnode_p); }
+    void pop_back() { udlist_remove_node(ud_, ud_->fstnode_p->prev); }
+
+    // 删除 pos 处的元素, 返回其后一个元素的迭代器
+    iterator erase(const_iterator pos)
+    {
+        iterator next(ud_, pos.node_);
+
+        ++next;
+        udlist_remove_node(ud_, pos.node_);
+        return next;
+    }
+
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        while (first != last)
+        {
+            first = erase(first);
+        } /* end of while (first != last) */
+
+        return iterator(ud_, last.node_);
+    }
+
+    void clear() noexcept
+    {
+        if (NULL != ud_)
+        {
+            udlist_destroy(ud_);
+        } /* end of if (NULL != ud_) */
+    }
+
+    // 删除所有满足谓词的元素, 返回删除个数
+    template <typename Pred>
+    size_type remove_if(Pred pred)
+    {
+        node_t *p = first();
+        node_t *next = NULL;
+        int n = count();
+        size_type removed = 0;
+
+        for (; n > 0; n--, p = next)
+        {
+            next = p->next;
+            if (pred(*elem(p)))
+            {
+                udlist_remove_node(ud_, p);
+                removed++;
+            } /* end of if (pred(*elem(p))) */
+        } /* end of for (; n > 0; n--, p = next) */
+
+        return removed;
+    }
+
+    template <typename U>
+    size_type remove(const U &key)
+    {
+        return remove_if([&key](const T &v) { return v == key; });
+    }
+
+
+    /* 查找: 谓词直接内联到遍历循环中 */
+    template <typename Pred>
+    iterator find_if(Pred pred)
+    {
+        return iterator(ud_, scan(pred));
+    }
+
+    template <typename Pred>
+    const_iterator find_if(Pred pred) const
+    {
+        return const_iterator(ud_, scan(pred));
+    }
+
+    template <typename U>
+    iterator find(const U &key)
+    {
+        return find_if([&key](const T &v) { return v == key; });
+    }
+
+    template <typename U>
+    const_iterator find(const U &key) const
+    {
+        return find_if([&key](const T &v) { return v == key; });
+    }
+
+    template <typename U>
+    bool contains(const U &key) const
+    {
+        return end() != find(key);
+    }
+
+    // 第一个满足谓词的元素索引, 没有返回 -1(同 get_match_index)
+    template <typename Pred>
+    int index_if(Pred pred) const
+    {
+        node_t *p = first();
+        int n = count();
+        int i = 0;
+
+        for (i = 0; i < n; i++, p = p->next)
+        {
+            if (pred(*elem(p)))
+            {
+                return i;
+            } /* end of if (pred(*elem(p))) */
+        } /* end of for (i = 0; i < n; i++, p = p->next) */
+
+        return -1;
+    }
+
+    template <typename Pred>
+    size_type count_if(Pred pred) const
+    {
+        node_t *p = first();
+        int c = count();
+        size_type n = 0;
+        int i = 0;
+
+        for (i = 0; i < c; i++, p = p->next)
+        {
+            n += pred(*elem(p)) ? 1 : 0;
+        } /* end of for (i = 0; i < c; i++, p = p->next) */
+
+        return n;
+    }
+
+
+    /**
+     * @brief           稳定排序(只调整节点链接, 不移动元素)
+     * @details         由 udlist_sort 的归并排序完成, 比较经过一次函数指针调用; comp 不能抛出异常
+     * @param           比较函数, a 应排在 b 之前时返回 true
+     */
+    template <typename Compare>
+    void sort(Compare comp)
+    {
+        const void *save = sort_ctx();
+
+        if (NULL == ud_)
+        {
+            return;
+        } /* end of if (NULL == ud_) */
+
+        sort_ctx() = &comp;
+        udlist_sort(ud_, &sort_thunk<Compare>);
+        sort_ctx() = save;
+    }
+
+    void sort()
+    {
+        sort([](const T &a, const T &b) { return a < b; });
+    }
+
+
+private:
+    // 底层链表
+    udlist_t *ud_;
+
+    static bool bad(const void *p)
+    {
+        return NULL == p || (void *)(intptr_t)PAR_ERROR == p || (void *)(intptr_t)FUN_ERROR == p;
+    }
+
+    static T *elem(node_t *p)
+    {
+        return static_cast<T *>(p->data);
+    }
+
+    // 析构元素(my_destroy), 返回值忽略
+    static int destroy_thunk(void *data)
+    {
+        static_cast<T *>(data)->~T();
+        return 0;
+    }
+
+    // 平凡析构类型不需要 my_destroy, 内存池模式可以整块释放
+    static op_t destroy_fn()
+    {
+        return std::is_trivially_destructible<T>::value ? NULL : &destroy_thunk;
+    }
+
+    static udlist_t *create()
+    {
+        udlist_t *ud = Alloc::create((int)sizeof(T), destroy_fn());
+
+        if (bad(ud))
+        {
+            throw std::bad_alloc();
+        } /* end of if (bad(ud)) */
+
+        return ud;
+    }
+
+    // 移动后 ud_ 为 NULL, 按空链表处理
+    node_t *first() const noexcept
+    {
+        return (NULL == ud_) ? NULL : ud_->fstnode_p;
+    }
+
+    int count() const noexcept
+    {
+        return (NULL == ud_) ? 0 : ud_->count;
+    }
+
+    node_t *last() const
+    {
+        return (NULL == first()) ? NULL : ud_->fstnode_p->prev;
+    }
+
+    // 插入到 pos 之前时的前驱节点, NULL 表示插入到头部
+    node_t *before(node_t *pos) const
+    {
+        if (NULL == pos)
+        {
+            return last();
+        } /* end of if (NULL == pos) */
+
+        return (pos == first()) ? NULL : pos->prev;
+    }
+
+    /**
+     * @brief           在 after 之后插入新节点并原位构造元素
+     * @details         平凡可拷贝类型构造在栈上, 由 C 接口拷贝进节点;
+     *                  其他类型先插入未初始化的节点, 再在节点数据域中构造, 构造抛出异常时摘下节点且不析构
+     */
+    template <typename... Args>
+    node_t *emplace_after(node_t *after, Args &&...args)
+    {
+        node_t *p = NULL;
+
+        // 移动后第一次插入时重新创建底层链表
+        if (NULL == ud_)
+        {
+            ud_ = create();
+        } /* end of if (NULL == ud_) */
+
+        if constexpr (std::is_trivially_copyable<T>::value)
+        {
+            T tmp(std::forward<Args>(args)...);
+
+            p = udlist_insert_after_node(ud_, after, &tmp);
+            if (bad(p))
+            {
+                throw std::bad_alloc();
+            } /* end of if (bad(p)) */
+        }
+        else
+        {
+            alignas(T) unsigned char raw[sizeof(T)] = {};
+
+            p = udlist_insert_after_node(ud_, after, raw);
+            if (bad(p))
+            {
+                throw std::bad_alloc();
+            } /* end of if (bad(p)) */
+
+            try
+            {
+                ::new (p->data) T(std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                unlink_raw(p);
+                throw;
+            }
+        }
+
+        return p;
+    }
+
+    // 删除未构造元素的节点(不调用 my_destroy)
+    void unlink_raw(node_t *p) noexcept
+    {
+        op_t save = ud_->my_destroy;
+
+        ud_->my_destroy = NULL;
+        udlist_remove_node(ud_, p);
+        ud_->my_destroy = save;
+    }
+
+    template <typename Pred>
+    node_t *scan(Pred &pred) const
+    {
+        node_t *head = first();
+        node_t *p = head;
+
+        if (NULL == p)
+        {
+            return NULL;
+        } /* end of if (NULL == p) */
+
+        do
+        {
+            if (pred(*elem(p)))
+            {
+                return p;
+            } /* end of if (pred(*elem(p))) */
+            p = p->next;
+        }
+        while (p != head);
+
+        return NULL;
+    }
+
+    T *peek(size_type index) const
+    {
+        void *p = udlist_peek_by_index(ud_, (int)index);
+
+        // 非并发模式下借用只用于定位, 立即归还
+        if (!bad(p))
+        {
+            udlist_peek_end(ud_);
+        } /* end of if (!bad(p)) */
+
+        return static_cast<T *>(p);
+    }
+
+    void check(size_type index) const
+    {
+        if (index >= size())
+        {
+            throw std::out_of_range("udlist: index out of range");
+        } /* end of if (index >= size()) */
+    }
+
+    // 排序比较函数的上下文(ord_t 没有上下文参数)
+    static const void *&sort_ctx()
+    {
+        static thread_local const void *ctx = NULL;
+
+        return ctx;
+    }
+
+    template <typename Compare>
+    static int sort_thunk(void *a, void *b)
+    {
+        const Compare &comp = *static_cast<const Compare *>(sort_ctx());
+
+        return comp(*static_cast<const T *>(a), *static_cast<const T *>(b)) ? -1 : 0;
+    }
+};
+
+
+template <typename T, typename Alloc>
+void swap(udlist<T, Alloc> &a, udlist<T, Alloc> &b) noexcept
+{
+    a.swap(b);
+}
+
+
+
+#endif /* __UDLIST_HPP__ */
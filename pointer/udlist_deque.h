@@ -0,0 +1,134 @@
+/**
+ * @file                udlist_deque.h
+ * @brief               无锁双端队列(UDLIST_LOCKFREE 模式)
+ * @details             只支持头尾插入、删除, 多生产者多消费者同时调用无需加锁;
+                        队列两端及状态打包在一个 64 位锚点中, 插入、删除均为一次锚点 CAS,
+                        插入后由任意线程协助补全相邻节点的链接(Michael 双端队列算法);
+                        节点从按索引寻址的分块内存中切分, 删除的节点经危险指针确认
+                        无线程访问后回收到无锁空闲栈复用;
+                        元素按 size 拷入拷出, my_destroy 语义同 UDLIST_INLINE
+ * @author              BHR
+ * @version             v1.0
+ * @date                2024-03-07
+ * @copyright           MIT
+ */
+
+#ifndef __UDLIST_DEQUE_H__
+#define __UDLIST_DEQUE_H__
+
+#include <stdint.h>
+#include "uni_doubly_linkedlist.h"
+
+// 同时操作同一队列的最大线程数, 超出时多余线程等待
+#define UDDQ_THREADS 64
+
+// 每个线程的危险指针个数
+#define UDDQ_HP 2
+
+// 每个线程待回收节点数达到该值时扫描危险指针并回收
+#define UDDQ_RETIRED (UDDQ_THREADS * UDDQ_HP + 64)
+
+// 分块个数: 第 c 块容纳 64 << c 个节点, 节点索引不超过 31 位
+#define UDDQ_CHUNKS 26
+
+
+/**
+ * @brief 队列节点定义
+ */
+typedef struct _uddq_node_t
+{
+    uint32_t left;                  // 左邻节点索引(0 表示无)
+    uint32_t right;                 // 右邻节点索引
+    uint32_t free_next;             // 空闲栈中的下一个节点索引
+    uint32_t reserved;              // 保留, 使数据域按 8 字节对齐
+    unsigned char data[];           // 数据域
+}uddq_node_t;
+
+
+/**
+ * @brief 线程操作记录定义(危险指针及待回收节点)
+ */
+typedef struct _uddq_rec_t
+{
+    uint32_t active;                // 是否被线程占用
+    uint32_t hp[UDDQ_HP];           // 危险指针: 正在访问的节点索引
+    int retired_n;                  // 待回收节点个数
+    uint32_t retired[UDDQ_RETIRED]; // 待回收节点索引
+}__attribute__((aligned(64))) uddq_rec_t;
+
+
+/**
+ * @brief 无锁双端队列定义
+ */
+typedef struct _uddq_t
+{
+    uint64_t anchor __attribute__((aligned(64)));    // 锚点: 左端索引 | 右端索引 | 状态
+    uint64_t free_top __attribute__((aligned(64)));  // 空闲栈: 栈顶索引 | 版本号
+    uint32_t bump;                  // 下一个未切分的节点索引
+    int count __attribute__((aligned(64)));          // 元素个数(并发时为近似值)
+    int size;                       // 元素大小
+    size_t node_size;               // 单个节点空间大小
+    op_t my_destroy;                // 自定义数据销毁函数(可以为 NULL)
+    unsigned char *chunk[UDDQ_CHUNKS];               // 节点分块
+    uddq_rec_t rec[UDDQ_THREADS];   // 线程操作记录
+}uddq_t;
+
+
+
+/**
+ * @brief           创建无锁双端队列
+ * @param           元素大小
+ * @param           自定义数据销毁函数(可以为 NULL)
+ * @return          队列指针, 失败返回 NULL
+ */
+uddq_t *uddq_create(int size, op_t my_destroy);
+
+
+/**
+ * @brief           插入元素(线程安全, 无锁)
+ * @param           队列指针
+ * @param           数据的指针
+ * @param           非 0 头部插入, 0 尾部插入
+ * @return
+ *      @arg  0:正常
+ *      @arg  FUN_ERROR:函数错误
+ */
+int uddq_push(uddq_t *q, void *data, int front);
+
+
+/**
+ * @brief           删除元素并拷出数据(线程安全, 无锁)
+ * @param           队列指针
+ * @param           输出数据的指针, NULL 表示丢弃(调用 my_destroy)
+ * @param           非 0 头部删除, 0 尾部删除
+ * @return
+ *      @arg  0:正常
+ *      @arg  MATCH_FAIL:队列为空
+ */
+int uddq_pop(uddq_t *q, void *data, int front);
+
+
+/**
+ * @brief           获取元素个数(并发插入、删除时为近似值)
+ * @param           队列指针
+ * @return          元素个数
+ */
+int uddq_count(uddq_t *q);
+
+
+/**
+ * @brief           清空队列并释放所有节点分块(不能与其他操作同时调用)
+ * @param           队列指针
+ */
+void uddq_clear(uddq_t *q);
+
+
+/**
+ * @brief           销毁队列(不能与其他操作同时调用)
+ * @param           队列指针的地址
+ */
+void uddq_destroy(uddq_t **q);
+
+
+
+#endif /* __UDLIST_DEQUE_H__ */
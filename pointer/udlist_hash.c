@@ -0,0 +1,381 @@
+/**
+ * @file                udlist_hash.c
+ * @brief               链表关键字哈希索引
+ * @author              BHR
+ * @version             v1.0
+ * @date                2024-03-07
+ * @copyright           MIT
+ */
+
+#include "udlist_hash.h"
+#include "udlist_lock.h"
+#include "udlist_trace.h"
+
+// 最小槽个数
+#define UDHASH_MIN_CAP 16
+
+
+/**
+ * @brief           将节点放入槽数组(不检查容量)
+ * @param           槽数组
+ * @param           槽个数掩码
+ * @param           哈希值
+ * @param           节点指针
+ */
+static void __hash_place(udhash_slot_t *slots, size_t mask, unsigned long hash, node_t *p)
+{
+    size_t i = hash & mask;
+
+    while (NULL != slots[i].node)
+    {
+        i = (i + 1) & mask;
+    } /* end of while (NULL != slots[i].node) */
+
+    slots[i].hash = hash;
+    slots[i].node = p;
+}
+
+
+
+/**
+ * @brief           扩容到指定槽个数并重新放置所有节点
+ * @param           哈希索引指针
+ * @param           新槽个数(2 的幂)
+ * @return
+ *      @arg  0:正常
+ *      @arg  FUN_ERROR:函数错误
+ */
+static int __hash_resize(udhash_t *h, size_t cap)
+{
+    udhash_slot_t *slots = NULL;
+    size_t i = 0;
+
+    slots = (udhash_slot_t *)calloc(cap, sizeof(udhash_slot_t));
+    if (NULL == slots)
+    {
+        UD_ALLOC_ERROR("__hash_resize: calloc error\n");
+        goto ERR1;
+    } /* end of if (NULL == slots) */
+
+    /* 重新放置 */
+    for (i = 0; i < h->cap; i++)
+    {
+        if (NULL != h->slots[i].node)
+        {
+            __hash_place(slots, cap - 1, h->slots[i].hash, h->slots[i].node);
+        } /* end of if (NULL != h->slots[i].node) */
+    } /* end of for (i = 0; i < h->cap; i++) */
+
+    free(h->slots);
+    h->slots = slots;
+    h->cap = cap;
+
+    return 0;
+
+ERR1:
+    return FUN_ERROR;
+}
+
+
+
+/**
+ * @brief           创建哈希索引
+ * @param           自定义哈希函数
+ * @param           自定义比较函数
+ * @param           预计节点个数
+ * @return          哈希索引指针, 失败返回 NULL
+ */
+udhash_t *udhash_create(hash_t my_hash, cmp_t op_cmp, int expect)
+{
+    udhash_t *h = NULL;
+    size_t cap = UDHASH_MIN_CAP;
+
+    /* 负载因子不超过 1/2 */
+    while (cap < (size_t)expect * 2)
+    {
+        cap <<= 1;
+    } /* end of while (cap < (size_t)expect * 2) */
+
+    h = (udhash_t *)calloc(1, sizeof(udhash_t));
+    if (NULL == h)
+    {
+        goto ERR1;
+    } /* end of if (NULL == h) */
+
+    h->slots = (udhash_slot_t *)calloc(cap, sizeof(udhash_slot_t));
+    if (NULL == h->slots)
+    {
+        goto ERR2;
+    } /* end of if (NULL == h->slots) */
+
+    h->cap = cap;
+    h->used = 0;
+    h->my_hash = my_hash;
+    h->op_cmp = op_cmp;
+
+    return h;
+
+ERR2:
+    free(h);
+    h = NULL;
+ERR1:
+    UD_ALLOC_ERROR("udhash_create: calloc error\n");
+    return NULL;
+}
+
+
+
+/**
+ * @brief           将节点加入哈希索引
+ * @param           哈希索引指针
+ * @param           节点指针
+ * @return
+ *      @arg  0:正常
+ *      @arg  FUN_ERROR:扩容失败
+ */
+int udhash_add(udhash_t *h, node_t *p)
+{
+    /* 负载因子超过 3/4 时扩容 */
+    if ((h->used + 1) * 4 > h->cap * 3)
+    {
+        if (0 != __hash_resize(h, h->cap * 2))
+        {
+            return FUN_ERROR;
+        } /* end of if (0 != __hash_resize(h, h->cap * 2)) */
+    } /* end of if ((h->used + 1) * 4 > h->cap * 3) */
+
+    __hash_place(h->slots, h->cap - 1, h->my_hash(p->data), p);
+    h->used++;
+
+    return 0;
+}
+
+
+
+/**
+ * @brief           将节点从哈希索引中删除
+ * @details         删除后将同一探测序列中的后续槽前移, 不留墓碑
+ * @param           哈希索引指针
+ * @param           节点指针
+ */
+void udhash_del(udhash_t *h, node_t *p)
+{
+    size_t mask = h->cap - 1;
+    size_t i = h->my_hash(p->data) & mask;
+    size_t j = 0;
+    size_t k = 0;
+
+    /* 1.寻找节点所在槽 */
+    while (NULL != h->slots[i].node && p != h->slots[i].node)
+    {
+        i = (i + 1) & mask;
+    } /* end of while (NULL != h->slots[i].node && p != h->slots[i].node) */
+    if (NULL == h->slots[i].node)
+    {
+        return;
+    } /* end of if (NULL == h->slots[i].node) */
+
+    /* 2.后续槽前移 */
+    j = i;
+    while (1)
+    {
+        j = (j + 1) & mask;
+        if (NULL == h->slots[j].node)
+        {
+            break;
+        } /* end of if (NULL == h->slots[j].node) */
+
+        // 理想位置 k 不在 (i, j] 之间的槽可以移到 i
+        k = h->slots[j].hash & mask;
+        if ((i <= j) ? (k <= i || k > j) : (k <= i && k > j))
+        {
+            h->slots[i] = h->slots[j];
+            i = j;
+        } /* end of if ((i <= j) ? (k <= i || k > j) : (k <= i && k > j)) */
+    } /* end of while (1) */
+
+    h->slots[i].node = NULL;
+    h->used--;
+}
+
+
+
+/**
+ * @brief           根据关键字查找节点
+ * @param           哈希索引指针
+ * @param           关键字
+ * @param           输出是否有多个节点匹配
+ * @return          匹配的节点指针, 无匹配返回 NULL
+ */
+node_t *udhash_find(udhash_t *h, void *key, int *dup)
+{
+    size_t mask = h->cap - 1;
+    unsigned long hash = h->my_hash(key);
+    size_t i = hash & mask;
+    node_t *found = NULL;
+
+    *dup = 0;
+    while (NULL != h->slots[i].node)
+    {
+        if (hash == h->slots[i].hash
+            && MATCH_SUCCESS == h->op_cmp(h->slots[i].node->data, key))
+        {
+            if (NULL != found)
+            {
+                *dup = 1;
+                break;
+            } /* end of if (NULL != found) */
+            found = h->slots[i].node;
+        } /* end of if (hash == h->slots[i].hash && ...) */
+
+        i = (i + 1) & mask;
+    } /* end of while (NULL != h->slots[i].node) */
+
+    return found;
+}
+
+
+
+/**
+ * @brief           清空哈希索引
+ * @param           哈希索引指针
+ */
+void udhash_clear(udhash_t *h)
+{
+    memset(h->slots, 0, h->cap * sizeof(udhash_slot_t));
+    h->used = 0;
+}
+
+
+
+/**
+ * @brief           销毁哈希索引
+ * @param           哈希索引指针的地址
+ */
+void udhash_destroy(udhash_t **h)
+{
+    if (NULL == h || NULL == *h)
+    {
+        return;
+    } /* end of if (NULL == h || NULL == *h) */
+
+    free((*h)->slots);
+    free(*h);
+    *h = NULL;
+}
+
+
+
+/**
+ * @brief           为链表附加关键字哈希索引
+ * @param           头信息结构体的指针
+ * @param           自定义哈希函数
+ * @param           自定义比较函数
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+static int __udlist_hash_attach(udlist_t *ud, hash_t my_hash, cmp_t op_cmp)
+{
+    udhash_t *h = NULL;
+    node_t *temp = NULL;
+
+    /* 参数检查 */
+    if (NULL == ud || NULL == my_hash || NULL == op_cmp || NULL != ud->hash
+        || ((UDLIST_UNROLLED | UDLIST_LOCKFREE) & ud->flags))
+    {
+        UD_ERROR("udlist_hash_attach: Parameter error\n");
+        goto ERR0;
+    } /* end of if (NULL == ud || NULL == my_hash || ...) */
+
+    /* 创建哈希索引 */
+    h = udhash_create(my_hash, op_cmp, ud->count);
+    if (NULL == h)
+    {
+        goto ERR1;
+    } /* end of if (NULL == h) */
+
+    /* 加入已有节点 */
+    temp = ud->fstnode_p;
+    if (NULL != temp)
+    {
+        do
+        {
+            if (0 != udhash_add(h, temp))
+            {
+                udhash_destroy(&h);
+                goto ERR1;
+            } /* end of if (0 != udhash_add(h, temp)) */
+            temp = temp->next;
+        }
+        while (temp != ud->fstnode_p);
+    } /* end of if (NULL != temp) */
+
+    ud->hash = h;
+
+    return 0;
+
+ERR0:
+    return PAR_ERROR;
+ERR1:
+    return FUN_ERROR;
+}
+
+
+
+/**
+ * @brief           为链表附加关键字哈希索引(并发模式下持有写锁)
+ */
+int udlist_hash_attach(udlist_t *ud, hash_t my_hash, cmp_t op_cmp)
+{
+    int ret = 0;
+
+    UD_WRLOCK(ud);
+    ret = __udlist_hash_attach(ud, my_hash, op_cmp);
+    UD_WRUNLOCK(ud);
+
+    return ret;
+}
+
+
+
+/**
+ * @brief           移除链表的关键字哈希索引
+ * @param           头信息结构体的指针
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ */
+static int __udlist_hash_detach(udlist_t *ud)
+{
+    /* 参数检查 */
+    if (NULL == ud)
+    {
+        UD_ERROR("udlist_hash_detach: Parameter error\n");
+        goto ERR0;
+    } /* end of if (NULL == ud) */
+
+    udhash_destroy(&ud->hash);
+
+    return 0;
+
+ERR0:
+    return PAR_ERROR;
+}
+
+
+
+/**
+ * @brief           移除链表的关键字哈希索引(并发模式下持有写锁)
+ */
+int udlist_hash_detach(udlist_t *ud)
+{
+    int ret = 0;
+
+    UD_WRLOCK(ud);
+    ret = __udlist_hash_detach(ud);
+    UD_WRUNLOCK(ud);
+
+    return ret;
+}
@@ -0,0 +1,153 @@
+/**
+ * @file                udlist_iter.h
+ * @brief               链表游标(迭代器)
+ * @details             游标指向链表中的一个元素, 前后移动及取数据为头文件内联函数,
+                        编译器可以把遍历与调用者的处理逻辑合并, 不经过函数指针;
+                        游标本身不加锁, 并发模式下调用者必须保证使用游标期间没有其他线程修改链表;
+                        通过游标删除、插入以外的修改使游标失效
+ * @author              BHR
+ * @version             v1.0
+ * @date                2024-03-07
+ * @copyright           MIT
+ */
+
+#ifndef __UDLIST_ITER_H__
+#define __UDLIST_ITER_H__
+
+#include "uni_doubly_linkedlist.h"
+#include "udlist_unrolled.h"
+
+/**
+ * @brief 游标定义
+ */
+typedef struct _udlist_iter_t
+{
+    udlist_t *ud;                   // 所属链表
+    node_t *node;                   // 当前节点(展开模式为当前块), NULL 表示已越过末端
+    int off;                        // 当前元素在块中的偏移(UDLIST_UNROLLED 模式)
+    int index;                      // 当前元素的索引
+    unsigned long mods;             // 游标最近一次定位时链表的结构修改计数
+}udlist_iter_t;
+
+
+
+/**
+ * @brief           游标定位到第一个元素
+ * @note            UDLIST_LOCKFREE 模式不支持, 返回 PAR_ERROR
+ * @param           游标的指针
+ * @param           头信息结构体的指针
+ * @return
+ *      @arg  0:正常(链表为空时游标直接越过末端)
+ *      @arg  PAR_ERROR:参数错误
+ */
+int udlist_iter_begin(udlist_iter_t *it, udlist_t *ud);
+
+
+/**
+ * @brief           游标定位到最后一个元素
+ * @note            UDLIST_LOCKFREE 模式不支持, 返回 PAR_ERROR
+ * @param           游标的指针
+ * @param           头信息结构体的指针
+ * @return
+ *      @arg  0:正常(链表为空时游标直接越过末端)
+ *      @arg  PAR_ERROR:参数错误
+ */
+int udlist_iter_last(udlist_iter_t *it, udlist_t *ud);
+
+
+/**
+ * @brief           删除游标处的元素, 游标移到下一个元素
+ * @param           游标的指针
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误(游标越过末端或已失效)
+ */
+int udlist_iter_erase(udlist_iter_t *it);
+
+
+/**
+ * @brief           在游标处的元素之前插入, 游标仍指向原元素
+ * @details         游标越过末端时插入到尾部
+ * @note            UDLIST_SORTED 模式不支持, 返回 PAR_ERROR
+ * @param           游标的指针
+ * @param           数据的指针
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误(游标已失效)
+ *      @arg  FUN_ERROR:函数错误
+ */
+int udlist_iter_insert_before(udlist_iter_t *it, void *data);
+
+
+
+/**
+ * @brief           游标是否指向一个元素
+ * @param           游标的指针
+ * @return          非 0 表示指向元素, 0 表示已越过末端
+ */
+static inline int udlist_iter_valid(const udlist_iter_t *it)
+{
+    return NULL != it->node;
+}
+
+
+/**
+ * @brief           获取游标处元素的数据域指针
+ * @param           游标的指针(必须指向元素)
+ * @return          数据域指针
+ */
+static inline void *udlist_iter_get(const udlist_iter_t *it)
+{
+    if (UDLIST_UNROLLED & it->ud->flags)
+    {
+        return UD_ELEM(it->ud, UD_BLOCK(it->node), it->off);
+    } /* end of if (UDLIST_UNROLLED & it->ud->flags) */
+
+    return it->node->data;
+}
+
+
+/**
+ * @brief           游标移到下一个元素, 越过最后一个元素后不再指向元素
+ * @param           游标的指针(必须指向元素)
+ */
+static inline void udlist_iter_next(udlist_iter_t *it)
+{
+    it->index++;
+
+    /* 展开模式: 块内后移 */
+    if ((UDLIST_UNROLLED & it->ud->flags) && ++it->off < UD_BLOCK(it->node)->used)
+    {
+        return;
+    } /* end of if ((UDLIST_UNROLLED & it->ud->flags) && ...) */
+    it->off = 0;
+
+    it->node = (it->node->next == it->ud->fstnode_p) ? NULL : it->node->next;
+}
+
+
+/**
+ * @brief           游标移到上一个元素, 越过第一个元素后不再指向元素
+ * @param           游标的指针(必须指向元素)
+ */
+static inline void udlist_iter_prev(udlist_iter_t *it)
+{
+    it->index--;
+
+    /* 展开模式: 块内前移 */
+    if ((UDLIST_UNROLLED & it->ud->flags) && it->off > 0)
+    {
+        it->off--;
+        return;
+    } /* end of if ((UDLIST_UNROLLED & it->ud->flags) && it->off > 0) */
+
+    it->node = (it->node == it->ud->fstnode_p) ? NULL : it->node->prev;
+    if (NULL != it->node && (UDLIST_UNROLLED & it->ud->flags))
+    {
+        it->off = UD_BLOCK(it->node)->used - 1;
+    } /* end of if (NULL != it->node && ...) */
+}
+
+
+
+#endif /* __UDLIST_ITER_H__ */
@@ -0,0 +1,192 @@
+/**
+ * @file                udlist_lock.h
+ * @brief               链表并发模式(UDLIST_CONCURRENT)的加锁宏
+ * @details             读操作(遍历、检索、查找)持有读锁, 修改操作持有写锁,
+                        一次调用只加锁一次, 遍历期间一直持有;
+                        非并发模式下宏为空操作
+ * @author              BHR
+ * @version             v1.0
+ * @date                2024-03-07
+ * @copyright           MIT
+ */
+
+#ifndef __UDLIST_LOCK_H__
+#define __UDLIST_LOCK_H__
+
+#include "uni_doubly_linkedlist.h"
+
+// 是否需要加锁
+#define UD_LOCKED(ud) (NULL != (ud) && (UDLIST_CONCURRENT & (ud)->flags))
+
+// 加读锁
+#define UD_RDLOCK(ud)                                   \
+    do                                                  \
+    {                                                   \
+        if (UD_LOCKED(ud))                              \
+        {                                               \
+            pthread_rwlock_rdlock(&(ud)->lock);         \
+        }                                               \
+    }                                                   \
+    while (0)
+
+// 释放读锁
+#define UD_RDUNLOCK(ud)                                 \
+    do                                                  \
+    {                                                   \
+        if (UD_LOCKED(ud))                              \
+        {                                               \
+            pthread_rwlock_unlock(&(ud)->lock);         \
+        }                                               \
+    }                                                   \
+    while (0)
+
+// 检查借用: 写操作时不能有未归还的借用指针(udlist_peek_* / udlist_emplace_back), 只在定义 UDLIST_DEBUG 时检查;
+// 并发模式下其他线程的借用只是让写者等待, 只检查本线程的借用, 且在加写锁之前检查(否则本线程死锁)
+#ifdef UDLIST_DEBUG
+
+// 每个线程记录的未归还借用个数上限, 超出的借用不检查
+#define UD_BORROW_MAX 16
+
+// 本线程未归还借用的链表(借用几次出现几次, 定义在 uni_doubly_linkedlist.c)
+extern __thread udlist_t *ud_borrow_tls[UD_BORROW_MAX];
+
+/**
+ * @brief           记录本线程借用了链表
+ * @param           头信息结构体的指针
+ */
+static inline void __ud_borrow_add(udlist_t *ud)
+{
+    int i = 0;
+
+    for (i = 0; i < UD_BORROW_MAX; i++)
+    {
+        if (NULL == ud_borrow_tls[i])
+        {
+            ud_borrow_tls[i] = ud;
+            return;
+        } /* end of if (NULL == ud_borrow_tls[i]) */
+    } /* end of for (i = 0; i < UD_BORROW_MAX; i++) */
+}
+
+/**
+ * @brief           记录本线程归还了链表的一次借用
+ * @param           头信息结构体的指针
+ */
+static inline void __ud_borrow_del(udlist_t *ud)
+{
+    int i = 0;
+
+    for (i = 0; i < UD_BORROW_MAX; i++)
+    {
+        if (ud == ud_borrow_tls[i])
+        {
+            ud_borrow_tls[i] = NULL;
+            return;
+        } /* end of if (ud == ud_borrow_tls[i]) */
+    } /* end of for (i = 0; i < UD_BORROW_MAX; i++) */
+}
+
+/**
+ * @brief           本线程是否借用了链表
+ * @param           头信息结构体的指针
+ * @return          非 0 表示有未归还的借用
+ */
+static inline int __ud_borrow_mine(udlist_t *ud)
+{
+    int i = 0;
+
+    for (i = 0; i < UD_BORROW_MAX; i++)
+    {
+        if (ud == ud_borrow_tls[i])
+        {
+            return 1;
+        } /* end of if (ud == ud_borrow_tls[i]) */
+    } /* end of for (i = 0; i < UD_BORROW_MAX; i++) */
+
+    return 0;
+}
+
+#define UD_BORROW_ADD(ud) __ud_borrow_add(ud)
+#define UD_BORROW_DEL(ud) __ud_borrow_del(ud)
+
+// 输出到标准错误(标准输出为管道或文件时 abort 前来不及刷新)
+#define UD_BORROW_CHECK(ud)                                                         \
+    do                                                                              \
+    {                                                                               \
+        if (NULL != (ud)                                                            \
+            && (UD_LOCKED(ud) ? __ud_borrow_mine(ud) : (ud)->borrows > 0))          \
+        {                                                                           \
+            fprintf(stderr, "udlist: write during peek\n");                         \
+            abort();                                                                \
+        }                                                                           \
+    }                                                                               \
+    while (0)
+#else
+#define UD_BORROW_ADD(ud) do { } while (0)
+#define UD_BORROW_DEL(ud) do { } while (0)
+#define UD_BORROW_CHECK(ud) do { } while (0)
+#endif
+
+// 加写锁
+#define UD_WRLOCK(ud)                                   \
+    do                                                  \
+    {                                                   \
+        UD_BORROW_CHECK(ud);                            \
+        if (UD_LOCKED(ud))                              \
+        {                                               \
+            pthread_rwlock_wrlock(&(ud)->lock);         \
+            (ud)->writer = 1;                           \
+        }                                               \
+    }                                                   \
+    while (0)
+
+// 释放写锁
+#define UD_WRUNLOCK(ud)                                 \
+    do                                                  \
+    {                                                   \
+        if (UD_LOCKED(ud))                              \
+        {                                               \
+            (ud)->writer = 0;                           \
+            pthread_rwlock_unlock(&(ud)->lock);         \
+        }                                               \
+    }                                                   \
+    while (0)
+
+// 同时加两个链表的写锁: 按地址顺序加锁, 避免两个线程反向操作同一对链表时死锁
+#define UD_WRLOCK2(a, b)                                \
+    do                                                  \
+    {                                                   \
+        if ((unsigned long)(a) < (unsigned long)(b))    \
+        {                                               \
+            UD_WRLOCK(a);                               \
+            UD_WRLOCK(b);                               \
+        }                                               \
+        else                                            \
+        {                                               \
+            UD_WRLOCK(b);                               \
+            if ((a) != (b))                             \
+            {                                           \
+                UD_WRLOCK(a);                           \
+            }                                           \
+        }                                               \
+    }                                                   \
+    while (0)
+
+// 释放两个链表的写锁
+#define UD_WRUNLOCK2(a, b)                              \
+    do                                                  \
+    {                                                   \
+        if ((a) != (b))                                 \
+        {                                               \
+            UD_WRUNLOCK(a);                             \
+        }                                               \
+        UD_WRUNLOCK(b);                                 \
+    }                                                   \
+    while (0)
+
+// 是否可以刷新位置缓存: 并发模式下读者共享链表, 只有写者可以刷新
+#define UD_CACHE_OK(ud) (!(UDLIST_CONCURRENT & (ud)->flags) || (ud)->writer)
+
+
+
+#endif /* __UDLIST_LOCK_H__ */
@@ -0,0 +1,515 @@
+/**
+ * @file                udlist_parallel.c
+ * @brief               并行遍历及并行查找
+ * @author              BHR
+ * @version             v1.0
+ * @date                2024-03-07
+ * @copyright           MIT
+ */
+
+#include "udlist_parallel.h"
+#include "udlist_rank.h"
+#include "udlist_unrolled.h"
+#include "udlist_lock.h"
+#include "udlist_trace.h"
+
+/**
+ * @brief 单段匹配结果
+ */
+typedef struct _udpar_hits_t
+{
+    int *idx;                       // 匹配的元素索引(升序)
+    int n;                          // 匹配个数
+    int cap;                        // 数组容量
+}udpar_hits_t;
+
+
+/**
+ * @brief 并行任务定义
+ */
+typedef struct _udpar_job_t
+{
+    udlist_t *ud;                   // 链表头信息
+    udsplit_t *sp;                  // 分段点
+    pred_t fn;                      // 遍历函数(遍历任务)
+    void *ctx;                      // 遍历函数上下文
+    void *key;                      // 关键字(查找任务)
+    cmp_t op_cmp;                   // 比较函数(查找任务), 不为 NULL 表示查找任务
+    int next;                       // 下一个待领取的分段
+    int workers;                    // 允许加入的工作线程数
+    int joined;                     // 已加入的工作线程数
+    int ret;                        // 任务结果
+    udpar_hits_t hits[UDPAR_SEGS];  // 各段匹配结果
+}udpar_job_t;
+
+
+/* 线程池: 同一时间只执行一个任务, 忙时其他调用在自己的线程中依次处理 */
+static pthread_mutex_t __pool_run = PTHREAD_MUTEX_INITIALIZER;      // 任务执行权
+static pthread_mutex_t __pool_lock = PTHREAD_MUTEX_INITIALIZER;     // 保护以下状态
+static pthread_cond_t __pool_wake = PTHREAD_COND_INITIALIZER;       // 通知工作线程有新任务
+static pthread_cond_t __pool_idle = PTHREAD_COND_INITIALIZER;       // 通知调用线程工作线程已退出任务
+static udpar_job_t *__pool_job = NULL;                              // 当前任务
+static unsigned long __pool_gen = 0;                                // 任务序号
+static int __pool_threads = 0;                                      // 已创建的工作线程数
+static int __pool_active = 0;                                       // 正在执行任务的工作线程数
+
+/* 分段点缓存锁: 并发模式下多个读者可能同时刷新缓存 */
+static pthread_mutex_t __split_lock = PTHREAD_MUTEX_INITIALIZER;
+
+
+
+/**
+ * @brief           计算分段点
+ * @details         秩树模式按索引均分并由秩树选出起点;
+ *                  其他模式顺序走一遍(不调用自定义函数), 展开模式段起点对齐到块
+ * @param           链表头信息结构体指针(非空链表)
+ * @param           输出分段点
+ */
+static void __split_build(udlist_t *ud, udsplit_t *sp)
+{
+    node_t *p = ud->fstnode_p;
+    long long idx = 0;
+    int segs = ud->count / UDPAR_MIN_SEG;
+    int got = 1;
+    int s = 0;
+
+    segs = (segs < 1) ? 1 : ((segs > UDPAR_SEGS) ? UDPAR_SEGS : segs);
+    sp->mods = ud->mods;
+    sp->node[0] = p;
+    sp->index[0] = 0;
+
+    if (UDLIST_INDEXED & ud->flags)
+    {
+        for (s = 1; s < segs; s++)
+        {
+            sp->index[s] = (int)((long long)ud->count * s / segs);
+            sp->node[s] = udrank_select(ud, sp->index[s]);
+        } /* end of for (s = 1; s < segs; s++) */
+        got = segs;
+    }
+    else
+    {
+        // 走到最后一个段起点即可停止
+        do
+        {
+            if (idx >= (long long)ud->count * got / segs && idx > sp->index[got - 1])
+            {
+                sp->node[got] = p;
+                sp->index[got] = (int)idx;
+                got++;
+            } /* end of if (idx >= (long long)ud->count * got / segs && ...) */
+
+            idx += (UDLIST_UNROLLED & ud->flags) ? UD_BLOCK(p)->used : 1;
+            p = p->next;
+        }
+        while (p != ud->fstnode_p && got < segs);
+    }
+
+    sp->segs = got;
+    sp->index[got] = ud->count;
+}
+
+
+
+/**
+ * @brief           获取分段点
+ * @details         非秩树模式下结构修改计数未变化时复用缓存, 否则重新计算并刷新缓存
+ * @param           链表头信息结构体指针(非空链表)
+ * @param           输出分段点
+ */
+static void __split_get(udlist_t *ud, udsplit_t *sp)
+{
+    int hit = 0;
+
+    if (UDLIST_INDEXED & ud->flags)
+    {
+        __split_build(ud, sp);
+        return;
+    } /* end of if (UDLIST_INDEXED & ud->flags) */
+
+    /* 1.查找缓存 */
+    pthread_mutex_lock(&__split_lock);
+    if (NULL != ud->split && ud->split->mods == ud->mods)
+    {
+        memcpy(sp, ud->split, sizeof(udsplit_t));
+        hit = 1;
+    } /* end of if (NULL != ud->split && ud->split->mods == ud->mods) */
+    pthread_mutex_unlock(&__split_lock);
+
+    if (hit)
+    {
+        return;
+    } /* end of if (hit) */
+
+    /* 2.重新计算并刷新缓存(申请失败时只是不缓存) */
+    __split_build(ud, sp);
+    pthread_mutex_lock(&__split_lock);
+    if (NULL == ud->split)
+    {
+        ud->split = (udsplit_t *)malloc(sizeof(udsplit_t));
+    } /* end of if (NULL == ud->split) */
+    if (NULL != ud->split)
+    {
+        memcpy(ud->split, sp, sizeof(udsplit_t));
+    } /* end of if (NULL != ud->split) */
+    pthread_mutex_unlock(&__split_lock);
+}
+
+
+
+/**
+ * @brief           处理一个元素
+ * @param           任务
+ * @param           本段匹配结果
+ * @param           数据域
+ * @param           元素索引
+ */
+static void __elem_run(udpar_job_t *job, udpar_hits_t *h, void *data, int index)
+{
+    int *idx = NULL;
+
+    if (NULL == job->op_cmp)
+    {
+        job->fn(data, job->ctx);
+        return;
+    } /* end of if (NULL == job->op_cmp) */
+
+    if (MATCH_SUCCESS != job->op_cmp(data, job->key))
+    {
+        return;
+    } /* end of if (MATCH_SUCCESS != job->op_cmp(data, job->key)) */
+
+    /* 结果数组按 2 倍扩容 */
+    if (h->n == h->cap)
+    {
+        idx = (int *)realloc(h->idx, (size_t)(h->cap ? h->cap * 2 : 64) * sizeof(int));
+        if (NULL == idx)
+        {
+            __atomic_store_n(&job->ret, FUN_ERROR, __ATOMIC_RELAXED);
+            return;
+        } /* end of if (NULL == idx) */
+        h->idx = idx;
+        h->cap = h->cap ? h->cap * 2 : 64;
+    } /* end of if (h->n == h->cap) */
+    h->idx[h->n++] = index;
+}
+
+
+
+/**
+ * @brief           处理一个分段
+ * @param           任务
+ * @param           分段下标
+ */
+static void __seg_run(udpar_job_t *job, int s)
+{
+    udlist_t *ud = job->ud;
+    node_t *p = job->sp->node[s];
+    udpar_hits_t h = job->hits[s];
+    udblock_t *b = NULL;
+    int index = job->sp->index[s];
+    int end = job->sp->index[s + 1];
+    int i = 0;
+
+    while (index < end)
+    {
+        if (UDLIST_UNROLLED & ud->flags)
+        {
+            b = UD_BLOCK(p);
+            for (i = 0; i < b->used; i++, index++)
+            {
+                __elem_run(job, &h, UD_ELEM(ud, b, i), index);
+            } /* end of for (i = 0; i < b->used; i++, index++) */
+        }
+        else
+        {
+            __elem_run(job, &h, p->data, index);
+            index++;
+        }
+        p = p->next;
+    } /* end of while (index < end) */
+
+    job->hits[s] = h;
+}
+
+
+
+/**
+ * @brief           领取并处理分段直到全部领完
+ * @param           任务
+ */
+static void __job_run(udpar_job_t *job)
+{
+    int s = 0;
+
+    while ((s = __atomic_fetch_add(&job->next, 1, __ATOMIC_RELAXED)) < job->sp->segs)
+    {
+        __seg_run(job, s);
+    } /* end of while ((s = __atomic_fetch_add(&job->next, 1, __ATOMIC_RELAXED)) < ...) */
+}
+
+
+
+/**
+ * @brief           线程池工作线程
+ * @details         等待任务序号变化, 任务仍需要线程时加入; 线程不退出
+ * @param           未使用
+ * @return          NULL
+ */
+static void *__pool_worker(void *arg)
+{
+    udpar_job_t *job = NULL;
+    unsigned long seen = 0;
+
+    (void)arg;
+
+    pthread_mutex_lock(&__pool_lock);
+    while (1)
+    {
+        while (seen == __pool_gen)
+        {
+            pthread_cond_wait(&__pool_wake, &__pool_lock);
+        } /* end of while (seen == __pool_gen) */
+        seen = __pool_gen;
+
+        job = __pool_job;
+        if (NULL != job && job->joined < job->workers)
+        {
+            job->joined++;
+            __pool_active++;
+            pthread_mutex_unlock(&__pool_lock);
+
+            __job_run(job);
+
+            pthread_mutex_lock(&__pool_lock);
+            __pool_active--;
+            if (0 == __pool_active)
+            {
+                pthread_cond_signal(&__pool_idle);
+            } /* end of if (0 == __pool_active) */
+        } /* end of if (NULL != job && job->joined < job->workers) */
+    } /* end of while (1) */
+
+    return NULL;
+}
+
+
+
+/**
+ * @brief           执行任务
+ * @details         调用线程也参与处理; 单线程、只有一段或线程池正忙时在调用线程中依次处理
+ * @param           任务
+ * @param           线程数
+ */
+static void __pool_exec(udpar_job_t *job, int nthreads)
+{
+    pthread_attr_t attr;
+    pthread_t tid;
+    int workers = 0;
+    int i = 0;
+
+    nthreads = (nthreads > job->sp->segs) ? job->sp->segs : nthreads;
+    if (nthreads <= 1 || 0 != pthread_mutex_trylock(&__pool_run))
+    {
+        __job_run(job);
+        return;
+    } /* end of if (nthreads <= 1 || ...) */
+    workers = nthreads - 1;
+
+    /* 1.按需补足工作线程(创建失败时少用几个线程) */
+    pthread_mutex_lock(&__pool_lock);
+    if (__pool_threads < workers && 0 == pthread_attr_init(&attr))
+    {
+        pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+        while (__pool_threads < workers && 0 == pthread_create(&tid, &attr, __pool_worker, NULL))
+        {
+            __pool_threads++;
+        } /* end of while (__pool_threads < workers && ...) */
+        pthread_attr_destroy(&attr);
+    } /* end of if (__pool_threads < workers && 0 == pthread_attr_init(&attr)) */
+
+    /* 2.发布任务 */
+    job->workers = (workers > __pool_threads) ? __pool_threads : workers;
+    job->joined = 0;
+    __pool_job = job;
+    __pool_gen++;
+    for (i = 0; i < job->workers; i++)
+    {
+        pthread_cond_signal(&__pool_wake);
+    } /* end of for (i = 0; i < job->workers; i++) */
+    pthread_mutex_unlock(&__pool_lock);
+
+    /* 3.调用线程参与处理 */
+    __job_run(job);
+
+    /* 4.撤下任务并等待已加入的工作线程完成 */
+    pthread_mutex_lock(&__pool_lock);
+    __pool_job = NULL;
+    while (__pool_active > 0)
+    {
+        pthread_cond_wait(&__pool_idle, &__pool_lock);
+    } /* end of while (__pool_active > 0) */
+    pthread_mutex_unlock(&__pool_lock);
+
+    pthread_mutex_unlock(&__pool_run);
+}
+
+
+
+/**
+ * @brief           并行遍历链表
+ * @param           头信息结构体的指针
+ * @param           自定义函数(返回值忽略)
+ * @param           自定义函数上下文
+ * @param           线程数
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ */
+static int __udlist_traverse_parallel(udlist_t *ud, pred_t fn, void *ctx, int nthreads)
+{
+    udpar_job_t job;
+    udsplit_t sp;
+
+    /* 参数检查 */
+    if (NULL == ud || NULL == fn
+        || (UDLIST_LOCKFREE & ud->flags))
+    {
+        UD_ERROR("udlist_traverse_parallel: Parameter error\n");
+        goto ERR0;
+    } /* end of if (NULL == ud || NULL == fn || ...) */
+
+    /* 空链表直接返回 */
+    if (NULL == ud->fstnode_p)
+    {
+        return 0;
+    } /* end of if (NULL == ud->fstnode_p) */
+
+    /* 分段并执行 */
+    __split_get(ud, &sp);
+    memset(&job, 0, sizeof(job));
+    job.ud = ud;
+    job.sp = &sp;
+    job.fn = fn;
+    job.ctx = ctx;
+    __pool_exec(&job, nthreads);
+
+    return job.ret;
+
+
+ERR0:
+    return PAR_ERROR;
+}
+
+
+
+/**
+ * @brief           并行遍历链表(并发模式下持有读锁)
+ */
+int udlist_traverse_parallel(udlist_t *ud, pred_t fn, void *ctx, int nthreads)
+{
+    int ret = 0;
+
+    UD_RDLOCK(ud);
+    ret = __udlist_traverse_parallel(ud, fn, ctx, nthreads);
+    UD_RDUNLOCK(ud);
+
+    return ret;
+}
+
+
+
+/**
+ * @brief           并行查找所有匹配关键字的索引
+ * @param           头信息结构体的指针
+ * @param           关键字
+ * @param           自定义比较函数
+ * @param           线程数
+ * @return          存储索引链表
+ *      @arg  PAR_ERROR: 参数错误
+ *      @arg  NULL     : 没有找到匹配索引
+ */
+static udlist_t *__udlist_find_all_parallel(udlist_t *ud, void *key, cmp_t op_cmp, int nthreads)
+{
+    udlist_t *index_head = NULL;
+    udpar_job_t job;
+    udsplit_t sp;
+    int s = 0;
+
+    /* 参数检查 */
+    if (NULL == ud || NULL == key || NULL == op_cmp
+        || (UDLIST_LOCKFREE & ud->flags))
+    {
+        UD_ERROR("udlist_find_all_parallel: Parameter error\n");
+        goto ERR0;
+    } /* end of if (NULL == ud || NULL == key || ...) */
+
+    /* 判断链表是否存在 */
+    if (NULL == ud->fstnode_p)
+    {
+        goto ERR1;
+    } /* end of if (NULL == ud->fstnode_p) */
+
+    /* 1.各段并行查找 */
+    __split_get(ud, &sp);
+    memset(&job, 0, sizeof(job));
+    job.ud = ud;
+    job.sp = &sp;
+    job.key = key;
+    job.op_cmp = op_cmp;
+    __pool_exec(&job, nthreads);
+
+    /* 2.按段顺序合并, 结果与 udlist_find_all_index_by_key 相同 */
+    index_head = udlist_create_ex(sizeof(int), NULL, UDLIST_INLINE);
+    if ((void *)PAR_ERROR == index_head || (void *)FUN_ERROR == index_head)
+    {
+        index_head = NULL;
+        job.ret = FUN_ERROR;
+    } /* end of if ((void *)PAR_ERROR == index_head || ...) */
+    for (s = 0; s < sp.segs; s++)
+    {
+        if (0 == job.ret && job.hits[s].n > 0
+            && 0 != udlist_append_n(index_head, job.hits[s].idx, (size_t)job.hits[s].n))
+        {
+            job.ret = FUN_ERROR;
+        } /* end of if (0 == job.ret && job.hits[s].n > 0 && ...) */
+        free(job.hits[s].idx);
+    } /* end of for (s = 0; s < sp.segs; s++) */
+
+    if (0 != job.ret)
+    {
+        head_destroy(&index_head);
+        goto ERR1;
+    } /* end of if (0 != job.ret) */
+
+    /* 判断是否为空链表 */
+    if (0 == get_count(index_head))
+    {
+        head_destroy(&index_head);
+    } /* end of if (0 == get_count(index_head)) */
+
+
+    return index_head;
+
+
+ERR0:
+    return (void *)PAR_ERROR;
+ERR1:
+    return NULL;
+}
+
+
+
+/**
+ * @brief           并行查找所有匹配关键字的索引(并发模式下持有读锁)
+ */
+udlist_t *udlist_find_all_parallel(udlist_t *ud, void *key, cmp_t op_cmp, int nthreads)
+{
+    udlist_t *ret = NULL;
+
+    UD_RDLOCK(ud);
+    ret = __udlist_find_all_parallel(ud, key, op_cmp, nthreads);
+    UD_RDUNLOCK(ud);
+
+    return ret;
+}
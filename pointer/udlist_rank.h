@@ -0,0 +1,117 @@
+/**
+ * @file                udlist_rank.h
+ * @brief               链表秩树索引(UDLIST_INDEXED 模式)
+ * @details             以链表顺序为中序的隐式键 treap, 每个子树记录节点个数,
+                        按索引查找、插入、删除均为期望 O(log n);
+                        树节点放在链表节点头之前, 与节点在同一块空间中申请
+ * @author              BHR
+ * @version             v1.0
+ * @date                2024-03-07
+ * @copyright           MIT
+ */
+
+#ifndef __UDLIST_RANK_H__
+#define __UDLIST_RANK_H__
+
+#include "uni_doubly_linkedlist.h"
+
+/**
+ * @brief 秩树节点定义
+ */
+typedef struct _udrank_t
+{
+    struct _udrank_t *left;         // 左子树
+    struct _udrank_t *right;        // 右子树
+    struct _udrank_t *parent;       // 父节点
+    unsigned int prio;              // 堆优先级
+    int size;                       // 子树节点个数
+}udrank_t;
+
+
+// 链表节点与秩树节点互相转换
+#define UD_RANK(p)      ((udrank_t *)(p) - 1)
+#define UD_RANK_NODE(r) ((node_t *)((r) + 1))
+
+
+
+/**
+ * @brief           将已链接到链表中的节点插入秩树
+ * @param           头信息结构体的指针
+ * @param           节点指针
+ * @param           节点的索引
+ */
+void udrank_insert(udlist_t *ud, node_t *p, int index);
+
+
+/**
+ * @brief           将已链接到链表中的一段连续节点插入秩树
+ * @details         先按链表顺序 O(n) 建成一棵树, 再在 index 处并入
+ * @param           头信息结构体的指针
+ * @param           第一个节点指针
+ * @param           节点个数
+ * @param           第一个节点的索引
+ */
+void udrank_insert_n(udlist_t *ud, node_t *first, size_t n, int index);
+
+
+/**
+ * @brief           将节点从秩树中删除
+ * @param           头信息结构体的指针
+ * @param           节点指针
+ */
+void udrank_remove(udlist_t *ud, node_t *p);
+
+
+/**
+ * @brief           按索引查找节点 O(log n)
+ * @param           头信息结构体的指针
+ * @param           索引值(0 <= index < count)
+ * @return          节点指针
+ */
+node_t *udrank_select(udlist_t *ud, int index);
+
+
+/**
+ * @brief           计算节点的索引 O(log n)
+ * @param           头信息结构体的指针
+ * @param           节点指针
+ * @return          索引值
+ */
+int udrank_index(udlist_t *ud, node_t *p);
+
+
+/**
+ * @brief           有序链表中按关键字二分查找边界 O(log n)(UDLIST_SORTED 模式)
+ * @param           头信息结构体的指针
+ * @param           关键字(与元素同类型)
+ * @param           自定义排序比较函数
+ * @param           非 0 查找第一个大于关键字的元素, 0 查找第一个不小于关键字的元素
+ * @param           输出边界元素的索引(不存在时为元素个数)
+ * @return          边界节点指针, 不存在返回 NULL
+ */
+node_t *udrank_bound(udlist_t *ud, void *key, ord_t op_ord, int upper, int *index);
+
+
+/**
+ * @brief           从秩树中分离一段连续节点 O(log n)
+ * @details         被分离的节点仍在链表中, 由调用者摘下
+ * @param           头信息结构体的指针
+ * @param           第一个节点的索引
+ * @param           节点个数
+ * @return          分离出的子树根节点
+ */
+udrank_t *udrank_cut(udlist_t *ud, int index, int n);
+
+
+/**
+ * @brief           将一棵子树整体并入秩树 O(log n)
+ * @details         子树中的节点已按顺序链接到链表的 index 位置
+ * @param           头信息结构体的指针
+ * @param           子树根节点(由 udrank_cut 分离)
+ * @param           子树第一个节点的索引
+ */
+void udrank_paste(udlist_t *ud, udrank_t *t, int index);
+
+
+
+#endif /* __UDLIST_RANK_H__ */
@@ -0,0 +1,179 @@
+/**
+ * @file                udlist_shard.h
+ * @brief               分片链表
+ * @details             按关键字哈希值把元素分到 N 个独立的链表(分片)中,
+                        每个分片为并发模式(UDLIST_CONCURRENT)并使用自己的节点内存池,
+                        *_by_key 操作只锁定关键字所在的分片, 不同分片的操作可以并行;
+                        哈希函数必须保证比较匹配的数据和关键字哈希值相同(同 udlist_hash_attach)
+ * @author              BHR
+ * @version             v1.0
+ * @date                2024-03-07
+ * @copyright           MIT
+ */
+
+#ifndef __UDLIST_SHARD_H__
+#define __UDLIST_SHARD_H__
+
+#include "uni_doubly_linkedlist.h"
+
+// 每个分片内存池的每块节点个数
+#define UDSHARD_CHUNK 1024
+
+
+/**
+ * @brief 分片链表定义
+ */
+typedef struct _udlist_sharded_t
+{
+    udlist_t **shard;               // 分片链表数组
+    int shards;                     // 分片个数
+    int size;                       // 数据元素大小
+    hash_t my_hash;                 // 自定义哈希函数
+}udlist_sharded_t;
+
+
+
+/**
+ * @brief           创建分片链表
+ * @param           存储数据类型大小
+ * @param           自定义销毁数据函数(可以为 NULL, 语义同 UDLIST_INLINE)
+ * @param           自定义哈希函数
+ * @param           自定义比较函数, 不为 NULL 时每个分片附加哈希索引, 传入相同比较函数的 *_by_key 为 O(1)
+ * @param           分片个数
+ * @return          指向分片链表的指针
+ */
+udlist_sharded_t *udlist_sharded_create(int size, op_t my_destroy, hash_t my_hash, cmp_t op_cmp, int shards);
+
+
+/**
+ * @brief           获取关键字所在的分片
+ * @details         返回的分片可以直接调用 udlist_* 函数, 但插入的数据必须属于该分片
+ * @param           分片链表的指针
+ * @param           关键字(或数据)
+ * @return          分片链表头信息结构体的指针, 参数错误返回 NULL
+ */
+udlist_t *udlist_sharded_get(udlist_sharded_t *sh, void *key);
+
+
+/**
+ * @brief           插入数据到所在分片的尾部
+ * @param           分片链表的指针
+ * @param           数据的指针
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+int udlist_sharded_insert(udlist_sharded_t *sh, void *data);
+
+
+/**
+ * @brief           根据关键字删除第一个匹配的数据
+ * @param           分片链表的指针
+ * @param           关键字
+ * @param           自定义比较函数
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+int udlist_sharded_delete_by_key(udlist_sharded_t *sh, void *key, cmp_t op_cmp);
+
+
+/**
+ * @brief           根据关键字修改第一个匹配的数据
+ * @details         修改后的数据必须与原数据属于同一分片(关键字不变)
+ * @param           分片链表的指针
+ * @param           修改数据
+ * @param           关键字
+ * @param           自定义比较函数
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+int udlist_sharded_modify_by_key(udlist_sharded_t *sh, void *data, void *key, cmp_t op_cmp);
+
+
+/**
+ * @brief           根据关键字获取第一个匹配的数据
+ * @param           分片链表的指针
+ * @param           输出数据的指针
+ * @param           关键字
+ * @param           自定义比较函数
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+int udlist_sharded_retrieve_by_key(udlist_sharded_t *sh, void *data, void *key, cmp_t op_cmp);
+
+
+/**
+ * @brief           根据关键字删除所有匹配的数据
+ * @param           分片链表的指针
+ * @param           关键字
+ * @param           自定义比较函数
+ * @return          删除的个数, 参数错误返回 PAR_ERROR
+ */
+int udlist_sharded_delete_all_by_key(udlist_sharded_t *sh, void *key, cmp_t op_cmp);
+
+
+/**
+ * @brief           根据关键字修改所有匹配的数据
+ * @details         修改后的数据必须与原数据属于同一分片(关键字不变)
+ * @param           分片链表的指针
+ * @param           修改数据
+ * @param           关键字
+ * @param           自定义比较函数
+ * @return          修改的个数, 参数错误返回 PAR_ERROR
+ */
+int udlist_sharded_modify_all_by_key(udlist_sharded_t *sh, void *data, void *key, cmp_t op_cmp);
+
+
+/**
+ * @brief           获取所有分片的元素总数
+ * @param           分片链表的指针
+ * @return          元素个数, 参数错误返回 PAR_ERROR
+ */
+int udlist_sharded_get_count(udlist_sharded_t *sh);
+
+
+/**
+ * @brief           遍历所有分片
+ * @details         threads 大于 1 时多个线程并行遍历不同的分片, 每个分片遍历期间持有该分片的读锁,
+ *                  此时 my_print 必须可以被多个线程同时调用; 分片之间不保证顺序
+ * @param           分片链表的指针
+ * @param           自定义打印数据函数
+ * @param           遍历线程数(小于等于 1 时在调用线程中依次遍历)
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+int udlist_sharded_traverse(udlist_sharded_t *sh, op_t my_print, int threads);
+
+
+/**
+ * @brief           销毁所有分片中的数据(不包括分片链表本身)
+ * @param           分片链表的指针
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ */
+int udlist_sharded_destroy(udlist_sharded_t *sh);
+
+
+/**
+ * @brief           销毁分片链表本身
+ * @details         未销毁的数据随分片内存池一起释放, 不调用 my_destroy
+ * @param           分片链表的指针的地址
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ */
+int udlist_sharded_head_destroy(udlist_sharded_t **p);
+
+
+
+#endif /* __UDLIST_SHARD_H__ */
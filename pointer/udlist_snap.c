@@ -0,0 +1,609 @@
+/**
+ * @file                udlist_snap.c
+ * @brief               链表快照保存及加载
+ * @author              BHR
+ * @version             v1.0
+ * @date                2024-03-07
+ * @copyright           MIT
+ */
+
+#include <fcntl.h>
+#include <limits.h>
+#include <stddef.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "udlist_snap.h"
+#include "udlist_iter.h"
+#include "udlist_lock.h"
+#include "udlist_trace.h"
+
+// 保存时的写缓冲大小(必须为 UDSNAP_STRIPE 的整数倍)
+#define UDSNAP_BUF (1 << 20)
+
+// 校验和每次处理的字节数(4 路 x 8 字节)
+#define UDSNAP_STRIPE 32
+
+#define UDSNAP_P1 0x9E3779B185EBCA87ull
+#define UDSNAP_P2 0xC2B2AE3D27D4EB4Full
+#define UDSNAP_P3 0x165667B19E3779F9ull
+#define UDSNAP_P4 0x85EBCA77C2B2AE63ull
+#define UDSNAP_P5 0x27D4EB2F165667C5ull
+
+
+/**
+ * @brief 校验和状态
+ */
+typedef struct _udsnap_sum_t
+{
+    uint64_t v[4];                  // 4 路累加值
+    uint64_t total;                 // 已处理字节数
+}udsnap_sum_t;
+
+/**
+ * @brief 保存参数
+ */
+typedef struct _udsnap_save_t
+{
+    FILE *fp;                       // 临时文件
+    unsigned char *buf;             // 写缓冲
+    size_t used;                    // 写缓冲已用字节数
+    size_t size;                    // 元素大小
+    uint64_t count;                 // 已写元素个数
+    udsnap_sum_t sum;               // 校验和状态
+    int err;                        // 写文件失败
+}udsnap_save_t;
+
+
+/**
+ * @brief           循环左移
+ */
+static inline uint64_t __snap_rotl(uint64_t x, int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+/**
+ * @brief           读取 8 字节(不要求对齐)
+ */
+static inline uint64_t __snap_read64(const unsigned char *p)
+{
+    uint64_t x = 0;
+
+    memcpy(&x, p, sizeof(x));
+    return x;
+}
+
+/**
+ * @brief           单路混合一个 8 字节
+ */
+static inline uint64_t __snap_round(uint64_t acc, uint64_t x)
+{
+    acc += x * UDSNAP_P2;
+    acc = __snap_rotl(acc, 31);
+    return acc * UDSNAP_P1;
+}
+
+/**
+ * @brief           初始化校验和状态
+ */
+static void __snap_sum_init(udsnap_sum_t *s)
+{
+    s->v[0] = UDSNAP_P1 + UDSNAP_P2;
+    s->v[1] = UDSNAP_P2;
+    s->v[2] = 0;
+    s->v[3] = 0 - UDSNAP_P1;
+    s->total = 0;
+}
+
+/**
+ * @brief           累加数据, 只处理整 UDSNAP_STRIPE 字节的部分
+ * @details         4 路互不依赖, 每次 32 字节, 速度接近内存带宽
+ * @return          已处理的字节数, 剩余部分由 __snap_sum_final 处理
+ */
+static size_t __snap_sum_update(udsnap_sum_t *s, const unsigned char *p, size_t len)
+{
+    const unsigned char *end = p + (len - len % UDSNAP_STRIPE);
+    const unsigned char *q = p;
+    uint64_t v0 = s->v[0];
+    uint64_t v1 = s->v[1];
+    uint64_t v2 = s->v[2];
+    uint64_t v3 = s->v[3];
+
+    for (; q < end; q += UDSNAP_STRIPE)
+    {
+        v0 = __snap_round(v0, __snap_read64(q));
+        v1 = __snap_round(v1, __snap_read64(q + 8));
+        v2 = __snap_round(v2, __snap_read64(q + 16));
+        v3 = __snap_round(v3, __snap_read64(q + 24));
+    } /* end of for (; q < end; q += UDSNAP_STRIPE) */
+
+    s->v[0] = v0;
+    s->v[1] = v1;
+    s->v[2] = v2;
+    s->v[3] = v3;
+    s->total += (uint64_t)(q - p);
+
+    return (size_t)(q - p);
+}
+
+/**
+ * @brief           处理剩余不足 UDSNAP_STRIPE 的字节并得到校验和
+ */
+static uint64_t __snap_sum_final(udsnap_sum_t *s, const unsigned char *p, size_t len)
+{
+    uint64_t h = __snap_rotl(s->v[0], 1) + __snap_rotl(s->v[1], 7)
+               + __snap_rotl(s->v[2], 12) + __snap_rotl(s->v[3], 18);
+    size_t i = 0;
+
+    h += s->total + len;
+    for (i = 0; i + 8 <= len; i += 8)
+    {
+        h ^= __snap_round(0, __snap_read64(p + i));
+        h = __snap_rotl(h, 27) * UDSNAP_P1 + UDSNAP_P4;
+    } /* end of for (i = 0; i + 8 <= len; i += 8) */
+    for (; i < len; i++)
+    {
+        h ^= p[i] * UDSNAP_P5;
+        h = __snap_rotl(h, 11) * UDSNAP_P1;
+    } /* end of for (; i < len; i++) */
+
+    h ^= h >> 33;
+    h *= UDSNAP_P2;
+    h ^= h >> 29;
+    h *= UDSNAP_P3;
+    h ^= h >> 32;
+
+    return h;
+}
+
+/**
+ * @brief           写出写缓冲中的数据并累加校验和
+ * @details         缓冲满时写出, 缓冲大小为 UDSNAP_STRIPE 的整数倍, 不会留下未处理的字节
+ */
+static int __snap_flush(udsnap_save_t *sv)
+{
+    __snap_sum_update(&sv->sum, sv->buf, sv->used);
+    if (fwrite(sv->buf, 1, sv->used, sv->fp) != sv->used)
+    {
+        sv->err = 1;
+        return FUN_ERROR;
+    } /* end of if (fwrite(sv->buf, 1, sv->used, sv->fp) != sv->used) */
+    sv->used = 0;
+
+    return 0;
+}
+
+/**
+ * @brief           把一个元素拷贝到写缓冲, 缓冲满时写出
+ * @return          0 正常, 1 写文件失败
+ */
+static int __snap_put(udsnap_save_t *sv, const void *data)
+{
+    const unsigned char *p = (const unsigned char *)data;
+    size_t left = sv->size;
+    size_t n = 0;
+
+    while (left > 0)
+    {
+        n = UDSNAP_BUF - sv->used;
+        n = (n < left) ? n : left;
+        memcpy(sv->buf + sv->used, p, n);
+        sv->used += n;
+        p += n;
+        left -= n;
+        if (UDSNAP_BUF == sv->used && 0 != __snap_flush(sv))
+        {
+            return 1;
+        } /* end of if (UDSNAP_BUF == sv->used && 0 != __snap_flush(sv)) */
+    } /* end of while (left > 0) */
+    sv->count++;
+
+    return 0;
+}
+
+/**
+ * @brief           映射快照文件并校验文件头
+ * @param           快照文件路径
+ * @param           非 0 时校验数据区
+ * @param           输出映射长度
+ * @return          映射起始地址
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+static void *__snap_map(const char *path, int verify, size_t *len)
+{
+    const udsnap_head_t *head = NULL;
+    struct stat st;
+    void *map = NULL;
+    int fd = -1;
+
+    /* 1.打开并映射文件 */
+    fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        UD_ERROR("udlist_snap: open %s error\n", path);
+        goto ERR0;
+    } /* end of if (fd < 0) */
+    if (0 != fstat(fd, &st) || st.st_size < UDSNAP_HEAD_SIZE)
+    {
+        UD_ERROR("udlist_snap: %s is not a snapshot\n", path);
+        goto ERR1;
+    } /* end of if (0 != fstat(fd, &st) || st.st_size < UDSNAP_HEAD_SIZE) */
+    map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (MAP_FAILED == map)
+    {
+        UD_ERROR("udlist_snap: mmap error\n");
+        goto ERR1;
+    } /* end of if (MAP_FAILED == map) */
+    close(fd);
+    *len = (size_t)st.st_size;
+
+    /* 2.校验文件头: 标识、版本、文件头校验和、长度(与 verify 无关, seq 错误会使日志恢复跳过记录) */
+    head = (const udsnap_head_t *)map;
+    if (0 != memcmp(head->magic, "UDLS", 4) || UDSNAP_VERSION != head->version
+        || udsnap_sum(head, offsetof(udsnap_head_t, head_sum)) != head->head_sum || 0 == head->size
+        || head->size > INT_MAX || head->count > INT_MAX
+        || (uint64_t)*len - UDSNAP_HEAD_SIZE != head->count * head->size)
+    {
+        UD_ERROR("udlist_snap: %s bad header\n", path);
+        goto ERR2;
+    } /* end of if (0 != memcmp(head->magic, "UDLS", 4) || ...) */
+
+    /* 3.校验数据区 */
+    if (verify)
+    {
+        madvise(map, *len, MADV_SEQUENTIAL);
+        if (udsnap_sum((const unsigned char *)map + UDSNAP_HEAD_SIZE, *len - UDSNAP_HEAD_SIZE) != head->sum)
+        {
+            UD_ERROR("udlist_snap: %s checksum mismatch\n", path);
+            goto ERR2;
+        } /* end of if (udsnap_sum(...) != head->sum) */
+    } /* end of if (verify) */
+
+    return map;
+
+ERR2:
+    munmap(map, *len);
+    return (void *)FUN_ERROR;
+ERR1:
+    close(fd);
+ERR0:
+    return (void *)FUN_ERROR;
+}
+
+
+
+/**
+ * @brief           计算一段连续数据的校验和
+ * @param           数据起始地址
+ * @param           数据长度
+ * @return          64 位校验和
+ */
+uint64_t udsnap_sum(const void *p, size_t len)
+{
+    udsnap_sum_t s;
+    size_t done = 0;
+
+    __snap_sum_init(&s);
+    done = __snap_sum_update(&s, (const unsigned char *)p, len);
+
+    return __snap_sum_final(&s, (const unsigned char *)p + done, len - done);
+}
+
+
+/**
+ * @brief           保存链表快照(调用者持有锁)
+ * @param           头信息结构体的指针
+ * @param           快照文件路径
+ * @param           写入文件头的日志记录序号
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误(文件读写失败)
+ */
+int udsnap_save(udlist_t *ud, const char *path, uint64_t seq)
+{
+    udsnap_save_t sv;
+    udsnap_head_t head;
+    udlist_iter_t it;
+    unsigned char pad[UDSNAP_HEAD_SIZE];
+    char *tmp = NULL;
+    size_t n = 0;
+    int ret = 0;
+
+    /* 参数检查 */
+    if (NULL == ud || NULL == path || (ud->flags & UDLIST_LOCKFREE))
+    {
+        UD_ERROR("udlist_save: Parameter error\n");
+        goto ERR0;
+    } /* end of if (NULL == ud || NULL == path || (ud->flags & UDLIST_LOCKFREE)) */
+
+    /* 1.申请临时文件名及写缓冲 */
+    memset(&sv, 0, sizeof(sv));
+    tmp = (char *)malloc(strlen(path) + 5);
+    sv.buf = (unsigned char *)malloc(UDSNAP_BUF);
+    if (NULL == tmp || NULL == sv.buf)
+    {
+        UD_ALLOC_ERROR("udlist_save: malloc error\n");
+        goto ERR1;
+    } /* end of if (NULL == tmp || NULL == sv.buf) */
+    sprintf(tmp, "%s.tmp", path);
+
+    sv.fp = fopen(tmp, "wb");
+    if (NULL == sv.fp)
+    {
+        UD_ERROR("udlist_save: fopen %s error\n", tmp);
+        goto ERR1;
+    } /* end of if (NULL == sv.fp) */
+
+    /* 2.先写占位文件头, 再遍历写出数据 */
+    memset(pad, 0, sizeof(pad));
+    if (fwrite(pad, 1, sizeof(pad), sv.fp) != sizeof(pad))
+    {
+        goto ERR2;
+    } /* end of if (fwrite(pad, 1, sizeof(pad), sv.fp) != sizeof(pad)) */
+    sv.size = (size_t)ud->size;
+    __snap_sum_init(&sv.sum);
+    for (udlist_iter_begin(&it, ud); udlist_iter_valid(&it) && 0 == sv.err; udlist_iter_next(&it))
+    {
+        __snap_put(&sv, udlist_iter_get(&it));
+    } /* end of for (udlist_iter_begin(&it, ud); ...) */
+    if (sv.err || fwrite(sv.buf, 1, sv.used, sv.fp) != sv.used)
+    {
+        goto ERR2;
+    } /* end of if (sv.err || fwrite(sv.buf, 1, sv.used, sv.fp) != sv.used) */
+
+    /* 3.回填文件头 */
+    memset(&head, 0, sizeof(head));
+    memcpy(head.magic, "UDLS", 4);
+    head.version = UDSNAP_VERSION;
+    head.size = (uint32_t)ud->size;
+    head.count = sv.count;
+    n = __snap_sum_update(&sv.sum, sv.buf, sv.used);
+    head.sum = __snap_sum_final(&sv.sum, sv.buf + n, sv.used - n);
+    head.seq = seq;
+    head.head_sum = udsnap_sum(&head, offsetof(udsnap_head_t, head_sum));
+    if (0 != fseek(sv.fp, 0, SEEK_SET) || fwrite(&head, 1, sizeof(head), sv.fp) != sizeof(head))
+    {
+        goto ERR2;
+    } /* end of if (0 != fseek(sv.fp, 0, SEEK_SET) || ...) */
+
+    /* 4.同步到磁盘后改名 */
+    if (0 != fflush(sv.fp) || 0 != fsync(fileno(sv.fp)))
+    {
+        goto ERR2;
+    } /* end of if (0 != fflush(sv.fp) || 0 != fsync(fileno(sv.fp))) */
+    ret = fclose(sv.fp);
+    sv.fp = NULL;
+    if (0 != ret || 0 != rename(tmp, path))
+    {
+        goto ERR2;
+    } /* end of if (0 != ret || 0 != rename(tmp, path)) */
+
+    free(sv.buf);
+    free(tmp);
+
+    return 0;
+
+ERR0:
+    return PAR_ERROR;
+ERR2:
+    UD_ERROR("udlist_save: write %s error\n", tmp);
+    if (NULL != sv.fp)
+    {
+        fclose(sv.fp);
+    } /* end of if (NULL != sv.fp) */
+    unlink(tmp);
+ERR1:
+    free(sv.buf);
+    free(tmp);
+    return FUN_ERROR;
+}
+
+
+/**
+ * @brief           保存链表快照(并发模式下持有读锁)
+ */
+int udlist_save(udlist_t *ud, const char *path)
+{
+    int ret = 0;
+
+    UD_RDLOCK(ud);
+    ret = udsnap_save(ud, path, 0);
+    UD_RDUNLOCK(ud);
+
+    return ret;
+}
+
+
+/**
+ * @brief           加载快照, 创建内联模式的链表
+ * @details         同 udlist_load_ex(path, my_destroy, UDLIST_INLINE)
+ * @param           快照文件路径
+ * @param           自定义销毁数据函数(可以为 NULL)
+ * @return          指向链表头信息结构体的指针
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误(文件读写失败、格式错误或校验和不符)
+ */
+udlist_t *udlist_load(const char *path, op_t my_destroy)
+{
+    return udsnap_load(path, my_destroy, UDLIST_INLINE, NULL);
+}
+
+
+/**
+ * @brief           加载快照并输出文件头中的日志记录序号
+ * @param           快照文件路径
+ * @param           自定义销毁数据函数
+ * @param           存储模式, 同 udlist_create_ex
+ * @param           输出日志记录序号(可以为 NULL)
+ * @return          指向链表头信息结构体的指针
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误(文件读写失败、格式错误或校验和不符)
+ */
+udlist_t *udsnap_load(const char *path, op_t my_destroy, int flags, uint64_t *seq)
+{
+    const udsnap_head_t *head = NULL;
+    udlist_t *ud = NULL;
+    void *map = NULL;
+    size_t len = 0;
+
+    /* 参数检查 */
+    if (NULL == path)
+    {
+        UD_ERROR("udlist_load: Parameter error\n");
+        goto ERR0;
+    } /* end of if (NULL == path) */
+
+    /* 1.映射并校验文件 */
+    map = __snap_map(path, 1, &len);
+    if ((void *)FUN_ERROR == map)
+    {
+        goto ERR1;
+    } /* end of if ((void *)FUN_ERROR == map) */
+    head = (const udsnap_head_t *)map;
+    if (NULL != seq)
+    {
+        *seq = head->seq;
+    } /* end of if (NULL != seq) */
+
+    /* 2.创建链表并一次批量插入 */
+    ud = udlist_create_ex((int)head->size, my_destroy, flags);
+    if ((void *)PAR_ERROR == ud || (void *)FUN_ERROR == ud)
+    {
+        munmap(map, len);
+        return ud;
+    } /* end of if ((void *)PAR_ERROR == ud || (void *)FUN_ERROR == ud) */
+    if (head->count > 0 && 0 != udlist_append_n(ud, (const unsigned char *)map + UDSNAP_HEAD_SIZE, (size_t)head->count))
+    {
+        goto ERR2;
+    } /* end of if (head->count > 0 && 0 != udlist_append_n(...)) */
+
+    munmap(map, len);
+
+    return ud;
+
+ERR0:
+    return (void *)PAR_ERROR;
+ERR2:
+    udlist_destroy(ud);
+    head_destroy(&ud);
+    munmap(map, len);
+ERR1:
+    return (void *)FUN_ERROR;
+}
+
+
+/**
+ * @brief           按指定存储模式加载快照
+ * @details         mmap 文件并校验后, 按 udlist_create_ex 创建链表并一次批量插入所有元素(同 udlist_append_n);
+ *                  数据区校验和与数据一起顺序读过, 不需要额外的随机访问
+ * @param           快照文件路径
+ * @param           自定义销毁数据函数
+ * @param           存储模式, 同 udlist_create_ex
+ * @return          指向链表头信息结构体的指针
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误(文件读写失败、格式错误或校验和不符)
+ */
+udlist_t *udlist_load_ex(const char *path, op_t my_destroy, int flags)
+{
+    return udsnap_load(path, my_destroy, flags, NULL);
+}
+
+
+/**
+ * @brief           以只读视图打开快照
+ * @details         元素直接位于文件映射中, 不建立节点, 打开耗时与元素个数无关(不校验时);
+ *                  按需读入文件页, 元素不能修改
+ * @param           快照文件路径
+ * @param           非 0 打开时校验数据区(需要读入整个文件)
+ * @return          视图的指针
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误(文件读写失败、格式错误或校验和不符)
+ */
+udlist_view_t *udlist_view_open(const char *path, int verify)
+{
+    const udsnap_head_t *head = NULL;
+    udlist_view_t *v = NULL;
+    void *map = NULL;
+    size_t len = 0;
+
+    /* 参数检查 */
+    if (NULL == path)
+    {
+        UD_ERROR("udlist_view_open: Parameter error\n");
+        goto ERR0;
+    } /* end of if (NULL == path) */
+
+    /* 1.映射文件 */
+    map = __snap_map(path, verify, &len);
+    if ((void *)FUN_ERROR == map)
+    {
+        goto ERR1;
+    } /* end of if ((void *)FUN_ERROR == map) */
+    head = (const udsnap_head_t *)map;
+
+    /* 2.填写视图 */
+    v = (udlist_view_t *)calloc(1, sizeof(udlist_view_t));
+    if (NULL == v)
+    {
+        UD_ALLOC_ERROR("udlist_view_open: calloc error\n");
+        goto ERR2;
+    } /* end of if (NULL == v) */
+    v->map = map;
+    v->len = len;
+    v->size = (int)head->size;
+    v->count = (int)head->count;
+    v->base = (unsigned char *)map + UDSNAP_HEAD_SIZE;
+
+    return v;
+
+ERR0:
+    return (void *)PAR_ERROR;
+ERR2:
+    munmap(map, len);
+ERR1:
+    return (void *)FUN_ERROR;
+}
+
+
+/**
+ * @brief           获取视图中索引位置元素的地址 O(1)
+ * @param           视图的指针
+ * @param           索引值
+ * @return          元素地址(只读), 参数错误返回 NULL
+ */
+const void *udlist_view_at(udlist_view_t *v, int index)
+{
+    if (NULL == v || index < 0 || index >= v->count)
+    {
+        return NULL;
+    } /* end of if (NULL == v || index < 0 || index >= v->count) */
+
+    return v->base + (size_t)index * (size_t)v->size;
+}
+
+
+/**
+ * @brief           关闭视图, 解除文件映射
+ * @param           视图的指针的地址
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ */
+int udlist_view_close(udlist_view_t **v)
+{
+    /* 参数检查 */
+    if (NULL == v || NULL == *v)
+    {
+        UD_ERROR("udlist_view_close: Parameter error\n");
+        return PAR_ERROR;
+    } /* end of if (NULL == v || NULL == *v) */
+
+    munmap((*v)->map, (*v)->len);
+    free(*v);
+    *v = NULL;
+
+    return 0;
+}
@@ -0,0 +1,168 @@
+/**
+ * @file                udlist_snap.h
+ * @brief               链表快照保存及加载
+ * @details             快照文件为 64 字节文件头 + 紧密排列的元素数据(count * size 字节),
+                        文件头记录格式版本、元素大小、元素个数、数据区及文件头本身的 64 位校验和, 使用本机字节序;
+                        只保存数据域的字节, 数据中的指针等进程内资源不会被保存;
+                        加载时 mmap 文件, 可以一次批量建立链表节点, 也可以直接在映射上提供只读视图
+ * @author              BHR
+ * @version             v1.0
+ * @date                2024-03-07
+ * @copyright           MIT
+ */
+
+#ifndef __UDLIST_SNAP_H__
+#define __UDLIST_SNAP_H__
+
+#include <stdint.h>
+#include "uni_doubly_linkedlist.h"
+
+// 快照文件格式版本
+#define UDSNAP_VERSION 2
+
+// 文件头大小, 数据区从此偏移开始(保证元素按 64 字节对齐起始)
+#define UDSNAP_HEAD_SIZE 64
+
+
+/**
+ * @brief 快照文件头定义
+ */
+typedef struct _udsnap_head_t
+{
+    char magic[4];                  // 文件标识 "UDLS"
+    uint32_t version;               // 格式版本
+    uint32_t size;                  // 元素大小
+    uint32_t reserved;              // 保留, 写 0
+    uint64_t count;                 // 元素个数
+    uint64_t sum;                   // 数据区校验和
+    uint64_t seq;                   // 快照包含的最后一条日志记录序号(udlist_wal_checkpoint), 0 表示无
+    uint64_t head_sum;              // 文件头校验和(magic 到 seq), 每次打开都校验
+}udsnap_head_t;
+
+
+/**
+ * @brief 只读快照视图定义
+ */
+typedef struct _udlist_view_t
+{
+    void *map;                      // 文件映射起始地址
+    size_t len;                     // 映射长度
+    int size;                       // 元素大小
+    int count;                      // 元素个数
+    unsigned char *base;            // 第一个元素的地址
+}udlist_view_t;
+
+
+
+/**
+ * @brief           计算一段连续数据的校验和
+ * @details         4 路各 8 字节并行混合, 速度接近内存带宽; 快照数据区及日志记录共用
+ * @param           数据起始地址
+ * @param           数据长度
+ * @return          64 位校验和
+ */
+uint64_t udsnap_sum(const void *p, size_t len);
+
+
+/**
+ * @brief           保存链表快照(调用者持有锁)
+ * @details         同 udlist_save, 文件头写入日志记录序号; 供 udlist_wal_checkpoint 在持有写锁时调用
+ * @param           头信息结构体的指针
+ * @param           快照文件路径
+ * @param           写入文件头的日志记录序号
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误(文件读写失败)
+ */
+int udsnap_save(udlist_t *ud, const char *path, uint64_t seq);
+
+
+/**
+ * @brief           加载快照并输出文件头中的日志记录序号
+ * @param           快照文件路径
+ * @param           自定义销毁数据函数
+ * @param           存储模式, 同 udlist_create_ex
+ * @param           输出日志记录序号(可以为 NULL)
+ * @return          指向链表头信息结构体的指针
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误(文件读写失败、格式错误或校验和不符)
+ */
+udlist_t *udsnap_load(const char *path, op_t my_destroy, int flags, uint64_t *seq);
+
+
+/**
+ * @brief           保存链表快照
+ * @details         先写入 path.tmp, 写完并同步到磁盘后改名为 path, 失败时不影响已有的快照;
+ *                  遍历期间持有读锁(并发模式)
+ * @note            UDLIST_LOCKFREE 模式不支持, 返回 PAR_ERROR
+ * @param           头信息结构体的指针
+ * @param           快照文件路径
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误(文件读写失败)
+ */
+int udlist_save(udlist_t *ud, const char *path);
+
+
+/**
+ * @brief           加载快照, 创建内联模式的链表
+ * @details         同 udlist_load_ex(path, my_destroy, UDLIST_INLINE)
+ * @param           快照文件路径
+ * @param           自定义销毁数据函数(可以为 NULL)
+ * @return          指向链表头信息结构体的指针
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误(文件读写失败、格式错误或校验和不符)
+ */
+udlist_t *udlist_load(const char *path, op_t my_destroy);
+
+
+/**
+ * @brief           按指定存储模式加载快照
+ * @details         mmap 文件并校验后, 按 udlist_create_ex 创建链表并一次批量插入所有元素(同 udlist_append_n);
+ *                  数据区校验和与数据一起顺序读过, 不需要额外的随机访问
+ * @param           快照文件路径
+ * @param           自定义销毁数据函数
+ * @param           存储模式, 同 udlist_create_ex
+ * @return          指向链表头信息结构体的指针
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误(文件读写失败、格式错误或校验和不符)
+ */
+udlist_t *udlist_load_ex(const char *path, op_t my_destroy, int flags);
+
+
+/**
+ * @brief           以只读视图打开快照
+ * @details         元素直接位于文件映射中, 不建立节点, 打开耗时与元素个数无关(不校验时);
+ *                  按需读入文件页, 元素不能修改
+ * @param           快照文件路径
+ * @param           非 0 打开时校验数据区(需要读入整个文件)
+ * @return          视图的指针
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误(文件读写失败、格式错误或校验和不符)
+ */
+udlist_view_t *udlist_view_open(const char *path, int verify);
+
+
+/**
+ * @brief           获取视图中索引位置元素的地址 O(1)
+ * @param           视图的指针
+ * @param           索引值
+ * @return          元素地址(只读), 参数错误返回 NULL
+ */
+const void *udlist_view_at(udlist_view_t *v, int index);
+
+
+/**
+ * @brief           关闭视图, 解除文件映射
+ * @param           视图的指针的地址
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ */
+int udlist_view_close(udlist_view_t **v);
+
+
+
+#endif /* __UDLIST_SNAP_H__ */
@@ -0,0 +1,233 @@
+/**
+ * @file                udlist_stats.c
+ * @brief               链表操作统计
+ * @author              BHR
+ * @version             v1.0
+ * @date                2024-03-07
+ * @copyright           MIT
+ */
+
+#include <time.h>
+#include "udlist_stats.h"
+#include "udlist_trace.h"
+
+// 统计块中的计数个数
+#define UDSTAT_WORDS (sizeof(udstats_t) / sizeof(unsigned long long))
+
+#ifdef UDLIST_STATS
+/**
+ * @brief 接口名称(按 UDSTAT_* 编号)
+ */
+static const char *s_op_name[UDSTAT_OPS] =
+{
+    "append", "prepend", "append_n", "prepend_n", "pop_front", "pop_back",
+    "insert_by_index", "delete_by_index", "modify_by_index", "retrieve_by_index",
+    "delete_by_key", "modify_by_key", "retrieve_by_key", "delete_all_by_key", "modify_all_by_key",
+    "find_all_index", "remove_if", "find_node", "peek_by_index", "peek_by_key",
+    "traverse", "traverse_back", "traverse_ex", "sort", "destroy"
+};
+
+
+/**
+ * @brief           按直方图估计分位数
+ * @param           直方图
+ * @param           总次数
+ * @param           分位(0~1)
+ * @return          所在桶的上界(纳秒)
+ */
+static unsigned long long __stat_quantile(const unsigned long long *hist, unsigned long long total, double q)
+{
+    unsigned long long need = (unsigned long long)(q * (double)total);
+    unsigned long long sum = 0;
+    int b = 0;
+
+    for (b = 0; b < UDSTAT_BUCKETS - 1; b++)
+    {
+        sum += hist[b];
+        if (sum > need)
+        {
+            break;
+        } /* end of if (sum > need) */
+    } /* end of for (b = 0; b < UDSTAT_BUCKETS - 1; b++) */
+
+    return 2ull << b;
+}
+#endif /* UDLIST_STATS */
+
+
+
+/**
+ * @brief           获取统计(拷贝)
+ * @param           头信息结构体的指针
+ * @return          统计块的拷贝, 未定义 UDLIST_STATS 或参数错误时全为 0
+ */
+udstats_t udlist_stats_get(udlist_t *ud)
+{
+    udstats_t st;
+
+    memset(&st, 0, sizeof(st));
+#ifdef UDLIST_STATS
+    unsigned long long *dst = (unsigned long long *)&st;
+    unsigned long long *src = NULL;
+    size_t i = 0;
+
+    if (NULL != ud && NULL != ud->stats)
+    {
+        // 逐项原子读取, 各项之间不保证是同一时刻的值
+        src = (unsigned long long *)ud->stats;
+        for (i = 0; i < UDSTAT_WORDS; i++)
+        {
+            dst[i] = __atomic_load_n(&src[i], __ATOMIC_RELAXED);
+        } /* end of for (i = 0; i < UDSTAT_WORDS; i++) */
+    } /* end of if (NULL != ud && NULL != ud->stats) */
+#else
+    (void)ud;
+#endif
+
+    return st;
+}
+
+
+/**
+ * @brief           清零统计
+ * @param           头信息结构体的指针
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误(未定义 UDLIST_STATS)
+ */
+int udlist_stats_reset(udlist_t *ud)
+{
+    /* 参数检查 */
+    if (NULL == ud)
+    {
+        UD_ERROR("udlist_stats_reset: Parameter error\n");
+        return PAR_ERROR;
+    } /* end of if (NULL == ud) */
+
+#ifdef UDLIST_STATS
+    unsigned long long *p = (unsigned long long *)ud->stats;
+    size_t i = 0;
+
+    if (NULL == p)
+    {
+        return FUN_ERROR;
+    } /* end of if (NULL == p) */
+    for (i = 0; i < UDSTAT_WORDS; i++)
+    {
+        __atomic_store_n(&p[i], 0, __ATOMIC_RELAXED);
+    } /* end of for (i = 0; i < UDSTAT_WORDS; i++) */
+
+    return 0;
+#else
+    return FUN_ERROR;
+#endif
+}
+
+
+/**
+ * @brief           输出统计
+ * @details         每个调用过的接口一行: 调用次数、平均耗时、按直方图估计的 p50 / p99, 以及非空的直方图桶
+ * @param           头信息结构体的指针
+ * @param           输出文件(如 stdout)
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误(未定义 UDLIST_STATS)
+ */
+int udlist_stats_dump(udlist_t *ud, FILE *fp)
+{
+    /* 参数检查 */
+    if (NULL == ud || NULL == fp)
+    {
+        UD_ERROR("udlist_stats_dump: Parameter error\n");
+        return PAR_ERROR;
+    } /* end of if (NULL == ud || NULL == fp) */
+
+#ifdef UDLIST_STATS
+    udstats_t st = udlist_stats_get(ud);
+    int op = 0;
+    int b = 0;
+
+    if (NULL == ud->stats)
+    {
+        return FUN_ERROR;
+    } /* end of if (NULL == ud->stats) */
+
+    /* 1.全局计数 */
+    fprintf(fp, "udlist stats: count=%d visits=%llu cmps=%llu allocs=%llu frees=%llu\n",
+            ud->count, st.visits, st.cmps, st.allocs, st.frees);
+
+    /* 2.各接口的调用次数及耗时 */
+    fprintf(fp, "  %-18s %12s %10s %10s %10s  %s\n", "op", "calls", "avg(ns)", "p50(ns)", "p99(ns)", "histogram [log2 ns]:count");
+    for (op = 0; op < UDSTAT_OPS; op++)
+    {
+        if (0 == st.calls[op])
+        {
+            continue;
+        } /* end of if (0 == st.calls[op]) */
+
+        fprintf(fp, "  %-18s %12llu %10llu %10llu %10llu ", s_op_name[op], st.calls[op], st.ns[op] / st.calls[op],
+                __stat_quantile(st.hist[op], st.calls[op], 0.5), __stat_quantile(st.hist[op], st.calls[op], 0.99));
+        for (b = 0; b < UDSTAT_BUCKETS; b++)
+        {
+            if (0 != st.hist[op][b])
+            {
+                fprintf(fp, " %d:%llu", b, st.hist[op][b]);
+            } /* end of if (0 != st.hist[op][b]) */
+        } /* end of for (b = 0; b < UDSTAT_BUCKETS; b++) */
+        fprintf(fp, "\n");
+    } /* end of for (op = 0; op < UDSTAT_OPS; op++) */
+
+    return 0;
+#else
+    fprintf(fp, "udlist stats: disabled (compile with -DUDLIST_STATS)\n");
+    return FUN_ERROR;
+#endif
+}
+
+
+/**
+ * @brief           获取单调时钟(纳秒)
+ * @return          纳秒
+ */
+unsigned long long udstats_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ull + (unsigned long long)ts.tv_nsec;
+}
+
+
+/**
+ * @brief           记录一次接口调用
+ * @param           头信息结构体的指针(可以为 NULL)
+ * @param           接口编号 UDSTAT_*
+ * @param           开始时间(udstats_now)
+ */
+void udstats_record(udlist_t *ud, int op, unsigned long long t0)
+{
+#ifdef UDLIST_STATS
+    unsigned long long d = 0;
+    int b = 0;
+
+    if (NULL == ud || NULL == ud->stats)
+    {
+        return;
+    } /* end of if (NULL == ud || NULL == ud->stats) */
+
+    /* 桶号为耗时的二进制位数减 1 */
+    d = udstats_now() - t0;
+    b = 63 - __builtin_clzll(d | 1);
+    b = (b < UDSTAT_BUCKETS) ? b : UDSTAT_BUCKETS - 1;
+
+    __atomic_fetch_add(&ud->stats->calls[op], 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&ud->stats->ns[op], d, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&ud->stats->hist[op][b], 1, __ATOMIC_RELAXED);
+#else
+    (void)ud;
+    (void)op;
+    (void)t0;
+#endif
+}
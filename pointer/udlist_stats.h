@@ -0,0 +1,145 @@
+/**
+ * @file                udlist_stats.h
+ * @brief               链表操作统计
+ * @details             定义 UDLIST_STATS 编译时每个链表附带一个统计块, 记录主要接口的调用次数及耗时直方图、
+                        按索引定位及按关键字查找访问的节点数、比较函数调用次数、节点申请及释放次数;
+                        计数使用原子操作, 并发模式下读者可以同时更新;
+                        未定义时链表不带统计块, 统计宏为空操作, 接口返回全 0 的统计
+ * @author              BHR
+ * @version             v1.0
+ * @date                2024-03-07
+ * @copyright           MIT
+ */
+
+#ifndef __UDLIST_STATS_H__
+#define __UDLIST_STATS_H__
+
+#include "uni_doubly_linkedlist.h"
+
+// 统计的接口
+#define UDSTAT_APPEND               0
+#define UDSTAT_PREPEND              1
+#define UDSTAT_APPEND_N             2
+#define UDSTAT_PREPEND_N            3
+#define UDSTAT_POP_FRONT            4
+#define UDSTAT_POP_BACK             5
+#define UDSTAT_INSERT_BY_INDEX      6
+#define UDSTAT_DELETE_BY_INDEX      7
+#define UDSTAT_MODIFY_BY_INDEX      8
+#define UDSTAT_RETRIEVE_BY_INDEX    9
+#define UDSTAT_DELETE_BY_KEY        10
+#define UDSTAT_MODIFY_BY_KEY        11
+#define UDSTAT_RETRIEVE_BY_KEY      12
+#define UDSTAT_DELETE_ALL_BY_KEY    13
+#define UDSTAT_MODIFY_ALL_BY_KEY    14
+#define UDSTAT_FIND_ALL_INDEX       15
+#define UDSTAT_REMOVE_IF            16
+#define UDSTAT_FIND_NODE            17
+#define UDSTAT_PEEK_BY_INDEX        18
+#define UDSTAT_PEEK_BY_KEY          19
+#define UDSTAT_TRAVERSE             20
+#define UDSTAT_TRAVERSE_BACK        21
+#define UDSTAT_TRAVERSE_EX          22
+#define UDSTAT_SORT                 23
+#define UDSTAT_DESTROY              24
+#define UDSTAT_OPS                  25
+
+// 耗时直方图桶数, 第 b 桶为 [2^b, 2^(b+1)) 纳秒, 最后一桶包含更长的耗时
+#define UDSTAT_BUCKETS 32
+
+
+/**
+ * @brief 统计块定义(全部为计数, 可以按 unsigned long long 数组逐项处理)
+ */
+typedef struct _udstats_t
+{
+    unsigned long long calls[UDSTAT_OPS];                   // 调用次数
+    unsigned long long ns[UDSTAT_OPS];                      // 总耗时(纳秒, 包括等待锁)
+    unsigned long long hist[UDSTAT_OPS][UDSTAT_BUCKETS];    // 耗时直方图
+    unsigned long long visits;                              // 按索引定位及按关键字查找访问的节点(元素)数
+    unsigned long long cmps;                                // 比较函数(谓词)调用次数
+    unsigned long long allocs;                              // 节点(展开模式为块)申请次数
+    unsigned long long frees;                               // 节点(展开模式为块)释放次数
+}udstats_t;
+
+
+#ifdef UDLIST_STATS
+
+// 累加计数
+#define UD_STAT_ADD(ud, field, n)                                                       \
+    do                                                                                  \
+    {                                                                                   \
+        if (NULL != (ud)->stats)                                                        \
+        {                                                                               \
+            __atomic_fetch_add(&(ud)->stats->field, (unsigned long long)(n), __ATOMIC_RELAXED); \
+        }                                                                               \
+    }                                                                                   \
+    while (0)
+
+// 接口开始计时(放在局部变量定义之后)
+#define UD_STAT_BEGIN() unsigned long long __stat_t0 = udstats_now()
+
+// 接口结束, 记录调用次数及耗时
+#define UD_STAT_END(ud, op) udstats_record((ud), (op), __stat_t0)
+
+#else
+
+// 计数表达式只求值不使用, 避免局部计数变量告警, 编译器会将其优化掉
+#define UD_STAT_ADD(ud, field, n) do { (void)(n); } while (0)
+#define UD_STAT_BEGIN() do { } while (0)
+#define UD_STAT_END(ud, op) do { } while (0)
+
+#endif /* UDLIST_STATS */
+
+
+
+/**
+ * @brief           获取统计(拷贝)
+ * @param           头信息结构体的指针
+ * @return          统计块的拷贝, 未定义 UDLIST_STATS 或参数错误时全为 0
+ */
+udstats_t udlist_stats_get(udlist_t *ud);
+
+
+/**
+ * @brief           清零统计
+ * @param           头信息结构体的指针
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误(未定义 UDLIST_STATS)
+ */
+int udlist_stats_reset(udlist_t *ud);
+
+
+/**
+ * @brief           输出统计
+ * @details         每个调用过的接口一行: 调用次数、平均耗时、按直方图估计的 p50 / p99, 以及非空的直方图桶
+ * @param           头信息结构体的指针
+ * @param           输出文件(如 stdout)
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误(未定义 UDLIST_STATS)
+ */
+int udlist_stats_dump(udlist_t *ud, FILE *fp);
+
+
+/**
+ * @brief           获取单调时钟(纳秒)
+ * @return          纳秒
+ */
+unsigned long long udstats_now(void);
+
+
+/**
+ * @brief           记录一次接口调用
+ * @param           头信息结构体的指针(可以为 NULL)
+ * @param           接口编号 UDSTAT_*
+ * @param           开始时间(udstats_now)
+ */
+void udstats_record(udlist_t *ud, int op, unsigned long long t0);
+
+
+
+#endif /* __UDLIST_STATS_H__ */
@@ -0,0 +1,146 @@
+/**
+ * @file                udlist_trace.h
+ * @brief               链表追踪
+ * @details             定义 UDLIST_TRACE 编译时, 接口进入/退出、按索引定位及按关键字查找访问的节点数、
+                        内存申请失败及其他错误记录到进程内共享的无锁环形缓冲区(写满后覆盖最早的事件),
+                        可以输出为文本或 Chrome trace JSON(chrome://tracing 或 Perfetto 打开);
+                        未定义时追踪宏为空操作, 不产生任何代码;
+                        错误信息统一由 UD_ERROR 输出: 定义 UDLIST_DEBUG 时打印到标准输出, 定义 UDLIST_TRACE 时记录为事件
+ * @author              BHR
+ * @version             v1.0
+ * @date                2024-03-07
+ * @copyright           MIT
+ */
+
+#ifndef __UDLIST_TRACE_H__
+#define __UDLIST_TRACE_H__
+
+#include <stdio.h>
+#include "define.h"
+
+// 事件类型
+#define UDTRACE_ENTER       1       // 进入接口
+#define UDTRACE_EXIT        2       // 退出接口
+#define UDTRACE_WALK        3       // 定位或查找访问的节点数
+#define UDTRACE_ALLOC_FAIL  4       // 内存申请失败
+#define UDTRACE_ERROR       5       // 参数错误及其他错误
+
+// 环形缓冲区事件个数(2 的幂)
+#define UDTRACE_CAP 65536
+
+
+/**
+ * @brief 追踪事件定义
+ */
+typedef struct _udtrace_ev_t
+{
+    unsigned long long seq;         // 写入序号加 1, 写入期间为 0
+    unsigned long long ts;          // 时间戳(纳秒, 单调时钟)
+    const char *name;               // 事件名(接口名或错误信息, 必须为静态字符串)
+    const void *obj;                // 链表头信息结构体的指针(错误事件为 NULL)
+    long long arg;                  // 参数: UDTRACE_WALK 为访问的节点数
+    unsigned int tid;               // 线程编号(进程内从 1 开始)
+    int type;                       // 事件类型 UDTRACE_*
+}udtrace_ev_t;
+
+
+#ifdef UDLIST_DEBUG
+#define __UD_PRINT(...) printf(__VA_ARGS__)
+#else
+#define __UD_PRINT(...) do { } while (0)
+#endif /* UDLIST_DEBUG */
+
+#ifdef UDLIST_TRACE
+
+// 记录事件, 事件名为所在函数名
+#define UD_TRACE(type, obj, arg) udtrace_emit((type), __func__, (obj), (long long)(arg))
+
+// 错误事件, 事件名为错误信息的格式字符串
+#define __UD_TRACE_MSG(type, fmt, ...) udtrace_emit((type), (fmt), NULL, 0)
+
+#else
+
+#define UD_TRACE(type, obj, arg) do { } while (0)
+#define __UD_TRACE_MSG(type, ...) do { } while (0)
+
+#endif /* UDLIST_TRACE */
+
+// 接口进入及退出
+#define UD_TRACE_ENTER(ud) UD_TRACE(UDTRACE_ENTER, (ud), 0)
+#define UD_TRACE_EXIT(ud) UD_TRACE(UDTRACE_EXIT, (ud), 0)
+
+// 定位或查找访问的节点数
+#define UD_TRACE_WALK(ud, n) UD_TRACE(UDTRACE_WALK, (ud), (n))
+
+// 错误信息(参数同 printf)
+#define UD_ERROR(...)                                   \
+    do                                                  \
+    {                                                   \
+        __UD_PRINT(__VA_ARGS__);                        \
+        __UD_TRACE_MSG(UDTRACE_ERROR, __VA_ARGS__, 0);  \
+    }                                                   \
+    while (0)
+
+// 内存申请失败(参数同 printf)
+#define UD_ALLOC_ERROR(...)                                 \
+    do                                                      \
+    {                                                       \
+        __UD_PRINT(__VA_ARGS__);                            \
+        __UD_TRACE_MSG(UDTRACE_ALLOC_FAIL, __VA_ARGS__, 0); \
+    }                                                       \
+    while (0)
+
+
+
+/**
+ * @brief           开始或暂停记录
+ * @details         定义 UDLIST_TRACE 时默认开始记录
+ * @param           非 0 开始, 0 暂停
+ * @return
+ *      @arg  0:正常
+ *      @arg  FUN_ERROR:函数错误(未定义 UDLIST_TRACE)
+ */
+int udlist_trace_enable(int on);
+
+
+/**
+ * @brief           清空环形缓冲区
+ * @details         不能与记录同时进行(先暂停记录)
+ * @return
+ *      @arg  0:正常
+ *      @arg  FUN_ERROR:函数错误(未定义 UDLIST_TRACE)
+ */
+int udlist_trace_clear(void);
+
+
+/**
+ * @brief           按文本输出缓冲区中的事件
+ * @details         每个事件一行: 时间戳(纳秒) 线程编号 类型 事件名 链表指针 参数;
+ *                  可以与记录同时进行, 输出期间被覆盖的事件跳过
+ * @param           输出文件(如 stdout)
+ * @return          输出的事件个数, 参数错误返回 PAR_ERROR, 未定义 UDLIST_TRACE 返回 FUN_ERROR
+ */
+int udlist_trace_dump(FILE *fp);
+
+
+/**
+ * @brief           输出为 Chrome trace JSON
+ * @details         进入/退出为 B/E 事件, 访问节点数为计数(C)事件, 错误为即时(i)事件
+ * @param           文件路径
+ * @return          输出的事件个数, 参数错误返回 PAR_ERROR, 打开文件失败或未定义 UDLIST_TRACE 返回 FUN_ERROR
+ */
+int udlist_trace_export_chrome(const char *path);
+
+
+/**
+ * @brief           记录一个事件(无锁, 可以被多个线程同时调用)
+ * @param           事件类型 UDTRACE_*
+ * @param           事件名(静态字符串)
+ * @param           链表头信息结构体的指针(可以为 NULL)
+ * @param           参数
+ */
+void udtrace_emit(int type, const char *name, const void *obj, long long arg);
+
+
+
+#endif /* __UDLIST_TRACE_H__ */
@@ -0,0 +1,163 @@
+/**
+ * @file                udlist_unrolled.h
+ * @brief               展开链表存储(UDLIST_UNROLLED 模式)
+ * @details             每个链表节点的数据域是一个元素数组, 连续存放最多 unroll_k 个元素,
+                        节点满时分裂, 过空时与后继节点合并;
+                        count 仍表示元素个数, my_destroy 语义同 UDLIST_INLINE
+ * @author              BHR
+ * @version             v1.0
+ * @date                2024-03-07
+ * @copyright           MIT
+ */
+
+#ifndef __UDLIST_UNROLLED_H__
+#define __UDLIST_UNROLLED_H__
+
+#include "uni_doubly_linkedlist.h"
+
+/**
+ * @brief 元素块定义(位于节点的内联数据域)
+ */
+typedef struct _udblock_t
+{
+    int used;                       // 已用元素个数
+    int reserved;                   // 保留, 使元素数组按 8 字节对齐
+    unsigned char elem[];           // 元素数组
+}udblock_t;
+
+
+// 每个节点目标字节数, 用于计算默认的 unroll_k
+#define UDUR_NODE_BYTES 256
+
+// 节点的元素块
+#define UD_BLOCK(p) ((udblock_t *)(p)->payload)
+
+// 元素块中第 i 个元素
+#define UD_ELEM(ud, b, i) ((b)->elem + (size_t)(i) * (ud)->size)
+
+
+
+/**
+ * @brief           计算默认的每节点元素个数
+ * @param           元素大小
+ * @return          每节点元素个数
+ */
+int udur_default_k(int size);
+
+
+/**
+ * @brief           在索引处插入元素, 索引大于元素个数时尾部插入
+ * @param           头信息结构体的指针
+ * @param           数据的指针, NULL 表示只预留位置不写入数据
+ * @param           索引值
+ * @return
+ *      @arg  0:正常
+ *      @arg  FUN_ERROR:函数错误
+ */
+int udur_insert(udlist_t *ud, void *data, int index);
+
+
+/**
+ * @brief           在头部或尾部批量插入元素
+ * @param           头信息结构体的指针
+ * @param           元素数组
+ * @param           元素个数
+ * @param           0 尾部插入, 1 头部插入
+ * @return
+ *      @arg  0:正常
+ *      @arg  FUN_ERROR:函数错误
+ */
+int udur_insert_n(udlist_t *ud, const void *array, size_t n, int front);
+
+
+/**
+ * @brief           删除索引处的元素
+ * @param           头信息结构体的指针
+ * @param           索引值(0 <= index < count)
+ * @param           输出数据的指针, NULL 表示丢弃(调用 my_destroy)
+ */
+void udur_delete(udlist_t *ud, int index, void *data);
+
+
+/**
+ * @brief           删除块内指定位置的元素(调用 my_destroy)并定位其后继元素
+ * @param           头信息结构体的指针
+ * @param           元素块节点
+ * @param           块内偏移, 输出后继元素的块内偏移
+ * @param           被删除元素的索引
+ * @return          后继元素所在的块节点, 没有后继元素返回 NULL
+ */
+node_t *udur_erase(udlist_t *ud, node_t *p, int *off, int index);
+
+
+/**
+ * @brief           定位索引所在的元素块
+ * @param           头信息结构体的指针
+ * @param           索引值(0 <= index < count)
+ * @param           输出块内偏移
+ * @return          元素块节点
+ */
+node_t *udur_locate(udlist_t *ud, int index, int *off);
+
+
+/**
+ * @brief           获取索引处元素的地址
+ * @param           头信息结构体的指针
+ * @param           索引值(0 <= index < count)
+ * @return          元素地址
+ */
+void *udur_at(udlist_t *ud, int index);
+
+
+/**
+ * @brief           寻找第一个匹配关键字的元素
+ * @param           头信息结构体的指针
+ * @param           关键字
+ * @param           自定义比较函数
+ * @param           输出匹配元素的索引(可以为 NULL)
+ * @return          元素地址, 无匹配返回 NULL
+ */
+void *udur_find(udlist_t *ud, void *key, cmp_t op_cmp, int *index);
+
+
+/**
+ * @brief           单次遍历删除或覆盖所有匹配的元素
+ * @param           头信息结构体的指针
+ * @param           关键字(或谓词上下文)
+ * @param           自定义比较函数(或谓词)
+ * @param           覆盖的数据, NULL 表示删除
+ * @return          命中的元素个数
+ */
+int udur_sweep(udlist_t *ud, void *key, cmp_t op_cmp, void *data);
+
+
+/**
+ * @brief           遍历所有元素
+ * @details         反向遍历与 udlist_traverse_back 一致: 先第一个元素, 再从尾部向前
+ * @param           头信息结构体的指针
+ * @param           自定义函数
+ * @param           0 正向, 1 反向
+ */
+void udur_traverse(udlist_t *ud, op_t my_op, int back);
+
+
+/**
+ * @brief           稳定排序所有元素(需要临时空间, 块结构不变)
+ * @param           头信息结构体的指针(非空链表)
+ * @param           自定义排序比较函数
+ * @return
+ *      @arg  0:正常
+ *      @arg  FUN_ERROR:函数错误
+ */
+int udur_sort(udlist_t *ud, ord_t op_ord);
+
+
+/**
+ * @brief           释放所有元素及节点
+ * @param           头信息结构体的指针
+ */
+void udur_destroy(udlist_t *ud);
+
+
+
+#endif /* __UDLIST_UNROLLED_H__ */
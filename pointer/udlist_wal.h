@@ -0,0 +1,264 @@
+/**
+ * @file                udlist_wal.h
+ * @brief               链表预写日志(WAL)
+ * @details             开启后每次修改操作在持有写锁时向日志缓冲追加一条紧凑的二进制记录,
+                        释放写锁后按持久化级别写出或同步; 恢复时加载最近一次快照再重放之后的记录;
+                        记录按链表位置描述修改(*_by_key 操作记录命中元素的索引), 重放不需要比较函数;
+                        检查点把当前链表保存为快照(udlist_snap.h)并清空日志;
+                        记录的操作: append / prepend / insert_by_index / delete_by_index / modify_by_index /
+                        delete_by_key / modify_by_key / delete_all_by_key / modify_all_by_key / remove_if /
+                        append_n / prepend_n / pop_front / pop_back / udlist_destroy / emplace_back /
+                        append_h / remove_node / insert_after_node / 游标删除及插入;
+                        无法紧凑记录的操作(sort / merge / splice / split_at / concat)返回 PAR_ERROR,
+                        非并发模式下借用的指针可以写入, udlist_peek_by_index / udlist_peek_by_key 返回 PAR_ERROR
+ * @author              BHR
+ * @version             v1.0
+ * @date                2024-03-07
+ * @copyright           MIT
+ */
+
+#ifndef __UDLIST_WAL_H__
+#define __UDLIST_WAL_H__
+
+#include <stdint.h>
+#include "uni_doubly_linkedlist.h"
+
+// 日志文件格式版本
+#define UDWAL_VERSION 1
+
+// 持久化级别: 后台线程每 interval 毫秒写出并同步一次, 崩溃可能丢失最近 interval 毫秒的修改
+#define UDWAL_LAZY 0
+
+// 持久化级别: 修改返回前写入操作系统(进程崩溃不丢失), 后台线程每 interval 毫秒同步一次
+#define UDWAL_FLUSH 1
+
+// 持久化级别: 修改返回前同步到磁盘, 多个线程同时提交时由一个线程写出所有记录并同步一次(组提交)
+#define UDWAL_SYNC 2
+
+// 默认同步间隔(毫秒)
+#define UDWAL_INTERVAL 10
+
+// UDWAL_LAZY 级别缓冲超过此大小时提前唤醒后台线程写出
+#define UDWAL_BUF_MAX (1 << 20)
+
+// 记录类型
+#define UDWAL_APPEND        1       // 尾部插入: data
+#define UDWAL_PREPEND       2       // 头部插入: data
+#define UDWAL_INSERT        3       // 按索引插入: index, data
+#define UDWAL_DELETE        4       // 按索引删除: index
+#define UDWAL_MODIFY        5       // 按索引修改: index, data
+#define UDWAL_DELETE_SET    6       // 删除所有命中元素: n 个命中元素在遍历中的位置
+#define UDWAL_MODIFY_SET    7       // 修改所有命中元素: data, n 个命中元素在遍历中的位置
+#define UDWAL_APPEND_N      8       // 尾部批量插入: n 个元素
+#define UDWAL_PREPEND_N     9       // 头部批量插入: n 个元素
+#define UDWAL_CLEAR         10      // 销毁所有元素
+
+// 写日志失败时 udwal_log 的返回值
+#define UDWAL_FAIL ((uint64_t)-1)
+
+
+/**
+ * @brief 日志文件头定义
+ */
+typedef struct _udwal_head_t
+{
+    char magic[4];                  // 文件标识 "UDLW"
+    uint32_t version;               // 格式版本
+    uint32_t size;                  // 元素大小
+    uint32_t reserved;              // 保留, 写 0
+    uint64_t base;                  // 清空日志时快照包含的最后一条记录序号
+    uint64_t reserved2;             // 保留, 写 0
+}udwal_head_t;
+
+
+/**
+ * @brief 日志记录头定义, 之后为负载(元素数据及命中位置), 记录总长度按 8 字节对齐
+ */
+typedef struct _udwal_rec_t
+{
+    uint32_t len;                   // 记录总长度(含记录头)
+    uint16_t type;                  // 记录类型
+    uint16_t reserved;              // 保留, 写 0
+    int32_t index;                  // 索引
+    uint32_t n;                     // 元素个数或命中位置个数
+    uint64_t seq;                   // 记录序号(从 1 开始递增)
+    uint64_t sum;                   // 记录(sum 为 0 时)的校验和, 用于识别写了一半的记录
+}udwal_rec_t;
+
+
+/**
+ * @brief 预写日志定义
+ */
+typedef struct _udwal_t
+{
+    int fd;                         // 日志文件
+    char *snap;                     // 快照文件路径
+    int level;                      // 持久化级别
+    int interval;                   // 后台同步间隔(毫秒)
+    int size;                       // 元素大小
+    unsigned char *buf;             // 追加缓冲
+    size_t used;                    // 追加缓冲已用字节数
+    size_t cap;                     // 追加缓冲容量
+    unsigned char *spare;           // 正在写出的缓冲(与追加缓冲交替使用)
+    size_t spare_cap;               // 写出缓冲容量
+    uint64_t seq;                   // 最后一条记录的序号
+    uint64_t lsn;                   // 已追加的总字节数
+    uint64_t written;               // 已写入操作系统的总字节数
+    uint64_t synced;                // 已同步到磁盘的总字节数
+    int writing;                    // 是否有线程正在写出
+    int refs;                       // 已追加但尚未提交的记录个数(关闭时等待其提交完成)
+    int err;                        // 写日志失败(之后的提交均返回 FUN_ERROR)
+    int stop;                       // 通知后台线程退出
+    int has_thread;                 // 是否启动了后台线程
+    pthread_t thread;               // 后台同步线程
+    pthread_mutex_t mutex;          // 保护以上字段
+    pthread_cond_t cond;            // 写出完成
+    pthread_cond_t kick;            // 唤醒后台线程
+}udwal_t;
+
+
+/**
+ * @brief 命中位置记录及重放匹配参数
+ */
+typedef struct _udwal_match_t
+{
+    void *key;                      // 关键字(记录时)
+    cmp_t op_cmp;                   // 自定义比较函数(记录时), NULL 表示重放
+    int pos;                        // 当前遍历位置
+    int *hit;                       // 命中位置数组
+    int n;                          // 命中位置个数
+    int cap;                        // 命中位置数组容量
+    int next;                       // 下一个待匹配的命中位置(重放时)
+    int err;                        // 命中位置数组申请失败
+}udwal_match_t;
+
+
+// 在写锁内追加日志记录, ok 为 0 时(修改失败)不记录; wal 记下追加时的预写日志, 提交时不再读取 ud->wal
+#define UD_WAL_LOG(ud, wal, lsn, ok, type, index, data, n, pos)                 \
+    do                                                                          \
+    {                                                                           \
+        if ((ok) && NULL != (ud) && NULL != (ud)->wal)                          \
+        {                                                                       \
+            (wal) = (ud)->wal;                                                  \
+            (lsn) = udwal_log((ud), (type), (index), (data), (n), (pos));       \
+        }                                                                       \
+    }                                                                           \
+    while (0)
+
+// 释放写锁后提交日志记录, 返回修改操作的返回值, 写日志失败返回 FUN_ERROR
+#define UD_WAL_DONE(wal, lsn, ret) ((0 == (lsn)) ? (ret) : udwal_commit((wal), (lsn), (ret)))
+
+
+
+/**
+ * @brief           开启预写日志
+ * @details         先把当前链表保存为快照并新建日志, 之后的修改记录到日志中;
+ *                  UDWAL_LAZY / UDWAL_FLUSH 级别启动一个后台同步线程
+ * @note            UDLIST_LOCKFREE 模式不支持, 返回 PAR_ERROR
+ * @param           头信息结构体的指针
+ * @param           快照文件路径
+ * @param           日志文件路径(已存在时清空)
+ * @param           持久化级别 UDWAL_LAZY / UDWAL_FLUSH / UDWAL_SYNC
+ * @param           后台同步间隔(毫秒), 小于等于 0 时使用 UDWAL_INTERVAL
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误(包括已经开启)
+ *      @arg  FUN_ERROR:函数错误(文件读写失败)
+ */
+int udlist_wal_attach(udlist_t *ud, const char *snap, const char *log, int level, int interval);
+
+
+/**
+ * @brief           从快照及日志恢复链表并继续记录日志
+ * @details         加载快照, 按顺序重放日志中快照之后的记录, 日志末尾写了一半的记录被丢弃;
+ *                  日志不存在时只加载快照; 之后的修改继续追加到同一个日志
+ * @param           快照文件路径
+ * @param           日志文件路径
+ * @param           自定义销毁数据函数
+ * @param           存储模式, 同 udlist_create_ex
+ * @param           持久化级别 UDWAL_LAZY / UDWAL_FLUSH / UDWAL_SYNC
+ * @param           后台同步间隔(毫秒), 小于等于 0 时使用 UDWAL_INTERVAL
+ * @return          指向链表头信息结构体的指针
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误(文件读写失败、格式错误或日志与快照不一致)
+ */
+udlist_t *udlist_wal_recover(const char *snap, const char *log, op_t my_destroy, int flags, int level, int interval);
+
+
+/**
+ * @brief           立即写出并同步所有日志记录
+ * @param           头信息结构体的指针
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误(未开启预写日志)
+ *      @arg  FUN_ERROR:函数错误(文件读写失败)
+ */
+int udlist_wal_sync(udlist_t *ud);
+
+
+/**
+ * @brief           检查点: 保存快照并清空日志(并发模式下持有写锁)
+ * @details         快照记录其包含的最后一条记录序号, 在保存快照和清空日志之间崩溃时重放会跳过已包含的记录
+ * @param           头信息结构体的指针
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误(未开启预写日志)
+ *      @arg  FUN_ERROR:函数错误(文件读写失败)
+ */
+int udlist_wal_checkpoint(udlist_t *ud);
+
+
+/**
+ * @brief           同步所有日志记录并关闭预写日志(并发模式下持有写锁)
+ * @param           头信息结构体的指针
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误(未开启预写日志)
+ *      @arg  FUN_ERROR:函数错误(最后一次同步失败)
+ */
+int udlist_wal_close(udlist_t *ud);
+
+
+/**
+ * @brief           追加一条日志记录(调用者持有写锁)
+ * @param           头信息结构体的指针
+ * @param           记录类型
+ * @param           索引
+ * @param           元素数据(n 个元素或 1 个元素, 可以为 NULL)
+ * @param           元素个数或命中位置个数, 小于 0 表示无法记录(之后的提交均失败)
+ * @param           命中位置数组(可以为 NULL)
+ * @return          记录结束位置, 失败返回 UDWAL_FAIL
+ */
+uint64_t udwal_log(udlist_t *ud, int type, int index, const void *data, int n, const int *pos);
+
+
+/**
+ * @brief           按持久化级别等待日志记录写出或同步
+ * @details         每条追加成功的记录必须提交一次, 关闭预写日志时等待所有记录提交完成
+ * @param           预写日志的指针
+ * @param           记录结束位置
+ * @param           修改操作的返回值
+ * @return          修改操作的返回值, 写日志失败返回 FUN_ERROR
+ */
+int udwal_commit(udwal_t *wal, uint64_t lsn, int ret);
+
+
+/**
+ * @brief           比较函数: 记录时调用原比较函数并记下命中位置, 重放时按位置命中
+ * @details         传给 delete_all_by_key / modify_all_by_key, 依赖单次遍历按顺序对每个元素调用一次
+ * @param           数据
+ * @param           udwal_match_t 的指针
+ * @return          MATCH_SUCCESS / MATCH_FAIL
+ */
+int udwal_match(void *data, void *key);
+
+
+/**
+ * @brief           同步并销毁预写日志(head_destroy 调用)
+ * @param           预写日志的指针的地址
+ */
+void udwal_destroy(udwal_t **wal);
+
+
+
+#endif /* __UDLIST_WAL_H__ */
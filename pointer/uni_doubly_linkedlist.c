@@ -1,1086 +1,4553 @@
-/**
- * @file                uni_doubly_linkedlist.c
- * @brief               万能型双向循环链表
- * @author              BHR
- * @version             v1.0
- * @date                2024-03-07
- * @copyright           MIT
- */
-
-#include "uni_doubly_linkedlist.h"
-
-
-/**
- * @brief           创建节点空间
- * @param           链表头信息结构体指针
- * @return          节点指针
- */
-static node_t *__node_calloc(udlist_t *ud)
-{
-    /* 变量定义 */
-    node_t *p = NULL;
-
-    /* 参数检查 */
-    if (NULL == ud)
-    {
-    #ifdef DEBUG
-        printf("__node_calloc: Parameter error\n");
-    #elif defined FILE_DEBUG
-        
-    #endif
-        goto ERR0;  
-    } /* end of if (NULL == ud) */
-
-    /* 创建节点空间 */ 
-    p = (node_t *)calloc(1, sizeof(node_t));
-    if (NULL == p)
-    {
-    #ifdef DEBUG
-        printf("__node_calloc: p calloc error\n");
-    #elif defined FILE_DEBUG
-        
-    #endif
-        goto ERR1;  
-    } /* end of if (NULL == p) */
-
-    /* 创建节点中数据空间 */
-    p->data = (void *)calloc(1, ud->size);
-    if (NULL == p->data)
-    {
-    #ifdef DEBUG
-        printf("__node_calloc: data calloc error\n");
-    #elif defined FILE_DEBUG
-        
-    #endif
-        goto ERR2;          
-    } /* end of if (NULL == p->data) */
-
-
-    return p;
-
-ERR0:
-    return (void *)PAR_ERROR;
-ERR2:
-    free(p);
-    p = NULL;
-ERR1:
-    return (void *)FUN_ERROR;
-}
-
-
-
-/**
- * @brief           创建链表头信息结构体
- * @param           存储数据类型大小
- * @param           自定义销毁数据函数
- * @return          指向链表头信息结构体的指针
- */
-udlist_t *udlist_create(int size, op_t my_destroy)
-{
-    /* 变量定义 */
-    udlist_t *ud = NULL;
-
-    /* 参数检查 */
-    if (size <= 0 || NULL == my_destroy)
-    {
-    #ifdef DEBUG
-        printf("udlist_create: Parameter error\n");
-    #elif defined FILE_DEBUG
-        
-    #endif
-        goto ERR0;
-    } /* end of if (size <= 0 || NULL == my_destroy) */
-
-
-    /* 申请头信息结构体空间 */
-    ud = (udlist_t *)calloc(1, sizeof(udlist_t));
-    if (NULL == ud)
-    {
-    #ifdef DEBUG
-        printf("udlist_create: calloc error\n");
-    #elif defined FILE_DEBUG
-        
-    #endif
-        goto ERR1;       
-    } /* end of if (NULL == ud) */
-
-    /* 信息输入 */
-    ud->count = 0;
-    ud->size = size;
-    ud->fstnode_p = NULL;
-    ud->my_destroy = my_destroy;
-
-
-    return ud;
-
-ERR0:
-    return (void *)PAR_ERROR;
-ERR1:
-    return (void *)FUN_ERROR;
-}
-
-
-
-/**
- * @brief           链表尾部插入
- * @param           头信息结构体的指针
- * @param           数据的指针
- * @return          
- *      @arg  0:正常
- *      @arg  PAR_ERROR:参数错误
- *      @arg  FUN_ERROR:函数错误
- */
-int udlist_append(udlist_t *ud, void *data)
-{
-    node_t *temp1 = NULL;
-    node_t *temp2 = NULL;
-
-    /* 参数检查 */
-    if (NULL == ud || NULL == data)
-    {
-    #ifdef DEBUG
-        printf("udlist_append: Parameter error\n");
-    #elif defined FILE_DEBUG
-        
-    #endif
-        goto ERR0;        
-    } /* end of if (NULL == ud || NULL == data) */
-
-    /* 1.创建一个新的节点 */
-    temp1 = __node_calloc(ud);
-
-    /* 2.节点数据输入 */
-    temp1->next = temp1;
-    temp1->prev = temp1;
-    memcpy(temp1->data, data, ud->size);
-
-    /* 3.数据尾部插入 */
-    if (0 == ud->count)
-    {
-        ud->fstnode_p = temp1;
-    }
-    else 
-    {
-        temp2 = ud->fstnode_p->prev;
-        ud->fstnode_p->prev = temp1;
-        temp2->next = temp1;
-        temp1->prev = temp2;
-        temp1->next = ud->fstnode_p;
-    }
-
-
-    /* 4.刷新信息 */
-    ud->count++;
-
-    return 0;
-
-ERR0:
-    return PAR_ERROR;
-ERR1:
-    return FUN_ERROR;     
-}
-
-
-/**
- * @brief           链表头部插入
- * @param           头信息结构体的指针
- * @param           插入节点数据
- * @return          
- *      @arg  0:正常
- *      @arg  PAR_ERROR:参数错误
- *      @arg  FUN_ERROR:函数错误
- */
-int udlist_prepend(udlist_t *ud, void *data)
-{
-    udlist_append(ud, data);
-
-    ud->fstnode_p = ud->fstnode_p->prev;
-
-    return 0;
-}
-
-
-/**
- * @brief           链表的遍历
- * @param           头信息结构体的指针
- * @param           自定义打印数据函数
- * @return          
- *      @arg  0:正常
- *      @arg  PAR_ERROR:参数错误
- *      @arg  FUN_ERROR:函数错误
- */
-int udlist_traverse(udlist_t *ud, op_t my_print)
-{
-    node_t *temp = NULL;
-
-    /* 参数检查 */
-    if (NULL == ud || NULL == my_print)
-    {
-    #ifdef DEBUG
-        printf("udlist_traverse: Parameter error\n");
-    #elif defined FILE_DEBUG
-        
-    #endif
-        goto ERR0;        
-    } /* end of if (NULL == ud || NULL == my_print) */
-
-
-
-    /* 链表的遍历 */
-    temp = ud->fstnode_p;
-    do 
-    {
-        my_print(temp->data);
-        temp = temp->next;
-    }
-    while (temp != ud->fstnode_p);
-
-
-
-    return 0;
-
-
-ERR0:
-    return PAR_ERROR;
-ERR1:
-    return FUN_ERROR;   
-}
-
-
-
-/**
- * @brief           链表的反向遍历
- * @param           头信息结构体的指针
- * @param           自定义打印数据函数
- * @return          
- *      @arg  0:正常
- *      @arg  PAR_ERROR:参数错误
- *      @arg  FUN_ERROR:函数错误
- */
-int udlist_traverse_back(udlist_t *ud, op_t my_print)
-{
-    node_t *temp = NULL;
-
-    /* 参数检查 */
-    if (NULL == ud || NULL == my_print)
-    {
-    #ifdef DEBUG
-        printf("udlist_traverse_back: Parameter error\n");
-    #elif defined FILE_DEBUG
-        
-    #endif
-        goto ERR0;        
-    } /* end of if (NULL == ud || NULL == my_print) */
-
-
-
-    /* 链表的遍历 */
-    temp = ud->fstnode_p;
-    do 
-    {
-        my_print(temp->data);
-        temp = temp->prev;
-    }
-    while (temp != ud->fstnode_p);
-
-
-
-    return 0;
-
-
-ERR0:
-    return PAR_ERROR;
-ERR1:
-    return FUN_ERROR;   
-}
-
-
-/**
- * @brief           链表销毁函数（不包括头信息结构体）
- * @param           头信息结构体的指针
- * @return          
- *      @arg  0:正常
- *      @arg  PAR_ERROR:参数错误
- *      @arg  FUN_ERROR:函数错误
- */
-int udlist_destroy(udlist_t *ud)
-{
-    node_t *temp = NULL;
-    node_t *save = NULL;
-
-    /* 参数检查 */
-    if (NULL == ud)
-    {
-    #ifdef DEBUG
-        printf("udlist_destroy: Parameter error\n");
-    #elif defined FILE_DEBUG
-        
-    #endif
-        goto ERR0;        
-    } /* end of if (NULL == ud) */    
-
-    temp = ud->fstnode_p;
-
-    /* 依次释放节点空间 */
-    if (NULL != temp)
-    {
-        do 
-        {
-            /* 1.保存下个节点的指针 */
-            save = temp->next;
-
-            /* 2.释放数据空间 */
-            ud->my_destroy(temp->data);
-            temp->data = NULL;
-
-            /* 3.释放节点空间 */
-            free(temp);
-            temp = NULL;
-
-            /* 4.指向下一个节点 */
-            temp = save;
-        }
-        while (temp != ud->fstnode_p);
-    } /* end of if (NULL != temp) */
-
-    /* 头信息刷新 */
-    ud->fstnode_p = NULL;
-    ud->count = 0;
-
-    return 0;
-
-
-ERR0:
-    return PAR_ERROR;
-ERR1:
-    return FUN_ERROR;   
-}
-
-
-/**
- * @brief           头信息结构体销毁函数
- * @param           头信息结构体的指针的地址
- * @return          
- *      @arg  0:正常
- *      @arg  PAR_ERROR:参数错误
- *      @arg  FUN_ERROR:函数错误
- */
-int head_destroy(udlist_t **p)
-{
-    /* 参数检查 */
-    if (NULL == p)
-    {
-    #ifdef DEBUG
-        printf("head_destroy: Parameter error\n");
-    #elif defined FILE_DEBUG
-        
-    #endif
-        goto ERR0;        
-    } /* end of if (NULL == p) */  
-
-    /* 销毁结构体空间 */
-    free(*p);
-    *p = NULL;
-
-    return 0;
-
-
-ERR0:
-    return PAR_ERROR;
-ERR1:
-    return FUN_ERROR;  
-}
-
-
-/**
- * @brief           获取链表中节点的个数
- * @param           头信息结构体的指针
- * @return          链表节点个数
- */
-int get_count(udlist_t *p)
-{
-    /* 参数检查 */
-    if (NULL == p)
-    {
-    #ifdef DEBUG
-        printf("get_count: Parameter error\n");
-    #elif defined FILE_DEBUG
-        
-    #endif
-        goto ERR0;        
-    } /* end of if (NULL == p) */  
-
-    return p->count;
-
-ERR0:
-    return PAR_ERROR;    
-}
-
-
-/**
- * @brief           链表根据索引插入
- * @param           头信息结构体的指针
- * @param           数据的指针
- * @param           索引值
- * @return          
- *      @arg  0:正常
- *      @arg  PAR_ERROR:参数错误
- *      @arg  FUN_ERROR:函数错误
- */
-int udlist_insert_by_index(udlist_t *ud, void *data, int index)
-{
-    node_t *temp1 = NULL;
-    node_t *temp2 = NULL;
-    node_t *save = NULL;
-    int i = 0;
-
-
-    /* 参数检查 */
-    if (NULL == ud || NULL == data || index < 0)
-    {
-    #ifdef DEBUG
-        printf("udlist_insert_by_index: Parameter error\n");
-    #elif defined FILE_DEBUG
-        
-    #endif
-        goto ERR0;        
-    } /* end of if (NULL == ud || NULL == data || index < 0) */
-
-
-    /* 判断索引 */
-    temp2 = ud->fstnode_p;
-    if (index < ud->count && index > 0)
-    {
-        // 创建一个新的节点 
-        temp1 = __node_calloc(ud);
-
-        // 节点数据输入 
-        temp1->next = temp1;
-        temp1->prev = temp1;
-        memcpy(temp1->data, data, ud->size);
-
-
-        // 寻找索引位置
-        for (i = 0; i < index - 1; i++)
-        {
-            temp2 = temp2->next;
-        } /* end of for (i = 0; i < index; i++) */
-
-        // 保存索引位置的链表
-        save = temp2->next;
-
-        // 链接新节点
-        save->prev = temp1;
-        temp2->next = temp1;
-        temp1->prev = temp2;
-        temp1->next = save;
-
-        // 刷新管理信息 
-        ud->count++;
-    }
-    else if (index == 0)
-    {
-        // 头部插入
-        udlist_prepend(ud, data);
-    }
-    else 
-    {
-        // 尾部插入
-        udlist_append(ud, data);
-    }
-
-
-    return 0;
-
-
-ERR0:
-    return PAR_ERROR;
-ERR1:
-    return FUN_ERROR; 
-}
-
-
-
-/**
- * @brief           链表根据索引删除
- * @param           头信息结构体的指针
- * @param           索引值
- * @return          
- *      @arg  0:正常
- *      @arg  PAR_ERROR:参数错误
- *      @arg  FUN_ERROR:函数错误
- */
-int udlist_delete_by_index(udlist_t *ud, int index)
-{
-    node_t *temp1 = NULL;
-    node_t *temp2 = NULL;
-    node_t *des = NULL;
-    int i = 0;
-
-
-    /* 参数检查 */
-    if (NULL == ud || index < 0 || index >= ud->count)
-    {
-    #ifdef DEBUG
-        printf("udlist_delete_by_index: Parameter error\n");
-    #elif defined FILE_DEBUG
-        
-    #endif
-        goto ERR0;        
-    } /* end of if (NULL == ud || index < 0 || index >= ud->count) */
-
-    /* 寻找索引的前一个 */
-    if (index == 0)
-    {
-        // 保存节点
-        des = ud->fstnode_p;
-        temp1 = ud->fstnode_p->prev;
-        temp2 = ud->fstnode_p->next;
-
-        // 连接节点
-        temp1->next = temp2;
-        temp2->prev = temp1;
-        ud->fstnode_p = temp2;
-
-        // 释放节点
-        ud->my_destroy(des->data);
-        free(des);
-        des = NULL;
-    }
-    else 
-    {
-        // 寻找并保存节点
-        temp1 = ud->fstnode_p;
-        for (i = 0; i < index - 1; i++)
-        {
-            temp1 = temp1->next;
-        } /* end of for (i = 0; i < index - 1; i++) */
-
-        temp2 = temp1->next->next;
-        des = temp1->next;
-
-        // 连接节点
-        temp1->next = temp2;
-        temp2->prev = temp1;
-
-        // 释放节点
-        ud->my_destroy(des->data);
-        free(des);
-        des = NULL;
-    }
-
-
-    /* 刷新信息 */
-    ud->count--;
-
-    return 0;
-
-
-ERR0:
-    return PAR_ERROR;
-ERR1:
-    return FUN_ERROR; 
-
-}
-
-
-/**
- * @brief           链表根据索引修改数据
- * @param           头信息结构体的指针
- * @param           修改数据
- * @param           索引值
- * @return          
- *      @arg  0:正常
- *      @arg  PAR_ERROR:参数错误
- *      @arg  FUN_ERROR:函数错误
- */
-int udlist_modify_by_index(udlist_t *ud, void *data, int index)
-{
-    int i = 0;
-    node_t *temp = NULL;
-
-
-    /* 参数检查 */
-    if (NULL == ud || index < 0 || index >= ud->count || NULL == data)
-    {
-    #ifdef DEBUG
-        printf("udlist_modify_by_index: Parameter error\n");
-    #elif defined FILE_DEBUG
-        
-    #endif
-        goto ERR0;        
-    } /* end of if (NULL == ud || index < 0 || index >= ud->count || NULL == data) */
-
-    /* 寻找索引位置 */
-    temp = ud->fstnode_p;
-    for (i = 0; i < index; i++)
-    {
-        temp = temp->next;
-    } /* end of for (i = 0; i < index; i++) */
-
-    /* 修改数据 */
-    memcpy(temp->data, data, ud->size);
-
-    return 0;
-
-
-ERR0:
-    return PAR_ERROR;
-ERR1:
-    return FUN_ERROR;       
-}
-
-
-/**
- * @brief           链表根据索引检索数据
- * @param           头信息结构体的指针
- * @param           要检索的数据
- * @param           索引值
- * @return          
- *      @arg  0:正常
- *      @arg  PAR_ERROR:参数错误
- *      @arg  FUN_ERROR:函数错误
- */
-int udlist_retrieve_by_index(udlist_t *ud, void *data, int index)
-{
-    int i = 0;
-    node_t *temp = NULL;
-
-    /* 参数检查 */
-    if (NULL == ud || index < 0 || index >= ud->count || NULL == data)
-    {
-    #ifdef DEBUG
-        printf("udlist_retrieve_by_index: Parameter error\n");
-    #elif defined FILE_DEBUG
-        
-    #endif
-        goto ERR0;        
-    } /* end of if (NULL == ud || index < 0 || index >= ud->count || NULL == data) */
-
-
-    /* 寻找索引位置 */
-    temp = ud->fstnode_p;
-    for (i = 0; i < index; i++)
-    {
-        temp = temp->next;
-    } /* end of for (i = 0; i < index; i++) */
-
-    /* 修改数据 */
-    memcpy(data, temp->data, ud->size);
-
-
-    return 0;
-
-
-ERR0:
-    return PAR_ERROR;
-ERR1:
-    return FUN_ERROR;      
-}
-
-
-/**
- * @brief           根据关键字寻找匹配索引
- * @param           头信息结构体的指针
- * @param           关键字
- * @param           自定义比较函数
- * @return          索引值    
- *      @arg  PAR_ERROR:参数错误
- *      @arg  MATCH_FAIL:无匹配索引
- */
-int get_match_index(udlist_t *ud, void *key, cmp_t op_cmp)
-{
-    int index = 0;
-    node_t *temp = NULL;
-
-
-    /* 参数检查 */
-    if (NULL == ud || NULL == key || NULL == op_cmp)
-    {
-    #ifdef DEBUG
-        printf("get_match_index: Parameter error\n");
-    #elif defined FILE_DEBUG
-        
-    #endif
-        goto ERR0;        
-    } /* end of if (NULL == ud || NULL == key || NULL == op_cmp) */
-
-
-    /* 判断是否为空链表 */
-    if (NULL == ud->fstnode_p)
-    {
-        goto ERR1;
-    } /* end of if (NULL == ud->fstnode_p) */
-
-    /* 寻找匹配索引 */
-    index = 0;
-    temp = ud->fstnode_p;
-    while (1)
-    {
-        if (MATCH_SUCCESS == op_cmp(temp->data, key))
-        {
-            return index;
-        } /* end of if (MATCH_SUCCESS == op_cmp(temp->data, key)) */
-
-        temp = temp->next;
-        if (ud->fstnode_p == temp)
-        {
-            goto ERR1;
-        } /* end of if (ud->fstnode_p == temp) */
-        index++;
-    } /* end of while (1) */
-
-
-ERR0:
-    return PAR_ERROR;
-ERR1:
-    return MATCH_FAIL; 
-}
-
-
-
-/**
- * @brief           链表根据关键字删除
- * @param           头信息结构体的指针
- * @param           关键字
- * @param           自定义比较函数
- * @return          
- *      @arg  0:正常
- *      @arg  PAR_ERROR:参数错误
- *      @arg  FUN_ERROR:函数错误
- */
-int udlist_delete_by_key(udlist_t *ud, void *key, cmp_t op_cmp)
-{
-    int index = 0;
-
-    /* 参数检查 */
-    if (NULL == ud || NULL == key || NULL == op_cmp)
-    {
-    #ifdef DEBUG
-        printf("udlist_delete_by_key: Parameter error\n");
-    #elif defined FILE_DEBUG
-        
-    #endif
-        goto ERR0;        
-    } /* end of if (NULL == ud || NULL == key || NULL == op_cmp) */
-
-
-    /* 获取匹配索引 */
-    index = get_match_index(ud, key, op_cmp);
-    if (PAR_ERROR == index || MATCH_FAIL == index)
-    {
-        goto ERR1;
-    } /* end of if (PAR_ERROR == index || MATCH_FAIL == index) */
-
-
-    /* 根据索引删除节点 */
-    udlist_delete_by_index(ud, index);
-
-
-    return 0;
-
-
-ERR0:
-    return PAR_ERROR;
-ERR1:
-    return FUN_ERROR;        
-}
-
-
-
-/**
- * @brief           链表根据关键字修改数据
- * @param           头信息结构体的指针
- * @param           修改的数据
- * @param           关键字
- * @param           自定义比较函数
- * @return          
- *      @arg  0:正常
- *      @arg  PAR_ERROR:参数错误
- *      @arg  FUN_ERROR:函数错误
- */
-int udlist_modify_by_key(udlist_t *ud, void *data, void *key, cmp_t op_cmp)
-{
-    int index = 0;
-
-    /* 参数检查 */
-    if (NULL == ud || NULL == key || NULL == op_cmp || NULL == data)
-    {
-    #ifdef DEBUG
-        printf("udlist_modify_by_key: Parameter error\n");
-    #elif defined FILE_DEBUG
-        
-    #endif
-        goto ERR0;        
-    } /* end of if (NULL == ud || NULL == key || NULL == op_cmp || NULL == data) */
-
-
-    /* 获取匹配索引 */
-    index = get_match_index(ud, key, op_cmp);
-    if (PAR_ERROR == index || MATCH_FAIL == index)
-    {
-        goto ERR1;
-    } /* end of if (PAR_ERROR == index || MATCH_FAIL == index) */
-
-
-    /* 根据索引修改数据 */
-    udlist_modify_by_index(ud, data, index);
-
-
-    return 0;
-
-ERR0:
-    return PAR_ERROR;
-ERR1:
-    return FUN_ERROR; 
-}
-
-
-
-/**
- * @brief           链表根据关键字获取数据
- * @param           头信息结构体的指针
- * @param           获取的数据
- * @param           关键字
- * @param           自定义比较函数
- * @return          
- *      @arg  0:正常
- *      @arg  PAR_ERROR:参数错误
- *      @arg  FUN_ERROR:函数错误
- */
-int udlist_retrieve_by_key(udlist_t *ud, void *data, void *key, cmp_t op_cmp)
-{
-    int index = 0;
-
-    /* 参数检查 */
-    if (NULL == ud || NULL == key || NULL == op_cmp || NULL == data)
-    {
-    #ifdef DEBUG
-        printf("udlist_retrieve_by_key: Parameter error\n");
-    #elif defined FILE_DEBUG
-        
-    #endif
-        goto ERR0;        
-    } /* end of if (NULL == ud || NULL == key || NULL == op_cmp || NULL == data) */
-
-
-    /* 获取匹配索引 */
-    index = get_match_index(ud, key, op_cmp);
-    if (PAR_ERROR == index || MATCH_FAIL == index)
-    {
-        goto ERR1;
-    } /* end of if (PAR_ERROR == index || MATCH_FAIL == index) */
-
-    /* 根据索引获取数据 */
-    udlist_retrieve_by_index(ud, data, index);
-
-    return 0;
-
-
-ERR0:
-    return PAR_ERROR;
-ERR1:
-    return FUN_ERROR; 
-}
-
-
-/**
- * @brief           链表根据关键字删除所有匹配的节点
- * @param           头信息结构体的指针
- * @param           关键字
- * @param           自定义比较函数 
- * @return          
- *      @arg  0:正常
- *      @arg  PAR_ERROR:参数错误
- *      @arg  FUN_ERROR:函数错误
- */
-int udlist_delete_all_by_key(udlist_t *ud, void *key, cmp_t op_cmp)
-{
-    int index = 0;
-
-    /* 参数检查 */
-    if (NULL == ud || NULL == key || NULL == op_cmp)
-    {
-    #ifdef DEBUG
-        printf("udlist_delete_all_by_key: Parameter error\n");
-    #elif defined FILE_DEBUG
-        
-    #endif
-        goto ERR0;        
-    } /* end of if (NULL == ud || NULL == key || NULL == op_cmp) */
-
-    while (1)
-    {
-        /* 获取匹配索引 */
-        index = get_match_index(ud, key, op_cmp);
-        if (PAR_ERROR == index || MATCH_FAIL == index)
-        {
-            goto ERR1;
-        } /* end of if (PAR_ERROR == index || MATCH_FAIL == index) */
-
-
-        /* 根据索引删除节点 */
-        udlist_delete_by_index(ud, index);
-
-    } /* end of while (1) */
-
-    return 0;
-
-ERR0:
-    return PAR_ERROR;
-ERR1:
-    return FUN_ERROR;  
-
-}
-
-
-/**
- * @brief           链表根据关键字修改所有匹配节点的数据
- * @param           头信息结构体的指针
- * @param           修改的数据
- * @param           关键字
- * @param           自定义比较函数
- * @return          
- *      @arg  0:正常
- *      @arg  PAR_ERROR:参数错误
- *      @arg  FUN_ERROR:函数错误
- */
-int udlist_modify_all_by_key(udlist_t *ud, void *data, void *key, cmp_t op_cmp)
-{
-    int index = 0;
-
-    /* 参数检查 */
-    if (NULL == ud || NULL == key || NULL == op_cmp || NULL == data)
-    {
-    #ifdef DEBUG
-        printf("udlist_modify_all_by_key: Parameter error\n");
-    #elif defined FILE_DEBUG
-        
-    #endif
-        goto ERR0;        
-    } /* end of if (NULL == ud || NULL == key || NULL == op_cmp || NULL == data) */
-
-    while (1)
-    {
-        /* 获取匹配索引 */
-        index = get_match_index(ud, key, op_cmp);
-        if (PAR_ERROR == index || MATCH_FAIL == index)
-        {
-            goto ERR1;
-        } /* end of if (PAR_ERROR == index || MATCH_FAIL == index) */
-
-
-        /* 根据索引修改数据 */
-        udlist_modify_by_index(ud, data, index);
-
-    } /* end of while (1) */
-
-    return 0;
-
-ERR0:
-    return PAR_ERROR;
-ERR1:
-    return FUN_ERROR; 
-}
-
-
-
-/**
- * @brief           自定义索引销毁函数
- * @param           数据域
- * @return          0
- */
-int index_destroy(void *data)
-{
-    free(data);
-    data = NULL;
-    return 0;
-}
-
-
-/**
- * @brief           自定义索引打印函数
- * @param           数据域
- * @return          0
- */
-int index_print(void *data)
-{
-    printf("index = %d\n", *(int *)data);
-    return 0;
-}
-
-
-/**
- * @brief           链表根据关键字查找所有的索引
- * @param           头信息结构体的指针
- * @param           关键字
- * @param           自定义比较函数 
- * @return          存储索引链表
- *      @arg  PAR_ERROR: 参数错误
- *      @arg  NULL     : 没有找到匹配索引
- */
-udlist_t *udlist_find_all_index_by_key(udlist_t *ud, void *key, cmp_t op_cmp)
-{
-    udlist_t *index_head = NULL;
-    node_t *temp = NULL;
-    int index = 0;
-
-
-    /* 参数检查 */
-    if (NULL == ud || NULL == key || NULL == op_cmp)
-    {
-    #ifdef DEBUG
-        printf("udlist_find_all_index_by_key: Parameter error\n");
-    #elif defined FILE_DEBUG
-        
-    #endif
-        goto ERR0;        
-    } /* end of if (NULL == ud || NULL == key || NULL == op_cmp) */
-
-
-    /* 判断链表是否存在 */
-    if (NULL == ud->fstnode_p)
-    {
-        goto ERR1;
-    } /* end of if (NULL == ud->fstnode_p) */
-
-
-    /* 创建存储索引的链表头信息结构体 */
-    index_head = udlist_create(sizeof(int), index_destroy);
-
-
-    /* 查找索引并插入链表 */
-    temp = ud->fstnode_p;
-    index = 0;
-    do 
-    {
-        if (MATCH_SUCCESS == op_cmp(temp->data, key))
-        {
-            udlist_append(index_head, &index);
-        } /* end of if (MATCH_SUCCESS == op_cmp(temp->data, key)) */
-
-        index++;
-        temp = temp->next;
-    }
-    while (temp != ud->fstnode_p);
-
-
-
-    /* 判断是否为空链表 */
-    if (0 == get_count(index_head))
-    {
-        head_destroy(&index_head);
-    } /* end of if (0 == get_count(index_head)) */
-
-
-    return index_head;
-
-
-ERR0:
-    return (void *)PAR_ERROR;
-ERR1:
-    return NULL;
-}
-
-
-
+/**
+ * @file                uni_doubly_linkedlist.c
+ * @brief               万能型双向循环链表
+ * @author              BHR
+ * @version             v1.0
+ * @date                2024-03-07
+ * @copyright           MIT
+ */
+
+#include <limits.h>
+#include "uni_doubly_linkedlist.h"
+#include "udlist_pool.h"
+#include "udlist_rank.h"
+#include "udlist_hash.h"
+#include "udlist_unrolled.h"
+#include "udlist_lock.h"
+#include "udlist_deque.h"
+#include "udlist_iter.h"
+#include "udlist_wal.h"
+#include "udlist_stats.h"
+#include "udlist_trace.h"
+
+#ifdef UDLIST_DEBUG
+// 本线程未归还借用的链表(udlist_lock.h)
+__thread udlist_t *ud_borrow_tls[UD_BORROW_MAX];
+#endif /* UDLIST_DEBUG */
+
+// 秩树模式下距离不超过该值时直接遍历查找
+#define UDRANK_WALK 16
+
+// 归并排序的有序链个数, 可排序 2^64 个节点
+#define UDSORT_BINS 64
+
+
+/**
+ * @brief           创建节点空间
+ * @details         节点空间依次为: 附加空间(秩树节点) + 节点头 + 内联数据域
+ * @param           链表头信息结构体指针
+ * @return          节点指针
+ */
+static node_t *__node_calloc(udlist_t *ud)
+{
+    /* 变量定义 */
+    node_t *p = NULL;
+    unsigned char *base = NULL;
+    size_t len = 0;
+
+    /* 参数检查 */
+    if (NULL == ud)
+    {
+        UD_ERROR("__node_calloc: Parameter error\n");
+        goto ERR0;  
+    } /* end of if (NULL == ud) */
+
+    /* 计算节点空间大小 */
+    len = ud->node_off + sizeof(node_t);
+    if (UDLIST_INLINE & ud->flags)
+    {
+        len += ud->size;
+    } /* end of if (UDLIST_INLINE & ud->flags) */
+
+    /* 创建节点空间: 内存池模式从内存块中切分 */ 
+    if (NULL != ud->pool)
+    {
+        base = (unsigned char *)udpool_alloc(ud->pool);
+        if (NULL != base)
+        {
+            memset(base, 0, ud->node_off + sizeof(node_t));
+        } /* end of if (NULL != base) */
+    }
+    else
+    {
+        base = (unsigned char *)calloc(1, len);
+    }
+    if (NULL == base)
+    {
+        UD_ALLOC_ERROR("__node_calloc: p calloc error\n");
+        goto ERR1;  
+    } /* end of if (NULL == base) */
+    p = (node_t *)(base + ud->node_off);
+    UD_STAT_ADD(ud, allocs, 1);
+
+    /* 内联模式: 数据域紧跟节点头 */
+    if (UDLIST_INLINE & ud->flags)
+    {
+        p->data = p->payload;
+        return p;
+    } /* end of if (UDLIST_INLINE & ud->flags) */
+
+    /* 创建节点中数据空间 */
+    p->data = (void *)calloc(1, ud->size);
+    if (NULL == p->data)
+    {
+        UD_ALLOC_ERROR("__node_calloc: data calloc error\n");
+        goto ERR2;          
+    } /* end of if (NULL == p->data) */
+
+
+    return p;
+
+ERR0:
+    return NULL;
+ERR2:
+    UD_STAT_ADD(ud, frees, 1);
+    free(base);
+    base = NULL;
+ERR1:
+    return NULL;
+}
+
+
+/**
+ * @brief           释放节点空间, 不调用 my_destroy
+ * @details         兼容模式下释放单独申请的数据域空间, 数据引用的资源由调用者负责
+ * @param           链表头信息结构体指针
+ * @param           节点指针
+ */
+static void __node_release(udlist_t *ud, node_t *p)
+{
+    UD_STAT_ADD(ud, frees, 1);
+
+    /* 兼容模式的数据域单独申请 */
+    if (!(UDLIST_INLINE & ud->flags))
+    {
+        free(p->data);
+    } /* end of if (!(UDLIST_INLINE & ud->flags)) */
+    p->data = NULL;
+
+    /* 释放节点空间(从附加空间开始) */
+    if (NULL != ud->pool)
+    {
+        udpool_free(ud->pool, (unsigned char *)p - ud->node_off);
+    }
+    else
+    {
+        free((unsigned char *)p - ud->node_off);
+    }
+}
+
+
+
+/**
+ * @brief           释放节点空间
+ * @details         兼容模式下数据域由 my_destroy 释放, 内联模式下随节点一起释放,
+ *                  内存池模式下节点归还空闲链表
+ * @param           链表头信息结构体指针
+ * @param           节点指针
+ */
+static void __node_free(udlist_t *ud, node_t *p)
+{
+    /* 释放数据域 */
+    if (NULL != ud->my_destroy)
+    {
+        ud->my_destroy(p->data);
+    } /* end of if (NULL != ud->my_destroy) */
+    p->data = NULL;
+
+    __node_release(ud, p);
+}
+
+
+
+/**
+ * @brief           创建节点并拷贝数据
+ * @param           链表头信息结构体指针
+ * @param           数据的指针
+ * @return          节点指针, 失败返回 NULL
+ */
+static node_t *__node_new(udlist_t *ud, void *data)
+{
+    node_t *p = NULL;
+
+    p = __node_calloc(ud);
+    if (NULL == p)
+    {
+        return NULL;
+    } /* end of if (NULL == p) */
+
+    memcpy(p->data, data, ud->size);
+
+    return p;
+}
+
+
+
+/**
+ * @brief           将节点加入哈希索引
+ * @details         哈希索引扩容失败时移除哈希索引, 之后的查找退回顺序查找
+ * @param           链表头信息结构体指针
+ * @param           节点指针
+ */
+static void __node_hash_add(udlist_t *ud, node_t *p)
+{
+    if (NULL != ud->hash && 0 != udhash_add(ud->hash, p))
+    {
+        UD_ERROR("__node_hash_add: hash index dropped\n");
+        udhash_destroy(&ud->hash);
+    } /* end of if (NULL != ud->hash && 0 != udhash_add(ud->hash, p)) */
+}
+
+
+
+/**
+ * @brief           将节点链接到 pos 之前
+ * @details         链表为空时 pos 为 NULL, 新节点成为第一个节点;
+ *                  pos 为第一个节点时相当于尾部插入, 不改变 fstnode_p
+ * @param           链表头信息结构体指针
+ * @param           插入位置节点
+ * @param           新节点
+ * @param           新节点插入后的索引, -1 表示未知
+ */
+static void __node_link_before(udlist_t *ud, node_t *pos, node_t *p, int index)
+{
+    if (NULL == pos)
+    {
+        // 空链表
+        p->prev = p;
+        p->next = p;
+        ud->fstnode_p = p;
+    }
+    else
+    {
+        p->prev = pos->prev;
+        p->next = pos;
+        pos->prev->next = p;
+        pos->prev = p;
+    }
+
+    /* 秩树模式: 同步插入秩树, 未知索引时由位置节点计算 */
+    if (UDLIST_INDEXED & ud->flags)
+    {
+        if (index >= 0)
+        {
+            udrank_insert(ud, p, index);
+        }
+        else if (NULL == pos || pos == ud->fstnode_p)
+        {
+            udrank_insert(ud, p, NULL == pos ? 0 : ud->count);
+        }
+        else
+        {
+            udrank_insert(ud, p, udrank_index(ud, pos));
+        }
+    } /* end of if (UDLIST_INDEXED & ud->flags) */
+
+    /* 同步加入哈希索引 */
+    __node_hash_add(ud, p);
+
+    /* 刷新位置缓存: 插在缓存位置之前则缓存索引后移 */
+    if (NULL != ud->finger_p)
+    {
+        if (index < 0)
+        {
+            ud->finger_p = NULL;
+        }
+        else if (index <= ud->finger_idx)
+        {
+            ud->finger_idx++;
+        }
+    } /* end of if (NULL != ud->finger_p) */
+
+    /* 刷新信息 */
+    ud->count++;
+    ud->mods++;
+}
+
+
+
+/**
+ * @brief           将节点从链表中摘下(不释放)
+ * @param           链表头信息结构体指针
+ * @param           节点指针
+ * @param           节点的索引, -1 表示未知
+ */
+static void __node_unlink(udlist_t *ud, node_t *p, int index)
+{
+    /* 秩树模式: 同步删除 */
+    if (UDLIST_INDEXED & ud->flags)
+    {
+        udrank_remove(ud, p);
+    } /* end of if (UDLIST_INDEXED & ud->flags) */
+
+    /* 同步删除哈希索引 */
+    if (NULL != ud->hash)
+    {
+        udhash_del(ud->hash, p);
+    } /* end of if (NULL != ud->hash) */
+
+    /* 刷新位置缓存 */
+    if (NULL != ud->finger_p)
+    {
+        if (index < 0 || (p == ud->finger_p && index == ud->count - 1))
+        {
+            ud->finger_p = NULL;
+        }
+        else if (p == ud->finger_p)
+        {
+            // 后继节点接替该索引
+            ud->finger_p = p->next;
+        }
+        else if (index < ud->finger_idx)
+        {
+            ud->finger_idx--;
+        }
+    } /* end of if (NULL != ud->finger_p) */
+
+    if (p->next == p)
+    {
+        // 最后一个节点
+        ud->fstnode_p = NULL;
+    }
+    else
+    {
+        p->prev->next = p->next;
+        p->next->prev = p->prev;
+        if (ud->fstnode_p == p)
+        {
+            ud->fstnode_p = p->next;
+        } /* end of if (ud->fstnode_p == p) */
+    }
+
+    /* 刷新信息 */
+    ud->count--;
+    ud->mods++;
+}
+
+
+
+/**
+ * @brief           有序模式: 将节点按顺序链接到链表中 O(log n)
+ * @param           链表头信息结构体指针
+ * @param           新节点
+ * @param           非 0 插入到相等元素之后, 0 插入到相等元素之前
+ */
+static void __node_link_sorted(udlist_t *ud, node_t *p, int upper)
+{
+    node_t *pos = NULL;
+    int index = 0;
+
+    pos = udrank_bound(ud, p->data, ud->op_ord, upper, &index);
+
+    // 没有更大的元素时插入到尾部(第一个节点之前)
+    __node_link_before(ud, NULL == pos ? ud->fstnode_p : pos, p, index);
+    if (0 == index)
+    {
+        ud->fstnode_p = p;
+    } /* end of if (0 == index) */
+}
+
+
+
+/**
+ * @brief           有序模式: 节点数据修改后恢复顺序
+ * @details         仍然与前驱、后继有序时不移动, 否则摘下后重新按顺序插入 O(log n)
+ * @param           链表头信息结构体指针
+ * @param           节点指针
+ */
+static void __node_reorder(udlist_t *ud, node_t *p)
+{
+    if ((p != ud->fstnode_p && ud->op_ord(p->prev->data, p->data) > 0)
+        || (p->next != ud->fstnode_p && ud->op_ord(p->data, p->next->data) > 0))
+    {
+        __node_unlink(ud, p, -1);
+        __node_link_sorted(ud, p, 1);
+    } /* end of if ((p != ud->fstnode_p && ...) || ...) */
+}
+
+
+
+/**
+ * @brief           寻找索引位置的节点
+ * @details         从头部、尾部和最近访问位置中选择最近的起点双向查找,
+ *                  顺序访问 i, i+1, ... 均摊 O(1); 秩树模式下距离较远时 O(log n)
+ * @param           链表头信息结构体指针
+ * @param           索引值(0 <= index < count)
+ * @return          节点指针
+ */
+static node_t *__node_seek(udlist_t *ud, int index)
+{
+    int pos = 0;
+    int dist = 0;
+    node_t *temp = NULL;
+
+    /* 1.选择起点: 头部向后 或 尾部向前 */
+    if (index <= ud->count - 1 - index)
+    {
+        temp = ud->fstnode_p;
+        pos = 0;
+        dist = index;
+    }
+    else
+    {
+        temp = ud->fstnode_p->prev;
+        pos = ud->count - 1;
+        dist = ud->count - 1 - index;
+    }
+
+    /* 2.最近访问位置更近则从缓存位置出发 */
+    if (NULL != ud->finger_p && abs(index - ud->finger_idx) < dist)
+    {
+        temp = ud->finger_p;
+        pos = ud->finger_idx;
+        dist = abs(index - ud->finger_idx);
+    } /* end of if (NULL != ud->finger_p && ...) */
+
+    /* 3.秩树模式距离较远时按秩查找 */
+    if ((UDLIST_INDEXED & ud->flags) && dist > UDRANK_WALK)
+    {
+        temp = udrank_select(ud, index);
+        pos = index;
+    } /* end of if ((UDLIST_INDEXED & ud->flags) && dist > UDRANK_WALK) */
+
+    /* 4.双向查找 */
+    UD_STAT_ADD(ud, visits, abs(index - pos));
+    UD_TRACE_WALK(ud, abs(index - pos));
+    while (pos < index)
+    {
+        temp = temp->next;
+        pos++;
+    } /* end of while (pos < index) */
+    while (pos > index)
+    {
+        temp = temp->prev;
+        pos--;
+    } /* end of while (pos > index) */
+
+    /* 5.刷新位置缓存(并发模式下读者不刷新) */
+    if (UD_CACHE_OK(ud))
+    {
+        ud->finger_p = temp;
+        ud->finger_idx = index;
+    } /* end of if (UD_CACHE_OK(ud)) */
+
+    return temp;
+}
+
+
+
+/**
+ * @brief           寻找第一个匹配关键字的节点
+ * @details         比较函数与哈希索引一致时通过哈希索引查找 O(1),
+ *                  此时不计算索引; 有多个节点匹配时退回顺序查找以保证返回第一个
+ * @param           链表头信息结构体指针
+ * @param           关键字
+ * @param           自定义比较函数
+ * @param           输出匹配节点的索引, -1 表示未计算(可以为 NULL)
+ * @return          节点指针, 无匹配返回 NULL
+ */
+static node_t *__node_find(udlist_t *ud, void *key, cmp_t op_cmp, int *index)
+{
+    int i = 0;
+    int dup = 0;
+    node_t *temp = NULL;
+
+    /* 判断是否为空链表 */
+    if (NULL == ud->fstnode_p)
+    {
+        return NULL;
+    } /* end of if (NULL == ud->fstnode_p) */
+
+    /* 哈希索引查找 */
+    if (NULL != ud->hash && op_cmp == ud->hash->op_cmp)
+    {
+        temp = udhash_find(ud->hash, key, &dup);
+        if (!dup)
+        {
+            if (NULL != index)
+            {
+                *index = -1;
+            } /* end of if (NULL != index) */
+            return temp;
+        } /* end of if (!dup) */
+    } /* end of if (NULL != ud->hash && op_cmp == ud->hash->op_cmp) */
+
+    /* 寻找匹配节点 */
+    temp = ud->fstnode_p;
+    do
+    {
+        if (MATCH_SUCCESS == op_cmp(temp->data, key))
+        {
+            if (NULL != index)
+            {
+                *index = i;
+            } /* end of if (NULL != index) */
+            UD_STAT_ADD(ud, visits, i + 1);
+            UD_TRACE_WALK(ud, i + 1);
+            UD_STAT_ADD(ud, cmps, i + 1);
+            return temp;
+        } /* end of if (MATCH_SUCCESS == op_cmp(temp->data, key)) */
+
+        i++;
+        temp = temp->next;
+    }
+    while (temp != ud->fstnode_p);
+    UD_STAT_ADD(ud, visits, i);
+    UD_TRACE_WALK(ud, i);
+    UD_STAT_ADD(ud, cmps, i);
+
+    return NULL;
+}
+
+
+
+/**
+ * @brief           计算节点的索引
+ * @details         秩树模式下 O(log n), 否则向前数到第一个节点
+ * @param           链表头信息结构体指针
+ * @param           节点指针
+ * @return          索引值
+ */
+static int __node_index(udlist_t *ud, node_t *p)
+{
+    int index = 0;
+
+    if (UDLIST_INDEXED & ud->flags)
+    {
+        return udrank_index(ud, p);
+    } /* end of if (UDLIST_INDEXED & ud->flags) */
+
+    while (p != ud->fstnode_p)
+    {
+        p = p->prev;
+        index++;
+    } /* end of while (p != ud->fstnode_p) */
+
+    return index;
+}
+
+
+
+/**
+ * @brief           修改节点数据并同步哈希索引
+ * @param           链表头信息结构体指针
+ * @param           节点指针
+ * @param           新数据
+ */
+static void __node_write(udlist_t *ud, node_t *p, void *data)
+{
+    if (NULL != ud->hash)
+    {
+        udhash_del(ud->hash, p);
+    } /* end of if (NULL != ud->hash) */
+
+    memcpy(p->data, data, ud->size);
+
+    __node_hash_add(ud, p);
+}
+
+
+
+/**
+ * @brief           单次正向遍历, 删除或覆盖所有匹配的节点
+ * @param           链表头信息结构体指针
+ * @param           关键字(或谓词上下文)
+ * @param           自定义比较函数(或谓词), 返回 MATCH_SUCCESS 表示命中
+ * @param           覆盖的数据, NULL 表示删除命中的节点
+ * @return          命中的节点个数
+ */
+static int __node_sweep(udlist_t *ud, void *key, cmp_t op_cmp, void *data)
+{
+    int i = 0;
+    int n = 0;
+    int hit = 0;
+    node_t *temp = NULL;
+    node_t *save = NULL;
+
+    /* 每个节点只访问一次 */
+    n = ud->count;
+    temp = ud->fstnode_p;
+    for (i = 0; i < n; i++)
+    {
+        save = temp->next;
+
+        if (MATCH_SUCCESS == op_cmp(temp->data, key))
+        {
+            if (NULL == data)
+            {
+                // 摘下并释放节点, 当前索引为 i - hit
+                __node_unlink(ud, temp, i - hit);
+                __node_free(ud, temp);
+            }
+            else
+            {
+                // 原地覆盖数据
+                __node_write(ud, temp, data);
+            }
+            hit++;
+        } /* end of if (MATCH_SUCCESS == op_cmp(temp->data, key)) */
+
+        temp = save;
+    } /* end of for (i = 0; i < n; i++) */
+    UD_STAT_ADD(ud, visits, n);
+    UD_TRACE_WALK(ud, n);
+    UD_STAT_ADD(ud, cmps, n);
+
+    return hit;
+}
+
+
+
+/**
+ * @brief           在头部或尾部批量插入节点
+ * @details         节点在本地串成链后一次接入, 秩树整段建树后并入;
+ *                  内存池模式从同一内存块连续切分所有节点; 申请失败时链表不变
+ * @param           链表头信息结构体指针
+ * @param           元素数组
+ * @param           元素个数(大于 0)
+ * @param           0 尾部插入, 1 头部插入
+ * @return
+ *      @arg  0:正常
+ *      @arg  FUN_ERROR:函数错误
+ */
+static int __node_insert_n(udlist_t *ud, const void *array, size_t n, int front)
+{
+    const unsigned char *src = (const unsigned char *)array;
+    unsigned char *base = NULL;
+    node_t *first = NULL;
+    node_t *last = NULL;
+    node_t *p = NULL;
+    size_t i = 0;
+
+    /* 1.内存池模式一次切分所有节点 */
+    if (NULL != ud->pool)
+    {
+        base = (unsigned char *)udpool_alloc_n(ud->pool, n);
+        if (NULL == base)
+        {
+            goto ERR1;
+        } /* end of if (NULL == base) */
+        UD_STAT_ADD(ud, allocs, n);
+    } /* end of if (NULL != ud->pool) */
+
+    /* 2.创建节点并在本地串成链 */
+    for (i = 0; i < n; i++)
+    {
+        if (NULL != base)
+        {
+            p = (node_t *)(base + i * ud->pool->node_size + ud->node_off);
+            p->data = p->payload;
+        }
+        else
+        {
+            p = __node_calloc(ud);
+            if (NULL == p)
+            {
+                goto ERR2;
+            } /* end of if (NULL == p) */
+        }
+        memcpy(p->data, src + i * ud->size, ud->size);
+
+        if (NULL == first)
+        {
+            first = p;
+        }
+        else
+        {
+            last->next = p;
+            p->prev = last;
+        }
+        last = p;
+    } /* end of for (i = 0; i < n; i++) */
+
+    /* 有序模式: 逐个按顺序插入, 头部插入时倒序插入以保持数组中相等元素的顺序 */
+    if (UDLIST_SORTED & ud->flags)
+    {
+        p = front ? last : first;
+        for (i = 0; i < n; i++)
+        {
+            first = front ? p->prev : p->next;
+            __node_link_sorted(ud, p, !front);
+            p = first;
+        } /* end of for (i = 0; i < n; i++) */
+        return 0;
+    } /* end of if (UDLIST_SORTED & ud->flags) */
+
+    /* 3.整链接入 */
+    if (NULL == ud->fstnode_p)
+    {
+        first->prev = last;
+        last->next = first;
+        ud->fstnode_p = first;
+    }
+    else
+    {
+        first->prev = ud->fstnode_p->prev;
+        last->next = ud->fstnode_p;
+        ud->fstnode_p->prev->next = first;
+        ud->fstnode_p->prev = last;
+        if (front)
+        {
+            ud->fstnode_p = first;
+        } /* end of if (front) */
+    }
+
+    /* 4.同步秩树及哈希索引 */
+    if (UDLIST_INDEXED & ud->flags)
+    {
+        udrank_insert_n(ud, first, n, front ? 0 : ud->count);
+    } /* end of if (UDLIST_INDEXED & ud->flags) */
+    for (p = first, i = 0; i < n && NULL != ud->hash; i++, p = p->next)
+    {
+        __node_hash_add(ud, p);
+    } /* end of for (p = first, i = 0; i < n && NULL != ud->hash; ...) */
+
+    /* 5.刷新位置缓存及节点个数 */
+    if (front && NULL != ud->finger_p)
+    {
+        ud->finger_idx += (int)n;
+    } /* end of if (front && NULL != ud->finger_p) */
+    ud->count += (int)n;
+    ud->mods++;
+
+    return 0;
+
+ERR2:
+    /* 释放已创建的节点(数据为拷贝, 不调用 my_destroy) */
+    while (NULL != first)
+    {
+        p = (first == last) ? NULL : first->next;
+        if (!(UDLIST_INLINE & ud->flags))
+        {
+            free(first->data);
+        } /* end of if (!(UDLIST_INLINE & ud->flags)) */
+        free((unsigned char *)first - ud->node_off);
+        UD_STAT_ADD(ud, frees, 1);
+        first = p;
+    } /* end of while (NULL != first) */
+ERR1:
+    return FUN_ERROR;
+}
+
+
+
+/**
+ * @brief           无锁模式批量插入
+ * @details         逐个插入, 头部插入时倒序插入以保持数组中的顺序;
+ *                  其他线程可能同时插入、删除, 插入的元素之间不保证相邻, 失败时已插入的元素保留
+ * @param           无锁双端队列指针
+ * @param           元素数组
+ * @param           元素个数
+ * @param           非 0 头部插入, 0 尾部插入
+ * @return
+ *      @arg  0:正常
+ *      @arg  FUN_ERROR:函数错误
+ */
+static int __deque_push_n(uddq_t *q, const void *array, size_t n, int front)
+{
+    size_t i = 0;
+    size_t k = 0;
+
+    for (i = 0; i < n; i++)
+    {
+        k = front ? n - 1 - i : i;
+        if (0 != uddq_push(q, (unsigned char *)array + k * q->size, front))
+        {
+            return FUN_ERROR;
+        } /* end of if (0 != uddq_push(q, ...)) */
+    } /* end of for (i = 0; i < n; i++) */
+
+    return 0;
+}
+
+
+
+/**
+ * @brief           初始化写者优先的读写锁
+ * @param           读写锁指针
+ * @return          0 正常, 否则为 pthread 错误码
+ */
+static int __lock_init(pthread_rwlock_t *lock)
+{
+    pthread_rwlockattr_t attr;
+    int ret = 0;
+
+    pthread_rwlockattr_init(&attr);
+#ifdef __GLIBC__
+    // glibc 默认读者优先
+    pthread_rwlockattr_setkind_np(&attr, PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP);
+#endif
+    ret = pthread_rwlock_init(lock, &attr);
+    pthread_rwlockattr_destroy(&attr);
+
+    return ret;
+}
+
+
+
+/**
+ * @brief           合并两条有序的单向节点链(按 next 链接, NULL 结尾)
+ * @details         相等时 a 中的节点在前, 保证稳定
+ * @param           靠前的有序链
+ * @param           靠后的有序链
+ * @param           自定义排序比较函数
+ * @return          合并后的第一个节点
+ */
+static node_t *__node_merge(node_t *a, node_t *b, ord_t op_ord)
+{
+    node_t *first = NULL;
+    node_t **tail = &first;
+
+    while (NULL != a && NULL != b)
+    {
+        if (op_ord(b->data, a->data) < 0)
+        {
+            *tail = b;
+            b = b->next;
+        }
+        else
+        {
+            *tail = a;
+            a = a->next;
+        }
+        tail = &(*tail)->next;
+    } /* end of while (NULL != a && NULL != b) */
+    *tail = (NULL != a) ? a : b;
+
+    return first;
+}
+
+
+
+/**
+ * @brief           单向节点链自底向上稳定归并排序, 不申请内存
+ * @details         依次取出已有序的一段作为 carry, 与 bin[0], bin[1], ... 合并进位,
+ *                  下标越大的 bin 中的节点越靠前; 已有序的链表只需 O(n) 次比较
+ * @param           第一个节点(按 next 链接, NULL 结尾)
+ * @param           自定义排序比较函数
+ * @return          排序后的第一个节点
+ */
+static node_t *__node_sort(node_t *list, ord_t op_ord)
+{
+    node_t *bin[UDSORT_BINS] = {NULL};
+    node_t *carry = NULL;
+    node_t *tail = NULL;
+    int i = 0;
+
+    while (NULL != list)
+    {
+        /* 1.取出不递减的一段 */
+        carry = list;
+        tail = list;
+        while (NULL != tail->next && op_ord(tail->next->data, tail->data) >= 0)
+        {
+            tail = tail->next;
+        } /* end of while (NULL != tail->next && ...) */
+        list = tail->next;
+        tail->next = NULL;
+
+        /* 2.逐级合并进位 */
+        for (i = 0; NULL != bin[i]; i++)
+        {
+            carry = __node_merge(bin[i], carry, op_ord);
+            bin[i] = NULL;
+        } /* end of for (i = 0; NULL != bin[i]; i++) */
+        bin[i] = carry;
+    } /* end of while (NULL != list) */
+
+    carry = NULL;
+    for (i = 0; i < UDSORT_BINS; i++)
+    {
+        if (NULL != bin[i])
+        {
+            carry = __node_merge(bin[i], carry, op_ord);
+        } /* end of if (NULL != bin[i]) */
+    } /* end of for (i = 0; i < UDSORT_BINS; i++) */
+
+    return carry;
+}
+
+
+
+/**
+ * @brief           单向节点链重新连成循环链表并刷新索引结构
+ * @details         补全前驱指针, 位置缓存失效, 秩树模式按新顺序 O(n) 重建
+ * @param           链表头信息结构体指针
+ * @param           第一个节点(按 next 链接, NULL 结尾)
+ */
+static void __node_relink(udlist_t *ud, node_t *first)
+{
+    node_t *p = first;
+
+    while (NULL != p->next)
+    {
+        p->next->prev = p;
+        p = p->next;
+    } /* end of while (NULL != p->next) */
+    p->next = first;
+    first->prev = p;
+    ud->fstnode_p = first;
+
+    ud->finger_p = NULL;
+    if (UDLIST_INDEXED & ud->flags)
+    {
+        ud->root = NULL;
+        udrank_insert_n(ud, first, (size_t)ud->count, 0);
+    } /* end of if (UDLIST_INDEXED & ud->flags) */
+    ud->mods++;
+}
+
+
+
+/**
+ * @brief           创建链表头信息结构体
+ * @param           存储数据类型大小
+ * @param           自定义销毁数据函数
+ * @return          指向链表头信息结构体的指针
+ */
+udlist_t *udlist_create(int size, op_t my_destroy)
+{
+    return udlist_create_ex(size, my_destroy, UDLIST_COMPAT);
+}
+
+
+
+/**
+ * @brief           按指定存储模式创建链表头信息结构体
+ * @param           存储数据类型大小
+ * @param           自定义销毁数据函数
+ * @param           存储模式 UDLIST_COMPAT / UDLIST_INLINE / UDLIST_UNROLLED, 可以或上 UDLIST_INDEXED / UDLIST_CONCURRENT
+ * @return          指向链表头信息结构体的指针
+ */
+udlist_t *udlist_create_ex(int size, op_t my_destroy, int flags)
+{
+    /* 变量定义 */
+    udlist_t *ud = NULL;
+
+    /* 参数检查: 兼容模式必须提供销毁函数释放数据域, 展开模式不能与秩树模式同时使用, 无锁模式只能与内联模式组合 */
+    if (size <= 0 || (flags & ~(UDLIST_INLINE | UDLIST_INDEXED | UDLIST_UNROLLED | UDLIST_CONCURRENT | UDLIST_LOCKFREE))
+        || (NULL == my_destroy && !((UDLIST_INLINE | UDLIST_UNROLLED | UDLIST_LOCKFREE) & flags))
+        || ((UDLIST_UNROLLED & flags) && (UDLIST_INDEXED & flags))
+        || ((UDLIST_LOCKFREE & flags) && (flags & ~(UDLIST_LOCKFREE | UDLIST_INLINE))))
+    {
+        UD_ERROR("udlist_create: Parameter error\n");
+        goto ERR0;
+    } /* end of if (size <= 0 || ...) */
+
+
+    /* 申请头信息结构体空间 */
+    ud = (udlist_t *)calloc(1, sizeof(udlist_t));
+    if (NULL == ud)
+    {
+        UD_ALLOC_ERROR("udlist_create: calloc error\n");
+        goto ERR1;       
+    } /* end of if (NULL == ud) */
+
+    /* 信息输入 */
+    ud->count = 0;
+    ud->size = size;
+    ud->fstnode_p = NULL;
+    ud->my_destroy = my_destroy;
+    ud->flags = flags;
+    ud->finger_p = NULL;
+    ud->finger_idx = 0;
+    ud->root = NULL;
+    ud->hash = NULL;
+    ud->node_off = (UDLIST_INDEXED & flags) ? sizeof(udrank_t) : 0;
+    ud->unroll_k = (UDLIST_UNROLLED & flags) ? udur_default_k(size) : 0;
+    ud->writer = 0;
+    ud->deque = NULL;
+    ud->mods = 0;
+    ud->split = NULL;
+    ud->op_ord = NULL;
+    ud->borrows = 0;
+    ud->emplace_p = NULL;
+    ud->wal = NULL;
+    ud->stats = NULL;
+
+    /* 并发模式初始化读写锁(写者优先, 避免读者持续到来时写者饿死) */
+    if ((UDLIST_CONCURRENT & flags) && 0 != __lock_init(&ud->lock))
+    {
+        UD_ERROR("udlist_create: rwlock init error\n");
+        free(ud);
+        ud = NULL;
+        goto ERR1;
+    } /* end of if ((UDLIST_CONCURRENT & flags) && ...) */
+
+    /* 无锁模式创建双端队列 */
+    if (UDLIST_LOCKFREE & flags)
+    {
+        ud->deque = uddq_create(size, my_destroy);
+        if (NULL == ud->deque)
+        {
+            UD_ERROR("udlist_create: deque create error\n");
+            free(ud);
+            ud = NULL;
+            goto ERR1;
+        } /* end of if (NULL == ud->deque) */
+    } /* end of if (UDLIST_LOCKFREE & flags) */
+
+    /* 统计块(申请失败时不统计), 放在可能失败的步骤之后 */
+#ifdef UDLIST_STATS
+    ud->stats = (struct _udstats_t *)calloc(1, sizeof(udstats_t));
+#endif
+
+
+    return ud;
+
+ERR0:
+    return (void *)PAR_ERROR;
+ERR1:
+    return (void *)FUN_ERROR;
+}
+
+
+
+/**
+ * @brief           创建使用节点内存池的链表头信息结构体
+ * @param           存储数据类型大小
+ * @param           自定义销毁数据函数(可以为 NULL)
+ * @param           每个内存块的节点个数
+ * @return          指向链表头信息结构体的指针
+ */
+udlist_t *udlist_create_pooled(int size, op_t my_destroy, int chunk_nodes)
+{
+    return udlist_create_pooled_ex(size, my_destroy, chunk_nodes, 0);
+}
+
+
+
+/**
+ * @brief           按指定存储模式创建使用节点内存池的链表头信息结构体
+ * @param           存储数据类型大小
+ * @param           自定义销毁数据函数(可以为 NULL)
+ * @param           每个内存块的节点个数
+ * @param           存储模式 0 / UDLIST_INDEXED / UDLIST_CONCURRENT 的组合
+ * @return          指向链表头信息结构体的指针
+ */
+udlist_t *udlist_create_pooled_ex(int size, op_t my_destroy, int chunk_nodes, int flags)
+{
+    /* 变量定义 */
+    udlist_t *ud = NULL;
+
+    /* 参数检查 */
+    if (size <= 0 || chunk_nodes <= 0 || (flags & ~(UDLIST_INDEXED | UDLIST_CONCURRENT)))
+    {
+        UD_ERROR("udlist_create_pooled: Parameter error\n");
+        goto ERR0;
+    } /* end of if (size <= 0 || chunk_nodes <= 0 || ...) */
+
+    /* 内联模式创建头信息结构体 */
+    ud = udlist_create_ex(size, my_destroy, UDLIST_INLINE | flags);
+    if ((void *)PAR_ERROR == ud || (void *)FUN_ERROR == ud)
+    {
+        return ud;
+    } /* end of if ((void *)PAR_ERROR == ud || (void *)FUN_ERROR == ud) */
+
+    /* 创建节点内存池 */
+    ud->pool = udpool_create(ud->node_off + sizeof(node_t) + size, chunk_nodes);
+    if (NULL == ud->pool)
+    {
+        head_destroy(&ud);
+        goto ERR1;
+    } /* end of if (NULL == ud->pool) */
+
+    return ud;
+
+ERR0:
+    return (void *)PAR_ERROR;
+ERR1:
+    return (void *)FUN_ERROR;
+}
+
+
+
+/**
+ * @brief           创建有序链表头信息结构体
+ * @param           存储数据类型大小
+ * @param           自定义销毁数据函数(可以为 NULL)
+ * @param           自定义排序比较函数
+ * @return          指向链表头信息结构体的指针
+ */
+udlist_t *udlist_create_sorted(int size, op_t my_destroy, ord_t op_ord)
+{
+    return udlist_create_sorted_ex(size, my_destroy, op_ord, 0);
+}
+
+
+
+/**
+ * @brief           按指定存储模式创建有序链表头信息结构体
+ * @param           存储数据类型大小
+ * @param           自定义销毁数据函数(可以为 NULL)
+ * @param           自定义排序比较函数
+ * @param           存储模式 0 / UDLIST_CONCURRENT
+ * @return          指向链表头信息结构体的指针
+ */
+udlist_t *udlist_create_sorted_ex(int size, op_t my_destroy, ord_t op_ord, int flags)
+{
+    /* 变量定义 */
+    udlist_t *ud = NULL;
+
+    /* 参数检查 */
+    if (size <= 0 || NULL == op_ord || (flags & ~UDLIST_CONCURRENT))
+    {
+        UD_ERROR("udlist_create_sorted: Parameter error\n");
+        goto ERR0;
+    } /* end of if (size <= 0 || NULL == op_ord || ...) */
+
+    /* 内联秩树模式创建头信息结构体, 秩树的中序即为排序顺序 */
+    ud = udlist_create_ex(size, my_destroy, UDLIST_INLINE | UDLIST_INDEXED | flags);
+    if ((void *)PAR_ERROR == ud || (void *)FUN_ERROR == ud)
+    {
+        return ud;
+    } /* end of if ((void *)PAR_ERROR == ud || (void *)FUN_ERROR == ud) */
+
+    ud->op_ord = op_ord;
+    ud->flags |= UDLIST_SORTED;
+
+    return ud;
+
+ERR0:
+    return (void *)PAR_ERROR;
+}
+
+
+
+/**
+ * @brief           链表尾部插入
+ * @param           头信息结构体的指针
+ * @param           数据的指针
+ * @return          
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+static int __udlist_append(udlist_t *ud, void *data)
+{
+    node_t *temp = NULL;
+
+    /* 参数检查 */
+    if (NULL == ud || NULL == data)
+    {
+        UD_ERROR("udlist_append: Parameter error\n");
+        goto ERR0;        
+    } /* end of if (NULL == ud || NULL == data) */
+
+    /* 无锁模式 */
+    if (UDLIST_LOCKFREE & ud->flags)
+    {
+        return uddq_push(ud->deque, data, 0);
+    } /* end of if (UDLIST_LOCKFREE & ud->flags) */
+
+    /* 展开模式 */
+    if (UDLIST_UNROLLED & ud->flags)
+    {
+        return udur_insert(ud, data, ud->count);
+    } /* end of if (UDLIST_UNROLLED & ud->flags) */
+
+    /* 1.创建一个新的节点并输入数据 */
+    temp = __node_new(ud, data);
+    if (NULL == temp)
+    {
+        goto ERR1;
+    } /* end of if (NULL == temp) */
+
+    /* 2.数据尾部插入(第一个节点之前即为尾部), 有序模式插入到相等元素之后 */
+    if (UDLIST_SORTED & ud->flags)
+    {
+        __node_link_sorted(ud, temp, 1);
+    }
+    else
+    {
+        __node_link_before(ud, ud->fstnode_p, temp, ud->count);
+    }
+
+    return 0;
+
+ERR0:
+    return PAR_ERROR;
+ERR1:
+    return FUN_ERROR;     
+}
+
+
+
+/**
+ * @brief           链表尾部插入(并发模式下持有写锁)
+ */
+int udlist_append(udlist_t *ud, void *data)
+{
+    udwal_t *wal = NULL;
+    uint64_t lsn = 0;
+    int ret = 0;
+
+    UD_STAT_BEGIN();
+    UD_TRACE_ENTER(ud);
+    UD_WRLOCK(ud);
+    ret = __udlist_append(ud, data);
+    UD_WAL_LOG(ud, wal, lsn, 0 == ret, UDWAL_APPEND, 0, data, 1, NULL);
+    UD_WRUNLOCK(ud);
+    ret = UD_WAL_DONE(wal, lsn, ret);
+    UD_TRACE_EXIT(ud);
+    UD_STAT_END(ud, UDSTAT_APPEND);
+
+    return ret;
+}
+
+
+/**
+ * @brief           链表头部插入
+ * @param           头信息结构体的指针
+ * @param           插入节点数据
+ * @return          
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+static int __udlist_prepend(udlist_t *ud, void *data)
+{
+    node_t *temp = NULL;
+
+    /* 参数检查 */
+    if (NULL == ud || NULL == data)
+    {
+        UD_ERROR("udlist_prepend: Parameter error\n");
+        goto ERR0;        
+    } /* end of if (NULL == ud || NULL == data) */
+
+    /* 无锁模式 */
+    if (UDLIST_LOCKFREE & ud->flags)
+    {
+        return uddq_push(ud->deque, data, 1);
+    } /* end of if (UDLIST_LOCKFREE & ud->flags) */
+
+    /* 展开模式 */
+    if (UDLIST_UNROLLED & ud->flags)
+    {
+        return udur_insert(ud, data, 0);
+    } /* end of if (UDLIST_UNROLLED & ud->flags) */
+
+    /* 1.创建一个新的节点并输入数据 */
+    temp = __node_new(ud, data);
+    if (NULL == temp)
+    {
+        goto ERR1;
+    } /* end of if (NULL == temp) */
+
+    /* 2.插入到第一个节点之前并成为第一个节点, 有序模式插入到相等元素之前 */
+    if (UDLIST_SORTED & ud->flags)
+    {
+        __node_link_sorted(ud, temp, 0);
+    }
+    else
+    {
+        __node_link_before(ud, ud->fstnode_p, temp, 0);
+        ud->fstnode_p = temp;
+    }
+
+    return 0;
+
+ERR0:
+    return PAR_ERROR;
+ERR1:
+    return FUN_ERROR;     
+}
+
+
+
+/**
+ * @brief           链表头部插入(并发模式下持有写锁)
+ */
+int udlist_prepend(udlist_t *ud, void *data)
+{
+    udwal_t *wal = NULL;
+    uint64_t lsn = 0;
+    int ret = 0;
+
+    UD_STAT_BEGIN();
+    UD_TRACE_ENTER(ud);
+    UD_WRLOCK(ud);
+    ret = __udlist_prepend(ud, data);
+    UD_WAL_LOG(ud, wal, lsn, 0 == ret, UDWAL_PREPEND, 0, data, 1, NULL);
+    UD_WRUNLOCK(ud);
+    ret = UD_WAL_DONE(wal, lsn, ret);
+    UD_TRACE_EXIT(ud);
+    UD_STAT_END(ud, UDSTAT_PREPEND);
+
+    return ret;
+}
+
+
+/**
+ * @brief           链表尾部批量插入
+ * @param           头信息结构体的指针
+ * @param           元素数组(n 个连续存放的元素)
+ * @param           元素个数
+ * @return          
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+static int __udlist_append_n(udlist_t *ud, const void *array, size_t n)
+{
+    /* 参数检查 */
+    if (NULL == ud || NULL == array || n > (size_t)(INT_MAX - ud->count))
+    {
+        UD_ERROR("udlist_append_n: Parameter error\n");
+        goto ERR0;        
+    } /* end of if (NULL == ud || NULL == array || ...) */
+
+    if (0 == n)
+    {
+        return 0;
+    } /* end of if (0 == n) */
+
+    /* 无锁模式: 逐个插入 */
+    if (UDLIST_LOCKFREE & ud->flags)
+    {
+        return __deque_push_n(ud->deque, array, n, 0);
+    } /* end of if (UDLIST_LOCKFREE & ud->flags) */
+
+    /* 展开模式 */
+    if (UDLIST_UNROLLED & ud->flags)
+    {
+        return udur_insert_n(ud, array, n, 0);
+    } /* end of if (UDLIST_UNROLLED & ud->flags) */
+
+    return __node_insert_n(ud, array, n, 0);
+
+ERR0:
+    return PAR_ERROR;
+}
+
+
+
+/**
+ * @brief           链表尾部批量插入(并发模式下持有写锁)
+ */
+int udlist_append_n(udlist_t *ud, const void *array, size_t n)
+{
+    udwal_t *wal = NULL;
+    uint64_t lsn = 0;
+    int ret = 0;
+
+    UD_STAT_BEGIN();
+    UD_TRACE_ENTER(ud);
+    UD_WRLOCK(ud);
+    ret = __udlist_append_n(ud, array, n);
+    UD_WAL_LOG(ud, wal, lsn, 0 == ret && n > 0, UDWAL_APPEND_N, 0, array, (int)n, NULL);
+    UD_WRUNLOCK(ud);
+    ret = UD_WAL_DONE(wal, lsn, ret);
+    UD_TRACE_EXIT(ud);
+    UD_STAT_END(ud, UDSTAT_APPEND_N);
+
+    return ret;
+}
+
+
+
+/**
+ * @brief           链表头部批量插入, 插入后元素保持数组中的顺序
+ * @param           头信息结构体的指针
+ * @param           元素数组(n 个连续存放的元素)
+ * @param           元素个数
+ * @return          
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+static int __udlist_prepend_n(udlist_t *ud, const void *array, size_t n)
+{
+    /* 参数检查 */
+    if (NULL == ud || NULL == array || n > (size_t)(INT_MAX - ud->count))
+    {
+        UD_ERROR("udlist_prepend_n: Parameter error\n");
+        goto ERR0;        
+    } /* end of if (NULL == ud || NULL == array || ...) */
+
+    if (0 == n)
+    {
+        return 0;
+    } /* end of if (0 == n) */
+
+    /* 无锁模式: 逐个插入 */
+    if (UDLIST_LOCKFREE & ud->flags)
+    {
+        return __deque_push_n(ud->deque, array, n, 1);
+    } /* end of if (UDLIST_LOCKFREE & ud->flags) */
+
+    /* 展开模式 */
+    if (UDLIST_UNROLLED & ud->flags)
+    {
+        return udur_insert_n(ud, array, n, 1);
+    } /* end of if (UDLIST_UNROLLED & ud->flags) */
+
+    return __node_insert_n(ud, array, n, 1);
+
+ERR0:
+    return PAR_ERROR;
+}
+
+
+
+/**
+ * @brief           链表头部批量插入, 插入后元素保持数组中的顺序(并发模式下持有写锁)
+ */
+int udlist_prepend_n(udlist_t *ud, const void *array, size_t n)
+{
+    udwal_t *wal = NULL;
+    uint64_t lsn = 0;
+    int ret = 0;
+
+    UD_STAT_BEGIN();
+    UD_TRACE_ENTER(ud);
+    UD_WRLOCK(ud);
+    ret = __udlist_prepend_n(ud, array, n);
+    UD_WAL_LOG(ud, wal, lsn, 0 == ret && n > 0, UDWAL_PREPEND_N, 0, array, (int)n, NULL);
+    UD_WRUNLOCK(ud);
+    ret = UD_WAL_DONE(wal, lsn, ret);
+    UD_TRACE_EXIT(ud);
+    UD_STAT_END(ud, UDSTAT_PREPEND_N);
+
+    return ret;
+}
+
+
+
+/**
+ * @brief           头部插入, 同 udlist_prepend
+ */
+int udlist_push_front(udlist_t *ud, void *data)
+{
+    return udlist_prepend(ud, data);
+}
+
+
+
+/**
+ * @brief           尾部插入, 同 udlist_append
+ */
+int udlist_push_back(udlist_t *ud, void *data)
+{
+    return udlist_append(ud, data);
+}
+
+
+
+/**
+ * @brief           删除头部或尾部元素并拷出数据
+ * @details         元素的所有权转移给调用者, 不调用 my_destroy
+ * @param           头信息结构体的指针
+ * @param           输出数据的指针
+ * @param           非 0 删除头部, 0 删除尾部
+ * @return          
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  MATCH_FAIL:链表为空
+ */
+static int __udlist_pop(udlist_t *ud, void *data, int front)
+{
+    node_t *des = NULL;
+    int index = 0;
+
+    /* 参数检查 */
+    if (NULL == ud || NULL == data)
+    {
+        UD_ERROR("udlist_pop: Parameter error\n");
+        goto ERR0;        
+    } /* end of if (NULL == ud || NULL == data) */
+
+    /* 无锁模式 */
+    if (UDLIST_LOCKFREE & ud->flags)
+    {
+        return uddq_pop(ud->deque, data, front);
+    } /* end of if (UDLIST_LOCKFREE & ud->flags) */
+
+    /* 判断是否为空链表 */
+    if (0 == ud->count)
+    {
+        return MATCH_FAIL;
+    } /* end of if (0 == ud->count) */
+    index = front ? 0 : ud->count - 1;
+
+    /* 展开模式 */
+    if (UDLIST_UNROLLED & ud->flags)
+    {
+        udur_delete(ud, index, data);
+        return 0;
+    } /* end of if (UDLIST_UNROLLED & ud->flags) */
+
+    /* 拷出数据后摘下并释放节点 */
+    des = front ? ud->fstnode_p : ud->fstnode_p->prev;
+    memcpy(data, des->data, ud->size);
+    __node_unlink(ud, des, index);
+    __node_release(ud, des);
+    des = NULL;
+
+    return 0;
+
+ERR0:
+    return PAR_ERROR;
+}
+
+
+
+/**
+ * @brief           删除头部元素并拷出数据(并发模式下持有写锁)
+ */
+int udlist_pop_front(udlist_t *ud, void *data)
+{
+    udwal_t *wal = NULL;
+    uint64_t lsn = 0;
+    int ret = 0;
+
+    UD_STAT_BEGIN();
+    UD_TRACE_ENTER(ud);
+    UD_WRLOCK(ud);
+    ret = __udlist_pop(ud, data, 1);
+    UD_WAL_LOG(ud, wal, lsn, 0 == ret, UDWAL_DELETE, 0, NULL, 0, NULL);
+    UD_WRUNLOCK(ud);
+    ret = UD_WAL_DONE(wal, lsn, ret);
+    UD_TRACE_EXIT(ud);
+    UD_STAT_END(ud, UDSTAT_POP_FRONT);
+
+    return ret;
+}
+
+
+
+/**
+ * @brief           删除尾部元素并拷出数据(并发模式下持有写锁)
+ */
+int udlist_pop_back(udlist_t *ud, void *data)
+{
+    udwal_t *wal = NULL;
+    uint64_t lsn = 0;
+    int ret = 0;
+
+    UD_STAT_BEGIN();
+    UD_TRACE_ENTER(ud);
+    UD_WRLOCK(ud);
+    ret = __udlist_pop(ud, data, 0);
+    UD_WAL_LOG(ud, wal, lsn, 0 == ret, UDWAL_DELETE, ud->count, NULL, 0, NULL);
+    UD_WRUNLOCK(ud);
+    ret = UD_WAL_DONE(wal, lsn, ret);
+    UD_TRACE_EXIT(ud);
+    UD_STAT_END(ud, UDSTAT_POP_BACK);
+
+    return ret;
+}
+
+
+/**
+ * @brief           链表的遍历
+ * @param           头信息结构体的指针
+ * @param           自定义打印数据函数
+ * @return          
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+static int __udlist_traverse(udlist_t *ud, op_t my_print)
+{
+    node_t *temp = NULL;
+
+    /* 参数检查 */
+    if (NULL == ud || NULL == my_print
+        || (UDLIST_LOCKFREE & ud->flags))
+    {
+        UD_ERROR("udlist_traverse: Parameter error\n");
+        goto ERR0;        
+    } /* end of if (NULL == ud || NULL == my_print || ...) */
+
+    /* 展开模式 */
+    if (UDLIST_UNROLLED & ud->flags)
+    {
+        udur_traverse(ud, my_print, 0);
+        return 0;
+    } /* end of if (UDLIST_UNROLLED & ud->flags) */
+
+
+
+    /* 链表的遍历(空链表直接返回) */
+    temp = ud->fstnode_p;
+    if (NULL != temp)
+    {
+        do 
+        {
+            my_print(temp->data);
+            temp = temp->next;
+        }
+        while (temp != ud->fstnode_p);
+    } /* end of if (NULL != temp) */
+
+
+
+    return 0;
+
+
+ERR0:
+    return PAR_ERROR;
+ERR1:
+    return FUN_ERROR;   
+}
+
+
+
+/**
+ * @brief           链表的遍历(并发模式下持有读锁)
+ */
+int udlist_traverse(udlist_t *ud, op_t my_print)
+{
+    int ret = 0;
+
+    UD_STAT_BEGIN();
+    UD_TRACE_ENTER(ud);
+    UD_RDLOCK(ud);
+    ret = __udlist_traverse(ud, my_print);
+    UD_RDUNLOCK(ud);
+    UD_TRACE_EXIT(ud);
+    UD_STAT_END(ud, UDSTAT_TRAVERSE);
+
+    return ret;
+}
+
+
+
+/**
+ * @brief           链表的反向遍历
+ * @param           头信息结构体的指针
+ * @param           自定义打印数据函数
+ * @return          
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+static int __udlist_traverse_back(udlist_t *ud, op_t my_print)
+{
+    node_t *temp = NULL;
+
+    /* 参数检查 */
+    if (NULL == ud || NULL == my_print
+        || (UDLIST_LOCKFREE & ud->flags))
+    {
+        UD_ERROR("udlist_traverse_back: Parameter error\n");
+        goto ERR0;        
+    } /* end of if (NULL == ud || NULL == my_print || ...) */
+
+    /* 展开模式 */
+    if (UDLIST_UNROLLED & ud->flags)
+    {
+        udur_traverse(ud, my_print, 1);
+        return 0;
+    } /* end of if (UDLIST_UNROLLED & ud->flags) */
+
+
+
+    /* 链表的遍历(空链表直接返回) */
+    temp = ud->fstnode_p;
+    if (NULL != temp)
+    {
+        do 
+        {
+            my_print(temp->data);
+            temp = temp->prev;
+        }
+        while (temp != ud->fstnode_p);
+    } /* end of if (NULL != temp) */
+
+
+
+    return 0;
+
+
+ERR0:
+    return PAR_ERROR;
+ERR1:
+    return FUN_ERROR;   
+}
+
+
+
+/**
+ * @brief           链表的反向遍历(并发模式下持有读锁)
+ */
+int udlist_traverse_back(udlist_t *ud, op_t my_print)
+{
+    int ret = 0;
+
+    UD_STAT_BEGIN();
+    UD_TRACE_ENTER(ud);
+    UD_RDLOCK(ud);
+    ret = __udlist_traverse_back(ud, my_print);
+    UD_RDUNLOCK(ud);
+    UD_TRACE_EXIT(ud);
+    UD_STAT_END(ud, UDSTAT_TRAVERSE_BACK);
+
+    return ret;
+}
+
+
+/**
+ * @brief           链表销毁函数（不包括头信息结构体）
+ * @param           头信息结构体的指针
+ * @return          
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+static int __udlist_destroy(udlist_t *ud)
+{
+    node_t *temp = NULL;
+    node_t *save = NULL;
+
+    /* 参数检查 */
+    if (NULL == ud)
+    {
+        UD_ERROR("udlist_destroy: Parameter error\n");
+        goto ERR0;        
+    } /* end of if (NULL == ud) */    
+
+    temp = ud->fstnode_p;
+
+    /* 展开模式: 逐块释放 */
+    if (UDLIST_UNROLLED & ud->flags)
+    {
+        udur_destroy(ud);
+        temp = NULL;
+    } /* end of if (UDLIST_UNROLLED & ud->flags) */
+
+    /* 无锁模式 */
+    if (UDLIST_LOCKFREE & ud->flags)
+    {
+        uddq_clear(ud->deque);
+    } /* end of if (UDLIST_LOCKFREE & ud->flags) */
+
+    /* 内存池模式: 只清理数据引用的资源, 然后整块释放 */
+    if (NULL != ud->pool)
+    {
+        if (NULL != temp && NULL != ud->my_destroy)
+        {
+            do
+            {
+                ud->my_destroy(temp->data);
+                temp = temp->next;
+            }
+            while (temp != ud->fstnode_p);
+        } /* end of if (NULL != temp && NULL != ud->my_destroy) */
+
+        UD_STAT_ADD(ud, frees, ud->count);
+        udpool_reset(ud->pool);
+        temp = NULL;
+    } /* end of if (NULL != ud->pool) */
+
+    /* 依次释放节点空间 */
+    if (NULL != temp)
+    {
+        do 
+        {
+            /* 1.保存下个节点的指针 */
+            save = temp->next;
+
+            /* 2.释放数据及节点空间 */
+            __node_free(ud, temp);
+            temp = NULL;
+
+            /* 3.指向下一个节点 */
+            temp = save;
+        }
+        while (temp != ud->fstnode_p);
+    } /* end of if (NULL != temp) */
+
+    /* 清空哈希索引 */
+    if (NULL != ud->hash)
+    {
+        udhash_clear(ud->hash);
+    } /* end of if (NULL != ud->hash) */
+
+    /* 头信息刷新 */
+    ud->fstnode_p = NULL;
+    ud->finger_p = NULL;
+    ud->root = NULL;
+    ud->count = 0;
+    ud->mods++;
+
+    return 0;
+
+
+ERR0:
+    return PAR_ERROR;
+ERR1:
+    return FUN_ERROR;   
+}
+
+
+
+/**
+ * @brief           链表销毁函数（不包括头信息结构体）(并发模式下持有写锁)
+ */
+int udlist_destroy(udlist_t *ud)
+{
+    udwal_t *wal = NULL;
+    uint64_t lsn = 0;
+    int ret = 0;
+
+    UD_STAT_BEGIN();
+    UD_TRACE_ENTER(ud);
+    UD_WRLOCK(ud);
+    ret = __udlist_destroy(ud);
+    UD_WAL_LOG(ud, wal, lsn, 0 == ret, UDWAL_CLEAR, 0, NULL, 0, NULL);
+    UD_WRUNLOCK(ud);
+    ret = UD_WAL_DONE(wal, lsn, ret);
+    UD_TRACE_EXIT(ud);
+    UD_STAT_END(ud, UDSTAT_DESTROY);
+
+    return ret;
+}
+
+
+/**
+ * @brief           头信息结构体销毁函数
+ * @param           头信息结构体的指针的地址
+ * @return          
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+int head_destroy(udlist_t **p)
+{
+    /* 参数检查 */
+    if (NULL == p)
+    {
+        UD_ERROR("head_destroy: Parameter error\n");
+        goto ERR0;        
+    } /* end of if (NULL == p) */  
+
+    /* 销毁节点内存池及哈希索引 */
+    if (NULL != *p)
+    {
+        udpool_destroy(&(*p)->pool);
+        udhash_destroy(&(*p)->hash);
+        uddq_destroy(&(*p)->deque);
+        free((*p)->split);
+        udwal_destroy(&(*p)->wal);
+        free((*p)->stats);
+        if (UDLIST_CONCURRENT & (*p)->flags)
+        {
+            pthread_rwlock_destroy(&(*p)->lock);
+        } /* end of if (UDLIST_CONCURRENT & (*p)->flags) */
+    } /* end of if (NULL != *p) */
+
+    /* 销毁结构体空间 */
+    free(*p);
+    *p = NULL;
+
+    return 0;
+
+
+ERR0:
+    return PAR_ERROR;
+ERR1:
+    return FUN_ERROR;  
+}
+
+
+/**
+ * @brief           获取链表中节点的个数
+ * @param           头信息结构体的指针
+ * @return          链表节点个数
+ */
+static int __get_count(udlist_t *p)
+{
+    /* 参数检查 */
+    if (NULL == p)
+    {
+        UD_ERROR("get_count: Parameter error\n");
+        goto ERR0;        
+    } /* end of if (NULL == p) */  
+
+    /* 无锁模式 */
+    if (UDLIST_LOCKFREE & p->flags)
+    {
+        return uddq_count(p->deque);
+    } /* end of if (UDLIST_LOCKFREE & p->flags) */
+
+    return p->count;
+
+ERR0:
+    return PAR_ERROR;    
+}
+
+
+
+/**
+ * @brief           获取链表中节点的个数(并发模式下持有读锁)
+ */
+int get_count(udlist_t *p)
+{
+    int ret = 0;
+
+    UD_RDLOCK(p);
+    ret = __get_count(p);
+    UD_RDUNLOCK(p);
+
+    return ret;
+}
+
+
+/**
+ * @brief           链表根据索引插入
+ * @param           头信息结构体的指针
+ * @param           数据的指针
+ * @param           索引值
+ * @return          
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+static int __udlist_insert_by_index(udlist_t *ud, void *data, int index)
+{
+    node_t *temp = NULL;
+
+
+    /* 参数检查 */
+    if (NULL == ud || NULL == data || index < 0
+        || (UDLIST_LOCKFREE & ud->flags))
+    {
+        UD_ERROR("udlist_insert_by_index: Parameter error\n");
+        goto ERR0;        
+    } /* end of if (NULL == ud || NULL == data || ...) */
+
+    /* 展开模式 */
+    if (UDLIST_UNROLLED & ud->flags)
+    {
+        return udur_insert(ud, data, index);
+    } /* end of if (UDLIST_UNROLLED & ud->flags) */
+
+
+    /* 创建一个新的节点并输入数据 */
+    temp = __node_new(ud, data);
+    if (NULL == temp)
+    {
+        goto ERR1;
+    } /* end of if (NULL == temp) */
+
+
+    /* 判断索引 */
+    if (UDLIST_SORTED & ud->flags)
+    {
+        // 有序模式忽略索引, 按顺序插入
+        __node_link_sorted(ud, temp, 1);
+    }
+    else if (index < ud->count)
+    {
+        // 链接到索引位置节点之前
+        __node_link_before(ud, __node_seek(ud, index), temp, index);
+        if (0 == index)
+        {
+            // 头部插入
+            ud->fstnode_p = temp;
+        } /* end of if (0 == index) */
+    }
+    else 
+    {
+        // 尾部插入
+        __node_link_before(ud, ud->fstnode_p, temp, ud->count);
+    }
+
+
+    return 0;
+
+
+ERR0:
+    return PAR_ERROR;
+ERR1:
+    return FUN_ERROR; 
+}
+
+
+
+/**
+ * @brief           链表根据索引插入(并发模式下持有写锁)
+ */
+int udlist_insert_by_index(udlist_t *ud, void *data, int index)
+{
+    udwal_t *wal = NULL;
+    uint64_t lsn = 0;
+    int ret = 0;
+
+    UD_STAT_BEGIN();
+    UD_TRACE_ENTER(ud);
+    UD_WRLOCK(ud);
+    ret = __udlist_insert_by_index(ud, data, index);
+    UD_WAL_LOG(ud, wal, lsn, 0 == ret, UDWAL_INSERT, index, data, 1, NULL);
+    UD_WRUNLOCK(ud);
+    ret = UD_WAL_DONE(wal, lsn, ret);
+    UD_TRACE_EXIT(ud);
+    UD_STAT_END(ud, UDSTAT_INSERT_BY_INDEX);
+
+    return ret;
+}
+
+
+
+/**
+ * @brief           链表根据索引删除
+ * @param           头信息结构体的指针
+ * @param           索引值
+ * @return          
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+static int __udlist_delete_by_index(udlist_t *ud, int index)
+{
+    node_t *des = NULL;
+
+
+    /* 参数检查 */
+    if (NULL == ud || index < 0
+        || ((UDLIST_LOCKFREE & ud->flags) ? 0 != index : index >= ud->count))
+    {
+        UD_ERROR("udlist_delete_by_index: Parameter error\n");
+        goto ERR0;        
+    } /* end of if (NULL == ud || index < 0 || ...) */
+
+    /* 无锁模式: 只支持删除头部 */
+    if (UDLIST_LOCKFREE & ud->flags)
+    {
+        return (0 == uddq_pop(ud->deque, NULL, 1)) ? 0 : PAR_ERROR;
+    } /* end of if (UDLIST_LOCKFREE & ud->flags) */
+
+    /* 展开模式 */
+    if (UDLIST_UNROLLED & ud->flags)
+    {
+        udur_delete(ud, index, NULL);
+        return 0;
+    } /* end of if (UDLIST_UNROLLED & ud->flags) */
+
+    /* 寻找并摘下节点 */
+    des = __node_seek(ud, index);
+    __node_unlink(ud, des, index);
+
+    /* 释放节点 */
+    __node_free(ud, des);
+    des = NULL;
+
+    return 0;
+
+
+ERR0:
+    return PAR_ERROR;
+}
+
+
+
+/**
+ * @brief           链表根据索引删除(并发模式下持有写锁)
+ */
+int udlist_delete_by_index(udlist_t *ud, int index)
+{
+    udwal_t *wal = NULL;
+    uint64_t lsn = 0;
+    int ret = 0;
+
+    UD_STAT_BEGIN();
+    UD_TRACE_ENTER(ud);
+    UD_WRLOCK(ud);
+    ret = __udlist_delete_by_index(ud, index);
+    UD_WAL_LOG(ud, wal, lsn, 0 == ret, UDWAL_DELETE, index, NULL, 0, NULL);
+    UD_WRUNLOCK(ud);
+    ret = UD_WAL_DONE(wal, lsn, ret);
+    UD_TRACE_EXIT(ud);
+    UD_STAT_END(ud, UDSTAT_DELETE_BY_INDEX);
+
+    return ret;
+}
+
+
+/**
+ * @brief           链表根据索引修改数据
+ * @param           头信息结构体的指针
+ * @param           修改数据
+ * @param           索引值
+ * @return          
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+static int __udlist_modify_by_index(udlist_t *ud, void *data, int index)
+{
+    node_t *temp = NULL;
+
+
+    /* 参数检查 */
+    if (NULL == ud || index < 0 || index >= ud->count || NULL == data
+        || (UDLIST_LOCKFREE & ud->flags))
+    {
+        UD_ERROR("udlist_modify_by_index: Parameter error\n");
+        goto ERR0;        
+    } /* end of if (NULL == ud || index < 0 || ...) */
+
+    /* 展开模式 */
+    if (UDLIST_UNROLLED & ud->flags)
+    {
+        memcpy(udur_at(ud, index), data, ud->size);
+        return 0;
+    } /* end of if (UDLIST_UNROLLED & ud->flags) */
+
+    /* 寻找索引位置 */
+    temp = __node_seek(ud, index);
+
+    /* 修改数据, 有序模式恢复顺序 */
+    __node_write(ud, temp, data);
+    if (UDLIST_SORTED & ud->flags)
+    {
+        __node_reorder(ud, temp);
+    } /* end of if (UDLIST_SORTED & ud->flags) */
+
+    return 0;
+
+
+ERR0:
+    return PAR_ERROR;
+ERR1:
+    return FUN_ERROR;       
+}
+
+
+
+/**
+ * @brief           链表根据索引修改数据(并发模式下持有写锁)
+ */
+int udlist_modify_by_index(udlist_t *ud, void *data, int index)
+{
+    udwal_t *wal = NULL;
+    uint64_t lsn = 0;
+    int ret = 0;
+
+    UD_STAT_BEGIN();
+    UD_TRACE_ENTER(ud);
+    UD_WRLOCK(ud);
+    ret = __udlist_modify_by_index(ud, data, index);
+    UD_WAL_LOG(ud, wal, lsn, 0 == ret, UDWAL_MODIFY, index, data, 1, NULL);
+    UD_WRUNLOCK(ud);
+    ret = UD_WAL_DONE(wal, lsn, ret);
+    UD_TRACE_EXIT(ud);
+    UD_STAT_END(ud, UDSTAT_MODIFY_BY_INDEX);
+
+    return ret;
+}
+
+
+/**
+ * @brief           链表根据索引检索数据
+ * @param           头信息结构体的指针
+ * @param           要检索的数据
+ * @param           索引值
+ * @return          
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+static int __udlist_retrieve_by_index(udlist_t *ud, void *data, int index)
+{
+    node_t *temp = NULL;
+
+    /* 参数检查 */
+    if (NULL == ud || index < 0 || index >= ud->count || NULL == data
+        || (UDLIST_LOCKFREE & ud->flags))
+    {
+        UD_ERROR("udlist_retrieve_by_index: Parameter error\n");
+        goto ERR0;        
+    } /* end of if (NULL == ud || index < 0 || ...) */
+
+    /* 展开模式 */
+    if (UDLIST_UNROLLED & ud->flags)
+    {
+        memcpy(data, udur_at(ud, index), ud->size);
+        return 0;
+    } /* end of if (UDLIST_UNROLLED & ud->flags) */
+
+
+    /* 寻找索引位置 */
+    temp = __node_seek(ud, index);
+
+    /* 修改数据 */
+    memcpy(data, temp->data, ud->size);
+
+
+    return 0;
+
+
+ERR0:
+    return PAR_ERROR;
+ERR1:
+    return FUN_ERROR;      
+}
+
+
+
+/**
+ * @brief           链表根据索引检索数据(并发模式下持有读锁)
+ */
+int udlist_retrieve_by_index(udlist_t *ud, void *data, int index)
+{
+    int ret = 0;
+
+    UD_STAT_BEGIN();
+    UD_TRACE_ENTER(ud);
+    UD_RDLOCK(ud);
+    ret = __udlist_retrieve_by_index(ud, data, index);
+    UD_RDUNLOCK(ud);
+    UD_TRACE_EXIT(ud);
+    UD_STAT_END(ud, UDSTAT_RETRIEVE_BY_INDEX);
+
+    return ret;
+}
+
+
+/**
+ * @brief           根据关键字寻找匹配索引
+ * @param           头信息结构体的指针
+ * @param           关键字
+ * @param           自定义比较函数
+ * @return          索引值    
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  MATCH_FAIL:无匹配索引
+ */
+static int __get_match_index(udlist_t *ud, void *key, cmp_t op_cmp)
+{
+    int index = 0;
+    node_t *temp = NULL;
+
+
+    /* 参数检查 */
+    if (NULL == ud || NULL == key || NULL == op_cmp
+        || (UDLIST_LOCKFREE & ud->flags))
+    {
+        UD_ERROR("get_match_index: Parameter error\n");
+        goto ERR0;        
+    } /* end of if (NULL == ud || NULL == key || ...) */
+
+    /* 展开模式 */
+    if (UDLIST_UNROLLED & ud->flags)
+    {
+        if (NULL == udur_find(ud, key, op_cmp, &index))
+        {
+            goto ERR1;
+        } /* end of if (NULL == udur_find(ud, key, op_cmp, &index)) */
+        return index;
+    } /* end of if (UDLIST_UNROLLED & ud->flags) */
+
+
+    /* 寻找匹配节点 */
+    temp = __node_find(ud, key, op_cmp, &index);
+    if (NULL == temp)
+    {
+        goto ERR1;
+    } /* end of if (NULL == temp) */
+
+    /* 通过哈希索引找到的节点需要计算索引 */
+    if (index < 0)
+    {
+        index = __node_index(ud, temp);
+    } /* end of if (index < 0) */
+
+    return index;
+
+
+ERR0:
+    return PAR_ERROR;
+ERR1:
+    return MATCH_FAIL; 
+}
+
+
+
+/**
+ * @brief           根据关键字寻找匹配索引(并发模式下持有读锁)
+ */
+int get_match_index(udlist_t *ud, void *key, cmp_t op_cmp)
+{
+    int ret = 0;
+
+    UD_RDLOCK(ud);
+    ret = __get_match_index(ud, key, op_cmp);
+    UD_RDUNLOCK(ud);
+
+    return ret;
+}
+
+
+
+/**
+ * @brief           链表根据关键字删除
+ * @param           头信息结构体的指针
+ * @param           关键字
+ * @param           自定义比较函数
+ * @param           输出删除元素的索引(可以为 NULL)
+ * @return          
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+static int __udlist_delete_by_key(udlist_t *ud, void *key, cmp_t op_cmp, int *out)
+{
+    node_t *temp = NULL;
+    int index = 0;
+
+    /* 参数检查 */
+    if (NULL == ud || NULL == key || NULL == op_cmp
+        || (UDLIST_LOCKFREE & ud->flags))
+    {
+        UD_ERROR("udlist_delete_by_key: Parameter error\n");
+        goto ERR0;        
+    } /* end of if (NULL == ud || NULL == key || ...) */
+
+    /* 展开模式 */
+    if (UDLIST_UNROLLED & ud->flags)
+    {
+        if (NULL == udur_find(ud, key, op_cmp, &index))
+        {
+            goto ERR1;
+        } /* end of if (NULL == udur_find(ud, key, op_cmp, &index)) */
+        udur_delete(ud, index, NULL);
+        if (NULL != out)
+        {
+            *out = index;
+        } /* end of if (NULL != out) */
+        return 0;
+    } /* end of if (UDLIST_UNROLLED & ud->flags) */
+
+
+    /* 寻找匹配节点 */
+    temp = __node_find(ud, key, op_cmp, &index);
+    if (NULL == temp)
+    {
+        goto ERR1;
+    } /* end of if (NULL == temp) */
+
+
+    /* 输出索引(哈希索引命中时未计算) */
+    if (NULL != out)
+    {
+        *out = (index < 0) ? __node_index(ud, temp) : index;
+    } /* end of if (NULL != out) */
+
+    /* 摘下并释放节点 */
+    __node_unlink(ud, temp, index);
+    __node_free(ud, temp);
+    temp = NULL;
+
+
+    return 0;
+
+
+ERR0:
+    return PAR_ERROR;
+ERR1:
+    return FUN_ERROR;        
+}
+
+
+
+/**
+ * @brief           链表根据关键字删除(并发模式下持有写锁)
+ */
+int udlist_delete_by_key(udlist_t *ud, void *key, cmp_t op_cmp)
+{
+    udwal_t *wal = NULL;
+    uint64_t lsn = 0;
+    int index = 0;
+    int ret = 0;
+
+    UD_STAT_BEGIN();
+    UD_TRACE_ENTER(ud);
+    // 只在开启预写日志时计算索引
+    UD_WRLOCK(ud);
+    ret = __udlist_delete_by_key(ud, key, op_cmp, (NULL != ud && NULL != ud->wal) ? &index : NULL);
+    UD_WAL_LOG(ud, wal, lsn, 0 == ret, UDWAL_DELETE, index, NULL, 0, NULL);
+    UD_WRUNLOCK(ud);
+    ret = UD_WAL_DONE(wal, lsn, ret);
+    UD_TRACE_EXIT(ud);
+    UD_STAT_END(ud, UDSTAT_DELETE_BY_KEY);
+
+    return ret;
+}
+
+
+
+/**
+ * @brief           链表根据关键字修改数据
+ * @param           头信息结构体的指针
+ * @param           修改的数据
+ * @param           关键字
+ * @param           自定义比较函数
+ * @param           输出修改元素的索引(可以为 NULL)
+ * @return          
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+static int __udlist_modify_by_key(udlist_t *ud, void *data, void *key, cmp_t op_cmp, int *index)
+{
+    node_t *temp = NULL;
+    void *elem = NULL;
+
+    /* 参数检查 */
+    if (NULL == ud || NULL == key || NULL == op_cmp || NULL == data
+        || (UDLIST_LOCKFREE & ud->flags))
+    {
+        UD_ERROR("udlist_modify_by_key: Parameter error\n");
+        goto ERR0;        
+    } /* end of if (NULL == ud || NULL == key || ...) */
+
+    /* 展开模式 */
+    if (UDLIST_UNROLLED & ud->flags)
+    {
+        elem = udur_find(ud, key, op_cmp, index);
+        if (NULL == elem)
+        {
+            goto ERR1;
+        } /* end of if (NULL == elem) */
+        memcpy(elem, data, ud->size);
+        return 0;
+    } /* end of if (UDLIST_UNROLLED & ud->flags) */
+
+
+    /* 寻找匹配节点 */
+    temp = __node_find(ud, key, op_cmp, index);
+    if (NULL == temp)
+    {
+        goto ERR1;
+    } /* end of if (NULL == temp) */
+    if (NULL != index && *index < 0)
+    {
+        *index = __node_index(ud, temp);
+    } /* end of if (NULL != index && *index < 0) */
+
+
+    /* 修改数据, 有序模式恢复顺序 */
+    __node_write(ud, temp, data);
+    if (UDLIST_SORTED & ud->flags)
+    {
+        __node_reorder(ud, temp);
+    } /* end of if (UDLIST_SORTED & ud->flags) */
+
+
+    return 0;
+
+ERR0:
+    return PAR_ERROR;
+ERR1:
+    return FUN_ERROR; 
+}
+
+
+
+/**
+ * @brief           链表根据关键字修改数据(并发模式下持有写锁)
+ */
+int udlist_modify_by_key(udlist_t *ud, void *data, void *key, cmp_t op_cmp)
+{
+    udwal_t *wal = NULL;
+    uint64_t lsn = 0;
+    int index = 0;
+    int ret = 0;
+
+    UD_STAT_BEGIN();
+    UD_TRACE_ENTER(ud);
+    // 只在开启预写日志时计算索引
+    UD_WRLOCK(ud);
+    ret = __udlist_modify_by_key(ud, data, key, op_cmp, (NULL != ud && NULL != ud->wal) ? &index : NULL);
+    UD_WAL_LOG(ud, wal, lsn, 0 == ret, UDWAL_MODIFY, index, data, 1, NULL);
+    UD_WRUNLOCK(ud);
+    ret = UD_WAL_DONE(wal, lsn, ret);
+    UD_TRACE_EXIT(ud);
+    UD_STAT_END(ud, UDSTAT_MODIFY_BY_KEY);
+
+    return ret;
+}
+
+
+
+/**
+ * @brief           链表根据关键字获取数据
+ * @param           头信息结构体的指针
+ * @param           获取的数据
+ * @param           关键字
+ * @param           自定义比较函数
+ * @return          
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+static int __udlist_retrieve_by_key(udlist_t *ud, void *data, void *key, cmp_t op_cmp)
+{
+    node_t *temp = NULL;
+    void *elem = NULL;
+
+    /* 参数检查 */
+    if (NULL == ud || NULL == key || NULL == op_cmp || NULL == data
+        || (UDLIST_LOCKFREE & ud->flags))
+    {
+        UD_ERROR("udlist_retrieve_by_key: Parameter error\n");
+        goto ERR0;        
+    } /* end of if (NULL == ud || NULL == key || ...) */
+
+    /* 展开模式 */
+    if (UDLIST_UNROLLED & ud->flags)
+    {
+        elem = udur_find(ud, key, op_cmp, NULL);
+        if (NULL == elem)
+        {
+            goto ERR1;
+        } /* end of if (NULL == elem) */
+        memcpy(data, elem, ud->size);
+        return 0;
+    } /* end of if (UDLIST_UNROLLED & ud->flags) */
+
+
+    /* 寻找匹配节点 */
+    temp = __node_find(ud, key, op_cmp, NULL);
+    if (NULL == temp)
+    {
+        goto ERR1;
+    } /* end of if (NULL == temp) */
+
+    /* 获取数据 */
+    memcpy(data, temp->data, ud->size);
+
+    return 0;
+
+
+ERR0:
+    return PAR_ERROR;
+ERR1:
+    return FUN_ERROR; 
+}
+
+
+
+/**
+ * @brief           链表根据关键字获取数据(并发模式下持有读锁)
+ */
+int udlist_retrieve_by_key(udlist_t *ud, void *data, void *key, cmp_t op_cmp)
+{
+    int ret = 0;
+
+    UD_STAT_BEGIN();
+    UD_TRACE_ENTER(ud);
+    UD_RDLOCK(ud);
+    ret = __udlist_retrieve_by_key(ud, data, key, op_cmp);
+    UD_RDUNLOCK(ud);
+    UD_TRACE_EXIT(ud);
+    UD_STAT_END(ud, UDSTAT_RETRIEVE_BY_KEY);
+
+    return ret;
+}
+
+
+/**
+ * @brief           链表根据关键字删除所有匹配的节点
+ * @param           头信息结构体的指针
+ * @param           关键字
+ * @param           自定义比较函数 
+ * @return          删除的节点个数
+ *      @arg  PAR_ERROR:参数错误
+ */
+static int __udlist_delete_all_by_key(udlist_t *ud, void *key, cmp_t op_cmp)
+{
+    /* 参数检查 */
+    if (NULL == ud || NULL == key || NULL == op_cmp
+        || (UDLIST_LOCKFREE & ud->flags))
+    {
+        UD_ERROR("udlist_delete_all_by_key: Parameter error\n");
+        goto ERR0;        
+    } /* end of if (NULL == ud || NULL == key || ...) */
+
+    /* 单次遍历删除 */
+    if (UDLIST_UNROLLED & ud->flags)
+    {
+        return udur_sweep(ud, key, op_cmp, NULL);
+    } /* end of if (UDLIST_UNROLLED & ud->flags) */
+    return __node_sweep(ud, key, op_cmp, NULL);
+
+ERR0:
+    return PAR_ERROR;
+}
+
+
+
+/**
+ * @brief           链表根据关键字删除所有匹配的节点(并发模式下持有写锁)
+ */
+int udlist_delete_all_by_key(udlist_t *ud, void *key, cmp_t op_cmp)
+{
+    udwal_match_t m;
+    udwal_t *wal = NULL;
+    uint64_t lsn = 0;
+    int ret = 0;
+
+    UD_STAT_BEGIN();
+    UD_TRACE_ENTER(ud);
+    UD_WRLOCK(ud);
+    if (NULL != ud && NULL != ud->wal && NULL != key && NULL != op_cmp)
+    {
+        // 预写日志: 遍历时记下命中位置, 数组申请失败时日志不再可用
+        memset(&m, 0, sizeof(m));
+        m.key = key;
+        m.op_cmp = op_cmp;
+        ret = __udlist_delete_all_by_key(ud, &m, udwal_match);
+        UD_WAL_LOG(ud, wal, lsn, ret > 0, UDWAL_DELETE_SET, 0, NULL, m.err ? -1 : m.n, m.hit);
+        free(m.hit);
+    }
+    else
+    {
+        ret = __udlist_delete_all_by_key(ud, key, op_cmp);
+    }
+    UD_WRUNLOCK(ud);
+    ret = UD_WAL_DONE(wal, lsn, ret);
+    UD_TRACE_EXIT(ud);
+    UD_STAT_END(ud, UDSTAT_DELETE_ALL_BY_KEY);
+
+    return ret;
+}
+
+
+/**
+ * @brief           链表根据关键字修改所有匹配节点的数据
+ * @param           头信息结构体的指针
+ * @param           修改的数据
+ * @param           关键字
+ * @param           自定义比较函数
+ * @return          修改的节点个数
+ *      @arg  PAR_ERROR:参数错误
+ */
+static int __udlist_modify_all_by_key(udlist_t *ud, void *data, void *key, cmp_t op_cmp)
+{
+    int hit = 0;
+
+    /* 参数检查 */
+    if (NULL == ud || NULL == key || NULL == op_cmp || NULL == data
+        || (UDLIST_LOCKFREE & ud->flags))
+    {
+        UD_ERROR("udlist_modify_all_by_key: Parameter error\n");
+        goto ERR0;        
+    } /* end of if (NULL == ud || NULL == key || ...) */
+
+    /* 单次遍历修改, 新数据仍然匹配也不会重复处理 */
+    if (UDLIST_UNROLLED & ud->flags)
+    {
+        return udur_sweep(ud, key, op_cmp, data);
+    } /* end of if (UDLIST_UNROLLED & ud->flags) */
+    hit = __node_sweep(ud, key, op_cmp, data);
+
+    /* 有序模式: 修改的元素可能不再有序, 重新排序(其余元素有序, 接近 O(n)) */
+    if ((UDLIST_SORTED & ud->flags) && hit > 0)
+    {
+        ud->fstnode_p->prev->next = NULL;
+        __node_relink(ud, __node_sort(ud->fstnode_p, ud->op_ord));
+    } /* end of if ((UDLIST_SORTED & ud->flags) && hit > 0) */
+
+    return hit;
+
+ERR0:
+    return PAR_ERROR;
+}
+
+
+
+/**
+ * @brief           链表根据关键字修改所有匹配节点的数据(并发模式下持有写锁)
+ */
+int udlist_modify_all_by_key(udlist_t *ud, void *data, void *key, cmp_t op_cmp)
+{
+    udwal_match_t m;
+    udwal_t *wal = NULL;
+    uint64_t lsn = 0;
+    int ret = 0;
+
+    UD_STAT_BEGIN();
+    UD_TRACE_ENTER(ud);
+    UD_WRLOCK(ud);
+    if (NULL != ud && NULL != ud->wal && NULL != key && NULL != op_cmp)
+    {
+        // 预写日志: 遍历时记下命中位置, 数组申请失败时日志不再可用
+        memset(&m, 0, sizeof(m));
+        m.key = key;
+        m.op_cmp = op_cmp;
+        ret = __udlist_modify_all_by_key(ud, data, &m, udwal_match);
+        UD_WAL_LOG(ud, wal, lsn, ret > 0, UDWAL_MODIFY_SET, 0, data, m.err ? -1 : m.n, m.hit);
+        free(m.hit);
+    }
+    else
+    {
+        ret = __udlist_modify_all_by_key(ud, data, key, op_cmp);
+    }
+    UD_WRUNLOCK(ud);
+    ret = UD_WAL_DONE(wal, lsn, ret);
+    UD_TRACE_EXIT(ud);
+    UD_STAT_END(ud, UDSTAT_MODIFY_ALL_BY_KEY);
+
+    return ret;
+}
+
+
+
+/**
+ * @brief           删除所有满足谓词的节点
+ * @param           头信息结构体的指针
+ * @param           自定义谓词函数, 返回 MATCH_SUCCESS 表示删除
+ * @param           谓词上下文
+ * @return          删除的节点个数
+ *      @arg  PAR_ERROR:参数错误
+ */
+static int __udlist_remove_if(udlist_t *ud, pred_t pred, void *ctx)
+{
+    /* 参数检查 */
+    if (NULL == ud || NULL == pred
+        || (UDLIST_LOCKFREE & ud->flags))
+    {
+        UD_ERROR("udlist_remove_if: Parameter error\n");
+        goto ERR0;        
+    } /* end of if (NULL == ud || NULL == pred || ...) */
+
+    /* 单次遍历删除 */
+    if (UDLIST_UNROLLED & ud->flags)
+    {
+        return udur_sweep(ud, ctx, pred, NULL);
+    } /* end of if (UDLIST_UNROLLED & ud->flags) */
+    return __node_sweep(ud, ctx, pred, NULL);
+
+ERR0:
+    return PAR_ERROR;
+}
+
+
+
+/**
+ * @brief           删除所有满足谓词的节点(并发模式下持有写锁)
+ */
+int udlist_remove_if(udlist_t *ud, pred_t pred, void *ctx)
+{
+    udwal_match_t m;
+    udwal_t *wal = NULL;
+    uint64_t lsn = 0;
+    int ret = 0;
+
+    UD_STAT_BEGIN();
+    UD_TRACE_ENTER(ud);
+    UD_WRLOCK(ud);
+    if (NULL != ud && NULL != ud->wal && NULL != pred)
+    {
+        // 预写日志: 遍历时记下命中位置, 同 udlist_delete_all_by_key
+        memset(&m, 0, sizeof(m));
+        m.key = ctx;
+        m.op_cmp = pred;
+        ret = __udlist_remove_if(ud, udwal_match, &m);
+        UD_WAL_LOG(ud, wal, lsn, ret > 0, UDWAL_DELETE_SET, 0, NULL, m.err ? -1 : m.n, m.hit);
+        free(m.hit);
+    }
+    else
+    {
+        ret = __udlist_remove_if(ud, pred, ctx);
+    }
+    UD_WRUNLOCK(ud);
+    ret = UD_WAL_DONE(wal, lsn, ret);
+    UD_TRACE_EXIT(ud);
+    UD_STAT_END(ud, UDSTAT_REMOVE_IF);
+
+    return ret;
+}
+
+
+/**
+ * @brief           自定义索引销毁函数
+ * @param           数据域
+ * @return          0
+ */
+int index_destroy(void *data)
+{
+    free(data);
+    data = NULL;
+    return 0;
+}
+
+
+/**
+ * @brief           自定义索引打印函数
+ * @param           数据域
+ * @return          0
+ */
+int index_print(void *data)
+{
+    printf("index = %d\n", *(int *)data);
+    return 0;
+}
+
+
+/**
+ * @brief           收集所有匹配关键字的索引
+ * @details         grow 为 0 时最多写入 cap 个但继续计数, 否则 *vec 按 2 倍扩容
+ * @param           链表头信息结构体指针
+ * @param           关键字
+ * @param           自定义比较函数
+ * @param           索引数组指针的地址
+ * @param           数组容量
+ * @param           是否扩容
+ * @return          匹配个数, 扩容失败返回 FUN_ERROR(已写入的数组仍由调用者释放)
+ */
+static int __index_collect(udlist_t *ud, void *key, cmp_t op_cmp, int **vec, int cap, int grow)
+{
+    node_t *p = ud->fstnode_p;
+    void *data = NULL;
+    int *save = NULL;
+    int index = 0;
+    int hit = 0;
+    int n = 0;
+    int i = 0;
+
+    if (NULL == p)
+    {
+        return 0;
+    } /* end of if (NULL == p) */
+
+    do
+    {
+        // 展开模式依次访问块内元素
+        n = (UDLIST_UNROLLED & ud->flags) ? UD_BLOCK(p)->used : 1;
+        for (i = 0; i < n; i++, index++)
+        {
+            data = (UDLIST_UNROLLED & ud->flags) ? UD_ELEM(ud, UD_BLOCK(p), i) : p->data;
+            if (MATCH_SUCCESS != op_cmp(data, key))
+            {
+                continue;
+            } /* end of if (MATCH_SUCCESS != op_cmp(data, key)) */
+
+            if (grow && hit == cap)
+            {
+                cap = (0 == cap) ? 64 : ((cap > INT_MAX / 2) ? INT_MAX : cap * 2);
+                save = (int *)realloc(*vec, (size_t)cap * sizeof(int));
+                if (NULL == save)
+                {
+                    return FUN_ERROR;
+                } /* end of if (NULL == save) */
+                *vec = save;
+            } /* end of if (grow && hit == cap) */
+
+            if (hit < cap)
+            {
+                (*vec)[hit] = index;
+            } /* end of if (hit < cap) */
+            hit++;
+        } /* end of for (i = 0; i < n; i++, index++) */
+
+        p = p->next;
+    }
+    while (p != ud->fstnode_p);
+
+    return hit;
+}
+
+
+
+/**
+ * @brief           链表根据关键字查找所有的索引
+ * @param           头信息结构体的指针
+ * @param           关键字
+ * @param           自定义比较函数 
+ * @return          存储索引链表
+ *      @arg  PAR_ERROR: 参数错误
+ *      @arg  NULL     : 没有找到匹配索引
+ */
+static udlist_t *__udlist_find_all_index_by_key(udlist_t *ud, void *key, cmp_t op_cmp)
+{
+    udlist_t *index_head = NULL;
+    int *vec = NULL;
+    int n = 0;
+
+
+    /* 参数检查 */
+    if (NULL == ud || NULL == key || NULL == op_cmp
+        || (UDLIST_LOCKFREE & ud->flags))
+    {
+        UD_ERROR("udlist_find_all_index_by_key: Parameter error\n");
+        goto ERR0;        
+    } /* end of if (NULL == ud || NULL == key || ...) */
+
+
+    /* 判断链表是否存在 */
+    if (NULL == ud->fstnode_p)
+    {
+        goto ERR1;
+    } /* end of if (NULL == ud->fstnode_p) */
+
+
+    /* 收集匹配索引(没有匹配时不创建链表) */
+    n = __index_collect(ud, key, op_cmp, &vec, 0, 1);
+    if (n <= 0)
+    {
+        free(vec);
+        goto ERR1;
+    } /* end of if (n <= 0) */
+
+
+    /* 创建存储索引的链表头信息结构体 */
+    index_head = udlist_create_ex(sizeof(int), NULL, UDLIST_INLINE);
+    if ((void *)PAR_ERROR == index_head || (void *)FUN_ERROR == index_head)
+    {
+        free(vec);
+        goto ERR1;
+    } /* end of if ((void *)PAR_ERROR == index_head || ...) */
+
+
+    /* 索引批量插入链表 */
+    if (0 != udlist_append_n(index_head, vec, (size_t)n))
+    {
+        udlist_destroy(index_head);
+        head_destroy(&index_head);
+    } /* end of if (0 != udlist_append_n(index_head, vec, (size_t)n)) */
+    free(vec);
+
+
+    return index_head;
+
+
+ERR0:
+    return (void *)PAR_ERROR;
+ERR1:
+    return NULL;
+}
+
+
+
+/**
+ * @brief           链表根据关键字查找所有的索引(并发模式下持有读锁)
+ */
+udlist_t *udlist_find_all_index_by_key(udlist_t *ud, void *key, cmp_t op_cmp)
+{
+    udlist_t *ret = NULL;
+
+    UD_STAT_BEGIN();
+    UD_TRACE_ENTER(ud);
+    UD_RDLOCK(ud);
+    ret = __udlist_find_all_index_by_key(ud, key, op_cmp);
+    UD_RDUNLOCK(ud);
+    UD_TRACE_EXIT(ud);
+    UD_STAT_END(ud, UDSTAT_FIND_ALL_INDEX);
+
+    return ret;
+}
+
+
+
+/**
+ * @brief           链表根据关键字查找所有的索引并写入调用者提供的数组
+ * @param           头信息结构体的指针
+ * @param           关键字
+ * @param           自定义比较函数
+ * @param           索引数组(cap 为 0 时可以为 NULL)
+ * @param           数组容量
+ * @return          匹配总个数(可能大于 cap, 只写入前 cap 个)
+ *      @arg  PAR_ERROR:参数错误
+ */
+static int __udlist_find_all_index_buf(udlist_t *ud, void *key, cmp_t op_cmp, int *buf, int cap)
+{
+    /* 参数检查 */
+    if (NULL == ud || NULL == key || NULL == op_cmp || cap < 0
+        || (NULL == buf && cap > 0) || (UDLIST_LOCKFREE & ud->flags))
+    {
+        UD_ERROR("udlist_find_all_index_buf: Parameter error\n");
+        goto ERR0;        
+    } /* end of if (NULL == ud || NULL == key || ...) */
+
+    return __index_collect(ud, key, op_cmp, &buf, cap, 0);
+
+ERR0:
+    return PAR_ERROR;
+}
+
+
+
+/**
+ * @brief           链表根据关键字查找所有的索引并写入调用者提供的数组(并发模式下持有读锁)
+ */
+int udlist_find_all_index_buf(udlist_t *ud, void *key, cmp_t op_cmp, int *buf, int cap)
+{
+    int ret = 0;
+
+    UD_RDLOCK(ud);
+    ret = __udlist_find_all_index_buf(ud, key, op_cmp, buf, cap);
+    UD_RDUNLOCK(ud);
+
+    return ret;
+}
+
+
+
+/**
+ * @brief           链表根据关键字查找所有的索引并返回连续数组
+ * @param           头信息结构体的指针
+ * @param           关键字
+ * @param           自定义比较函数
+ * @param           输出匹配个数
+ * @return          索引数组(由调用者 free)
+ *      @arg  PAR_ERROR: 参数错误
+ *      @arg  FUN_ERROR: 函数错误
+ *      @arg  NULL     : 没有找到匹配索引
+ */
+static int *__udlist_find_all_index_array(udlist_t *ud, void *key, cmp_t op_cmp, int *count)
+{
+    int *vec = NULL;
+    int *save = NULL;
+    int n = 0;
+
+    /* 参数检查 */
+    if (NULL == ud || NULL == key || NULL == op_cmp || NULL == count
+        || (UDLIST_LOCKFREE & ud->flags))
+    {
+        UD_ERROR("udlist_find_all_index_array: Parameter error\n");
+        goto ERR0;        
+    } /* end of if (NULL == ud || NULL == key || ...) */
+
+    /* 收集匹配索引 */
+    *count = 0;
+    n = __index_collect(ud, key, op_cmp, &vec, 0, 1);
+    if (n < 0)
+    {
+        free(vec);
+        goto ERR1;
+    } /* end of if (n < 0) */
+
+    /* 收缩到实际大小(失败时保留原数组) */
+    if (n > 0)
+    {
+        save = (int *)realloc(vec, (size_t)n * sizeof(int));
+        vec = (NULL == save) ? vec : save;
+    } /* end of if (n > 0) */
+
+    *count = n;
+    return vec;
+
+ERR0:
+    return (void *)PAR_ERROR;
+ERR1:
+    return (void *)FUN_ERROR;
+}
+
+
+
+/**
+ * @brief           链表根据关键字查找所有的索引并返回连续数组(并发模式下持有读锁)
+ */
+int *udlist_find_all_index_array(udlist_t *ud, void *key, cmp_t op_cmp, int *count)
+{
+    int *ret = NULL;
+
+    UD_RDLOCK(ud);
+    ret = __udlist_find_all_index_array(ud, key, op_cmp, count);
+    UD_RDUNLOCK(ud);
+
+    return ret;
+}
+
+
+
+/**
+ * @brief           链表稳定排序
+ * @param           头信息结构体的指针
+ * @param           自定义排序比较函数
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+static int __udlist_sort(udlist_t *ud, ord_t op_ord)
+{
+    node_t *last = NULL;
+
+    /* 参数检查 */
+    if (NULL == ud || NULL == op_ord
+        || (UDLIST_LOCKFREE & ud->flags) || NULL != ud->wal
+        || ((UDLIST_SORTED & ud->flags) && op_ord != ud->op_ord))
+    {
+        UD_ERROR("udlist_sort: Parameter error\n");
+        goto ERR0;        
+    } /* end of if (NULL == ud || NULL == op_ord || ...) */
+
+    /* 不超过一个元素时已有序 */
+    if (ud->count <= 1)
+    {
+        return 0;
+    } /* end of if (ud->count <= 1) */
+
+    /* 展开模式: 块内元素按序重排 */
+    if (UDLIST_UNROLLED & ud->flags)
+    {
+        if (0 != udur_sort(ud, op_ord))
+        {
+            goto ERR1;
+        } /* end of if (0 != udur_sort(ud, op_ord)) */
+        ud->mods++;
+        return 0;
+    } /* end of if (UDLIST_UNROLLED & ud->flags) */
+
+    /* 1.断开循环, 排序单向节点链 */
+    last = ud->fstnode_p->prev;
+    last->next = NULL;
+
+    /* 2.重新连成循环链表 */
+    __node_relink(ud, __node_sort(ud->fstnode_p, op_ord));
+
+    return 0;
+
+
+ERR0:
+    return PAR_ERROR;
+ERR1:
+    return FUN_ERROR;
+}
+
+
+
+/**
+ * @brief           链表稳定排序(并发模式下持有写锁)
+ */
+int udlist_sort(udlist_t *ud, ord_t op_ord)
+{
+    int ret = 0;
+
+    UD_STAT_BEGIN();
+    UD_TRACE_ENTER(ud);
+    UD_WRLOCK(ud);
+    ret = __udlist_sort(ud, op_ord);
+    UD_WRUNLOCK(ud);
+    UD_TRACE_EXIT(ud);
+    UD_STAT_END(ud, UDSTAT_SORT);
+
+    return ret;
+}
+
+
+
+/**
+ * @brief           将有序链表 src 的节点合并到有序链表 dst 中
+ * @param           目的链表头信息结构体的指针
+ * @param           源链表头信息结构体的指针(合并后为空)
+ * @param           自定义排序比较函数
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ */
+static int __udlist_merge(udlist_t *dst, udlist_t *src, ord_t op_ord)
+{
+    node_t *p = NULL;
+
+    /* 参数检查: 节点直接转移, 两个链表的节点布局必须相同且都不使用内存池 */
+    if (NULL == dst || NULL == src || NULL == op_ord || dst == src
+        || dst->size != src->size
+        || ((UDLIST_INLINE | UDLIST_INDEXED) & (dst->flags ^ src->flags))
+        || ((UDLIST_UNROLLED | UDLIST_LOCKFREE) & (dst->flags | src->flags))
+        || NULL != dst->pool || NULL != src->pool
+        || NULL != dst->wal || NULL != src->wal
+        || ((UDLIST_SORTED & dst->flags) && op_ord != dst->op_ord))
+    {
+        UD_ERROR("udlist_merge: Parameter error\n");
+        goto ERR0;        
+    } /* end of if (NULL == dst || NULL == src || ...) */
+
+    /* 源链表为空 */
+    if (NULL == src->fstnode_p)
+    {
+        return 0;
+    } /* end of if (NULL == src->fstnode_p) */
+
+    /* 1.哈希索引: 源链表清空, 节点加入目的链表 */
+    if (NULL != src->hash)
+    {
+        udhash_clear(src->hash);
+    } /* end of if (NULL != src->hash) */
+    p = src->fstnode_p;
+    do
+    {
+        __node_hash_add(dst, p);
+        p = p->next;
+    }
+    while (p != src->fstnode_p && NULL != dst->hash);
+
+    /* 2.断开循环后合并, 相等时目的链表的节点在前 */
+    src->fstnode_p->prev->next = NULL;
+    if (NULL != dst->fstnode_p)
+    {
+        dst->fstnode_p->prev->next = NULL;
+    } /* end of if (NULL != dst->fstnode_p) */
+    p = __node_merge(dst->fstnode_p, src->fstnode_p, op_ord);
+
+    /* 3.刷新信息 */
+    dst->count += src->count;
+    __node_relink(dst, p);
+
+    src->fstnode_p = NULL;
+    src->finger_p = NULL;
+    src->root = NULL;
+    src->count = 0;
+    src->mods++;
+
+    return 0;
+
+
+ERR0:
+    return PAR_ERROR;
+}
+
+
+
+/**
+ * @brief           将有序链表 src 的节点合并到有序链表 dst 中(并发模式下按地址顺序持有两个写锁)
+ */
+int udlist_merge(udlist_t *dst, udlist_t *src, ord_t op_ord)
+{
+    int ret = 0;
+
+    UD_WRLOCK2(dst, src);
+    ret = __udlist_merge(dst, src, op_ord);
+    UD_WRUNLOCK2(dst, src);
+
+    return ret;
+}
+
+
+
+/**
+ * @brief           有序链表二分查找边界
+ * @param           头信息结构体的指针
+ * @param           关键字
+ * @param           非 0 查找第一个大于关键字的元素, 0 查找第一个不小于关键字的元素
+ * @return          边界元素的索引, 不存在时为元素个数
+ *      @arg  PAR_ERROR:参数错误
+ */
+static int __udlist_bound(udlist_t *ud, void *key, int upper)
+{
+    int index = 0;
+
+    /* 参数检查 */
+    if (NULL == ud || NULL == key
+        || !(UDLIST_SORTED & ud->flags))
+    {
+        UD_ERROR("udlist_bound: Parameter error\n");
+        goto ERR0;        
+    } /* end of if (NULL == ud || NULL == key || ...) */
+
+    udrank_bound(ud, key, ud->op_ord, upper, &index);
+
+    return index;
+
+ERR0:
+    return PAR_ERROR;
+}
+
+
+
+/**
+ * @brief           有序链表查找第一个不小于关键字的元素(并发模式下持有读锁)
+ */
+int udlist_lower_bound(udlist_t *ud, void *key)
+{
+    int ret = 0;
+
+    UD_RDLOCK(ud);
+    ret = __udlist_bound(ud, key, 0);
+    UD_RDUNLOCK(ud);
+
+    return ret;
+}
+
+
+
+/**
+ * @brief           有序链表查找第一个大于关键字的元素(并发模式下持有读锁)
+ */
+int udlist_upper_bound(udlist_t *ud, void *key)
+{
+    int ret = 0;
+
+    UD_RDLOCK(ud);
+    ret = __udlist_bound(ud, key, 1);
+    UD_RDUNLOCK(ud);
+
+    return ret;
+}
+
+
+
+/**
+ * @brief           有序链表区间查询
+ * @param           头信息结构体的指针
+ * @param           区间下界
+ * @param           区间上界
+ * @param           输出区间第一个节点, 区间为空时为 NULL
+ * @return          区间内的元素个数
+ *      @arg  PAR_ERROR:参数错误
+ */
+static int __udlist_range(udlist_t *ud, void *lo, void *hi, node_t **first)
+{
+    node_t *p = NULL;
+    int i = 0;
+    int j = 0;
+
+    /* 参数检查 */
+    if (NULL == ud || NULL == lo || NULL == hi || NULL == first
+        || !(UDLIST_SORTED & ud->flags))
+    {
+        UD_ERROR("udlist_range: Parameter error\n");
+        goto ERR0;        
+    } /* end of if (NULL == ud || NULL == lo || ...) */
+
+    /* [lo, hi] 对应索引区间 [i, j) */
+    p = udrank_bound(ud, lo, ud->op_ord, 0, &i);
+    udrank_bound(ud, hi, ud->op_ord, 1, &j);
+
+    if (j <= i)
+    {
+        *first = NULL;
+        return 0;
+    } /* end of if (j <= i) */
+
+    *first = p;
+    return j - i;
+
+ERR0:
+    return PAR_ERROR;
+}
+
+
+
+/**
+ * @brief           有序链表区间查询(并发模式下持有读锁)
+ */
+int udlist_range(udlist_t *ud, void *lo, void *hi, node_t **first)
+{
+    int ret = 0;
+
+    UD_RDLOCK(ud);
+    ret = __udlist_range(ud, lo, hi, first);
+    UD_RDUNLOCK(ud);
+
+    return ret;
+}
+
+
+
+/**
+ * @brief           有序链表删除区间内的所有元素
+ * @param           头信息结构体的指针
+ * @param           区间下界
+ * @param           区间上界
+ * @return          删除的个数
+ *      @arg  PAR_ERROR:参数错误
+ */
+static int __udlist_delete_range(udlist_t *ud, void *lo, void *hi)
+{
+    node_t *first = NULL;
+    node_t *last = NULL;
+    node_t *save = NULL;
+    int i = 0;
+    int k = 0;
+    int n = 0;
+
+    /* 参数检查 */
+    n = __udlist_range(ud, lo, hi, &first);
+    if (n <= 0)
+    {
+        return n;
+    } /* end of if (n <= 0) */
+    i = udrank_index(ud, first);
+
+    /* 1.秩树中整段删除 */
+    udrank_cut(ud, i, n);
+
+    /* 2.整段摘下 */
+    last = first;
+    for (k = 1; k < n; k++)
+    {
+        last = last->next;
+    } /* end of for (k = 1; k < n; k++) */
+    if (last->next == first)
+    {
+        // 删除全部节点
+        ud->fstnode_p = NULL;
+    }
+    else
+    {
+        first->prev->next = last->next;
+        last->next->prev = first->prev;
+        if (ud->fstnode_p == first)
+        {
+            ud->fstnode_p = last->next;
+        } /* end of if (ud->fstnode_p == first) */
+    }
+    last->next = NULL;
+
+    /* 3.释放节点 */
+    while (NULL != first)
+    {
+        save = first->next;
+        if (NULL != ud->hash)
+        {
+            udhash_del(ud->hash, first);
+        } /* end of if (NULL != ud->hash) */
+        __node_free(ud, first);
+        first = save;
+    } /* end of while (NULL != first) */
+
+    /* 4.刷新位置缓存及节点个数 */
+    if (NULL != ud->finger_p)
+    {
+        if (ud->finger_idx >= i + n)
+        {
+            ud->finger_idx -= n;
+        }
+        else if (ud->finger_idx >= i)
+        {
+            ud->finger_p = NULL;
+        }
+    } /* end of if (NULL != ud->finger_p) */
+    ud->count -= n;
+    ud->mods++;
+
+    return n;
+}
+
+
+
+/**
+ * @brief           有序链表删除区间内的所有元素(并发模式下持有写锁)
+ */
+int udlist_delete_range(udlist_t *ud, void *lo, void *hi)
+{
+    int ret = 0;
+
+    UD_WRLOCK(ud);
+    ret = __udlist_delete_range(ud, lo, hi);
+    UD_WRUNLOCK(ud);
+
+    return ret;
+}
+
+
+
+/**
+ * @brief           检查两个链表之间能否直接转移节点
+ * @details         节点布局必须相同且都不使用内存池, 目的链表不能为有序模式, 都没有开启预写日志(转移无法记录)
+ * @param           目的链表头信息结构体指针
+ * @param           源链表头信息结构体指针
+ * @return          非 0 表示可以转移
+ */
+static int __node_movable(udlist_t *dst, udlist_t *src)
+{
+    return NULL != dst && NULL != src && dst != src
+        && dst->size == src->size
+        && !((UDLIST_INLINE | UDLIST_INDEXED) & (dst->flags ^ src->flags))
+        && !((UDLIST_UNROLLED | UDLIST_LOCKFREE) & (dst->flags | src->flags))
+        && !(UDLIST_SORTED & dst->flags)
+        && NULL == dst->pool && NULL == src->pool
+        && NULL == dst->wal && NULL == src->wal;
+}
+
+
+
+/**
+ * @brief           将源链表中连续的一段节点转移到目的链表 pos 之后
+ * @details         两端各 O(1) 重新链接, 秩树模式整段分裂、合并 O(log n),
+ *                  附加哈希索引时逐个转移 O(k); 两个链表的位置缓存失效
+ * @param           目的链表头信息结构体指针
+ * @param           目的链表中的位置节点, NULL 表示插入到头部
+ * @param           源链表头信息结构体指针
+ * @param           第一个节点
+ * @param           最后一个节点
+ * @param           节点个数
+ * @param           第一个节点在源链表中的索引(秩树模式)
+ */
+static void __node_transfer(udlist_t *dst, node_t *pos, udlist_t *src, node_t *first, node_t *last, int k, int index)
+{
+    udrank_t *sub = NULL;
+    node_t *p = NULL;
+    int at = 0;
+
+    /* 1.秩树整段分离, 计算插入位置的索引 */
+    if (UDLIST_INDEXED & src->flags)
+    {
+        sub = udrank_cut(src, index, k);
+        at = (NULL == pos) ? 0 : udrank_index(dst, pos) + 1;
+    } /* end of if (UDLIST_INDEXED & src->flags) */
+
+    /* 2.从源链表摘下 */
+    if (k == src->count)
+    {
+        src->fstnode_p = NULL;
+    }
+    else
+    {
+        first->prev->next = last->next;
+        last->next->prev = first->prev;
+        if (src->fstnode_p == first)
+        {
+            src->fstnode_p = last->next;
+        } /* end of if (src->fstnode_p == first) */
+    }
+
+    /* 3.哈希索引逐个转移 */
+    for (p = first; NULL != src->hash || NULL != dst->hash; p = p->next)
+    {
+        if (NULL != src->hash)
+        {
+            udhash_del(src->hash, p);
+        } /* end of if (NULL != src->hash) */
+        __node_hash_add(dst, p);
+        if (p == last)
+        {
+            break;
+        } /* end of if (p == last) */
+    } /* end of for (p = first; NULL != src->hash || NULL != dst->hash; p = p->next) */
+
+    /* 4.链接到目的链表 */
+    if (NULL == dst->fstnode_p)
+    {
+        first->prev = last;
+        last->next = first;
+        dst->fstnode_p = first;
+    }
+    else
+    {
+        // 头部插入即插入到尾节点之后并成为第一个节点
+        p = (NULL == pos) ? dst->fstnode_p->prev : pos;
+        last->next = p->next;
+        first->prev = p;
+        p->next->prev = last;
+        p->next = first;
+        if (NULL == pos)
+        {
+            dst->fstnode_p = first;
+        } /* end of if (NULL == pos) */
+    }
+
+    /* 5.秩树整段并入 */
+    if (UDLIST_INDEXED & dst->flags)
+    {
+        udrank_paste(dst, sub, at);
+    } /* end of if (UDLIST_INDEXED & dst->flags) */
+
+    /* 6.刷新信息 */
+    src->count -= k;
+    dst->count += k;
+    src->finger_p = NULL;
+    dst->finger_p = NULL;
+    src->mods++;
+    dst->mods++;
+}
+
+
+
+/**
+ * @brief           将源链表中 [first, last] 一段节点移动到目的链表 pos 之后
+ * @param           目的链表头信息结构体的指针
+ * @param           目的链表中的位置节点, NULL 表示插入到头部
+ * @param           源链表头信息结构体的指针
+ * @param           源链表中第一个节点
+ * @param           源链表中最后一个节点
+ * @return          移动的节点个数
+ *      @arg  PAR_ERROR:参数错误
+ */
+static int __udlist_splice(udlist_t *dst, node_t *pos, udlist_t *src, node_t *first, node_t *last)
+{
+    node_t *p = NULL;
+    int index = 0;
+    int k = 0;
+
+    /* 参数检查 */
+    if (!__node_movable(dst, src) || NULL == first || NULL == last)
+    {
+        UD_ERROR("udlist_splice: Parameter error\n");
+        goto ERR0;        
+    } /* end of if (!__node_movable(dst, src) || ...) */
+
+    /* 计算节点个数: 秩树模式 O(log n), 否则 O(k) */
+    if (UDLIST_INDEXED & src->flags)
+    {
+        index = udrank_index(src, first);
+        k = udrank_index(src, last) - index + 1;
+    }
+    else
+    {
+        for (p = first, k = 1; p != last && p->next != src->fstnode_p; p = p->next)
+        {
+            k++;
+        } /* end of for (p = first, k = 1; p != last && ...; p = p->next) */
+        k = (p == last) ? k : 0;
+    }
+
+    // last 在 first 之前
+    if (k <= 0)
+    {
+        UD_ERROR("udlist_splice: Parameter error\n");
+        goto ERR0;        
+    } /* end of if (k <= 0) */
+
+    __node_transfer(dst, pos, src, first, last, k, index);
+
+    return k;
+
+ERR0:
+    return PAR_ERROR;
+}
+
+
+
+/**
+ * @brief           将源链表中一段节点移动到目的链表(并发模式下按地址顺序持有两个写锁)
+ */
+int udlist_splice(udlist_t *dst, node_t *pos, udlist_t *src, node_t *first, node_t *last)
+{
+    int ret = 0;
+
+    UD_WRLOCK2(dst, src);
+    ret = __udlist_splice(dst, pos, src, first, last);
+    UD_WRUNLOCK2(dst, src);
+
+    return ret;
+}
+
+
+
+/**
+ * @brief           从节点处拆分链表, 该节点及之后的节点移动到 out 的尾部
+ * @param           头信息结构体的指针
+ * @param           拆分位置节点
+ * @param           接收后半部分的链表头信息结构体的指针
+ * @return          移动的节点个数
+ *      @arg  PAR_ERROR:参数错误
+ */
+static int __udlist_split_at(udlist_t *ud, node_t *node, udlist_t *out)
+{
+    node_t *p = NULL;
+    node_t *q = NULL;
+    int index = 0;
+    int k = 0;
+
+    /* 参数检查 */
+    if (!__node_movable(out, ud) || NULL == node || NULL == ud->fstnode_p)
+    {
+        UD_ERROR("udlist_split_at: Parameter error\n");
+        goto ERR0;        
+    } /* end of if (!__node_movable(out, ud) || ...) */
+
+    /* 计算节点个数: 秩树模式 O(log n), 否则同时向尾部、头部走, 先到达一端即可算出 */
+    if (UDLIST_INDEXED & ud->flags)
+    {
+        index = udrank_index(ud, node);
+        k = ud->count - index;
+    }
+    else
+    {
+        for (p = node, q = node, k = 0; ; p = p->next, q = q->prev, k++)
+        {
+            if (p->next == ud->fstnode_p)
+            {
+                k = k + 1;
+                break;
+            } /* end of if (p->next == ud->fstnode_p) */
+            if (q == ud->fstnode_p)
+            {
+                k = ud->count - k;
+                break;
+            } /* end of if (q == ud->fstnode_p) */
+        } /* end of for (p = node, q = node, k = 0; ; ...) */
+    }
+
+    __node_transfer(out, NULL == out->fstnode_p ? NULL : out->fstnode_p->prev,
+                    ud, node, ud->fstnode_p->prev, k, index);
+
+    return k;
+
+ERR0:
+    return PAR_ERROR;
+}
+
+
+
+/**
+ * @brief           从节点处拆分链表(并发模式下按地址顺序持有两个写锁)
+ */
+int udlist_split_at(udlist_t *ud, node_t *node, udlist_t *out)
+{
+    int ret = 0;
+
+    UD_WRLOCK2(ud, out);
+    ret = __udlist_split_at(ud, node, out);
+    UD_WRUNLOCK2(ud, out);
+
+    return ret;
+}
+
+
+
+/**
+ * @brief           将链表 b 的所有节点移动到链表 a 的尾部
+ * @param           链表 a 头信息结构体的指针
+ * @param           链表 b 头信息结构体的指针(移动后为空)
+ * @return          移动的节点个数
+ *      @arg  PAR_ERROR:参数错误
+ */
+static int __udlist_concat(udlist_t *a, udlist_t *b)
+{
+    int k = 0;
+
+    /* 参数检查 */
+    if (!__node_movable(a, b))
+    {
+        UD_ERROR("udlist_concat: Parameter error\n");
+        goto ERR0;        
+    } /* end of if (!__node_movable(a, b)) */
+
+    /* b 为空 */
+    if (NULL == b->fstnode_p)
+    {
+        return 0;
+    } /* end of if (NULL == b->fstnode_p) */
+
+    k = b->count;
+    __node_transfer(a, NULL == a->fstnode_p ? NULL : a->fstnode_p->prev,
+                    b, b->fstnode_p, b->fstnode_p->prev, k, 0);
+
+    return k;
+
+ERR0:
+    return PAR_ERROR;
+}
+
+
+
+/**
+ * @brief           将链表 b 的所有节点移动到链表 a 的尾部(并发模式下按地址顺序持有两个写锁)
+ */
+int udlist_concat(udlist_t *a, udlist_t *b)
+{
+    int ret = 0;
+
+    UD_WRLOCK2(a, b);
+    ret = __udlist_concat(a, b);
+    UD_WRUNLOCK2(a, b);
+
+    return ret;
+}
+
+
+
+/**
+ * @brief           借用的指针能否写入且写入无法记录
+ * @details         非并发模式下可以通过借用的指针修改元素, 开启预写日志时不允许借用
+ * @param           头信息结构体的指针
+ * @return          非 0 表示不允许借用
+ */
+static int __peek_unlogged(udlist_t *ud)
+{
+    return NULL != ud->wal && !(UDLIST_CONCURRENT & ud->flags);
+}
+
+
+
+/**
+ * @brief           借用索引位置元素的数据域指针
+ * @param           头信息结构体的指针
+ * @param           索引值
+ * @return          数据域指针
+ *      @arg  PAR_ERROR:参数错误
+ */
+static void *__udlist_peek_by_index(udlist_t *ud, int index)
+{
+    /* 参数检查 */
+    if (NULL == ud || index < 0 || index >= ud->count
+        || (UDLIST_LOCKFREE & ud->flags) || __peek_unlogged(ud))
+    {
+        UD_ERROR("udlist_peek_by_index: Parameter error\n");
+        goto ERR0;        
+    } /* end of if (NULL == ud || index < 0 || ...) */
+
+    /* 展开模式 */
+    if (UDLIST_UNROLLED & ud->flags)
+    {
+        return udur_at(ud, index);
+    } /* end of if (UDLIST_UNROLLED & ud->flags) */
+
+    return __node_seek(ud, index)->data;
+
+ERR0:
+    return (void *)PAR_ERROR;
+}
+
+
+
+/**
+ * @brief           借用索引位置元素的数据域指针(并发模式下持有读锁直到 udlist_peek_end)
+ */
+void *udlist_peek_by_index(udlist_t *ud, int index)
+{
+    void *ret = NULL;
+
+    UD_STAT_BEGIN();
+    UD_TRACE_ENTER(ud);
+    UD_RDLOCK(ud);
+    ret = __udlist_peek_by_index(ud, index);
+    if ((void *)PAR_ERROR == ret)
+    {
+        UD_RDUNLOCK(ud);
+    }
+    else
+    {
+        __atomic_add_fetch(&ud->borrows, 1, __ATOMIC_RELAXED);
+        UD_BORROW_ADD(ud);
+    }
+    UD_TRACE_EXIT(ud);
+    UD_STAT_END(ud, UDSTAT_PEEK_BY_INDEX);
+
+    return ret;
+}
+
+
+
+/**
+ * @brief           借用第一个匹配关键字的元素的数据域指针
+ * @param           头信息结构体的指针
+ * @param           关键字
+ * @param           自定义比较函数
+ * @return          数据域指针, 没有匹配返回 NULL
+ *      @arg  PAR_ERROR:参数错误
+ */
+static void *__udlist_peek_by_key(udlist_t *ud, void *key, cmp_t op_cmp)
+{
+    node_t *temp = NULL;
+
+    /* 参数检查 */
+    if (NULL == ud || NULL == key || NULL == op_cmp
+        || (UDLIST_LOCKFREE & ud->flags) || __peek_unlogged(ud))
+    {
+        UD_ERROR("udlist_peek_by_key: Parameter error\n");
+        goto ERR0;        
+    } /* end of if (NULL == ud || NULL == key || ...) */
+
+    /* 展开模式 */
+    if (UDLIST_UNROLLED & ud->flags)
+    {
+        return udur_find(ud, key, op_cmp, NULL);
+    } /* end of if (UDLIST_UNROLLED & ud->flags) */
+
+    temp = __node_find(ud, key, op_cmp, NULL);
+
+    return (NULL == temp) ? NULL : temp->data;
+
+ERR0:
+    return (void *)PAR_ERROR;
+}
+
+
+
+/**
+ * @brief           借用第一个匹配关键字的元素的数据域指针(并发模式下持有读锁直到 udlist_peek_end)
+ */
+void *udlist_peek_by_key(udlist_t *ud, void *key, cmp_t op_cmp)
+{
+    void *ret = NULL;
+
+    UD_STAT_BEGIN();
+    UD_TRACE_ENTER(ud);
+    UD_RDLOCK(ud);
+    ret = __udlist_peek_by_key(ud, key, op_cmp);
+    if (NULL == ret || (void *)PAR_ERROR == ret)
+    {
+        UD_RDUNLOCK(ud);
+    }
+    else
+    {
+        __atomic_add_fetch(&ud->borrows, 1, __ATOMIC_RELAXED);
+        UD_BORROW_ADD(ud);
+    }
+    UD_TRACE_EXIT(ud);
+    UD_STAT_END(ud, UDSTAT_PEEK_BY_KEY);
+
+    return ret;
+}
+
+
+
+/**
+ * @brief           链表尾部插入一个未初始化的元素并借用其数据域指针
+ * @param           头信息结构体的指针
+ * @return          新元素的数据域指针
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+static void *__udlist_emplace_back(udlist_t *ud)
+{
+    udhash_t *hash = NULL;
+    node_t *temp = NULL;
+
+    /* 参数检查 */
+    if (NULL == ud
+        || ((UDLIST_LOCKFREE | UDLIST_SORTED) & ud->flags))
+    {
+        UD_ERROR("udlist_emplace_back: Parameter error\n");
+        goto ERR0;        
+    } /* end of if (NULL == ud || ...) */
+
+    /* 展开模式: 块内预留位置, 不拷贝数据 */
+    if (UDLIST_UNROLLED & ud->flags)
+    {
+        if (0 != udur_insert(ud, NULL, ud->count))
+        {
+            goto ERR1;
+        } /* end of if (0 != udur_insert(ud, NULL, ud->count)) */
+        ud->emplace_p = ud->fstnode_p->prev;
+        return udur_at(ud, ud->count - 1);
+    } /* end of if (UDLIST_UNROLLED & ud->flags) */
+
+    /* 1.创建节点, 不拷贝数据 */
+    temp = __node_calloc(ud);
+    if (NULL == temp)
+    {
+        goto ERR1;
+    } /* end of if (NULL == temp) */
+
+    /* 2.尾部插入, 数据写入前无法计算哈希值, 推迟到 udlist_peek_end 加入哈希索引 */
+    hash = ud->hash;
+    ud->hash = NULL;
+    __node_link_before(ud, ud->fstnode_p, temp, ud->count);
+    ud->hash = hash;
+    ud->emplace_p = temp;
+
+    return temp->data;
+
+ERR0:
+    return (void *)PAR_ERROR;
+ERR1:
+    return (void *)FUN_ERROR;
+}
+
+
+
+/**
+ * @brief           链表尾部插入一个未初始化的元素并借用其数据域指针(并发模式下持有写锁直到 udlist_peek_end)
+ */
+void *udlist_emplace_back(udlist_t *ud)
+{
+    void *ret = NULL;
+
+    UD_WRLOCK(ud);
+    ret = __udlist_emplace_back(ud);
+    if ((void *)PAR_ERROR == ret || (void *)FUN_ERROR == ret)
+    {
+        UD_WRUNLOCK(ud);
+    }
+    else
+    {
+        ud->borrows++;
+        UD_BORROW_ADD(ud);
+    }
+
+    return ret;
+}
+
+
+
+/**
+ * @brief           归还借用的数据域指针
+ * @details         udlist_emplace_back 的新元素在此时加入哈希索引;
+ *                  并发模式下释放借用时持有的锁
+ * @param           头信息结构体的指针
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ */
+int udlist_peek_end(udlist_t *ud)
+{
+    udwal_t *wal = NULL;
+    uint64_t lsn = 0;
+    int ret = 0;
+
+    /* 参数检查 */
+    if (NULL == ud || __atomic_load_n(&ud->borrows, __ATOMIC_RELAXED) <= 0)
+    {
+        UD_ERROR("udlist_peek_end: Parameter error\n");
+        goto ERR0;        
+    } /* end of if (NULL == ud || ...) */
+
+    /* 新元素数据已写入, 加入哈希索引(展开模式不支持哈希索引)并记录日志 */
+    if (NULL != ud->emplace_p)
+    {
+        __node_hash_add(ud, ud->emplace_p);
+        UD_WAL_LOG(ud, wal, lsn, 1, UDWAL_APPEND, 0,
+                   (UDLIST_UNROLLED & ud->flags) ? udur_at(ud, ud->count - 1) : ud->emplace_p->data, 1, NULL);
+        ud->emplace_p = NULL;
+    } /* end of if (NULL != ud->emplace_p) */
+
+    /* 写者借用(udlist_emplace_back)释放写锁, 读者借用释放读锁 */
+    UD_BORROW_DEL(ud);
+    if (ud->writer)
+    {
+        ud->borrows--;
+        UD_WRUNLOCK(ud);
+    }
+    else
+    {
+        __atomic_sub_fetch(&ud->borrows, 1, __ATOMIC_RELAXED);
+        UD_RDUNLOCK(ud);
+    }
+    ret = UD_WAL_DONE(wal, lsn, ret);
+
+    return ret;
+
+ERR0:
+    return PAR_ERROR;
+}
+
+
+
+/**
+ * @brief           游标定位到第一个或最后一个元素
+ * @param           游标的指针
+ * @param           头信息结构体的指针
+ * @param           非 0 定位到最后一个元素
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ */
+static int __iter_seek(udlist_iter_t *it, udlist_t *ud, int last)
+{
+    /* 参数检查 */
+    if (NULL == it || NULL == ud
+        || (UDLIST_LOCKFREE & ud->flags))
+    {
+        UD_ERROR("udlist_iter_begin: Parameter error\n");
+        return PAR_ERROR;
+    } /* end of if (NULL == it || NULL == ud || ...) */
+
+    it->ud = ud;
+    it->mods = ud->mods;
+    it->node = (NULL == ud->fstnode_p || !last) ? ud->fstnode_p : ud->fstnode_p->prev;
+    it->index = last ? ud->count - 1 : 0;
+    it->off = (NULL != it->node && last && (UDLIST_UNROLLED & ud->flags)) ? UD_BLOCK(it->node)->used - 1 : 0;
+
+    return 0;
+}
+
+
+
+/**
+ * @brief           游标定位到第一个元素
+ */
+int udlist_iter_begin(udlist_iter_t *it, udlist_t *ud)
+{
+    return __iter_seek(it, ud, 0);
+}
+
+
+
+/**
+ * @brief           游标定位到最后一个元素
+ */
+int udlist_iter_last(udlist_iter_t *it, udlist_t *ud)
+{
+    return __iter_seek(it, ud, 1);
+}
+
+
+
+/**
+ * @brief           删除游标处的元素, 游标移到下一个元素
+ * @param           游标的指针
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ */
+static int __udlist_iter_erase(udlist_iter_t *it)
+{
+    udlist_t *ud = NULL;
+    node_t *p = NULL;
+    node_t *next = NULL;
+
+    /* 参数检查: 游标必须指向元素且链表在此期间没有被其他途径修改 */
+    if (NULL == it || NULL == it->ud || NULL == it->node
+        || it->mods != it->ud->mods)
+    {
+        UD_ERROR("udlist_iter_erase: Parameter error\n");
+        goto ERR0;        
+    } /* end of if (NULL == it || NULL == it->ud || ...) */
+    ud = it->ud;
+
+    /* 展开模式 */
+    if (UDLIST_UNROLLED & ud->flags)
+    {
+        it->node = udur_erase(ud, it->node, &it->off, it->index);
+        it->mods = ud->mods;
+        return 0;
+    } /* end of if (UDLIST_UNROLLED & ud->flags) */
+
+    /* 摘下前记下后继节点, 删除尾节点后游标越过末端 */
+    p = it->node;
+    next = (p->next == ud->fstnode_p) ? NULL : p->next;
+    __node_unlink(ud, p, it->index);
+    __node_free(ud, p);
+
+    it->node = next;
+    it->mods = ud->mods;
+
+    return 0;
+
+ERR0:
+    return PAR_ERROR;
+}
+
+
+
+/**
+ * @brief           删除游标处的元素(并发模式下持有写锁)
+ */
+int udlist_iter_erase(udlist_iter_t *it)
+{
+    udlist_t *ud = (NULL == it) ? NULL : it->ud;
+    udwal_t *wal = NULL;
+    uint64_t lsn = 0;
+    int ret = 0;
+
+    // 删除前后游标的索引不变
+    UD_WRLOCK(ud);
+    ret = __udlist_iter_erase(it);
+    UD_WAL_LOG(ud, wal, lsn, 0 == ret, UDWAL_DELETE, it->index, NULL, 0, NULL);
+    UD_WRUNLOCK(ud);
+    ret = UD_WAL_DONE(wal, lsn, ret);
+
+    return ret;
+}
+
+
+
+/**
+ * @brief           在游标处的元素之前插入, 游标仍指向原元素
+ * @param           游标的指针
+ * @param           数据的指针
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+static int __udlist_iter_insert_before(udlist_iter_t *it, void *data)
+{
+    udlist_t *ud = NULL;
+    node_t *temp = NULL;
+
+    /* 参数检查: 越过开头的游标不能插入 */
+    if (NULL == it || NULL == it->ud || NULL == data || it->index < 0
+        || it->mods != it->ud->mods
+        || (UDLIST_SORTED & it->ud->flags))
+    {
+        UD_ERROR("udlist_iter_insert_before: Parameter error\n");
+        goto ERR0;        
+    } /* end of if (NULL == it || NULL == it->ud || ...) */
+    ud = it->ud;
+
+    /* 展开模式: 插入可能分裂块, 按索引重新定位 */
+    if (UDLIST_UNROLLED & ud->flags)
+    {
+        if (0 != udur_insert(ud, data, it->index))
+        {
+            goto ERR1;
+        } /* end of if (0 != udur_insert(ud, data, it->index)) */
+        it->index++;
+        it->node = (it->index < ud->count) ? udur_locate(ud, it->index, &it->off) : NULL;
+        it->mods = ud->mods;
+        return 0;
+    } /* end of if (UDLIST_UNROLLED & ud->flags) */
+
+    /* 1.创建一个新的节点并输入数据 */
+    temp = __node_new(ud, data);
+    if (NULL == temp)
+    {
+        goto ERR1;
+    } /* end of if (NULL == temp) */
+
+    /* 2.链接到游标节点之前, 越过末端时即尾部插入 */
+    __node_link_before(ud, NULL == it->node ? ud->fstnode_p : it->node, temp, it->index);
+    if (0 == it->index)
+    {
+        ud->fstnode_p = temp;
+    } /* end of if (0 == it->index) */
+
+    it->index++;
+    it->mods = ud->mods;
+
+    return 0;
+
+ERR0:
+    return PAR_ERROR;
+ERR1:
+    return FUN_ERROR;
+}
+
+
+
+/**
+ * @brief           在游标处的元素之前插入(并发模式下持有写锁)
+ */
+int udlist_iter_insert_before(udlist_iter_t *it, void *data)
+{
+    udlist_t *ud = (NULL == it) ? NULL : it->ud;
+    udwal_t *wal = NULL;
+    uint64_t lsn = 0;
+    int ret = 0;
+
+    // 插入后游标的索引加 1, 新元素在原索引处
+    UD_WRLOCK(ud);
+    ret = __udlist_iter_insert_before(it, data);
+    UD_WAL_LOG(ud, wal, lsn, 0 == ret, UDWAL_INSERT, it->index - 1, data, 1, NULL);
+    UD_WRUNLOCK(ud);
+    ret = UD_WAL_DONE(wal, lsn, ret);
+
+    return ret;
+}
+
+
+
+/**
+ * @brief           带上下文的链表遍历, 可以提前停止
+ * @param           头信息结构体的指针
+ * @param           自定义函数, 返回非 0 时停止遍历
+ * @param           自定义函数上下文
+ * @param           非 0 反向遍历
+ * @return          停止处元素的索引, 遍历完所有元素返回元素个数
+ *      @arg  PAR_ERROR:参数错误
+ */
+static int __udlist_traverse_ex(udlist_t *ud, pred_t fn, void *ctx, int back)
+{
+    udlist_iter_t it;
+
+    /* 参数检查 */
+    if (NULL == ud || NULL == fn
+        || (UDLIST_LOCKFREE & ud->flags))
+    {
+        UD_ERROR("udlist_traverse_ex: Parameter error\n");
+        goto ERR0;        
+    } /* end of if (NULL == ud || NULL == fn || ...) */
+
+    /* 游标遍历 */
+    __iter_seek(&it, ud, back);
+    while (udlist_iter_valid(&it))
+    {
+        if (0 != fn(udlist_iter_get(&it), ctx))
+        {
+            return it.index;
+        } /* end of if (0 != fn(udlist_iter_get(&it), ctx)) */
+
+        if (back)
+        {
+            udlist_iter_prev(&it);
+        }
+        else
+        {
+            udlist_iter_next(&it);
+        }
+    } /* end of while (udlist_iter_valid(&it)) */
+
+    return ud->count;
+
+ERR0:
+    return PAR_ERROR;
+}
+
+
+
+/**
+ * @brief           带上下文的链表遍历(并发模式下持有读锁)
+ */
+int udlist_traverse_ex(udlist_t *ud, pred_t fn, void *ctx, int back)
+{
+    int ret = 0;
+
+    UD_STAT_BEGIN();
+    UD_TRACE_ENTER(ud);
+    UD_RDLOCK(ud);
+    ret = __udlist_traverse_ex(ud, fn, ctx, back);
+    UD_RDUNLOCK(ud);
+    UD_TRACE_EXIT(ud);
+    UD_STAT_END(ud, UDSTAT_TRAVERSE_EX);
+
+    return ret;
+}
+
+
+
+/**
+ * @brief           链表尾部插入并返回节点句柄
+ * @param           头信息结构体的指针
+ * @param           数据的指针
+ * @return          新节点的指针
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+static node_t *__udlist_append_h(udlist_t *ud, void *data)
+{
+    node_t *temp = NULL;
+
+    /* 参数检查 */
+    if (NULL == ud || NULL == data
+        || ((UDLIST_UNROLLED | UDLIST_LOCKFREE) & ud->flags))
+    {
+        UD_ERROR("udlist_append_h: Parameter error\n");
+        goto ERR0;        
+    } /* end of if (NULL == ud || NULL == data || ...) */
+
+    /* 1.创建一个新的节点并输入数据 */
+    temp = __node_new(ud, data);
+    if (NULL == temp)
+    {
+        goto ERR1;
+    } /* end of if (NULL == temp) */
+
+    /* 2.数据尾部插入, 有序模式按顺序插入 */
+    if (UDLIST_SORTED & ud->flags)
+    {
+        __node_link_sorted(ud, temp, 1);
+    }
+    else
+    {
+        __node_link_before(ud, ud->fstnode_p, temp, ud->count);
+    }
+
+    return temp;
+
+ERR0:
+    return (void *)PAR_ERROR;
+ERR1:
+    return (void *)FUN_ERROR;
+}
+
+
+
+/**
+ * @brief           链表尾部插入并返回节点句柄(并发模式下持有写锁)
+ */
+node_t *udlist_append_h(udlist_t *ud, void *data)
+{
+    udwal_t *wal = NULL;
+    uint64_t lsn = 0;
+    node_t *ret = NULL;
+
+    UD_WRLOCK(ud);
+    ret = __udlist_append_h(ud, data);
+    UD_WAL_LOG(ud, wal, lsn, (void *)PAR_ERROR != ret && (void *)FUN_ERROR != ret, UDWAL_APPEND, 0, data, 1, NULL);
+    UD_WRUNLOCK(ud);
+
+    // 写日志失败时同其他修改操作返回 FUN_ERROR(节点已插入)
+    if (FUN_ERROR == UD_WAL_DONE(wal, lsn, 0))
+    {
+        ret = (void *)FUN_ERROR;
+    } /* end of if (FUN_ERROR == UD_WAL_DONE(wal, lsn, 0)) */
+
+    return ret;
+}
+
+
+
+/**
+ * @brief           根据关键字寻找第一个匹配的节点句柄
+ * @param           头信息结构体的指针
+ * @param           关键字
+ * @param           自定义比较函数
+ * @return          节点指针
+ *      @arg  PAR_ERROR: 参数错误
+ *      @arg  NULL     : 没有找到匹配节点
+ */
+static node_t *__udlist_find_node(udlist_t *ud, void *key, cmp_t op_cmp)
+{
+    /* 参数检查 */
+    if (NULL == ud || NULL == key || NULL == op_cmp
+        || ((UDLIST_UNROLLED | UDLIST_LOCKFREE) & ud->flags))
+    {
+        UD_ERROR("udlist_find_node: Parameter error\n");
+        goto ERR0;        
+    } /* end of if (NULL == ud || NULL == key || NULL == op_cmp || ...) */
+
+    return __node_find(ud, key, op_cmp, NULL);
+
+ERR0:
+    return (void *)PAR_ERROR;
+}
+
+
+
+/**
+ * @brief           根据关键字寻找第一个匹配的节点句柄(并发模式下持有读锁)
+ */
+node_t *udlist_find_node(udlist_t *ud, void *key, cmp_t op_cmp)
+{
+    node_t *ret = NULL;
+
+    UD_STAT_BEGIN();
+    UD_TRACE_ENTER(ud);
+    UD_RDLOCK(ud);
+    ret = __udlist_find_node(ud, key, op_cmp);
+    UD_RDUNLOCK(ud);
+    UD_TRACE_EXIT(ud);
+    UD_STAT_END(ud, UDSTAT_FIND_NODE);
+
+    return ret;
+}
+
+
+
+/**
+ * @brief           根据节点句柄删除节点 O(1)
+ * @param           头信息结构体的指针
+ * @param           节点指针(必须属于该链表)
+ * @param           输出删除节点的索引(可以为 NULL, 非 NULL 时非秩树模式 O(n))
+ * @return          
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ */
+static int __udlist_remove_node(udlist_t *ud, node_t *node, int *out)
+{
+    /* 参数检查 */
+    if (NULL == ud || NULL == node || 0 == ud->count
+        || ((UDLIST_UNROLLED | UDLIST_LOCKFREE) & ud->flags))
+    {
+        UD_ERROR("udlist_remove_node: Parameter error\n");
+        goto ERR0;        
+    } /* end of if (NULL == ud || NULL == node || 0 == ud->count || ...) */
+
+    /* 输出索引 */
+    if (NULL != out)
+    {
+        *out = __node_index(ud, node);
+    } /* end of if (NULL != out) */
+
+    /* 摘下并释放节点 */
+    __node_unlink(ud, node, -1);
+    __node_free(ud, node);
+    node = NULL;
+
+    return 0;
+
+ERR0:
+    return PAR_ERROR;
+}
+
+
+
+/**
+ * @brief           根据节点句柄删除节点 O(1)(并发模式下持有写锁)
+ */
+int udlist_remove_node(udlist_t *ud, node_t *node)
+{
+    udwal_t *wal = NULL;
+    uint64_t lsn = 0;
+    int index = 0;
+    int ret = 0;
+
+    // 只在开启预写日志时计算索引
+    UD_WRLOCK(ud);
+    ret = __udlist_remove_node(ud, node, (NULL != ud && NULL != ud->wal) ? &index : NULL);
+    UD_WAL_LOG(ud, wal, lsn, 0 == ret, UDWAL_DELETE, index, NULL, 0, NULL);
+    UD_WRUNLOCK(ud);
+    ret = UD_WAL_DONE(wal, lsn, ret);
+
+    return ret;
+}
+
+
+
+/**
+ * @brief           在节点句柄之后插入 O(1)
+ * @param           头信息结构体的指针
+ * @param           位置节点指针(必须属于该链表), NULL 表示插入到链表头部
+ * @param           数据的指针
+ * @param           输出新节点的索引(可以为 NULL, 非 NULL 时非秩树模式 O(n))
+ * @return          新节点的指针
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+static node_t *__udlist_insert_after_node(udlist_t *ud, node_t *pos, void *data, int *out)
+{
+    node_t *temp = NULL;
+
+    /* 参数检查 */
+    if (NULL == ud || NULL == data
+        || ((UDLIST_UNROLLED | UDLIST_LOCKFREE | UDLIST_SORTED) & ud->flags))
+    {
+        UD_ERROR("udlist_insert_after_node: Parameter error\n");
+        goto ERR0;        
+    } /* end of if (NULL == ud || NULL == data || ...) */
+
+    /* 1.创建一个新的节点并输入数据 */
+    temp = __node_new(ud, data);
+    if (NULL == temp)
+    {
+        goto ERR1;
+    } /* end of if (NULL == temp) */
+
+    /* 2.链接节点 */
+    if (NULL == pos)
+    {
+        // 头部插入
+        __node_link_before(ud, ud->fstnode_p, temp, 0);
+        ud->fstnode_p = temp;
+    }
+    else
+    {
+        // 链接到 pos 的后继之前
+        __node_link_before(ud, pos->next, temp, -1);
+    }
+
+    /* 3.输出索引 */
+    if (NULL != out)
+    {
+        *out = __node_index(ud, temp);
+    } /* end of if (NULL != out) */
+
+    return temp;
+
+ERR0:
+    return (void *)PAR_ERROR;
+ERR1:
+    return (void *)FUN_ERROR;
+}
+
+
+
+/**
+ * @brief           在节点句柄之后插入 O(1)(并发模式下持有写锁)
+ */
+node_t *udlist_insert_after_node(udlist_t *ud, node_t *pos, void *data)
+{
+    udwal_t *wal = NULL;
+    uint64_t lsn = 0;
+    node_t *ret = NULL;
+    int index = 0;
+
+    // 只在开启预写日志时计算索引
+    UD_WRLOCK(ud);
+    ret = __udlist_insert_after_node(ud, pos, data, (NULL != ud && NULL != ud->wal) ? &index : NULL);
+    UD_WAL_LOG(ud, wal, lsn, (void *)PAR_ERROR != ret && (void *)FUN_ERROR != ret, UDWAL_INSERT, index, data, 1, NULL);
+    UD_WRUNLOCK(ud);
+
+    // 写日志失败时同其他修改操作返回 FUN_ERROR(节点已插入)
+    if (FUN_ERROR == UD_WAL_DONE(wal, lsn, 0))
+    {
+        ret = (void *)FUN_ERROR;
+    } /* end of if (FUN_ERROR == UD_WAL_DONE(wal, lsn, 0)) */
+
+    return ret;
+}
+
+
+
@@ -1,311 +1,858 @@
-/**
- * @file                uni_doubly_linkedlist.h
- * @brief               万能型双向循环链表
- * @details             需要提前写好如下自定义函数:
-                            int node_destroy(void *data)
-                            {
-                            }
-
-                            int data_print(void *data)
-                            {
-                            }
-
-                            int data_compare(void *data, void *key)
-                            {
-                            }
- * @author              BHR
- * @version             v1.0
- * @date                2024-03-07
- * @copyright           MIT
- */
-
-#ifndef __UNI_DOUBLY_LINKEDLIST_H__
-#define __UNI_DOUBLY_LINKEDLIST_H__
-
-#include <stdio.h>
-#include <string.h>
-#include <stdlib.h>
-#include "define.h"
-
-// 类型定义
-typedef int(*op_t)(void *data);
-typedef int(*cmp_t)(void *data, void *key);
-
-/**
- * @brief 链表节点定义
- */
-typedef struct _node_t
-{
-    void *data;                     // 数据域
-    struct _node_t *prev;           // 前驱指针
-    struct _node_t *next;           // 后继指针
-}node_t;
-
-
-/**
- * @brief 链表头信息结构体定义
- */
-typedef struct _udlist_t
-{
-    node_t *fstnode_p;              // 指向链表的第一个节点
-    int size;                       // 数据元素大小
-    int count;                      // 节点个数
-    op_t my_destroy;                // 自定义数据域销毁函数
-}udlist_t;
-
-
-
-/**
- * @brief           创建链表头信息结构体
- * @param           存储数据类型大小
- * @param           自定义销毁数据函数
- * @return          指向链表头信息结构体的指针
- */
-udlist_t *udlist_create(int size, op_t my_destroy);
-
-
-/**
- * @brief           链表尾部插入
- * @param           头信息结构体的指针
- * @param           数据的指针
- * @return          
- *      @arg  0:正常
- *      @arg  PAR_ERROR:参数错误
- *      @arg  FUN_ERROR:函数错误
- */
-int udlist_append(udlist_t *ud, void *data);
-
-
-/**
- * @brief           链表头部插入
- * @param           头信息结构体的指针
- * @param           插入节点数据
- * @return          
- *      @arg  0:正常
- *      @arg  PAR_ERROR:参数错误
- *      @arg  FUN_ERROR:函数错误
- */
-int udlist_prepend(udlist_t *ud, void *data);
-
-
-/**
- * @brief           链表的遍历
- * @param           头信息结构体的指针
- * @param           自定义打印数据函数
- * @return          
- *      @arg  0:正常
- *      @arg  PAR_ERROR:参数错误
- *      @arg  FUN_ERROR:函数错误
- */
-int udlist_traverse(udlist_t *ud, op_t my_print);
-
-
-/**
- * @brief           链表的反向遍历
- * @param           头信息结构体的指针
- * @param           自定义打印数据函数
- * @return          
- *      @arg  0:正常
- *      @arg  PAR_ERROR:参数错误
- *      @arg  FUN_ERROR:函数错误
- */
-int udlist_traverse_back(udlist_t *ud, op_t my_print);
-
-
-/**
- * @brief           链表销毁函数（不包括头信息结构体）
- * @param           头信息结构体的指针
- * @return          
- *      @arg  0:正常
- *      @arg  PAR_ERROR:参数错误
- *      @arg  FUN_ERROR:函数错误
- */
-int udlist_destroy(udlist_t *ud);
-
-
-/**
- * @brief           头信息结构体销毁函数
- * @param           头信息结构体的指针的地址
- * @return          
- *      @arg  0:正常
- *      @arg  PAR_ERROR:参数错误
- *      @arg  FUN_ERROR:函数错误
- */
-int head_destroy(udlist_t **p);
-
-
-/**
- * @brief           获取链表中节点的个数
- * @param           头信息结构体的指针
- * @return          链表节点个数
- */
-int get_count(udlist_t *p);
-
-
-/**
- * @brief           链表根据索引插入
- * @param           头信息结构体的指针
- * @param           数据的指针
- * @param           索引值
- * @return          
- *      @arg  0:正常
- *      @arg  PAR_ERROR:参数错误
- *      @arg  FUN_ERROR:函数错误
- */
-int udlist_insert_by_index(udlist_t *ud, void *data, int index);
-
-
-/**
- * @brief           链表根据索引删除
- * @param           头信息结构体的指针
- * @param           索引值
- * @return          
- *      @arg  0:正常
- *      @arg  PAR_ERROR:参数错误
- *      @arg  FUN_ERROR:函数错误
- */
-int udlist_delete_by_index(udlist_t *ud, int index);
-
-
-/**
- * @brief           链表根据索引修改数据
- * @param           头信息结构体的指针
- * @param           修改数据
- * @param           索引值
- * @return          
- *      @arg  0:正常
- *      @arg  PAR_ERROR:参数错误
- *      @arg  FUN_ERROR:函数错误
- */
-int udlist_modify_by_index(udlist_t *ud, void *data, int index);
-
-
-/**
- * @brief           链表根据索引检索数据
- * @param           头信息结构体的指针
- * @param           要检索的数据
- * @param           索引值
- * @return          
- *      @arg  0:正常
- *      @arg  PAR_ERROR:参数错误
- *      @arg  FUN_ERROR:函数错误
- */
-int udlist_retrieve_by_index(udlist_t *ud, void *data, int index);
-
-
-/**
- * @brief           根据关键字寻找匹配索引
- * @param           头信息结构体的指针
- * @param           关键字
- * @param           自定义比较函数
- * @return          索引值    
- *      @arg  PAR_ERROR:参数错误
- *      @arg  MATCH_FAIL:无匹配索引
- */
-int get_match_index(udlist_t *ud, void *key, cmp_t op_cmp);
-
-
-
-/**
- * @brief           链表根据关键字删除
- * @param           头信息结构体的指针
- * @param           关键字
- * @param           自定义比较函数
- * @return          
- *      @arg  0:正常
- *      @arg  PAR_ERROR:参数错误
- *      @arg  FUN_ERROR:函数错误
- */
-int udlist_delete_by_key(udlist_t *ud, void *key, cmp_t op_cmp);
-
-
-
-/**
- * @brief           链表根据关键字修改数据
- * @param           头信息结构体的指针
- * @param           修改的数据
- * @param           关键字
- * @param           自定义比较函数
- * @return          
- *      @arg  0:正常
- *      @arg  PAR_ERROR:参数错误
- *      @arg  FUN_ERROR:函数错误
- */
-int udlist_modify_by_key(udlist_t *ud, void *data, void *key, cmp_t op_cmp);
-
-
-
-/**
- * @brief           链表根据关键字获取数据
- * @param           头信息结构体的指针
- * @param           获取的数据
- * @param           关键字
- * @param           自定义比较函数
- * @return          
- *      @arg  0:正常
- *      @arg  PAR_ERROR:参数错误
- *      @arg  FUN_ERROR:函数错误
- */
-int udlist_retrieve_by_key(udlist_t *ud, void *data, void *key, cmp_t op_cmp);
-
-
-
-/**
- * @brief           链表根据关键字删除所有匹配的节点
- * @param           头信息结构体的指针
- * @param           关键字
- * @param           自定义比较函数 
- * @return          
- *      @arg  0:正常
- *      @arg  PAR_ERROR:参数错误
- *      @arg  FUN_ERROR:函数错误
- */
-int udlist_delete_all_by_key(udlist_t *ud, void *key, cmp_t op_cmp);
-
-
-
-/**
- * @brief           链表根据关键字修改所有匹配节点的数据
- * @param           头信息结构体的指针
- * @param           修改的数据
- * @param           关键字
- * @param           自定义比较函数
- * @return          
- *      @arg  0:正常
- *      @arg  PAR_ERROR:参数错误
- *      @arg  FUN_ERROR:函数错误
- */
-int udlist_modify_all_by_key(udlist_t *ud, void *data, void *key, cmp_t op_cmp);
-
-
-
-/**
- * @brief           自定义索引销毁函数
- * @param           数据域
- * @return          0
- */
-int index_destroy(void *data);
-
-
-/**
- * @brief           自定义索引打印函数
- * @param           数据域
- * @return          0
- */
-int index_print(void *data);
-
-
-/**
- * @brief           链表根据关键字查找所有的索引
- * @param           头信息结构体的指针
- * @param           关键字
- * @param           自定义比较函数 
- * @return          存储索引链表
- *      @arg  PAR_ERROR: 参数错误
- *      @arg  NULL     : 没有找到匹配索引
- */
-udlist_t *udlist_find_all_index_by_key(udlist_t *ud, void *key, cmp_t op_cmp);
-
-
-
-#endif /* __UNI_DOUBLY_LINKEDLIST_H__ */
+/**
+ * @file                uni_doubly_linkedlist.h
+ * @brief               万能型双向循环链表
+ * @details             需要提前写好如下自定义函数:
+                            int node_destroy(void *data)
+                            {
+                            }
+
+                            int data_print(void *data)
+                            {
+                            }
+
+                            int data_compare(void *data, void *key)
+                            {
+                            }
+ * @author              BHR
+ * @version             v1.0
+ * @date                2024-03-07
+ * @copyright           MIT
+ */
+
+#ifndef __UNI_DOUBLY_LINKEDLIST_H__
+#define __UNI_DOUBLY_LINKEDLIST_H__
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "define.h"
+
+// 类型定义
+typedef int(*op_t)(void *data);
+typedef int(*cmp_t)(void *data, void *key);
+typedef int(*pred_t)(void *data, void *ctx);
+typedef unsigned long(*hash_t)(void *data);
+typedef int(*ord_t)(void *a, void *b);
+
+/**
+ * @brief 链表节点定义
+ */
+typedef struct _node_t
+{
+    void *data;                     // 数据域
+    struct _node_t *prev;           // 前驱指针
+    struct _node_t *next;           // 后继指针
+    unsigned char payload[];        // 内联数据域(UDLIST_INLINE 模式下 data 指向这里)
+}node_t;
+
+
+struct _udpool_t;
+struct _udrank_t;
+struct _udhash_t;
+struct _uddq_t;
+struct _udsplit_t;
+
+/**
+ * @brief 链表头信息结构体定义
+ */
+typedef struct _udlist_t
+{
+    node_t *fstnode_p;              // 指向链表的第一个节点
+    int size;                       // 数据元素大小
+    int count;                      // 节点个数
+    op_t my_destroy;                // 自定义数据域销毁函数
+    int flags;                      // 存储模式
+    struct _udpool_t *pool;         // 节点内存池(NULL 表示逐个 calloc)
+    node_t *finger_p;               // 最近访问位置缓存(NULL 表示无效)
+    int finger_idx;                 // 最近访问位置的索引
+    struct _udrank_t *root;         // 秩树根节点(UDLIST_INDEXED 模式)
+    int node_off;                   // 节点头之前的附加空间大小
+    struct _udhash_t *hash;         // 关键字哈希索引(NULL 表示未附加)
+    int unroll_k;                   // 每个节点的元素个数(UDLIST_UNROLLED 模式)
+    pthread_rwlock_t lock;          // 读写锁(UDLIST_CONCURRENT 模式)
+    int writer;                     // 是否持有写锁(并发模式下只有写者刷新位置缓存)
+    struct _uddq_t *deque;          // 无锁双端队列(UDLIST_LOCKFREE 模式)
+    unsigned long mods;             // 结构修改计数(插入、删除时递增)
+    struct _udsplit_t *split;       // 并行遍历分段点缓存(NULL 表示无)
+    ord_t op_ord;                   // 排序比较函数(UDLIST_SORTED 模式)
+    int borrows;                    // 未归还的借用指针个数(udlist_peek_* / udlist_emplace_back)
+    node_t *emplace_p;              // udlist_emplace_back 的新节点(展开模式为所在块), 归还时加入哈希索引并记录日志
+    struct _udwal_t *wal;           // 预写日志(NULL 表示未开启)
+    struct _udstats_t *stats;       // 操作统计(NULL 表示未定义 UDLIST_STATS 或申请失败, 不统计)
+}udlist_t;
+
+
+
+/**
+ * @brief           创建链表头信息结构体
+ * @param           存储数据类型大小
+ * @param           自定义销毁数据函数
+ * @return          指向链表头信息结构体的指针
+ */
+udlist_t *udlist_create(int size, op_t my_destroy);
+
+
+/**
+ * @brief           按指定存储模式创建链表头信息结构体
+ * @details         UDLIST_INLINE 模式下节点头和数据域在同一块空间中申请,
+ *                  my_destroy 不能释放数据域本身, 只清理数据引用的资源, 可以为 NULL;
+ *                  或上 UDLIST_INDEXED 后按索引插入、删除、修改、检索均为 O(log n);
+ *                  UDLIST_UNROLLED 模式每个节点连续存放多个元素, 节省节点头开销并提高遍历局部性,
+ *                  不能与 UDLIST_INDEXED 同时使用, 不支持节点句柄及哈希索引;
+ *                  或上 UDLIST_CONCURRENT 后可以多线程同时调用: 遍历、检索、查找持有读锁可以并行,
+ *                  插入、删除、修改持有写锁; 节点句柄及 my_print 中不能再调用该链表的函数;
+ *                  UDLIST_LOCKFREE 模式为无锁双端队列, 多线程同时头尾插入、删除无需加锁,
+ *                  只支持头尾插入(含批量)、udlist_pop_front / udlist_pop_back、删除索引 0、
+ *                  get_count(并发时为近似值) 及销毁, 其他函数返回参数错误; 只能与 UDLIST_INLINE 组合
+ * @param           存储数据类型大小
+ * @param           自定义销毁数据函数
+ * @param           存储模式 UDLIST_COMPAT / UDLIST_INLINE / UDLIST_UNROLLED / UDLIST_LOCKFREE, 可以或上 UDLIST_INDEXED / UDLIST_CONCURRENT
+ * @return          指向链表头信息结构体的指针
+ */
+udlist_t *udlist_create_ex(int size, op_t my_destroy, int flags);
+
+
+/**
+ * @brief           创建使用节点内存池的链表头信息结构体
+ * @details         节点(节点头 + 数据域)从大块内存中切分, 删除的节点回收复用,
+ *                  udlist_destroy 整块释放; 数据域为内联存储, my_destroy 语义同 UDLIST_INLINE
+ * @param           存储数据类型大小
+ * @param           自定义销毁数据函数(可以为 NULL)
+ * @param           每个内存块的节点个数
+ * @return          指向链表头信息结构体的指针
+ */
+udlist_t *udlist_create_pooled(int size, op_t my_destroy, int chunk_nodes);
+
+
+/**
+ * @brief           按指定存储模式创建使用节点内存池的链表头信息结构体
+ * @details         同 udlist_create_pooled, 可以或上 UDLIST_INDEXED / UDLIST_CONCURRENT
+ * @param           存储数据类型大小
+ * @param           自定义销毁数据函数(可以为 NULL)
+ * @param           每个内存块的节点个数
+ * @param           存储模式 0 / UDLIST_INDEXED / UDLIST_CONCURRENT 的组合
+ * @return          指向链表头信息结构体的指针
+ */
+udlist_t *udlist_create_pooled_ex(int size, op_t my_destroy, int chunk_nodes, int flags);
+
+
+/**
+ * @brief           创建有序链表头信息结构体
+ * @details         内联秩树模式(UDLIST_INLINE | UDLIST_INDEXED), 插入时按 op_ord 保持有序,
+ *                  秩树的中序即为排序顺序, 按关键字插入、查找边界、区间删除均为 O(log n);
+ *                  尾部插入(含批量、按索引插入)插入到相等元素之后, 头部插入插入到相等元素之前;
+ *                  修改数据后自动恢复顺序; my_destroy 语义同 UDLIST_INLINE
+ * @note            不支持 udlist_insert_after_node, udlist_sort 只接受相同的 op_ord
+ * @param           存储数据类型大小
+ * @param           自定义销毁数据函数(可以为 NULL)
+ * @param           自定义排序比较函数, a 应排在 b 之前时返回负数, 相等返回 0
+ * @return          指向链表头信息结构体的指针
+ */
+udlist_t *udlist_create_sorted(int size, op_t my_destroy, ord_t op_ord);
+
+
+/**
+ * @brief           按指定存储模式创建有序链表头信息结构体
+ * @details         同 udlist_create_sorted, 可以或上 UDLIST_CONCURRENT
+ * @param           存储数据类型大小
+ * @param           自定义销毁数据函数(可以为 NULL)
+ * @param           自定义排序比较函数
+ * @param           存储模式 0 / UDLIST_CONCURRENT
+ * @return          指向链表头信息结构体的指针
+ */
+udlist_t *udlist_create_sorted_ex(int size, op_t my_destroy, ord_t op_ord, int flags);
+
+
+/**
+ * @brief           链表尾部插入
+ * @param           头信息结构体的指针
+ * @param           数据的指针
+ * @return          
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+int udlist_append(udlist_t *ud, void *data);
+
+
+/**
+ * @brief           链表头部插入
+ * @param           头信息结构体的指针
+ * @param           插入节点数据
+ * @return          
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+int udlist_prepend(udlist_t *ud, void *data);
+
+
+/**
+ * @brief           链表尾部批量插入
+ * @details         节点一次申请、在本地串成链后整体接入, 用于批量加载;
+ *                  内存池模式下所有节点从同一内存块连续切分; 失败时链表不变;
+ *                  UDLIST_LOCKFREE 模式下逐个插入, 失败时已插入的元素保留
+ * @param           头信息结构体的指针
+ * @param           元素数组(n 个连续存放的元素)
+ * @param           元素个数
+ * @return          
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+int udlist_append_n(udlist_t *ud, const void *array, size_t n);
+
+
+/**
+ * @brief           链表头部批量插入, 插入后元素保持数组中的顺序
+ * @param           头信息结构体的指针
+ * @param           元素数组(n 个连续存放的元素)
+ * @param           元素个数
+ * @return          
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+int udlist_prepend_n(udlist_t *ud, const void *array, size_t n);
+
+
+/**
+ * @brief           头部插入, 同 udlist_prepend
+ * @param           头信息结构体的指针
+ * @param           数据的指针
+ * @return          
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+int udlist_push_front(udlist_t *ud, void *data);
+
+
+/**
+ * @brief           尾部插入, 同 udlist_append
+ * @param           头信息结构体的指针
+ * @param           数据的指针
+ * @return          
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+int udlist_push_back(udlist_t *ud, void *data);
+
+
+/**
+ * @brief           删除头部元素并拷出数据
+ * @details         元素的所有权转移给调用者, 不调用 my_destroy;
+ *                  UDLIST_LOCKFREE 模式下无锁, 其他模式同一次调用内完成拷出和删除
+ * @param           头信息结构体的指针
+ * @param           输出数据的指针
+ * @return          
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  MATCH_FAIL:链表为空
+ */
+int udlist_pop_front(udlist_t *ud, void *data);
+
+
+/**
+ * @brief           删除尾部元素并拷出数据
+ * @details         同 udlist_pop_front
+ * @param           头信息结构体的指针
+ * @param           输出数据的指针
+ * @return          
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  MATCH_FAIL:链表为空
+ */
+int udlist_pop_back(udlist_t *ud, void *data);
+
+
+/**
+ * @brief           链表的遍历
+ * @param           头信息结构体的指针
+ * @param           自定义打印数据函数
+ * @return          
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+int udlist_traverse(udlist_t *ud, op_t my_print);
+
+
+/**
+ * @brief           链表的反向遍历
+ * @param           头信息结构体的指针
+ * @param           自定义打印数据函数
+ * @return          
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+int udlist_traverse_back(udlist_t *ud, op_t my_print);
+
+
+/**
+ * @brief           带上下文的链表遍历, 可以提前停止
+ * @details         fn(data, ctx) 返回 0 继续, 返回非 0 时停止并返回该元素的索引;
+ *                  逐个处理且需要内联时使用 udlist_iter.h 中的游标
+ * @note            UDLIST_LOCKFREE 模式不支持, 返回 PAR_ERROR
+ * @param           头信息结构体的指针
+ * @param           自定义函数
+ * @param           自定义函数上下文
+ * @param           0 正向遍历, 非 0 反向遍历
+ * @return          停止处元素的索引, 遍历完所有元素返回元素个数
+ *      @arg  PAR_ERROR:参数错误
+ */
+int udlist_traverse_ex(udlist_t *ud, pred_t fn, void *ctx, int back);
+
+
+/**
+ * @brief           链表销毁函数（不包括头信息结构体）
+ * @param           头信息结构体的指针
+ * @return          
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+int udlist_destroy(udlist_t *ud);
+
+
+/**
+ * @brief           头信息结构体销毁函数
+ * @param           头信息结构体的指针的地址
+ * @return          
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+int head_destroy(udlist_t **p);
+
+
+/**
+ * @brief           获取链表中节点的个数
+ * @param           头信息结构体的指针
+ * @return          链表节点个数
+ */
+int get_count(udlist_t *p);
+
+
+/**
+ * @brief           链表根据索引插入
+ * @note            UDLIST_SORTED 模式忽略索引, 按顺序插入
+ * @param           头信息结构体的指针
+ * @param           数据的指针
+ * @param           索引值
+ * @return          
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+int udlist_insert_by_index(udlist_t *ud, void *data, int index);
+
+
+/**
+ * @brief           链表根据索引删除
+ * @param           头信息结构体的指针
+ * @param           索引值
+ * @return          
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+int udlist_delete_by_index(udlist_t *ud, int index);
+
+
+/**
+ * @brief           链表根据索引修改数据
+ * @param           头信息结构体的指针
+ * @param           修改数据
+ * @param           索引值
+ * @return          
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+int udlist_modify_by_index(udlist_t *ud, void *data, int index);
+
+
+/**
+ * @brief           链表根据索引检索数据
+ * @param           头信息结构体的指针
+ * @param           要检索的数据
+ * @param           索引值
+ * @return          
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+int udlist_retrieve_by_index(udlist_t *ud, void *data, int index);
+
+
+/**
+ * @brief           根据关键字寻找匹配索引
+ * @param           头信息结构体的指针
+ * @param           关键字
+ * @param           自定义比较函数
+ * @return          索引值    
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  MATCH_FAIL:无匹配索引
+ */
+int get_match_index(udlist_t *ud, void *key, cmp_t op_cmp);
+
+
+
+/**
+ * @brief           链表根据关键字删除
+ * @param           头信息结构体的指针
+ * @param           关键字
+ * @param           自定义比较函数
+ * @return          
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+int udlist_delete_by_key(udlist_t *ud, void *key, cmp_t op_cmp);
+
+
+
+/**
+ * @brief           链表根据关键字修改数据
+ * @param           头信息结构体的指针
+ * @param           修改的数据
+ * @param           关键字
+ * @param           自定义比较函数
+ * @return          
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+int udlist_modify_by_key(udlist_t *ud, void *data, void *key, cmp_t op_cmp);
+
+
+
+/**
+ * @brief           链表根据关键字获取数据
+ * @param           头信息结构体的指针
+ * @param           获取的数据
+ * @param           关键字
+ * @param           自定义比较函数
+ * @return          
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+int udlist_retrieve_by_key(udlist_t *ud, void *data, void *key, cmp_t op_cmp);
+
+
+
+/**
+ * @brief           链表根据关键字删除所有匹配的节点
+ * @details         单次正向遍历, O(n)
+ * @param           头信息结构体的指针
+ * @param           关键字
+ * @param           自定义比较函数 
+ * @return          删除的节点个数
+ *      @arg  PAR_ERROR:参数错误
+ */
+int udlist_delete_all_by_key(udlist_t *ud, void *key, cmp_t op_cmp);
+
+
+
+/**
+ * @brief           链表根据关键字修改所有匹配节点的数据
+ * @details         单次正向遍历, 每个节点最多修改一次
+ * @param           头信息结构体的指针
+ * @param           修改的数据
+ * @param           关键字
+ * @param           自定义比较函数
+ * @return          修改的节点个数
+ *      @arg  PAR_ERROR:参数错误
+ */
+int udlist_modify_all_by_key(udlist_t *ud, void *data, void *key, cmp_t op_cmp);
+
+
+
+/**
+ * @brief           删除所有满足谓词的节点
+ * @details         单次正向遍历, O(n)
+ * @param           头信息结构体的指针
+ * @param           自定义谓词函数, 返回 MATCH_SUCCESS 表示删除
+ * @param           谓词上下文
+ * @return          删除的节点个数
+ *      @arg  PAR_ERROR:参数错误
+ */
+int udlist_remove_if(udlist_t *ud, pred_t pred, void *ctx);
+
+
+
+/**
+ * @brief           自定义索引销毁函数
+ * @param           数据域
+ * @return          0
+ */
+int index_destroy(void *data);
+
+
+/**
+ * @brief           自定义索引打印函数
+ * @param           数据域
+ * @return          0
+ */
+int index_print(void *data);
+
+
+/**
+ * @brief           链表根据关键字查找所有的索引
+ * @param           头信息结构体的指针
+ * @param           关键字
+ * @param           自定义比较函数 
+ * @return          存储索引链表
+ *      @arg  PAR_ERROR: 参数错误
+ *      @arg  NULL     : 没有找到匹配索引
+ */
+udlist_t *udlist_find_all_index_by_key(udlist_t *ud, void *key, cmp_t op_cmp);
+
+
+
+/**
+ * @brief           链表根据关键字查找所有的索引并写入调用者提供的数组
+ * @details         不申请内存; 返回值大于 cap 时可以按返回值准备数组后再次调用
+ * @param           头信息结构体的指针
+ * @param           关键字
+ * @param           自定义比较函数
+ * @param           索引数组(cap 为 0 时可以为 NULL, 只计数)
+ * @param           数组容量
+ * @return          匹配总个数(可能大于 cap, 只写入前 cap 个)
+ *      @arg  PAR_ERROR:参数错误
+ */
+int udlist_find_all_index_buf(udlist_t *ud, void *key, cmp_t op_cmp, int *buf, int cap);
+
+
+
+/**
+ * @brief           链表根据关键字查找所有的索引并返回连续数组
+ * @details         索引升序存放, 每个匹配只占一个 int, 结果与 udlist_find_all_index_by_key 相同
+ * @param           头信息结构体的指针
+ * @param           关键字
+ * @param           自定义比较函数
+ * @param           输出匹配个数
+ * @return          索引数组(由调用者 free)
+ *      @arg  PAR_ERROR: 参数错误
+ *      @arg  FUN_ERROR: 函数错误
+ *      @arg  NULL     : 没有找到匹配索引
+ */
+int *udlist_find_all_index_array(udlist_t *ud, void *key, cmp_t op_cmp, int *count);
+
+
+
+/**
+ * @brief           链表稳定排序 O(n log n)
+ * @details         自底向上归并排序, 只修改节点链接, 不申请内存也不拷贝数据域;
+ *                  秩树模式排序后 O(n) 重建秩树, 哈希索引不变;
+ *                  UDLIST_UNROLLED 模式在块内重排元素, 需要 n 个元素及 2n 个指针的临时空间
+ * @note            UDLIST_LOCKFREE 模式不支持, UDLIST_SORTED 模式的 op_ord 与创建时不同或开启预写日志时返回 PAR_ERROR
+ * @param           头信息结构体的指针
+ * @param           自定义排序比较函数, a 应排在 b 之前时返回负数, 相等返回 0
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+int udlist_sort(udlist_t *ud, ord_t op_ord);
+
+
+
+/**
+ * @brief           将有序链表 src 的节点合并到有序链表 dst 中 O(n + m)
+ * @details         节点直接转移到 dst, 不申请内存; 相等时 dst 的节点在前; 合并后 src 为空,
+ *                  转移的数据由 dst 的 my_destroy 销毁
+ * @note            两个链表的元素大小及 UDLIST_INLINE / UDLIST_INDEXED 模式必须相同,
+ *                  不支持内存池链表、开启预写日志的链表及 UDLIST_UNROLLED / UDLIST_LOCKFREE 模式, 返回 PAR_ERROR;
+ *                  dst 为 UDLIST_SORTED 模式时 op_ord 必须与创建时相同
+ * @param           目的链表头信息结构体的指针
+ * @param           源链表头信息结构体的指针
+ * @param           自定义排序比较函数
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ */
+int udlist_merge(udlist_t *dst, udlist_t *src, ord_t op_ord);
+
+
+
+/**
+ * @brief           有序链表查找第一个不小于关键字的元素 O(log n)
+ * @note            只支持 UDLIST_SORTED 模式, 其他模式返回 PAR_ERROR
+ * @param           头信息结构体的指针
+ * @param           关键字(与元素同类型, 由 op_ord 比较)
+ * @return          元素的索引, 不存在时为元素个数
+ *      @arg  PAR_ERROR:参数错误
+ */
+int udlist_lower_bound(udlist_t *ud, void *key);
+
+
+/**
+ * @brief           有序链表查找第一个大于关键字的元素 O(log n)
+ * @note            只支持 UDLIST_SORTED 模式, 其他模式返回 PAR_ERROR
+ * @param           头信息结构体的指针
+ * @param           关键字(与元素同类型, 由 op_ord 比较)
+ * @return          元素的索引, 不存在时为元素个数
+ *      @arg  PAR_ERROR:参数错误
+ */
+int udlist_upper_bound(udlist_t *ud, void *key);
+
+
+/**
+ * @brief           有序链表区间查询 O(log n)
+ * @details         区间 [lo, hi] 内的元素在链表中连续, 从 *first 开始沿 next 访问返回值个节点;
+ *                  节点句柄的使用限制同 udlist_find_node
+ * @note            只支持 UDLIST_SORTED 模式, 其他模式返回 PAR_ERROR
+ * @param           头信息结构体的指针
+ * @param           区间下界(包含)
+ * @param           区间上界(包含)
+ * @param           输出区间第一个节点, 区间为空时为 NULL
+ * @return          区间内的元素个数
+ *      @arg  PAR_ERROR:参数错误
+ */
+int udlist_range(udlist_t *ud, void *lo, void *hi, node_t **first);
+
+
+/**
+ * @brief           有序链表删除区间 [lo, hi] 内的所有元素 O(log n + k)
+ * @details         秩树中整段分裂删除, 链表中整段摘下, k 为删除的个数
+ * @note            只支持 UDLIST_SORTED 模式, 其他模式返回 PAR_ERROR
+ * @param           头信息结构体的指针
+ * @param           区间下界(包含)
+ * @param           区间上界(包含)
+ * @return          删除的个数
+ *      @arg  PAR_ERROR:参数错误
+ */
+int udlist_delete_range(udlist_t *ud, void *lo, void *hi);
+
+
+
+
+/**
+ * @brief           将源链表中 [first, last] 一段节点移动到目的链表 pos 之后
+ * @details         节点直接转移, 不申请内存也不拷贝数据域, 转移的数据由 dst 的 my_destroy 销毁;
+ *                  两端重新链接 O(1), 秩树模式整段分裂、合并并 O(log n) 计算节点个数,
+ *                  其他模式沿 first 走到 last 计算节点个数 O(k); 附加哈希索引时逐个转移 O(k)
+ * @note            两个链表必须不同, 元素大小及 UDLIST_INLINE / UDLIST_INDEXED 模式必须相同,
+ *                  不支持内存池链表、开启预写日志的链表及 UDLIST_UNROLLED / UDLIST_LOCKFREE 模式,
+ *                  dst 不能为 UDLIST_SORTED 模式;
+ *                  last 在 first 之前时返回 PAR_ERROR
+ * @param           目的链表头信息结构体的指针
+ * @param           目的链表中的位置节点, NULL 表示插入到头部
+ * @param           源链表头信息结构体的指针
+ * @param           源链表中第一个节点
+ * @param           源链表中最后一个节点
+ * @return          移动的节点个数
+ *      @arg  PAR_ERROR:参数错误
+ */
+int udlist_splice(udlist_t *dst, node_t *pos, udlist_t *src, node_t *first, node_t *last);
+
+
+/**
+ * @brief           从节点处拆分链表, 该节点及之后的节点移动到 out 的尾部
+ * @details         同 udlist_splice, 节点个数在秩树模式下 O(log n), 其他模式从两端中较近的一端计算 O(min(k, n - k))
+ * @note            限制同 udlist_splice
+ * @param           头信息结构体的指针
+ * @param           拆分位置节点
+ * @param           接收后半部分的链表头信息结构体的指针
+ * @return          移动的节点个数
+ *      @arg  PAR_ERROR:参数错误
+ */
+int udlist_split_at(udlist_t *ud, node_t *node, udlist_t *out);
+
+
+/**
+ * @brief           将链表 b 的所有节点移动到链表 a 的尾部 O(1)
+ * @details         同 udlist_splice, 秩树模式 O(log n), 附加哈希索引时 O(k); 移动后 b 为空
+ * @note            限制同 udlist_splice
+ * @param           链表 a 头信息结构体的指针
+ * @param           链表 b 头信息结构体的指针
+ * @return          移动的节点个数
+ *      @arg  PAR_ERROR:参数错误
+ */
+int udlist_concat(udlist_t *a, udlist_t *b);
+
+
+
+/**
+ * @brief           借用索引位置元素的数据域指针, 不拷贝数据
+ * @details         返回的指针直接指向节点(展开模式为块)内的数据, 使用完毕后必须调用 udlist_peek_end 归还;
+ *                  借用期间不能插入、删除、修改该链表; 只有定义 UDLIST_DEBUG(define.h 中去掉 _UDLIST_DEBUG 的下划线
+ *                  或编译时 -DUDLIST_DEBUG)时才检查: 写操作检查到未归还的借用会报错并终止程序, 默认不检查;
+ *                  并发模式下借用期间持有读锁, 多个线程可以同时借用, 只能通过指针读取,
+ *                  且借用期间同一线程不能再调用该链表的其他函数;
+ *                  非并发模式下可以通过指针修改不影响哈希值及排序的字段
+ * @note            UDLIST_LOCKFREE 模式不支持, 非并发模式下开启预写日志时(修改无法记录)不支持, 返回 PAR_ERROR;
+ *                  归还后不能再使用该指针
+ * @param           头信息结构体的指针
+ * @param           索引值
+ * @return          数据域指针
+ *      @arg  PAR_ERROR:参数错误(不需要归还)
+ */
+void *udlist_peek_by_index(udlist_t *ud, int index);
+
+
+/**
+ * @brief           借用第一个匹配关键字的元素的数据域指针, 不拷贝数据
+ * @details         借用规则同 udlist_peek_by_index
+ * @param           头信息结构体的指针
+ * @param           关键字
+ * @param           自定义比较函数
+ * @return          数据域指针
+ *      @arg  NULL     : 没有匹配的元素(不需要归还)
+ *      @arg  PAR_ERROR:参数错误(不需要归还)
+ */
+void *udlist_peek_by_key(udlist_t *ud, void *key, cmp_t op_cmp);
+
+
+/**
+ * @brief           链表尾部插入一个元素并借用其数据域指针, 由调用者直接写入数据
+ * @details         新元素的内容未定义(逐个申请节点时为 0), 必须在 udlist_peek_end 之前写完;
+ *                  附加哈希索引时新元素在 udlist_peek_end 时加入哈希索引, 开启预写日志时在 udlist_peek_end 时记录;
+ *                  并发模式下借用期间持有写锁; 其他借用规则同 udlist_peek_by_index
+ * @note            UDLIST_LOCKFREE / UDLIST_SORTED 模式不支持, 返回 PAR_ERROR
+ * @param           头信息结构体的指针
+ * @return          新元素的数据域指针
+ *      @arg  PAR_ERROR:参数错误(不需要归还)
+ *      @arg  FUN_ERROR:函数错误(不需要归还)
+ */
+void *udlist_emplace_back(udlist_t *ud);
+
+
+/**
+ * @brief           归还 udlist_peek_by_index / udlist_peek_by_key / udlist_emplace_back 借用的指针
+ * @param           头信息结构体的指针
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误(没有未归还的借用)
+ *      @arg  FUN_ERROR:函数错误(写 udlist_emplace_back 的日志失败, 元素已插入)
+ */
+int udlist_peek_end(udlist_t *ud);
+
+
+
+/**
+ * @brief           并行遍历链表
+ * @details         链表按索引分段, 各段由线程池中的线程并行处理, fn 必须可以被多个线程同时调用;
+ *                  同一段内按索引顺序调用, 段之间不保证顺序;
+ *                  元素较少时只有一段, 在调用线程中依次处理
+ * @note            UDLIST_LOCKFREE 模式不支持, 返回 PAR_ERROR
+ * @param           头信息结构体的指针
+ * @param           自定义函数(返回值忽略)
+ * @param           自定义函数上下文
+ * @param           线程数(包括调用线程, 小于等于 1 时在调用线程中依次处理)
+ * @return
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ */
+int udlist_traverse_parallel(udlist_t *ud, pred_t fn, void *ctx, int nthreads);
+
+
+
+/**
+ * @brief           并行查找所有匹配关键字的索引
+ * @details         各段并行比较后按索引顺序合并, 结果与 udlist_find_all_index_by_key 相同;
+ *                  op_cmp 必须可以被多个线程同时调用
+ * @note            UDLIST_LOCKFREE 模式不支持, 返回 PAR_ERROR
+ * @param           头信息结构体的指针
+ * @param           关键字
+ * @param           自定义比较函数
+ * @param           线程数(包括调用线程)
+ * @return          存储索引链表
+ *      @arg  PAR_ERROR: 参数错误
+ *      @arg  NULL     : 没有找到匹配索引
+ */
+udlist_t *udlist_find_all_parallel(udlist_t *ud, void *key, cmp_t op_cmp, int nthreads);
+
+
+
+/**
+ * @brief           链表尾部插入并返回节点句柄
+ * @details         节点句柄在节点被删除之前一直有效
+ * @note            UDLIST_UNROLLED 模式不支持, 返回 PAR_ERROR
+ * @param           头信息结构体的指针
+ * @param           数据的指针
+ * @return          新节点的指针
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+node_t *udlist_append_h(udlist_t *ud, void *data);
+
+
+
+/**
+ * @brief           根据关键字寻找第一个匹配的节点句柄
+ * @note            UDLIST_UNROLLED 模式不支持, 返回 PAR_ERROR
+ * @param           头信息结构体的指针
+ * @param           关键字
+ * @param           自定义比较函数
+ * @return          节点指针
+ *      @arg  PAR_ERROR: 参数错误
+ *      @arg  NULL     : 没有找到匹配节点
+ */
+node_t *udlist_find_node(udlist_t *ud, void *key, cmp_t op_cmp);
+
+
+
+/**
+ * @brief           根据节点句柄删除节点 O(1)
+ * @note            UDLIST_UNROLLED 模式不支持, 返回 PAR_ERROR
+ * @param           头信息结构体的指针
+ * @param           节点指针(必须属于该链表)
+ * @return          
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ */
+int udlist_remove_node(udlist_t *ud, node_t *node);
+
+
+
+/**
+ * @brief           在节点句柄之后插入 O(1)
+ * @note            UDLIST_UNROLLED / UDLIST_SORTED 模式不支持, 返回 PAR_ERROR
+ * @param           头信息结构体的指针
+ * @param           位置节点指针(必须属于该链表), NULL 表示插入到链表头部
+ * @param           数据的指针
+ * @return          新节点的指针
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+node_t *udlist_insert_after_node(udlist_t *ud, node_t *pos, void *data);
+
+
+
+/**
+ * @brief           为链表附加关键字哈希索引
+ * @details         附加后插入、修改、删除自动维护索引;
+ *                  get_match_index 及 *_by_key 传入相同的比较函数时按哈希查找 O(1),
+ *                  哈希函数必须保证比较匹配的数据和关键字哈希值相同
+ * @note            UDLIST_UNROLLED 模式不支持, 返回 PAR_ERROR
+ * @param           头信息结构体的指针
+ * @param           自定义哈希函数
+ * @param           自定义比较函数
+ * @return          
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ *      @arg  FUN_ERROR:函数错误
+ */
+int udlist_hash_attach(udlist_t *ud, hash_t my_hash, cmp_t op_cmp);
+
+
+
+/**
+ * @brief           移除链表的关键字哈希索引
+ * @param           头信息结构体的指针
+ * @return          
+ *      @arg  0:正常
+ *      @arg  PAR_ERROR:参数错误
+ */
+int udlist_hash_detach(udlist_t *ud);
+
+
+
+#endif /* __UNI_DOUBLY_LINKEDLIST_H__ */